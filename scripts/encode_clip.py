@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+"""Encode an animation into a clip for the Clip show.
+
+The clip format is described in src/support/Clip.h: a header, a palette of
+up to 256 colors and one record per frame, each frame a stream of delta ops
+against the frame before it (or against black for keyframes). This is a port
+of Support::Clip::Encoder and produces the same bytes.
+
+Input is either an image or raw RGB:
+  - a still image is one frame per row, one pixel per column
+  - an animated image (GIF, APNG, WebP) is one frame per image frame,
+    its pixels read row by row
+  - a .rgb file is 3 bytes per pixel, frame after frame; give --pixels
+Images need Pillow and are reduced to 256 colors if they have more.
+
+Usage:
+    python3 scripts/encode_clip.py sunset.png -o sunset.ledc --fps 30
+    python3 scripts/encode_clip.py fire.gif --upload ledz-a1b2c3.local
+"""
+
+import argparse
+import os
+import struct
+import sys
+import urllib.request
+import uuid
+
+VERSION = 1
+MAX_FPS = 100
+MAX_COLORS = 256
+DELTA, KEYFRAME = 0, 1
+
+SKIP, RUN, LITERAL, SHIFT = 0x00, 0x40, 0x80, 0xC0
+MAX_OP_PIXELS = 64
+MAX_SHIFT = 8
+
+
+def best_shift(frame, previous):
+    n = len(frame)
+    best, best_score = 0, sum(a == b for a, b in zip(frame, previous))
+    for shift in range(-MAX_SHIFT, MAX_SHIFT + 1):
+        if shift == 0:
+            continue
+        score = sum(frame[i] == previous[i + shift] for i in range(max(0, -shift), min(n, n - shift)))
+        if score > best_score:
+            best, best_score = shift, score
+    return best
+
+
+def encode_frame(frame, previous, index):
+    """Delta ops of one frame, see Support::Delta::encode."""
+    n = len(frame)
+    shift = best_shift(frame, previous)
+    ops = bytearray()
+    literal = []
+
+    def matching(i, offset):
+        count = 0
+        while count < MAX_OP_PIXELS and i + count < n:
+            source = i + count + offset
+            if source < 0 or source >= n or frame[i + count] != previous[source]:
+                break
+            count += 1
+        return count
+
+    def repeating(i):
+        count = 1
+        while count < MAX_OP_PIXELS and i + count < n and frame[i + count] == frame[i]:
+            count += 1
+        return count
+
+    def flush():
+        if literal:
+            ops.append(LITERAL | (len(literal) - 1))
+            ops.extend(literal)
+            literal.clear()
+
+    i = 0
+    while i < n:
+        skip = matching(i, 0)
+        shifted = matching(i, shift) if shift else 0
+        run = repeating(i)
+        pending = 1 if literal else 0
+        if skip >= 1 + pending and skip >= shifted and skip >= run:
+            flush()
+            ops.append(SKIP | (skip - 1))
+            i += skip
+        elif shifted >= 2 + pending and shifted >= run:
+            flush()
+            ops += bytes([SHIFT | (shifted - 1), shift & 0xFF])
+            i += shifted
+        elif run >= 2 + pending:
+            flush()
+            ops += bytes([RUN | (run - 1), index(frame[i])])
+            i += run
+        else:
+            literal.append(index(frame[i]))
+            if len(literal) == MAX_OP_PIXELS:
+                flush()
+            i += 1
+    flush()
+    return ops
+
+
+def encode(frames, fps, keyframe_interval):
+    """The clip file of a list of frames, each a list of packed colors."""
+    pixels = len(frames[0])
+    palette = {}
+
+    def index(color):
+        if color not in palette:
+            if len(palette) == MAX_COLORS:
+                raise ValueError("more than %d colors" % MAX_COLORS)
+            palette[color] = len(palette)
+        return palette[color]
+
+    black = [0] * pixels
+    previous = black
+    records = bytearray()
+    for number, frame in enumerate(frames):
+        keyframe = number % keyframe_interval == 0
+        ops = encode_frame(frame, black if keyframe else previous, index)
+        records += struct.pack("<BH", KEYFRAME if keyframe else DELTA, len(ops)) + ops
+        previous = frame
+
+    header = b"LEDC" + struct.pack("<BBHIHH", VERSION, fps, pixels, len(frames), len(palette), keyframe_interval)
+    return header + b"".join(struct.pack("<I", color) for color in palette) + bytes(records)
+
+
+def pack(r, g, b):
+    return r << 16 | g << 8 | b
+
+
+def read_raw(path, pixels):
+    data = open(path, "rb").read()
+    size = pixels * 3
+    if pixels <= 0 or len(data) % size:
+        sys.exit("%s: size is not a multiple of %d pixels" % (path, pixels))
+    return [[pack(*data[f + 3 * i:f + 3 * i + 3]) for i in range(pixels)] for f in range(0, len(data), size)]
+
+
+def read_image(path):
+    try:
+        from PIL import Image, ImageSequence
+    except ImportError:
+        sys.exit("Reading images needs Pillow: pip install pillow")
+    image = Image.open(path)
+    if getattr(image, "n_frames", 1) > 1:
+        shots = [frame.convert("RGB") for frame in ImageSequence.Iterator(image)]
+    else:
+        still = image.convert("RGB")
+        shots = [still.crop((0, y, still.width, y + 1)) for y in range(still.height)]
+
+    # one shared palette for all frames, by stacking them into a single image
+    width, height = shots[0].width, shots[0].height
+    sheet = Image.new("RGB", (width, height * len(shots)))
+    for number, shot in enumerate(shots):
+        sheet.paste(shot, (0, height * number))
+    if sheet.getcolors(MAX_COLORS) is None:
+        sheet = sheet.quantize(MAX_COLORS).convert("RGB")
+
+    colors = [pack(*rgb) for rgb in sheet.getdata()]
+    size = width * height
+    return [colors[start:start + size] for start in range(0, len(colors), size)]
+
+
+def upload(clip, host, name):
+    boundary = uuid.uuid4().hex
+    body = (("--%s\r\nContent-Disposition: form-data; name=\"file\"; filename=\"%s.ledc\"\r\n"
+             "Content-Type: application/octet-stream\r\n\r\n") % (boundary, name)).encode()
+    body += clip + ("\r\n--%s--\r\n" % boundary).encode()
+    request = urllib.request.Request("http://%s/api/clips?name=%s" % (host, name), data=body, method="POST",
+                                     headers={"Content-Type": "multipart/form-data; boundary=" + boundary})
+    with urllib.request.urlopen(request) as response:
+        print(response.read().decode())
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("input", help="image, animated image or .rgb file")
+    parser.add_argument("-o", "--output", help="clip file to write (default: input name with .ledc)")
+    parser.add_argument("--fps", type=int, default=25, help="frames per second, 1-%d (default: 25)" % MAX_FPS)
+    parser.add_argument("--keyframes", type=int, default=100, help="frames between keyframes (default: 100)")
+    parser.add_argument("--pixels", type=int, default=0, help="pixels per frame of a .rgb file")
+    parser.add_argument("--upload", metavar="HOST", help="upload to the device instead of writing a file")
+    parser.add_argument("--name", help="clip name on the device (default: input name)")
+    args = parser.parse_args()
+
+    if not 1 <= args.fps <= MAX_FPS:
+        sys.exit("--fps must be 1-%d" % MAX_FPS)
+    if not 1 <= args.keyframes <= 0xFFFF:
+        sys.exit("--keyframes must be 1-65535")
+
+    base = os.path.splitext(args.input)[0]
+    if args.input.lower().endswith(".rgb"):
+        frames = read_raw(args.input, args.pixels)
+    else:
+        frames = read_image(args.input)
+    if not frames or not 1 <= len(frames[0]) <= 0x7FFF:
+        sys.exit("%s: frames must have 1-32767 pixels" % args.input)
+
+    try:
+        clip = encode(frames, args.fps, args.keyframes)
+    except ValueError as error:
+        sys.exit("%s: %s" % (args.input, error))
+    print("%d frames of %d pixels: %d bytes (%d raw)" %
+          (len(frames), len(frames[0]), len(clip), 3 * len(frames) * len(frames[0])), file=sys.stderr)
+
+    if args.upload:
+        upload(clip, args.upload, args.name or os.path.basename(base))
+    else:
+        with open(args.output or base + ".ledc", "wb") as output:
+            output.write(clip)
+
+
+if __name__ == "__main__":
+    main()
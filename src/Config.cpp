@@ -1,13 +1,21 @@
 #include "Config.h"
 #include "Log.h"
+#include "support/Gradients.h"
 #include "support/LocalTime.h"
 
+#include <algorithm>
+
 #ifdef ARDUINO
 #include <esp_system.h>
 #endif
 
 static const char* TAG = "cfg";
 
+// A palette that fits a slot fits the shows, and the other way around
+static_assert(Config::CustomPalette::MAX_COLORS == Support::Gradients::MAX_COLORS, "Palette sizes differ");
+static_assert(Config::PalettesConfig::MAX_PALETTES == Support::Gradients::MAX_CUSTOM, "Palette counts differ");
+static_assert(sizeof(Config::CustomPalette::name) > Support::Gradients::MAX_NAME_LENGTH, "Palette names differ");
+
 namespace Config {
     ConfigManager::ConfigManager() {
     }
@@ -340,6 +348,12 @@ namespace Config {
         snprintf(key, sizeof(key), "preset_%u_valid", index);
         prefs.putBool(key, false);
 
+        // A preset saved into the slot later starts without a timeline
+        snprintf(key, sizeof(key), "preset_%u_tl", index);
+        if (prefs.isKey(key)) {
+            prefs.remove(key);
+        }
+
         prefs.end();
 
         ESP_LOGD(TAG, "Deleted preset %u", index);
@@ -349,6 +363,51 @@ namespace Config {
 #endif
     }
 
+    void ConfigManager::loadPresetTimeline(uint8_t index, char *json, size_t size) {
+        json[0] = '\0';
+        if (index >= PresetsConfig::MAX_PRESETS) {
+            return;
+        }
+
+#ifdef ARDUINO
+        prefs.begin(NAMESPACE, true); // Read-only mode
+
+        char key[20];
+        snprintf(key, sizeof(key), "preset_%u_tl", index);
+        if (prefs.isKey(key)) {
+            prefs.getString(key, json, size);
+        }
+
+        prefs.end();
+#endif
+    }
+
+    bool ConfigManager::savePresetTimeline(uint8_t index, const char *json) {
+        if (index >= PresetsConfig::MAX_PRESETS || strlen(json) >= PresetsConfig::MAX_TIMELINE_LENGTH) {
+            return false;
+        }
+
+#ifdef ARDUINO
+        prefs.begin(NAMESPACE, false); // Read-write mode
+
+        char key[20];
+        snprintf(key, sizeof(key), "preset_%u_tl", index);
+        bool saved = true;
+        if (json[0] != '\0') {
+            saved = prefs.putString(key, json) > 0;
+        } else if (prefs.isKey(key)) {
+            prefs.remove(key);
+        }
+
+        prefs.end();
+
+        ESP_LOGD(TAG, "Saved timeline of preset %u (%u bytes)", index, static_cast<unsigned>(strlen(json)));
+        return saved;
+#else
+        return false;
+#endif
+    }
+
     int ConfigManager::findPresetByName(const char *name) {
 #ifdef ARDUINO
         prefs.begin(NAMESPACE, true); // Read-only mode
@@ -540,6 +599,171 @@ namespace Config {
 
         ESP_LOGD(TAG, "TouchConfig: Saved - enabled=%d, threshold=%u",
                       config.enabled, config.threshold);
+#endif
+    }
+
+    TransitionConfig ConfigManager::loadTransitionConfig() {
+        TransitionConfig config;
+
+#ifdef ARDUINO
+        prefs.begin(NAMESPACE, true); // Read-only mode
+
+        if (prefs.isKey("trans_type")) {
+            prefs.getString("trans_type", config.type, sizeof(config.type));
+        }
+        config.duration_ms = prefs.getUShort("trans_ms", config.duration_ms);
+
+        prefs.end();
+#endif
+
+        return config;
+    }
+
+    void ConfigManager::saveTransitionConfig(const TransitionConfig &config) {
+#ifdef ARDUINO
+        prefs.begin(NAMESPACE, false); // Read-write mode
+
+        prefs.putString("trans_type", config.type);
+        prefs.putUShort("trans_ms", config.duration_ms);
+
+        prefs.end();
+
+        ESP_LOGD(TAG, "Saved transition - type=%s, duration=%u ms",
+                      config.type, config.duration_ms);
+#endif
+    }
+
+    PlaylistConfig ConfigManager::loadPlaylistConfig() {
+        PlaylistConfig config;
+
+#ifdef ARDUINO
+        prefs.begin(NAMESPACE, true); // Read-only mode
+
+        config.count = std::min<uint8_t>(prefs.getUChar("pl_count", 0), PlaylistConfig::MAX_ENTRIES);
+        config.shuffle = prefs.getBool("pl_shuffle", false);
+        config.enabled = prefs.getBool("pl_enabled", false);
+        if (prefs.isKey("pl_trans")) {
+            prefs.getString("pl_trans", config.transition, sizeof(config.transition));
+        }
+        config.transition_ms = prefs.getUShort("pl_trans_ms", config.transition_ms);
+
+        char key[16];
+        for (uint8_t i = 0; i < config.count; i++) {
+            snprintf(key, sizeof(key), "pl_%u_preset", i);
+            config.entries[i].preset_index = prefs.getUChar(key, 0);
+
+            snprintf(key, sizeof(key), "pl_%u_secs", i);
+            config.entries[i].duration_s = prefs.getUShort(key, config.entries[i].duration_s);
+        }
+
+        prefs.end();
+#endif
+
+        return config;
+    }
+
+    void ConfigManager::savePlaylistConfig(const PlaylistConfig &config) {
+#ifdef ARDUINO
+        prefs.begin(NAMESPACE, false); // Read-write mode
+
+        prefs.putUChar("pl_count", config.count);
+        prefs.putBool("pl_shuffle", config.shuffle);
+        prefs.putBool("pl_enabled", config.enabled);
+        prefs.putString("pl_trans", config.transition);
+        prefs.putUShort("pl_trans_ms", config.transition_ms);
+
+        char key[16];
+        for (uint8_t i = 0; i < config.count; i++) {
+            snprintf(key, sizeof(key), "pl_%u_preset", i);
+            prefs.putUChar(key, config.entries[i].preset_index);
+
+            snprintf(key, sizeof(key), "pl_%u_secs", i);
+            prefs.putUShort(key, config.entries[i].duration_s);
+        }
+
+        prefs.end();
+
+        ESP_LOGD(TAG, "Saved playlist - %u entries, shuffle=%d, enabled=%d",
+                      config.count, config.shuffle, config.enabled);
+#endif
+    }
+
+    PalettesConfig ConfigManager::loadPalettesConfig() {
+        PalettesConfig config;
+
+#ifdef ARDUINO
+        prefs.begin(NAMESPACE, true); // Read-only mode
+
+        char key[16];
+        for (uint8_t i = 0; i < PalettesConfig::MAX_PALETTES; i++) {
+            CustomPalette &palette = config.palettes[i];
+            snprintf(key, sizeof(key), "pal_%u_rgb", i);
+            if (!prefs.isKey(key)) {
+                continue;
+            }
+            // The colors are stored as they are, 3 bytes each
+            size_t length = std::min(prefs.getBytesLength(key), sizeof(palette.rgb));
+            palette.count = static_cast<uint8_t>(prefs.getBytes(key, palette.rgb, length) / 3);
+
+            snprintf(key, sizeof(key), "pal_%u_name", i);
+            prefs.getString(key, palette.name, sizeof(palette.name));
+        }
+
+        prefs.end();
+#endif
+
+        return config;
+    }
+
+    bool ConfigManager::savePalette(uint8_t index, const CustomPalette &palette) {
+        if (index >= PalettesConfig::MAX_PALETTES || palette.count == 0 ||
+            palette.count > CustomPalette::MAX_COLORS) {
+            return false;
+        }
+
+#ifdef ARDUINO
+        prefs.begin(NAMESPACE, false); // Read-write mode
+
+        char key[16];
+        snprintf(key, sizeof(key), "pal_%u_name", index);
+        bool saved = prefs.putString(key, palette.name) > 0;
+
+        snprintf(key, sizeof(key), "pal_%u_rgb", index);
+        saved = prefs.putBytes(key, palette.rgb, palette.count * 3) == palette.count * 3u && saved;
+
+        prefs.end();
+
+        ESP_LOGD(TAG, "Saved palette %u '%s' - %u colors", index, palette.name, palette.count);
+        return saved;
+#else
+        return false;
+#endif
+    }
+
+    bool ConfigManager::deletePalette(uint8_t index) {
+        if (index >= PalettesConfig::MAX_PALETTES) {
+            return false;
+        }
+
+#ifdef ARDUINO
+        prefs.begin(NAMESPACE, false); // Read-write mode
+
+        char key[16];
+        snprintf(key, sizeof(key), "pal_%u_name", index);
+        if (prefs.isKey(key)) {
+            prefs.remove(key);
+        }
+        snprintf(key, sizeof(key), "pal_%u_rgb", index);
+        if (prefs.isKey(key)) {
+            prefs.remove(key);
+        }
+
+        prefs.end();
+
+        ESP_LOGD(TAG, "Deleted palette %u", index);
+        return true;
+#else
+        return false;
 #endif
     }
 } // namespace Config
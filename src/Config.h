@@ -113,6 +113,8 @@ namespace Config {
      */
     struct PresetsConfig {
         static constexpr uint8_t MAX_PRESETS = 8;
+        // Parameter timelines are stored next to the presets, loaded on their own
+        static constexpr size_t MAX_TIMELINE_LENGTH = 1024;
         Preset presets[MAX_PRESETS];
     };
 
@@ -181,6 +183,88 @@ namespace Config {
         }
     };
 
+    /**
+     * Show transition configuration structure
+     */
+    struct TransitionConfig {
+        char type[16]; // "cut", "crossfade", "wipe" or "dissolve"
+        uint16_t duration_ms; // Duration of the blend, 0 cuts immediately
+
+        TransitionConfig() : duration_ms(1000) {
+            strcpy(type, "crossfade");
+        }
+    };
+
+    /**
+     * Playlist configuration structure
+     * Presets played in turn, each for its own duration
+     */
+    struct PlaylistConfig {
+        static constexpr uint8_t MAX_ENTRIES = 16;
+
+        struct Entry {
+            uint8_t preset_index;  // Preset slot (0-7)
+            uint16_t duration_s;   // How long the preset plays
+
+            Entry() : preset_index(0), duration_s(300) {
+            }
+        };
+
+        Entry entries[MAX_ENTRIES];
+        uint8_t count;             // Used entries
+        bool shuffle;              // New random order on every pass
+        bool enabled;              // Playing, resumed after a restart
+        char transition[16];       // Transition between entries, as in TransitionConfig
+        uint16_t transition_ms;
+
+        PlaylistConfig() : count(0), shuffle(false), enabled(false), transition_ms(2000) {
+            strcpy(transition, "crossfade");
+        }
+    };
+
+    /**
+     * Custom palette: colors spread evenly from the start to the end,
+     * stored as 3 bytes per color
+     */
+    struct CustomPalette {
+        static constexpr uint8_t MAX_COLORS = 16;
+        char name[16];
+        uint8_t count; // colors used, 0 for an empty slot
+        uint8_t rgb[MAX_COLORS * 3];
+
+        CustomPalette() : count(0) {
+            name[0] = '\0';
+        }
+
+        /**
+         * @return Color i as 0xRRGGBB
+         */
+        uint32_t color(uint8_t i) const {
+            return static_cast<uint32_t>(rgb[i * 3]) << 16 | static_cast<uint32_t>(rgb[i * 3 + 1]) << 8 | rgb[i * 3 + 2];
+        }
+
+        /**
+         * @param i Color index; ignored unless below MAX_COLORS
+         * @param color 0xRRGGBB
+         */
+        void setColor(uint8_t i, uint32_t color) {
+            if (i >= MAX_COLORS) {
+                return;
+            }
+            rgb[i * 3] = color >> 16 & 0xFF;
+            rgb[i * 3 + 1] = color >> 8 & 0xFF;
+            rgb[i * 3 + 2] = color & 0xFF;
+        }
+    };
+
+    /**
+     * Custom palettes configuration structure
+     */
+    struct PalettesConfig {
+        static constexpr uint8_t MAX_PALETTES = 8;
+        CustomPalette palettes[MAX_PALETTES];
+    };
+
 // ConfigManager is backed by ESP32 Preferences (NVS) and has no native
 // implementation (Config.cpp is excluded from the native build_src_filter),
 // so it is Arduino-only. The config structs above stay available natively
@@ -334,6 +418,22 @@ namespace Config {
          */
         bool deletePreset(uint8_t index);
 
+        /**
+         * Load the parameter timeline of a preset from NVS
+         * @param index Preset slot index (0-7)
+         * @param json Buffer for the timeline JSON, empty if the preset has none
+         * @param size Buffer size, up to PresetsConfig::MAX_TIMELINE_LENGTH
+         */
+        void loadPresetTimeline(uint8_t index, char *json, size_t size);
+
+        /**
+         * Save the parameter timeline of a preset to NVS
+         * @param index Preset slot index (0-7)
+         * @param json Timeline JSON, empty to remove it
+         * @return true if saved successfully
+         */
+        bool savePresetTimeline(uint8_t index, const char *json);
+
         /**
          * Find a preset by name
          * @param name Preset name to search for
@@ -370,6 +470,51 @@ namespace Config {
          * @param config Touch configuration to save
          */
         void saveTouchConfig(const TouchConfig &config);
+
+        /**
+         * Load transition configuration from NVS
+         * @return TransitionConfig structure with defaults if not found
+         */
+        TransitionConfig loadTransitionConfig();
+
+        /**
+         * Save transition configuration to NVS
+         * @param config Transition configuration to save
+         */
+        void saveTransitionConfig(const TransitionConfig &config);
+
+        /**
+         * Load playlist configuration from NVS
+         * @return PlaylistConfig structure, empty if not found
+         */
+        PlaylistConfig loadPlaylistConfig();
+
+        /**
+         * Save playlist configuration to NVS
+         * @param config Playlist configuration to save
+         */
+        void savePlaylistConfig(const PlaylistConfig &config);
+
+        /**
+         * Load the custom palettes from NVS
+         * @return PalettesConfig structure, all slots empty if none are stored
+         */
+        PalettesConfig loadPalettesConfig();
+
+        /**
+         * Save a custom palette to NVS
+         * @param index Palette slot index (0-7)
+         * @param palette Palette to save
+         * @return true if saved successfully
+         */
+        bool savePalette(uint8_t index, const CustomPalette &palette);
+
+        /**
+         * Delete a custom palette from NVS
+         * @param index Palette slot index (0-7)
+         * @return true if deleted successfully
+         */
+        bool deletePalette(uint8_t index);
     };
 
 #endif // ARDUINO
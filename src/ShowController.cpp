@@ -1,7 +1,9 @@
 #include "ShowController.h"
 #include "Log.h"
 #include "color.h"
+#include "show/Baked.h"
 
+#include <algorithm>
 #include <cstring> // strlen, strncpy
 
 #ifdef ARDUINO
@@ -11,14 +13,31 @@
 static constexpr size_t SHOW_COMMAND_QUEUE_SIZE = 5;
 #endif
 
+// RAM a periodic show may use for its precomputed frame loop
+static constexpr size_t BAKE_BUDGET_BYTES = 24 * 1024;
+
+// RAM for the two offscreen buffers of a show transition (1000 pixels fit)
+static constexpr size_t TRANSITION_BUDGET_BYTES = 8 * 1024;
+
+// How long before its slot a playlist entry's show is built
+static constexpr uint32_t PLAYLIST_LOOKAHEAD_MS = 5000;
+
 static const char* TAG = "ctrl";
 
+static uint32_t uptimeMs() {
+#ifdef ARDUINO
+    return millis();
+#else
+    return 0;
+#endif
+}
+
 ShowController::ShowController(ShowFactory &factory, Config::ConfigManager &config)
-    : factory(factory), config(config), brightness(128),
-      layout(), baseStrip()
+    :
 #ifdef ARDUINO
-      , commandQueue(nullptr)
+      commandQueue(nullptr),
 #endif
+      factory(factory), config(config), brightness(128), baseStrip(), layout(), timelineActive(false)
 {
 }
 
@@ -55,7 +74,7 @@ void ShowController::begin() {
 #ifdef ARDUINO
     ESP_LOGI(TAG, "Creating initial show %s with params %s", currentShowName.c_str(), params);
 #endif
-    currentShow = factory.createShow(currentShowName, params);
+    currentShow = createShow(currentShowName, params);
 #ifdef ARDUINO
     ESP_LOGD(TAG, "Show %s created", currentShowName.c_str());
     ESP_LOGD(TAG, "Initial show %p", currentShow.get());
@@ -71,6 +90,50 @@ void ShowController::begin() {
         ESP_LOGE(TAG, "Failed to create initial show!");
 #endif
     }
+
+    // Resume a playlist that was playing before the restart
+    Config::PlaylistConfig playlistConfig = config.loadPlaylistConfig();
+    if (playlistConfig.enabled) {
+        startPlaylist(playlistConfig);
+    }
+}
+
+std::unique_ptr<Show::Show> ShowController::createShow(const std::string &showName, const char *paramsJson) {
+    std::unique_ptr<Show::Show> show = factory.createShow(showName.c_str(), paramsJson);
+    if (show && show->period() > 0) {
+        Show::Iteration period = show->period();
+        return std::make_unique<Show::Baked>(std::move(show), period, BAKE_BUDGET_BYTES);
+    }
+    return show;
+}
+
+void ShowController::transitionTo(std::unique_ptr<Show::Show> &&incoming) {
+    Config::TransitionConfig transitionConfig = config.loadTransitionConfig();
+    Show::Transition::Type type = Show::Transition::typeFromName(transitionConfig.type);
+    Show::Iteration frames = transitionConfig.duration_ms / std::max<uint16_t>(1, getCycleTime());
+    transitionTo(std::move(incoming), type, frames);
+}
+
+void ShowController::transitionTo(std::unique_ptr<Show::Show> &&incoming, Show::Transition::Type type,
+                                  Show::Iteration frames) {
+    if (!currentShow || type == Show::Transition::Type::CUT || frames == 0) {
+        currentShow = std::move(incoming);
+        activeTransition = nullptr;
+        return;
+    }
+
+    // A transition interrupted by another one continues from a snapshot of the strip
+    std::unique_ptr<Show::Show> outgoing = activeTransition ? nullptr : std::move(currentShow);
+
+    size_t budget = TRANSITION_BUDGET_BYTES;
+#ifdef ARDUINO
+    budget = std::min<size_t>(budget, ESP.getMaxAllocHeap() / 2);
+#endif
+
+    auto transition = std::make_unique<Show::Transition>(std::move(outgoing), std::move(incoming),
+                                                         type, frames, budget);
+    activeTransition = transition.get();
+    currentShow = std::move(transition);
 }
 
 bool ShowController::queueShowChange(const std::string &showName, const std::string &paramsJson) {
@@ -125,9 +188,11 @@ void ShowController::applyCommand(const ShowCommand &cmd) {
     switch (cmd.type) {
         case ShowCommandType::SET_SHOW: {
             // Create new show with parameters
-            std::unique_ptr<Show::Show> newShow = factory.createShow(cmd.show_name, cmd.params_json);
+            std::unique_ptr<Show::Show> newShow = createShow(cmd.show_name, cmd.params_json);
             if (newShow != nullptr) {
-                currentShow = std::move(newShow);
+                leavePlaylist();
+                transitionTo(std::move(newShow));
+                setTimeline(nullptr);
                 {
                     std::lock_guard<std::mutex> lock(stateMutex);
                     currentShowName = cmd.show_name;
@@ -170,6 +235,10 @@ void ShowController::applyCommand(const ShowCommand &cmd) {
         case ShowCommandType::SET_LAYOUT: {
 #ifdef ARDUINO
             if (layout != nullptr && baseStrip != nullptr) {
+                // Take the overlay off while the old mapping still applies
+                overlay.restore(*layout);
+                overlay.cancel();
+
                 // Recreate layout with new parameters
                 layout = std::make_unique<Strip::Layout>(*baseStrip, cmd.layout_reverse,
                                                          cmd.layout_mirror, cmd.layout_dead_leds);
@@ -186,9 +255,10 @@ void ShowController::applyCommand(const ShowCommand &cmd) {
 
                 // Restart current show to pick up new layout dimensions
                 Config::ShowConfig showConfig = config.loadShowConfig();
-                std::unique_ptr<Show::Show> newShow = factory.createShow(currentShowName, showConfig.params_json);
+                std::unique_ptr<Show::Show> newShow = createShow(currentShowName, showConfig.params_json);
                 if (newShow != nullptr) {
                     currentShow = std::move(newShow);
+                    activeTransition = nullptr;
                     ESP_LOGI(TAG, "Restarted show '%s' with updated layout", currentShowName.c_str());
                 }
             } else {
@@ -199,11 +269,14 @@ void ShowController::applyCommand(const ShowCommand &cmd) {
         }
 
         case ShowCommandType::LOAD_PRESET: {
+            std::unique_ptr<Support::Timeline> presetTimeline(cmd.timeline);
 #ifdef ARDUINO
             ESP_LOGI(TAG, "Loading preset - show=%s", cmd.show_name);
 
             // 1. Update layout if we have valid strip pointers
             if (layout != nullptr && baseStrip != nullptr) {
+                overlay.restore(*layout);
+                overlay.cancel();
                 layout = std::make_unique<Strip::Layout>(*baseStrip, cmd.layout_reverse,
                                                          cmd.layout_mirror, cmd.layout_dead_leds);
 
@@ -219,9 +292,11 @@ void ShowController::applyCommand(const ShowCommand &cmd) {
             }
 
             // 2. Create show with preset parameters
-            std::unique_ptr<Show::Show> newShow = factory.createShow(cmd.show_name, cmd.params_json);
+            std::unique_ptr<Show::Show> newShow = createShow(cmd.show_name, cmd.params_json);
             if (newShow != nullptr) {
-                currentShow = std::move(newShow);
+                leavePlaylist();
+                transitionTo(std::move(newShow));
+                setTimeline(std::move(presetTimeline));
                 {
                     std::lock_guard<std::mutex> lock(stateMutex);
                     currentShowName = cmd.show_name;
@@ -241,7 +316,52 @@ void ShowController::applyCommand(const ShowCommand &cmd) {
 #endif
             break;
         }
+
+        case ShowCommandType::SHOW_OVERLAY: {
+            if (layout) {
+                Show::Iteration frames = cmd.overlay_duration_ms / std::max<uint16_t>(1, getCycleTime());
+                overlay.start(layout->length(), cmd.overlay_type, cmd.overlay_color,
+                              std::max<Show::Iteration>(1, frames), cmd.overlay_progress);
+#ifdef ARDUINO
+                ESP_LOGD(TAG, "Overlay %s for %u frames", Show::Overlay::typeName(cmd.overlay_type),
+                         static_cast<unsigned>(frames));
+#endif
+            }
+            break;
+        }
+
+        case ShowCommandType::SET_TIMELINE: {
+            setTimeline(std::unique_ptr<Support::Timeline>(cmd.timeline));
+#ifdef ARDUINO
+            ESP_LOGI(TAG, "Timeline %s", timeline ? "attached" : "removed");
+#endif
+            break;
+        }
+    }
+}
+
+void ShowController::setTimeline(std::unique_ptr<Support::Timeline> &&newTimeline) {
+    timeline = std::move(newTimeline);
+    timelineStart = uptimeMs();
+    timelineActive.store(timeline != nullptr);
+}
+
+std::unique_ptr<Support::Timeline> ShowController::loadTimeline(uint8_t presetIndex) {
+    std::unique_ptr<char[]> json(new char[Config::PresetsConfig::MAX_TIMELINE_LENGTH]);
+    config.loadPresetTimeline(presetIndex, json.get(), Config::PresetsConfig::MAX_TIMELINE_LENGTH);
+    if (json[0] == '\0') {
+        return nullptr;
+    }
+
+    JsonDocument doc;
+    auto presetTimeline = std::make_unique<Support::Timeline>();
+    std::string error = "not JSON";
+    if (deserializeJson(doc, json.get()) ||
+        !ShowFactory::parseTimeline(doc.as<JsonVariantConst>(), *presetTimeline, error)) {
+        ESP_LOGW(TAG, "Ignoring timeline of preset %u: %s", presetIndex, error.c_str());
+        return nullptr;
     }
+    return presetTimeline;
 }
 
 void ShowController::processCommands() {
@@ -260,6 +380,233 @@ void ShowController::processCommands() {
             free(cmd.params_json);
         }
     }
+#endif
+    advancePlaylist();
+}
+
+void ShowController::startPlaylist(const Config::PlaylistConfig &playlistConfig) {
+    std::vector<Support::Playlist::Entry> entries;
+    for (uint8_t i = 0; i < std::min(playlistConfig.count, Config::PlaylistConfig::MAX_ENTRIES); i++) {
+        const Config::PlaylistConfig::Entry &entry = playlistConfig.entries[i];
+        if (entry.preset_index < Config::PresetsConfig::MAX_PRESETS && entry.duration_s > 0) {
+            entries.push_back({entry.preset_index, entry.duration_s * 1000u});
+        }
+    }
+    Show::Transition::Type type = Show::Transition::typeFromName(playlistConfig.transition);
+    Show::Iteration frames = playlistConfig.transition_ms / std::max<uint16_t>(1, getCycleTime());
+
+    std::unique_ptr<Show::Show> discarded;
+    {
+        std::lock_guard<std::mutex> lock(playlistMutex);
+        playlist.start(entries, playlistConfig.shuffle, uptimeMs());
+        playlistTransition = type;
+        playlistTransitionFrames = frames;
+        playlistSkip = 0;
+        playlistVersion++;
+        staged.ready = false;
+        discarded = std::move(staged.show);
+    }
+
+    ESP_LOGI(TAG, "Playlist started with %u entries%s", static_cast<unsigned>(entries.size()),
+             playlistConfig.shuffle ? ", shuffled" : "");
+}
+
+bool ShowController::stopPlaylist() {
+    bool wasActive;
+    std::unique_ptr<Show::Show> discarded;
+    {
+        std::lock_guard<std::mutex> lock(playlistMutex);
+        wasActive = playlist.isActive();
+        playlist.stop();
+        playlistSkip = 0;
+        playlistVersion++;
+        staged.ready = false;
+        discarded = std::move(staged.show);
+    }
+
+    if (wasActive) {
+        ESP_LOGI(TAG, "Playlist stopped");
+    }
+    return wasActive;
+}
+
+void ShowController::leavePlaylist() {
+    if (stopPlaylist()) {
+        Config::PlaylistConfig playlistConfig = config.loadPlaylistConfig();
+        playlistConfig.enabled = false;
+        config.savePlaylistConfig(playlistConfig);
+    }
+}
+
+bool ShowController::skipPlaylist(bool forward) {
+    std::lock_guard<std::mutex> lock(playlistMutex);
+    if (!playlist.isActive()) {
+        return false;
+    }
+
+    int8_t skip = forward ? 1 : -1;
+    if (playlistSkip != skip) {
+        // The look-ahead builds the upcoming entry already, only a change of
+        // direction needs a different show
+        bool sameEntry = forward && playlistSkip == 0;
+        playlistSkip = skip;
+        if (!sameEntry) {
+            playlistVersion++;
+        }
+    }
+    return true;
+}
+
+void ShowController::preparePlaylist() {
+    uint8_t presetIndex;
+    uint32_t version;
+    bool forward;
+    {
+        std::lock_guard<std::mutex> lock(playlistMutex);
+        if (!playlist.isActive() || (staged.ready && staged.version == playlistVersion)) {
+            return;
+        }
+        if (playlistSkip == 0 && playlist.remaining(uptimeMs()) > PLAYLIST_LOOKAHEAD_MS) {
+            return;
+        }
+        forward = playlistSkip >= 0;
+        presetIndex = (forward ? playlist.upcoming() : playlist.preceding()).preset;
+        version = playlistVersion;
+    }
+
+    // Preset lookup and show construction are the slow part, kept off the LED task
+    Config::PresetsConfig presetsConfig = config.loadPresetsConfig();
+    const Config::Preset &preset = presetsConfig.presets[presetIndex];
+    std::unique_ptr<Show::Show> show;
+    std::unique_ptr<Support::Timeline> presetTimeline;
+    if (preset.valid) {
+        show = createShow(preset.show_name, preset.params_json);
+        presetTimeline = loadTimeline(presetIndex);
+    }
+    if (show) {
+        ESP_LOGD(TAG, "Playlist prepared preset %u: %s", presetIndex, preset.show_name);
+    } else {
+        ESP_LOGW(TAG, "Playlist skips preset %u: not set or unknown show", presetIndex);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(playlistMutex);
+        // A start, stop or skip while building makes the show useless
+        if (version == playlistVersion) {
+            std::swap(staged.show, show);
+            staged.timeline = std::move(presetTimeline);
+            staged.name = preset.show_name;
+            staged.version = version;
+            staged.forward = forward;
+            staged.ready = true;
+        }
+    }
+    // show now holds a stale build, if any, freed outside the lock
+}
+
+void ShowController::advancePlaylist() {
+    std::unique_ptr<Show::Show> incoming;
+    std::unique_ptr<Support::Timeline> incomingTimeline;
+    std::string name;
+    Show::Transition::Type type;
+    Show::Iteration frames;
+    size_t position;
+    {
+        std::lock_guard<std::mutex> lock(playlistMutex);
+        if (!staged.ready || staged.version != playlistVersion) {
+            return;
+        }
+        uint32_t now = uptimeMs();
+        if (playlistSkip == 0 && !playlist.isDue(now)) {
+            return;
+        }
+
+        if (staged.forward) {
+            playlist.next(now);
+        } else {
+            playlist.previous(now);
+        }
+        playlistSkip = 0;
+        playlistVersion++;
+        staged.ready = false;
+        incoming = std::move(staged.show);
+        incomingTimeline = std::move(staged.timeline);
+        name = std::move(staged.name);
+        type = playlistTransition;
+        frames = playlistTransitionFrames;
+        position = playlist.position();
+    }
+
+    // An unset preset passes its slot with the running show
+    if (incoming) {
+        transitionTo(std::move(incoming), type, frames);
+        setTimeline(std::move(incomingTimeline));
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            currentShowName = name;
+        }
+        ESP_LOGI(TAG, "Playlist entry %u: %s", static_cast<unsigned>(position), name.c_str());
+    }
+}
+
+PlaylistStatus ShowController::getPlaylistStatus() const {
+    PlaylistStatus status;
+    std::lock_guard<std::mutex> lock(playlistMutex);
+    status.active = playlist.isActive();
+    status.shuffle = playlist.isShuffled();
+    status.count = static_cast<uint8_t>(playlist.size());
+    status.position = static_cast<uint8_t>(playlist.position());
+    if (status.position < status.count) {
+        status.preset = playlist.current().preset;
+        status.remaining_ms = playlist.remaining(uptimeMs());
+    }
+    return status;
+}
+
+bool ShowController::queueOverlay(Show::Overlay::Type type, Strip::Color color, uint16_t duration_ms,
+                                  uint8_t progress) {
+#ifdef ARDUINO
+    if (commandQueue == nullptr) {
+        return false;
+    }
+
+    ShowCommand cmd;
+    cmd.type = ShowCommandType::SHOW_OVERLAY;
+    cmd.overlay_type = type;
+    cmd.overlay_color = color;
+    cmd.overlay_duration_ms = duration_ms;
+    cmd.overlay_progress = progress;
+
+    if (xQueueSend(commandQueue, &cmd, 0) == pdTRUE) {
+        return true;
+    }
+
+    ESP_LOGW(TAG, "Overlay command queue full!");
+    return false;
+#else
+    return false;
+#endif
+}
+
+bool ShowController::queueTimeline(std::unique_ptr<Support::Timeline> &&newTimeline) {
+#ifdef ARDUINO
+    if (commandQueue == nullptr) {
+        return false;
+    }
+
+    ShowCommand cmd;
+    cmd.type = ShowCommandType::SET_TIMELINE;
+    cmd.timeline = newTimeline.get();
+
+    if (xQueueSend(commandQueue, &cmd, 0) == pdTRUE) {
+        newTimeline.release(); // the LED task owns it now
+        return true;
+    }
+
+    ESP_LOGW(TAG, "Timeline command queue full!");
+    return false;
+#else
+    return false;
 #endif
 }
 
@@ -286,7 +633,7 @@ bool ShowController::queueLayoutChange(bool reverse, bool mirror, int16_t dead_l
 #endif
 }
 
-bool ShowController::queuePresetLoad(const Config::Preset &preset) {
+bool ShowController::queuePresetLoad(const Config::Preset &preset, int index) {
 #ifdef ARDUINO
     if (commandQueue == nullptr) {
         return false;
@@ -294,6 +641,8 @@ bool ShowController::queuePresetLoad(const Config::Preset &preset) {
 
     ShowCommand cmd;
     cmd.type = ShowCommandType::LOAD_PRESET;
+    // Parsed here, so the LED task only swaps it in
+    cmd.timeline = index >= 0 ? loadTimeline(index).release() : nullptr;
 
     // ShowCommand uses pointers; Preset stores C strings.
     cmd.show_name = strdup(preset.show_name);
@@ -311,6 +660,7 @@ bool ShowController::queuePresetLoad(const Config::Preset &preset) {
     // If failed to queue, we must free the memory
     free(cmd.show_name);
     free(cmd.params_json);
+    delete cmd.timeline;
 
     ESP_LOGW(TAG, "Preset load command queue full!");
     return false;
@@ -370,18 +720,29 @@ ShowController::~ShowController() {
 #endif
 }
 
-const std::vector<ShowFactory::ShowInfo> &ShowController::listShows() const {
-    return factory.listShows();
-}
-
 uint16_t ShowController::getCycleTime() const {
     return config.loadDeviceConfig().cycle_time;
 }
 
-void ShowController::executeShow(unsigned int iteration) const {
+void ShowController::executeShow(unsigned int iteration) {
     if (layout && currentShow) {
+        if (timeline) {
+            // O(tracks) and allocation free, see Support::Timeline
+            timeline->evaluate(uptimeMs() - timelineStart);
+            for (size_t i = 0; i < timeline->tracks(); i++) {
+                currentShow->setParameter(timeline->parameter(i), timeline->value(i));
+            }
+        }
+
         layout->setBrightness(brightness.load());
+        overlay.restore(*layout);
         currentShow->execute(*layout, iteration);
+
+        if (activeTransition && activeTransition->isFinished()) {
+            currentShow = activeTransition->release();
+            activeTransition = nullptr;
+        }
+        overlay.apply(*layout);
     }
 }
 
@@ -392,12 +753,17 @@ void ShowController::show() const {
 }
 
 bool ShowController::isShowComplete() const {
-    return currentShow && currentShow->isComplete();
+    return currentShow && currentShow->isComplete() && !overlay.isActive();
 }
 
 void ShowController::updateStats(const ShowStats &newStats) {
+    ShowStats updated = newStats;
+    if (currentShow) {
+        updated.layer_count = currentShow->layerTimings(updated.layers, Show::Layers::MAX_LAYERS);
+    }
+
     std::lock_guard<std::mutex> lock(stateMutex);
-    stats = newStats;
+    stats = updated;
 }
 
 ShowStats ShowController::getStats() const {
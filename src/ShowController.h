@@ -16,11 +16,16 @@
 #endif
 
 #include "show/Show.h"
+#include "show/Layers.h"
+#include "show/Overlay.h"
+#include "show/Transition.h"
 #include "ShowFactory.h"
 #include "Config.h"
 #include "strip/Base.h"
 #include "strip/Strip.h"
 #include "strip/Layout.h"
+#include "support/Playlist.h"
+#include "support/Timeline.h"
 
 /**
  * Show command types for queue communication
@@ -29,7 +34,9 @@ enum class ShowCommandType {
     SET_SHOW, // Change current show
     SET_BRIGHTNESS, // Change brightness
     SET_LAYOUT, // Change strip layout
-    LOAD_PRESET // Load a preset (show + params + layout)
+    LOAD_PRESET, // Load a preset (show + params + layout + timeline)
+    SHOW_OVERLAY, // Draw a notification over the running show
+    SET_TIMELINE // Animate parameters of the running show
 };
 
 /**
@@ -43,6 +50,11 @@ struct ShowCommand {
     bool layout_reverse;
     bool layout_mirror;
     int16_t layout_dead_leds;
+    Show::Overlay::Type overlay_type;
+    Strip::Color overlay_color;
+    uint16_t overlay_duration_ms;
+    uint8_t overlay_progress;
+    Support::Timeline *timeline; // owned by the command, nullptr for none
 };
 
 /**
@@ -54,6 +66,20 @@ struct ShowStats {
     uint32_t avg_cycle_time = 0;     // ms
     uint32_t last_execution_time = 0; // ms
     uint32_t last_show_time = 0;      // ms
+    Show::LayerTiming layers[Show::Layers::MAX_LAYERS] = {}; // per layer of a Layers show
+    uint8_t layer_count = 0;
+};
+
+/**
+ * Playlist state for status reporting
+ */
+struct PlaylistStatus {
+    bool active = false;
+    bool shuffle = false;
+    uint8_t position = 0;   // in the current pass, count before the first entry plays
+    uint8_t count = 0;      // entries
+    uint8_t preset = 0;     // preset index of the playing entry
+    uint32_t remaining_ms = 0;
 };
 
 /**
@@ -72,6 +98,8 @@ private:
     Config::ConfigManager &config;
 
     std::unique_ptr<Show::Show> currentShow;
+    Show::Transition *activeTransition = nullptr; // currentShow while a transition runs
+    Show::Overlay overlay;
     std::string currentShowName;
     std::atomic<uint8_t> brightness;
 
@@ -82,6 +110,80 @@ private:
     ShowStats stats;
     mutable std::mutex stateMutex;
 
+    // Parameter timeline of the current show, evaluated by the LED task
+    std::unique_ptr<Support::Timeline> timeline;
+    uint32_t timelineStart = 0;
+    std::atomic<bool> timelineActive;
+
+    /**
+     * Playlist entry show, built ahead by preparePlaylist() and swapped in by
+     * the LED task when its slot starts
+     */
+    struct StagedShow {
+        bool ready = false;
+        std::unique_ptr<Show::Show> show; // nullptr if the preset is gone: the playlist moves on
+        std::string name;
+        std::unique_ptr<Support::Timeline> timeline; // of the entry's preset
+        uint32_t version = 0; // playlistVersion it was built for
+        bool forward = true; // built for the upcoming entry, else the preceding one
+    };
+
+    // Guards the playlist, its version, the pending skip and the staged show
+    mutable std::mutex playlistMutex;
+    Support::Playlist playlist;
+    uint32_t playlistVersion = 0; // changes whenever the entry to build next changes
+    int8_t playlistSkip = 0; // requested from the API or touch: 1 next, -1 previous
+    Show::Transition::Type playlistTransition = Show::Transition::Type::CUT;
+    Show::Iteration playlistTransitionFrames = 0;
+    StagedShow staged;
+
+    /**
+     * Create a show through the factory, baking periodic shows into a frame loop
+     * @param showName Name of the show
+     * @param paramsJson JSON parameters
+     * @return Show instance, nullptr if unknown
+     */
+    std::unique_ptr<Show::Show> createShow(const std::string &showName, const char *paramsJson);
+
+    /**
+     * Make a show current, blending over from the running one as configured
+     * @param incoming Show to switch to
+     */
+    void transitionTo(std::unique_ptr<Show::Show> &&incoming);
+
+    /**
+     * Make a show current with the given transition
+     * @param incoming Show to switch to
+     * @param type Transition to blend with
+     * @param frames Transition length, 0 cuts
+     */
+    void transitionTo(std::unique_ptr<Show::Show> &&incoming, Show::Transition::Type type,
+                      Show::Iteration frames);
+
+    /**
+     * Attach a timeline to the current show, replacing any other (called from LED task)
+     * @param newTimeline Timeline starting now, nullptr to stop animating
+     */
+    void setTimeline(std::unique_ptr<Support::Timeline> &&newTimeline);
+
+    /**
+     * Load and parse the timeline stored with a preset
+     * @param presetIndex Preset slot index
+     * @return Timeline, nullptr if the preset has none or it does not parse
+     */
+    std::unique_ptr<Support::Timeline> loadTimeline(uint8_t presetIndex);
+
+    /**
+     * Switch to the staged playlist show once its slot starts (called from LED task)
+     * Never builds a show: if none is staged yet the current one plays on
+     */
+    void advancePlaylist();
+
+    /**
+     * Stop the playlist because a show was chosen by hand, and remember that
+     */
+    void leavePlaylist();
+
     /**
      * Apply a command (called from LED task)
      */
@@ -130,9 +232,69 @@ public:
     /**
      * Queue preset load command (called from Core 1 - webserver)
      * @param preset Preset to load
+     * @param index Slot of the preset, to load its timeline; -1 for none
      * @return true if queued successfully
      */
-    bool queuePresetLoad(const Config::Preset &preset);
+    bool queuePresetLoad(const Config::Preset &preset, int index = -1);
+
+    /**
+     * Queue a parameter timeline for the running show (called from any task)
+     * Values are fed into the show every frame; a show change ends the timeline
+     * @param timeline Timeline, nullptr to stop animating
+     * @return true if queued successfully
+     */
+    bool queueTimeline(std::unique_ptr<Support::Timeline> &&timeline);
+
+    /**
+     * @return true if a timeline animates the current show
+     */
+    bool hasTimeline() const { return timelineActive.load(); }
+
+    /**
+     * Queue a notification overlay (called from any task)
+     * The current show keeps running underneath
+     * @param type Overlay to draw
+     * @param color Overlay color
+     * @param duration_ms How long the overlay lasts
+     * @param progress Filled fraction of a progress bar (0-255)
+     * @return true if queued successfully
+     */
+    bool queueOverlay(Show::Overlay::Type type, Strip::Color color, uint16_t duration_ms,
+                      uint8_t progress = 255);
+
+    /**
+     * Start a playlist from its first entry (called from any task)
+     * Entries of presets that are not set are skipped when their turn comes
+     * @param playlist Entries, order and transition; empty stops
+     */
+    void startPlaylist(const Config::PlaylistConfig &playlist);
+
+    /**
+     * Stop the playlist, the current show keeps running (called from any task)
+     * @return true if a playlist was playing
+     */
+    bool stopPlaylist();
+
+    /**
+     * Move to the next or previous playlist entry (called from any task)
+     * The switch happens once preparePlaylist() has built the entry's show
+     * @param forward Next entry, else the previous one
+     * @return false if no playlist plays
+     */
+    bool skipPlaylist(bool forward = true);
+
+    /**
+     * Build the show of the playlist entry that plays next, shortly before
+     * its slot starts or right after a skip (called from the playlist task,
+     * never from the LED task)
+     */
+    void preparePlaylist();
+
+    /**
+     * Get the playlist position
+     * @return Current playlist state
+     */
+    PlaylistStatus getPlaylistStatus() const;
 
     /**
      * Set layout and base strip pointers for runtime reconfiguration
@@ -175,21 +337,25 @@ public:
      */
     ~ShowController();
 
-    const std::vector<ShowFactory::ShowInfo> &listShows() const;
-
-    void executeShow(unsigned int iteration) const;
+    /**
+     * Render the current show into the layout, with any active overlay on top
+     * Completes a running transition once the incoming show is fully visible
+     * @param iteration Frame counter
+     */
+    void executeShow(unsigned int iteration);
 
     void show() const;
 
     /**
      * Check if the current show has reached a static state
      * Used for power save mode
-     * @return true if show is static (no animation), false otherwise
+     * @return true if show is static (no animation) and no overlay runs, false otherwise
      */
     bool isShowComplete() const;
 
     /**
-     * Update show statistics
+     * Update show statistics (called from the LED task)
+     * Per-layer timings are taken from the current show
      * @param stats New statistics
      */
     void updateStats(const ShowStats &stats);
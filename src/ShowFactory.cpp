@@ -12,16 +12,76 @@
 #include "show/TheaterChase.h"
 #include "show/Stroboscope.h"
 #include "show/Fire.h"
+#include "show/Layers.h"
+#include "show/PostProcessed.h"
+#include "show/Shader.h"
+#include "show/Noise.h"
+#include "show/Automaton.h"
+#include "show/Spectrum.h"
+#include "show/BeatPulse.h"
+#include "show/Clip.h"
+#include "support/Gradients.h"
+#include "support/Random.h"
 #include "color.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 
 static const char* TAG = "show";
 
-ShowFactory::ShowFactory() {
-    // Register all available shows (in display order)
-    // Each lambda receives a JsonDocument and uses defaults via | operator
+// Fraction 0..1 from the params as 0..255
+static uint8_t fraction(JsonVariantConst value) {
+    float f = value | 0.0f;
+    return static_cast<uint8_t>(std::min(1.0f, std::max(0.0f, f)) * 255.0f + 0.5f);
+}
+
+// {"post":{"trail":0.8,"decay":0.5,"blur":1,"kernel":"gaussian"}}
+static Show::PostProcessed::Settings parsePostSettings(JsonVariantConst post) {
+    Show::PostProcessed::Settings settings;
+    settings.trail = fraction(post["trail"]);
+    settings.decay = fraction(post["decay"]);
+    settings.blur_passes = std::min(4, std::max(0, post["blur"] | 0));
+    settings.kernel = Support::PostProcess::kernelFromName(post["kernel"] | "gaussian");
+    if (settings.trail > 0 && settings.decay > 0) {
+        ESP_LOGW(TAG, "Post-processing trail and decay are exclusive, using trail");
+    }
+    return settings;
+}
+
+// [[r,g,b], ...]; entries that are not color triples are skipped
+static std::vector<Strip::Color> parseColors(JsonVariantConst list) {
+    std::vector<Strip::Color> colors;
+    for (JsonVariantConst entry: list.as<JsonArrayConst>()) {
+        JsonArrayConst rgb = entry.as<JsonArrayConst>();
+        if (rgb.size() >= 3) {
+            colors.push_back(color(rgb[0].as<uint8_t>(), rgb[1].as<uint8_t>(), rgb[2].as<uint8_t>()));
+        }
+    }
+    return colors;
+}
+
+// "palette": a built-in or custom gradient by name, or a list of [r,g,b] colors;
+// empty, for the show's own colors, if it is neither
+static std::vector<Strip::Color> parsePalette(JsonVariantConst value) {
+    if (value.is<const char *>()) {
+        std::vector<Strip::Color> colors = Support::Gradients::find(value.as<const char *>());
+        if (colors.empty()) {
+            ESP_LOGW(TAG, "Unknown palette %s", value.as<const char *>());
+        }
+        return colors;
+    }
+    return parseColors(value);
+}
 
-    registerShow("Solid", "Static light: one color, or the strip split into sections with optional gradient blending (flags, patterns)", [](const JsonDocument &doc) {
+// All available shows, in display order
+// Each constructor receives a JsonDocument and uses defaults via | operator;
+// the parameters string lists the same defaults for the web interface
+static constexpr ShowFactory::ShowInfo SHOWS[] = {
+    {"Solid", "Static light: one color, or the strip split into sections with optional gradient blending (flags, patterns)",
+     R"({"colors":[[255,250,230]],"ranges":[],"gradient":false})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
         std::vector<Strip::Color> colors;
         std::vector<float> ranges;
 
@@ -62,21 +122,39 @@ ShowFactory::ShowFactory() {
         }
 
         return std::make_unique<Show::ColorRanges>(colors, ranges, gradient);
-    });
+    }},
 
-    registerShow("Fire", "Flickering flames rising from one end, fed by random sparks and cooling into embers", [](const JsonDocument &doc) {
+    {"Fire", "Flickering flames rising from one end, fed by random sparks and cooling into embers",
+     R"({"cooling":0.1,"spread":10,"ignition":0.5,"spark_amount":0.5,"start_offset":5,"spark_range":5,"fuel":"wood","sources":[0],"palette":[]})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
         float cooling = doc["cooling"] | 0.1f;
         float spread = doc["spread"] | 10.0f;
         float ignition = doc["ignition"] | 0.5f;
         float spark_amount = doc["spark_amount"] | 0.5f;
         int start_offset = doc["start_offset"] | 5;
         int spark_range = doc["spark_range"] | 5;
-        ESP_LOGI(TAG, "Creating Fire cooling=%.2f, spread=%.2f, ignition=%.2f, spark_amount=%.2f, start_offset=%d, spark_range=%d",
-                      cooling, spread, ignition, spark_amount, start_offset, spark_range);
-        return std::make_unique<Show::Fire>(cooling, spread, ignition, spark_amount, std::vector<float>{1.0f}, start_offset, spark_range);
-    });
+        const char *fuel = doc["fuel"] | "wood";
+        // Pixels where sparks start, counted from start_offset below the strip
+        std::vector<Strip::PixelIndex> sources;
+        for (JsonVariantConst source: doc["sources"].as<JsonArrayConst>()) {
+            sources.push_back(source.as<Strip::PixelIndex>());
+        }
+        if (sources.empty()) {
+            sources.push_back(0);
+        }
+        // A palette replaces the colors of the fuel
+        std::vector<Strip::Color> palette = parsePalette(doc["palette"]);
+        ESP_LOGI(TAG, "Creating Fire cooling=%.2f, spread=%.2f, ignition=%.2f, spark_amount=%.2f, start_offset=%d, spark_range=%d, fuel=%s, sources=%u, palette=%u colors",
+                      cooling, spread, ignition, spark_amount, start_offset, spark_range, fuel,
+                      static_cast<unsigned>(sources.size()), static_cast<unsigned>(palette.size()));
+        return std::make_unique<Show::Fire>(cooling, spread, ignition, spark_amount, std::vector<float>{1.0f}, start_offset,
+                                            spark_range, Show::Fire::fuelFromName(fuel), sources,
+                                            Support::randomSeed(), palette);
+    }},
 
-    registerShow("Starlight", "Single pixels light up at random and slowly fade away, like stars in a night sky", [](const JsonDocument &doc) {
+    {"Starlight", "Single pixels light up at random and slowly fade away, like stars in a night sky",
+     R"({"probability":0.1,"length":5000,"fade":1000,"r":255,"g":180,"b":50})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
         float probability = doc["probability"] | 0.1f;
         unsigned long length_ms = doc["length"] | 5000;
         unsigned long fade_ms = doc["fade"] | 1000;
@@ -86,55 +164,79 @@ ShowFactory::ShowFactory() {
         ESP_LOGI(TAG, "Creating Starlight probability=%.2f, length=%lums, fade=%lums, RGB(%d,%d,%d)",
                       probability, length_ms, fade_ms, r, g, b);
         return std::make_unique<Show::Starlight>(probability, length_ms, fade_ms, r, g, b);
-    });
+    }},
 
-    registerShow("Stroboscope", "Hard on/off flashes of a single color at an adjustable rhythm", [](const JsonDocument &doc) {
+    {"Stroboscope", "Hard on/off flashes of a single color at an adjustable rhythm",
+     R"({"r":255,"g":255,"b":255,"on_cycles":1,"off_cycles":10,"flashes_per_beat":0})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
         uint8_t r = doc["r"] | 255;
         uint8_t g = doc["g"] | 255;
         uint8_t b = doc["b"] | 255;
         unsigned int on_cycles = doc["on_cycles"] | 1;
         unsigned int off_cycles = doc["off_cycles"] | 10;
-        ESP_LOGI(TAG, "Creating Stroboscope RGB(%d,%d,%d), on=%u, off=%u",
-                      r, g, b, on_cycles, off_cycles);
-        return std::make_unique<Show::Stroboscope>(r, g, b, on_cycles, off_cycles);
-    });
+        float flashes_per_beat = std::max(0.0f, doc["flashes_per_beat"] | 0.0f);
+        ESP_LOGI(TAG, "Creating Stroboscope RGB(%d,%d,%d), on=%u, off=%u, flashes_per_beat=%.2f",
+                      r, g, b, on_cycles, off_cycles, flashes_per_beat);
+        return std::make_unique<Show::Stroboscope>(r, g, b, on_cycles, off_cycles, flashes_per_beat);
+    }},
 
-    registerShow("ColorRun", "Colored dots appear at random and race along the strip at their own speed", [](const JsonDocument &doc) {
+    {"ColorRun", "Colored dots appear at random and race along the strip at their own speed",
+     R"({})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
         // ColorRun has no parameters yet
         return std::make_unique<Show::ColorRun>();
-    });
+    }},
 
-    registerShow("Jump", "Several balls bounce along the strip at different heights and speeds, swapping colors at each bounce", [](const JsonDocument &doc) {
+    {"Jump", "Several balls bounce along the strip at different heights and speeds, swapping colors at each bounce",
+     R"({})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
         // Jump has no parameters yet
         return std::make_unique<Show::Jump>();
-    });
+    }},
 
-    registerShow("Rainbow", "The full color spectrum drifting smoothly along the strip", [](const JsonDocument &doc) {
+    {"Rainbow", "The full color spectrum drifting smoothly along the strip",
+     R"({"time_step":1,"pixel_step":1,"palette":[]})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
         float time_step = doc["time_step"] | 1.0f;
         float pixel_step = doc["pixel_step"] | 1.0f;
-        ESP_LOGI(TAG, "Creating Rainbow time_step=%.2f, pixel_step=%.2f",
-                      time_step, pixel_step);
-        return std::make_unique<Show::Rainbow>(time_step, pixel_step);
-    });
+        std::vector<Strip::Color> palette = parsePalette(doc["palette"]);
+        ESP_LOGI(TAG, "Creating Rainbow time_step=%.2f, pixel_step=%.2f, palette=%u colors",
+                      time_step, pixel_step, static_cast<unsigned>(palette.size()));
+        return std::make_unique<Show::Rainbow>(time_step, pixel_step, palette);
+    }},
 
-    registerShow("Wave", "Rainbow waves roll out from one end and fade as they travel, with a pulsing source", [](const JsonDocument &doc) {
+    {"Wave", "Rainbow waves roll out from one end and fade as they travel, with a pulsing source",
+     R"({"wave_speed":1,"decay_rate":2,"brightness_frequency":0.1,"wavelength":6,"sources":[],"palette":[]})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
         float wave_speed = doc["wave_speed"] | 1.0f;
         float decay_rate = doc["decay_rate"] | 2.0f;
         float brightness_frequency = doc["brightness_frequency"] | 0.1f;
         float wavelength = doc["wavelength"] | 6.0f;
-        ESP_LOGI(TAG, "Creating Wave speed=%.2f, decay=%.2f, freq=%.2f, wavelength=%.2f",
-                      wave_speed, decay_rate, brightness_frequency, wavelength);
-        return std::make_unique<Show::Wave>(wave_speed, decay_rate, brightness_frequency, wavelength);
-    });
+        // [{"position":..,"wavelength":..,"speed":..}, ...]; missing fields use the values above
+        std::vector<Show::Wave::Source> sources;
+        for (JsonVariantConst source: doc["sources"].as<JsonArrayConst>()) {
+            sources.push_back({static_cast<Strip::PixelIndex>(source["position"] | 0), source["wavelength"] | wavelength, source["speed"] | wave_speed});
+        }
+        std::vector<Strip::Color> palette = parsePalette(doc["palette"]);
+        ESP_LOGI(TAG, "Creating Wave speed=%.2f, decay=%.2f, freq=%.2f, wavelength=%.2f, sources=%u, palette=%u colors",
+                      wave_speed, decay_rate, brightness_frequency, wavelength, static_cast<unsigned>(sources.size()),
+                      static_cast<unsigned>(palette.size()));
+        return std::make_unique<Show::Wave>(wave_speed, decay_rate, brightness_frequency, wavelength, sources, palette);
+    }},
 
-    registerShow("TheaterChase", "Evenly spaced rainbow dots march along the strip, like lights around a theater marquee", [](const JsonDocument &doc) {
+    {"TheaterChase", "Evenly spaced rainbow dots march along the strip, like lights around a theater marquee",
+     R"({"num_steps_per_cycle":21,"steps_per_beat":0})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
         unsigned int num_steps_per_cycle = doc["num_steps_per_cycle"] | 21;
-        ESP_LOGI(TAG, "Creating TheaterChase num_steps_per_cycle=%u",
-                      num_steps_per_cycle);
-        return std::make_unique<Show::TheaterChase>(num_steps_per_cycle);
-    });
+        float steps_per_beat = std::max(0.0f, doc["steps_per_beat"] | 0.0f);
+        ESP_LOGI(TAG, "Creating TheaterChase num_steps_per_cycle=%u, steps_per_beat=%.2f",
+                      num_steps_per_cycle, steps_per_beat);
+        return std::make_unique<Show::TheaterChase>(num_steps_per_cycle, steps_per_beat);
+    }},
 
-    registerShow("MorseCode", "Your own message spelled out in Morse code, scrolling across the strip as dots and dashes", [](const JsonDocument &doc) {
+    {"MorseCode", "Your own message spelled out in Morse code, scrolling across the strip as dots and dashes",
+     R"({"message":"HELLO","speed":0.5,"dot_length":2,"dash_length":4,"symbol_space":2,"letter_space":3,"word_space":5})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
         // MorseCode takes a const std::string& and copies, so handing it the
         // document's own pointer is safe for the duration of the call.
         const char *message = doc["message"] | "HELLO";
@@ -148,66 +250,380 @@ ShowFactory::ShowFactory() {
                       message, speed, dot_length, dash_length);
         return std::make_unique<Show::MorseCode>(message, speed, dot_length, dash_length,
                                                  symbol_space, letter_space, word_space);
-    });
+    }},
 
-    registerShow("Chaos", "The logistic map drawn live: steady points split again and again until they dissolve into chaos", [](const JsonDocument &doc) {
+    {"Chaos", "The logistic map drawn live: steady points split again and again until they dissolve into chaos",
+     R"({"Rmin":2.95,"Rmax":4,"Rdelta":0.0002,"mode":"points","iterations":10000,"decay":0.8,"palette":[]})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
         float Rmin = doc["Rmin"] | 2.95f;
         float Rmax = doc["Rmax"] | 4.0f;
         float Rdelta = doc["Rdelta"] | 0.0002f;
-        ESP_LOGI(TAG, "Creating Chaos Rmin=%.4f, Rmax=%.4f, Rdelta=%.6f",
-                      Rmin, Rmax, Rdelta);
-        return std::make_unique<Show::Chaos>(Rmin, Rmax, Rdelta);
-    });
+        const char *mode = doc["mode"] | "points";
+        unsigned int iterations = doc["iterations"] | 10000;
+        float decay = doc["decay"] | 0.8f;
+        std::vector<Strip::Color> palette = parsePalette(doc["palette"]);
+        ESP_LOGI(TAG, "Creating Chaos Rmin=%.4f, Rmax=%.4f, Rdelta=%.6f, mode=%s, iterations=%u, decay=%.2f, palette=%u colors",
+                      Rmin, Rmax, Rdelta, mode, iterations, decay, static_cast<unsigned>(palette.size()));
+        return std::make_unique<Show::Chaos>(Rmin, Rmax, Rdelta, Show::Chaos::modeFromName(mode), iterations, decay,
+                                             palette);
+    }},
 
-    registerShow("Mandelbrot", "A slow scan across the Mandelbrot set, one fractal slice at a time, colored by escape time", [](const JsonDocument &doc) {
+    {"Mandelbrot", "A slow scan across the Mandelbrot set, one fractal slice at a time, colored by escape time",
+     R"({"Cre0":-1.05,"Cim0":-0.3616,"Cim1":-0.3156,"scale":5,"max_iterations":50,"color_scale":10,"fixed_point":false,"palette":[]})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
         float Cre0 = doc["Cre0"] | -1.05f;
         float Cim0 = doc["Cim0"] | -0.3616f;
         float Cim1 = doc["Cim1"] | -0.3156f;
         unsigned int scale = doc["scale"] | 5;
         unsigned int max_iterations = doc["max_iterations"] | 50;
         unsigned int color_scale = doc["color_scale"] | 10;
+        bool fixed_point = doc["fixed_point"] | false;
+        std::vector<Strip::Color> palette = parsePalette(doc["palette"]);
         ESP_LOGI(TAG,
-            "Creating Mandelbrot Cre0=%.4f, Cim0=%.4f, Cim1=%.4f, scale=%u, max_iter=%u, color_scale=%u",
-            Cre0, Cim0, Cim1, scale, max_iterations, color_scale);
-        return std::make_unique<Show::Mandelbrot>(Cre0, Cim0, Cim1, scale, max_iterations, color_scale);
-    });
+            "Creating Mandelbrot Cre0=%.4f, Cim0=%.4f, Cim1=%.4f, scale=%u, max_iter=%u, color_scale=%u, fixed_point=%d, palette=%u colors",
+            Cre0, Cim0, Cim1, scale, max_iterations, color_scale, fixed_point, (unsigned) palette.size());
+        return std::make_unique<Show::Mandelbrot>(Cre0, Cim0, Cim1, scale, max_iterations, color_scale, fixed_point,
+                                                  palette);
+    }},
+
+    {"Noise", "Drifting fractal noise through a color palette: lava, clouds, ocean, forest or your own colors",
+     R"({"palette":"lava","scale":20,"speed":0.3,"octaves":3})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
+        // An unknown palette falls back to lava
+        std::vector<Strip::Color> palette = parsePalette(doc["palette"]);
+        float scale = doc["scale"] | 20.0f;
+        float speed = doc["speed"] | 0.3f;
+        int octaves = std::min(static_cast<int>(Support::Noise::MAX_OCTAVES), std::max(1, doc["octaves"] | 3));
+        ESP_LOGI(TAG, "Creating Noise palette=%u colors, scale=%.1f, speed=%.2f, octaves=%d",
+                      static_cast<unsigned>(palette.size()), scale, speed, octaves);
+        return std::make_unique<Show::Noise>(palette, scale, speed, static_cast<uint8_t>(octaves),
+                                             Support::randomSeed());
+    }},
+
+    {"Automaton", "Cellular automata: Rule 30, 90, 110 and friends along the strip, or the Game of Life on a matrix",
+     R"({"rule":30,"width":0,"seed":0,"interval":5,"trail":8,"palette":[]})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
+        uint8_t rule = doc["rule"] | 30;
+        int width = std::max(0, doc["width"] | 0);
+        uint32_t seed = doc["seed"] | 0u;
+        unsigned int interval = doc["interval"] | 5;
+        unsigned int trail = doc["trail"] | 8;
+        ESP_LOGI(TAG, "Creating Automaton rule=%u, width=%d, seed=%u, interval=%u, trail=%u",
+                      rule, width, seed, interval, trail);
+        return std::make_unique<Show::Automaton>(rule, static_cast<Strip::PixelIndex>(width), seed,
+                                                 parsePalette(doc["palette"]), interval, trail);
+    }},
+
+    {"Spectrum", "Music spectrum analyzer: a bar per frequency band from bass to treble, with falling peaks",
+     R"({"release":0.85,"peaks":true})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
+        float release = doc["release"] | 0.85f;
+        bool peaks = doc["peaks"] | true;
+        ESP_LOGI(TAG, "Creating Spectrum release=%.2f, peaks=%d", release, peaks);
+        return std::make_unique<Show::Spectrum>(release, peaks);
+    }},
+
+    {"BeatPulse", "Flashes to the beat of the music, spreading from the middle in a new color each beat",
+     R"({"decay":0.9,"spread":3,"hue_step":40})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
+        float decay = doc["decay"] | 0.9f;
+        float spread = doc["spread"] | 3.0f;
+        uint8_t hue_step = doc["hue_step"] | 40;
+        ESP_LOGI(TAG, "Creating BeatPulse decay=%.2f, spread=%.1f, hue_step=%u", decay, spread, hue_step);
+        return std::make_unique<Show::BeatPulse>(decay, spread, hue_step);
+    }},
+
+    {"Clip", "Plays an animation clip uploaded to the device, in a loop or once",
+     R"({"clip":"","loop":true})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
+        std::string clip = doc["clip"] | "";
+        bool loop = doc["loop"] | true;
+        if (!Support::Clip::isValidName(clip)) {
+            ESP_LOGW(TAG, "Invalid clip name '%s'", clip.c_str());
+            return std::make_unique<Show::Clip>("", loop);
+        }
+        ESP_LOGI(TAG, "Creating Clip clip=%s, loop=%d", clip.c_str(), loop);
+        return std::make_unique<Show::Clip>(Support::Clip::path(clip), loop);
+    }},
+
+    {"Shader", "Your own color formula of pixel position and time, compiled on the device",
+     R"json({"program":"hsv(x + t / 10, 1, wave(x * 4 - t))","vars":{},"palette":[]})json",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
+        Support::Shader::Program program;
+        Support::Shader::Error error;
+        if (ShowFactory::compileShader(doc.as<JsonVariantConst>(), program, error)) {
+            ESP_LOGI(TAG, "Creating Shader with %u frame and %u pixel instructions, %u registers",
+                          program.frameInstructions(), program.pixelInstructions(), program.registerCount());
+        } else {
+            ESP_LOGW(TAG, "Shader program error at %u: %s", error.position, error.message.c_str());
+        }
+        return std::make_unique<Show::Shader>(std::move(program));
+    }},
+
+    {"Layers", "Up to four shows stacked on top of each other, mixed with blend modes and opacity",
+     R"({"layers":[]})",
+     [](const JsonDocument &doc) -> std::unique_ptr<Show::Show> {
+        auto layers = std::make_unique<Show::Layers>();
+
+        // Bottom layer first: {"layers":[{"show":"Solid","params":{...},"blend":"normal","opacity":255}, ...]}
+        JsonArrayConst layersArray = doc["layers"].as<JsonArrayConst>();
+        for (JsonVariantConst layer: layersArray) {
+            const char *showName = layer["show"] | "";
+            if (strcmp(showName, "Layers") == 0) {
+                ESP_LOGW(TAG, "Layers cannot be nested, skipping");
+                continue;
+            }
+
+            std::string paramsJson = "{}";
+            if (!layer["params"].isNull()) {
+                paramsJson.clear();
+                serializeJson(layer["params"], paramsJson);
+            }
+
+            std::unique_ptr<Show::Show> show = ShowFactory::createShow(showName, paramsJson.c_str());
+            if (!show) {
+                continue;
+            }
+
+            const char *blend = layer["blend"] | "normal";
+            uint8_t opacity = layer["opacity"] | 255;
+            ESP_LOGI(TAG, "Adding layer %s blend=%s, opacity=%u", showName, blend, opacity);
+            if (!layers->addLayer(std::move(show), showName, Support::Blend::modeFromName(blend), opacity)) {
+                ESP_LOGW(TAG, "Too many layers, ignoring %s", showName);
+            }
+        }
+
+        return layers;
+    }},
+};
+
+static constexpr size_t SHOW_COUNT = sizeof(SHOWS) / sizeof(SHOWS[0]);
+
+// --- compile-time lookup index and /api/shows response ----------------------
+
+static constexpr int compareNames(const char *a, const char *b) {
+    while (*a != '\0' && *a == *b) {
+        a++;
+        b++;
+    }
+    return static_cast<unsigned char>(*a) - static_cast<unsigned char>(*b);
+}
+
+static constexpr size_t textLength(const char *text) {
+    size_t length = 0;
+    while (text[length] != '\0') {
+        length++;
+    }
+    return length;
 }
 
-void ShowFactory::registerShow(const std::string &name, const std::string &description, ShowConstructor &&constructor) {
-    showConstructors[name] = std::move(constructor);
-    showList.push_back({name, description});
+// Positions in SHOWS, sorted by name
+static constexpr std::array<uint8_t, SHOW_COUNT> sortByName() {
+    std::array<uint8_t, SHOW_COUNT> order{};
+    for (size_t i = 0; i < SHOW_COUNT; i++) {
+        size_t j = i;
+        for (; j > 0 && compareNames(SHOWS[order[j - 1]].name, SHOWS[i].name) > 0; j--) {
+            order[j] = order[j - 1];
+        }
+        order[j] = static_cast<uint8_t>(i);
+    }
+    return order;
 }
 
-std::unique_ptr<Show::Show> ShowFactory::createShow(const std::string &name) {
-    return createShow(name, "{}"); // Default to empty params
+static constexpr std::array<uint8_t, SHOW_COUNT> BY_NAME = sortByName();
+
+static constexpr bool namesAreUnique() {
+    for (size_t i = 1; i < SHOW_COUNT; i++) {
+        if (compareNames(SHOWS[BY_NAME[i - 1]].name, SHOWS[BY_NAME[i]].name) == 0) {
+            return false;
+        }
+    }
+    return true;
 }
 
-std::unique_ptr<Show::Show> ShowFactory::createShow(const std::string &name, const std::string &paramsJson) {
+static_assert(SHOW_COUNT < 256, "Show index is a byte");
+static_assert(namesAreUnique(), "Show names must be unique");
+
+// Names and descriptions go into the catalog unescaped
+static constexpr bool catalogTextIsPlain() {
+    for (const ShowFactory::ShowInfo &show: SHOWS) {
+        for (const char *text: {show.name, show.description}) {
+            for (; *text != '\0'; text++) {
+                if (*text == '"' || *text == '\\') {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(catalogTextIsPlain(), "Show names and descriptions must not need JSON escaping");
+
+static constexpr const char *CATALOG_START = R"({"shows":[)";
+static constexpr const char *CATALOG_NAME = R"({"name":")";
+static constexpr const char *CATALOG_DESCRIPTION = R"(","description":")";
+static constexpr const char *CATALOG_PARAMS = R"(","params":)";
+static constexpr const char *CATALOG_END = "]}";
+
+static constexpr size_t catalogLength() {
+    size_t length = textLength(CATALOG_START) + textLength(CATALOG_END);
+    for (const ShowFactory::ShowInfo &show: SHOWS) {
+        length += textLength(CATALOG_NAME) + textLength(show.name) + textLength(CATALOG_DESCRIPTION) +
+                  textLength(show.description) + textLength(CATALOG_PARAMS) + textLength(show.parameters) + 1;
+    }
+    return length + SHOW_COUNT - 1; // separating commas
+}
+
+static constexpr size_t CATALOG_LENGTH = catalogLength();
+
+struct CatalogText {
+    char text[CATALOG_LENGTH + 1];
+};
+
+static constexpr CatalogText serializeCatalog() {
+    CatalogText catalog{};
+    size_t length = 0;
+    auto append = [&catalog, &length](const char *text) {
+        while (*text != '\0') {
+            catalog.text[length++] = *text++;
+        }
+    };
+    append(CATALOG_START);
+    for (size_t i = 0; i < SHOW_COUNT; i++) {
+        if (i > 0) {
+            append(",");
+        }
+        append(CATALOG_NAME);
+        append(SHOWS[i].name);
+        append(CATALOG_DESCRIPTION);
+        append(SHOWS[i].description);
+        append(CATALOG_PARAMS);
+        append(SHOWS[i].parameters);
+        append("}");
+    }
+    append(CATALOG_END);
+    return catalog;
+}
+
+static constexpr CatalogText CATALOG = serializeCatalog();
+
+// --- lookup -----------------------------------------------------------------
+
+const ShowFactory::ShowInfo *ShowFactory::findShow(const char *name) {
+    size_t low = 0;
+    size_t high = SHOW_COUNT;
+    while (low < high) {
+        size_t middle = (low + high) / 2;
+        const ShowInfo &show = SHOWS[BY_NAME[middle]];
+        int order = strcmp(show.name, name);
+        if (order == 0) {
+            return &show;
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return nullptr;
+}
+
+std::unique_ptr<Show::Show> ShowFactory::createShow(const char *name, const char *paramsJson) {
     // Check if show exists
-    auto it = showConstructors.find(name);
-    if (it == showConstructors.end()) {
-        ESP_LOGW(TAG, "show %s not found", name.c_str());
+    const ShowInfo *info = findShow(name);
+    if (info == nullptr) {
+        ESP_LOGW(TAG, "show %s not found", name);
         return {};
     }
 
     JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, paramsJson.c_str());
+    DeserializationError error = deserializeJson(doc, paramsJson);
 
     // If JSON parsing fails, log warning and use empty document (will use defaults)
     if (error) {
         ESP_LOGW(TAG, "Failed to parse params for %s: %s; using default parameters",
-                       name.c_str(), error.c_str());
+                       name, error.c_str());
         doc.clear(); // Empty document will trigger all defaults via | operator
     }
 
-    // Call the stored factory function with the parsed (or empty) JSON document
-    return it->second(doc);
+    // Call the registered constructor with the parsed (or empty) JSON document
+    std::unique_ptr<Show::Show> show = info->constructor(doc);
+
+    // Any show can be post-processed
+    if (show && !doc["post"].isNull()) {
+        Show::PostProcessed::Settings settings = parsePostSettings(doc["post"]);
+        if (settings.isActive()) {
+            ESP_LOGI(TAG, "Post-processing %s trail=%u, decay=%u, blur=%u",
+                          name, settings.trail, settings.decay, settings.blur_passes);
+            show = std::make_unique<Show::PostProcessed>(std::move(show), settings);
+        }
+    }
+    return show;
+}
+
+ShowFactory::ShowList ShowFactory::listShows() {
+    return {SHOWS, SHOW_COUNT};
+}
+
+bool ShowFactory::hasShow(const char *name) {
+    return findShow(name) != nullptr;
 }
 
-const std::vector<ShowFactory::ShowInfo> &ShowFactory::listShows() const {
-    return showList;
+const char *ShowFactory::catalogJson() {
+    return CATALOG.text;
 }
 
-bool ShowFactory::hasShow(const std::string &name) const {
-    return showConstructors.find(name) != showConstructors.end();
+size_t ShowFactory::catalogJsonLength() {
+    return CATALOG_LENGTH;
+}
+
+bool ShowFactory::compileShader(JsonVariantConst params, Support::Shader::Program &program,
+                                Support::Shader::Error &error) {
+    std::vector<Support::Shader::Variable> variables;
+    for (JsonPairConst pair: params["vars"].as<JsonObjectConst>()) {
+        variables.push_back({pair.key().c_str(), pair.value() | 0.0f});
+    }
+
+    program.setPalette(parsePalette(params["palette"]));
+
+    const char *source = params["program"] | "hsv(x + t / 10, 1, wave(x * 4 - t))";
+    return program.compile(source, variables, error);
+}
+
+bool ShowFactory::parseTimeline(JsonVariantConst json, Support::Timeline &timeline, std::string &error) {
+    JsonObjectConst tracks = json["tracks"].as<JsonObjectConst>();
+    if (tracks.isNull() || tracks.size() == 0) {
+        error = "Timeline needs tracks";
+        return false;
+    }
+    timeline.setLoop(json["loop"] | false);
+
+    std::vector<Support::Timeline::Keyframe> keyframes;
+    for (JsonPairConst track: tracks) {
+        keyframes.clear();
+        for (JsonVariantConst entry: track.value().as<JsonArrayConst>()) {
+            JsonArrayConst key = entry.as<JsonArrayConst>();
+            float seconds = key[0] | -1.0f;
+            if (key.size() < 2 || seconds < 0.0f || seconds > 4000000.0f || !key[1].is<float>()) {
+                error = std::string("Keyframes of ") + track.key().c_str() + " must be [seconds, value, easing]";
+                return false;
+            }
+            Support::Timeline::Keyframe keyframe;
+            keyframe.time_ms = static_cast<uint32_t>(seconds * 1000.0f + 0.5f);
+            keyframe.value = key[1];
+            const char *easing = key[2];
+            if (easing != nullptr && !Support::Interpolation::easingFromName(easing, keyframe.easing)) {
+                error = std::string("Unknown easing ") + easing;
+                return false;
+            }
+            keyframes.push_back(keyframe);
+        }
+        if (!timeline.addTrack(track.key().c_str(), keyframes)) {
+            error = std::string("Track ") + track.key().c_str() +
+                    " needs 1 to 32 keyframes in time order, at most 8 tracks";
+            return false;
+        }
+    }
+    return true;
 }
@@ -4,9 +4,7 @@
 #ifndef LEDZ_SHOWFACTORY_H
 #define LEDZ_SHOWFACTORY_H
 
-#include <map>
-#include <vector>
-#include <functional>
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -20,52 +18,47 @@
 #endif
 
 #include "show/Show.h"
+#include "support/Shader.h"
+#include "support/Timeline.h"
 #include "Config.h"
 
 /**
  * ShowFactory
  * Factory pattern for creating LED shows by name
- * Supports show registration and parameter parsing
+ * The shows are a constexpr table in flash: registering them costs no heap
+ * at startup, and names are looked up by binary search over an index sorted
+ * at compile time.
  */
 class ShowFactory {
 public:
     /**
      * Show constructor function type that takes JSON parameters
      */
-    using ShowConstructor = std::function<std::unique_ptr<Show::Show>(const JsonDocument &)>;
+    using ShowConstructor = std::unique_ptr<Show::Show> (*)(const JsonDocument &);
 
     /**
      * Show metadata for listing available shows
      */
     struct ShowInfo {
-        std::string name;
-        std::string description;
+        const char *name;
+        const char *description;
+        const char *parameters; // JSON object of every parameter with its default
+        ShowConstructor constructor;
     };
 
-private:
-    std::map<std::string, ShowConstructor> showConstructors;
-    std::vector<ShowInfo> showList;
-
-public:
-    ShowFactory();
-
-    // disable copy constructor
-    ShowFactory(const ShowFactory &) = delete;
-
     /**
-     * Register a show with the factory
-     * @param name Show name (e.g., "Rainbow")
-     * @param description Human-readable description
-     * @param constructor Function that creates the show instance
+     * The registered shows in display order
      */
-    void registerShow(const std::string &name, const std::string &description, ShowConstructor &&constructor);
+    struct ShowList {
+        const ShowInfo *first;
+        size_t count;
 
-    /**
-     * Create a show by name
-     * @param name Show name
-     * @return Show instance (caller owns pointer) or nullptr if not found
-     */
-    std::unique_ptr<Show::Show> createShow(const std::string &name);
+        const ShowInfo *begin() const { return first; }
+
+        const ShowInfo *end() const { return first + count; }
+
+        size_t size() const { return count; }
+    };
 
     /**
      * Create a show by name with JSON parameters
@@ -73,20 +66,55 @@ public:
      * @param paramsJson JSON string with parameters (e.g., {"r":255,"g":0,"b":0})
      * @return Show instance (caller owns pointer) or nullptr if not found
      */
-    std::unique_ptr<Show::Show> createShow(const std::string &name, const std::string &paramsJson);
+    static std::unique_ptr<Show::Show> createShow(const char *name, const char *paramsJson = "{}");
 
     /**
      * Get list of all registered shows
-     * @return Vector of show names
      */
-    [[nodiscard]] const std::vector<ShowInfo> &listShows() const;
+    static ShowList listShows();
 
     /**
      * Check if a show is registered
      * @param name Show name
      * @return true if registered
      */
-    bool hasShow(const std::string &name) const;
+    static bool hasShow(const char *name);
+
+    /**
+     * @param name Show name
+     * @return The registered show, nullptr if there is none of that name
+     */
+    static const ShowInfo *findShow(const char *name);
+
+    /**
+     * The /api/shows response, serialized at compile time:
+     * {"shows":[{"name":"...","description":"...","params":{...}}, ...]}
+     */
+    static const char *catalogJson();
+
+    static size_t catalogJsonLength();
+
+    /**
+     * Compile the program of Shader show parameters
+     * {"program":"...","vars":{"speed":0.5},"palette":[[r,g,b],...]}
+     * @param params Shader show parameters
+     * @param program Program to compile into
+     * @param error Filled in when compiling fails
+     * @return true if the program compiled
+     */
+    static bool compileShader(JsonVariantConst params, Support::Shader::Program &program,
+                              Support::Shader::Error &error);
+
+    /**
+     * Parse a timeline of show parameters
+     * {"loop":true,"tracks":{"cooling":[[0,0.05],[3600,0.2,"ease-in-out"]]}}
+     * Keyframes are [seconds, value] or [seconds, value, easing towards the next one]
+     * @param json Timeline
+     * @param timeline Timeline to add the tracks to
+     * @param error Filled in when the timeline is invalid
+     * @return true if every track was added
+     */
+    static bool parseTimeline(JsonVariantConst json, Support::Timeline &timeline, std::string &error);
 };
 
 #endif //LEDZ_SHOWFACTORY_H
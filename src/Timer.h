@@ -1,9 +1,11 @@
 #ifndef LEDZ_TIMER_H
 #define LEDZ_TIMER_H
 
-// Forward declare millis() for non-Arduino builds
+// Forward declare millis() and micros() for non-Arduino builds
 #ifndef ARDUINO
 unsigned long millis();
+
+unsigned long micros();
 #endif
 
 namespace Support {
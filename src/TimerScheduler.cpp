@@ -1,6 +1,7 @@
 #include "TimerScheduler.h"
 #include "Log.h"
 #include "ShowController.h"
+#include "color.h"
 #include "support/LocalTime.h"
 
 #include <cstdlib>
@@ -12,6 +13,9 @@
 
 static const char* TAG = "timer";
 
+// Length of the flash marking an expired countdown
+static constexpr uint16_t COUNTDOWN_FLASH_MS = 800;
+
 TimerScheduler::TimerScheduler(Config::ConfigManager &config, ShowController &showController)
     : config(config), showController(showController) {
 }
@@ -123,6 +127,11 @@ void TimerScheduler::executeTimer(uint8_t index) {
     ESP_LOGI(TAG, "Executing timer %d, action=%d",
                   index, static_cast<int>(timer.action));
 
+    if (timer.type == Config::TimerType::COUNTDOWN) {
+        // Signal the expiry on top of whatever runs before the action takes over
+        showController.queueOverlay(Show::Overlay::Type::FLASH, color(255, 255, 255), COUNTDOWN_FLASH_MS);
+    }
+
     switch (timer.action) {
         case Config::TimerAction::TURN_OFF:
             // Turn off LEDs by switching to Solid show with black color
@@ -136,7 +145,7 @@ void TimerScheduler::executeTimer(uint8_t index) {
                 Config::PresetsConfig presetsConfig = config.loadPresetsConfig();
                 if (timer.preset_index < Config::PresetsConfig::MAX_PRESETS &&
                     presetsConfig.presets[timer.preset_index].valid) {
-                    showController.queuePresetLoad(presetsConfig.presets[timer.preset_index]);
+                    showController.queuePresetLoad(presetsConfig.presets[timer.preset_index], timer.preset_index);
                     ESP_LOGI(TAG, "Loaded preset %d (%s)",
                                   timer.preset_index, presetsConfig.presets[timer.preset_index].name);
                 } else {
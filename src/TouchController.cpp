@@ -5,6 +5,7 @@
 #include "TouchController.h"
 #include "Log.h"
 #include "ShowController.h"
+#include "color.h"
 
 #ifdef ARDUINO
 #include <Arduino.h>
@@ -12,6 +13,9 @@
 
 static const char* TAG = "touch";
 
+// Length of the progress bar acknowledging a variant or layout step
+static constexpr uint16_t STEP_OVERLAY_MS = 600;
+
 
 const char* SOLID_VARIANTS[] = {
     "{\"colors\":[[255,170,120]]}",
@@ -35,14 +39,23 @@ const char* TWOCOLORBLEND_VARIANTS[] = {
     R"({"colors":[[0,255,0],[255,0,0]],"gradient":true})",
     R"({"colors":[[0,255,0],[0,0,255]],"gradient":true})",
 };
-const char* COLORRUN_VARIANTS[] = {"{}"};
-const char* JUMP_VARIANTS[] = {"{}"};
+const char* COLORRUN_VARIANTS[] = {
+    "{}",
+    R"({"post":{"trail":0.85}})"
+};
+const char* JUMP_VARIANTS[] = {
+    "{}",
+    R"({"post":{"trail":0.7,"blur":1}})"
+};
 const char* RAINBOW_VARIANTS[] = {
     "{}",
     R"({"time_step":0.3,"pixel_step":1.0})",
     R"({"time_step":0.05,"pixel_step":0})"
 };
-const char* WAVE_VARIANTS[] = {"{}"};
+const char* WAVE_VARIANTS[] = {
+    "{}",
+    R"({"sources":[{"position":0},{"position":10000,"wavelength":4,"speed":1.5}]})"
+};
 const char* FIRE_VARIANTS[] = {
     R"({})",
     R"({"cooling":0.05})"
@@ -65,10 +78,10 @@ const TouchController::ShowVariantGroup TouchController::SHOW_VARIANTS[] = {
     {"Solid", SOLID_VARIANTS, 10},
     {"Solid", COLORRANGES_VARIANTS, 3},
     {"Solid", TWOCOLORBLEND_VARIANTS, 3},
-    {"ColorRun", COLORRUN_VARIANTS, 1},
-    {"Jump", JUMP_VARIANTS, 1},
+    {"ColorRun", COLORRUN_VARIANTS, 2},
+    {"Jump", JUMP_VARIANTS, 2},
     {"Rainbow", RAINBOW_VARIANTS, 3},
-    {"Wave", WAVE_VARIANTS, 1},
+    {"Wave", WAVE_VARIANTS, 2},
     {"Fire", FIRE_VARIANTS, 2},
     {"Starlight", STARLIGHT_VARIANTS, 2},
     {"TheaterChase", THEATERCHASE_VARIANTS, 3},
@@ -106,7 +119,8 @@ void TouchController::begin() {
 #ifdef ARDUINO
     ESP_LOGI(TAG, "Initializing touch pins");
     for (uint8_t i = 0; i < Config::TouchConfig::MAX_TOUCH_PINS; i++) {
-        const char* action = (i == 0) ? "Switch Show" : (i == 1) ? "Switch Variant" : "Switch Layout";
+        const char* action = (i == 0) ? "Switch Show / next entry, hold: playlist on/off"
+                           : (i == 1) ? "Switch Variant / previous entry" : "Switch Layout";
         ESP_LOGI(TAG, "  Touch pin %u (GPIO %u) -> %s",
                       i, TOUCH_PINS[i], action);
     }
@@ -132,64 +146,23 @@ void TouchController::update() {
 
         // Detect rising edge (transition from not-touched to touched)
         if (isTouched && !wasTouched[i]) {
-            // Check debounce
-            if (now - lastTouchTime[i] >= DEBOUNCE_MS) {
+            if (i == 0) {
+                pressStart = now;
+                holdHandled = false;
+            } else if (now - lastTouchTime[i] >= DEBOUNCE_MS) {
+                // Check debounce
                 lastTouchTime[i] = now;
+                onTap(i);
+            }
+        }
 
-                if (i == 0) {
-                    // Button 1: Switch Show
-                    currentShowIdx = (currentShowIdx + 1) % NUM_SHOW_VARIANTS;
-                    currentVariantIdx = 0; // Reset to first variant of new show
-
-                    const ShowVariantGroup& group = SHOW_VARIANTS[currentShowIdx];
-                    const char* params = group.variants[currentVariantIdx];
-
-                    ESP_LOGI(TAG, "Switching show to %s with variant %d: %s",
-                                  group.showName, currentVariantIdx, params);
-                    showController.queueShowChange(group.showName, params);
-                } else if (i == 1) {
-                    // Button 2: Switch Variant (Circulate variants of current show)
-                    const ShowVariantGroup& group = SHOW_VARIANTS[currentShowIdx];
-                    currentVariantIdx = (currentVariantIdx + 1) % group.numVariants;
-
-                    const char* params = group.variants[currentVariantIdx];
-
-                    ESP_LOGI(TAG, "Loading variant %d for show %s: %s",
-                                  currentVariantIdx, group.showName, params);
-                    showController.queueShowChange(group.showName, params);
-                } else if (i == 2) {
-                    // Button 3: Switch Layout (8 steps matching Python script)
-                    static uint8_t layoutStep = 0;
-                    layoutStep = (layoutStep + 1) % 8;
-                    
-                    bool reverse = false;
-                    bool mirror = false;
-                    int16_t dead_leds = 0;
-                    
-                    // Python create_layouts uses (dead_leds, reverse, mirror) logic:
-                    // 0: (0, F, F)
-                    // 1: (0, F, T)
-                    // 2: (0, T, F)
-                    // 3: (0, T, T)
-                    // 4: (D, F, F)
-                    // 5: (D, F, T)
-                    // 6: (D, T, F)
-                    // 7: (D, T, T)
-                    // Note: Python script order is slightly different but covers same combinations
-                    
-                    reverse = (layoutStep % 4) >= 2;
-                    mirror = (layoutStep % 2) == 1;
-                    
-                    if (layoutStep >= 4) {
-                        Config::DeviceConfig deviceConfig = config.loadDeviceConfig();
-                        // TODO: fix this
-                        // dead_leds = deviceConfig.dead_leds;
-                    }
-                    
-                    ESP_LOGI(TAG, "Switching layout to step %u (rev=%d, mir=%d, dead=%d)",
-                                  layoutStep, reverse, mirror, dead_leds);
-                    showController.queueLayoutChange(reverse, mirror, dead_leds);
-                }
+        if (i == 0) {
+            if (isTouched && !holdHandled && now - pressStart >= LONG_PRESS_MS) {
+                holdHandled = true;
+                togglePlaylist();
+            } else if (!isTouched && wasTouched[i] && !holdHandled && now - lastTouchTime[i] >= DEBOUNCE_MS) {
+                lastTouchTime[i] = now;
+                onTap(i);
             }
         }
 
@@ -198,6 +171,96 @@ void TouchController::update() {
 #endif
 }
 
+void TouchController::onTap(uint8_t index) {
+#ifdef ARDUINO
+    if (index == 0) {
+        // Button 1: Switch Show
+        if (showController.skipPlaylist(true)) {
+            ESP_LOGI(TAG, "Next playlist entry");
+            return;
+        }
+        currentShowIdx = (currentShowIdx + 1) % NUM_SHOW_VARIANTS;
+        currentVariantIdx = 0; // Reset to first variant of new show
+
+        const ShowVariantGroup& group = SHOW_VARIANTS[currentShowIdx];
+        const char* params = group.variants[currentVariantIdx];
+
+        ESP_LOGI(TAG, "Switching show to %s with variant %d: %s",
+                      group.showName, currentVariantIdx, params);
+        showController.queueShowChange(group.showName, params);
+    } else if (index == 1) {
+        // Button 2: Switch Variant (Circulate variants of current show)
+        if (showController.skipPlaylist(false)) {
+            ESP_LOGI(TAG, "Previous playlist entry");
+            return;
+        }
+        const ShowVariantGroup& group = SHOW_VARIANTS[currentShowIdx];
+        currentVariantIdx = (currentVariantIdx + 1) % group.numVariants;
+
+        const char* params = group.variants[currentVariantIdx];
+
+        ESP_LOGI(TAG, "Loading variant %d for show %s: %s",
+                      currentVariantIdx, group.showName, params);
+        showController.queueShowChange(group.showName, params);
+        showController.queueOverlay(Show::Overlay::Type::PROGRESS, color(255, 255, 255),
+                                    STEP_OVERLAY_MS,
+                                    (currentVariantIdx + 1) * 255 / group.numVariants);
+    } else if (index == 2) {
+        // Button 3: Switch Layout (8 steps matching Python script)
+        static uint8_t layoutStep = 0;
+        layoutStep = (layoutStep + 1) % 8;
+
+        bool reverse = false;
+        bool mirror = false;
+        int16_t dead_leds = 0;
+
+        // Python create_layouts uses (dead_leds, reverse, mirror) logic:
+        // 0: (0, F, F)
+        // 1: (0, F, T)
+        // 2: (0, T, F)
+        // 3: (0, T, T)
+        // 4: (D, F, F)
+        // 5: (D, F, T)
+        // 6: (D, T, F)
+        // 7: (D, T, T)
+        // Note: Python script order is slightly different but covers same combinations
+
+        reverse = (layoutStep % 4) >= 2;
+        mirror = (layoutStep % 2) == 1;
+
+        if (layoutStep >= 4) {
+            Config::DeviceConfig deviceConfig = config.loadDeviceConfig();
+            // TODO: fix this
+            // dead_leds = deviceConfig.dead_leds;
+        }
+
+        ESP_LOGI(TAG, "Switching layout to step %u (rev=%d, mir=%d, dead=%d)",
+                      layoutStep, reverse, mirror, dead_leds);
+        showController.queueLayoutChange(reverse, mirror, dead_leds);
+        showController.queueOverlay(Show::Overlay::Type::PROGRESS, color(0, 0, 255),
+                                    STEP_OVERLAY_MS, (layoutStep + 1) * 255 / 8);
+    }
+#endif
+}
+
+void TouchController::togglePlaylist() {
+    Config::PlaylistConfig playlistConfig = config.loadPlaylistConfig();
+    if (showController.stopPlaylist()) {
+        ESP_LOGI(TAG, "Playlist stopped");
+        showController.queueOverlay(Show::Overlay::Type::FLASH, color(255, 0, 0), STEP_OVERLAY_MS);
+        playlistConfig.enabled = false;
+    } else if (playlistConfig.count > 0) {
+        ESP_LOGI(TAG, "Playlist started");
+        showController.startPlaylist(playlistConfig);
+        showController.queueOverlay(Show::Overlay::Type::PULSE, color(0, 255, 0), STEP_OVERLAY_MS);
+        playlistConfig.enabled = true;
+    } else {
+        ESP_LOGW(TAG, "No playlist configured");
+        return;
+    }
+    config.savePlaylistConfig(playlistConfig);
+}
+
 void TouchController::reloadConfig() {
     touchConfig = config.loadTouchConfig();
 #ifdef ARDUINO
@@ -25,6 +25,11 @@ private:
     bool wasTouched[Config::TouchConfig::MAX_TOUCH_PINS];
     uint32_t lastTouchTime[Config::TouchConfig::MAX_TOUCH_PINS];
     static constexpr uint32_t DEBOUNCE_MS = 500; // Minimum time between triggers
+
+    // Holding the show pad starts or stops the playlist, so that pad acts on release
+    uint32_t pressStart = 0;
+    bool holdHandled = false;
+    static constexpr uint32_t LONG_PRESS_MS = 1500;
     
     struct ShowVariantGroup {
         const char* showName;
@@ -38,6 +43,18 @@ private:
     int currentShowIdx = 0;
     int currentVariantIdx = 0;
 
+    /**
+     * Act on a tap of a touch pin
+     * While a playlist plays, the show and variant pads step through it instead
+     * @param index Touch pin index
+     */
+    void onTap(uint8_t index);
+
+    /**
+     * Start the configured playlist, or stop the playing one
+     */
+    void togglePlaylist();
+
 public:
     /**
      * Constructor
@@ -7,18 +7,23 @@
 #include "Network.h"
 #include "ShowController.h"
 #include "ShowFactory.h"
+#include "color.h"
 #include "DeviceId.h"
 #include "OTAUpdater.h"
 #include "OTAConfig.h"
 #include "TimerScheduler.h"
 #include "TouchController.h"
+#include "support/Clip.h"
+#include "support/Gradients.h"
 #include "support/LocalTime.h"
+#include "support/Tempo.h"
 #include "support/WiFiCredentials.h"
 
 #ifdef ARDUINO
 #include <ArduinoJson.h>
 #include <AsyncJson.h>
 #include <esp_ota_ops.h>
+#include <SPIFFS.h>
 // Include compressed web content
 #include "generated/config_gz.h"
 #include "generated/control_gz.h"
@@ -58,8 +63,18 @@ static const char* API_PATH_SHOWS = "/api/shows";
 static const char* API_PATH_SHOW = "/api/show";
 static const char* API_PATH_BRIGHTNESS = "/api/brightness";
 static const char* API_PATH_LAYOUT = "/api/layout";
+static const char* API_PATH_TRANSITION = "/api/transition";
+static const char* API_PATH_OVERLAY = "/api/overlay";
+static const char* API_PATH_SHADER_VALIDATE = "/api/shader/validate";
+static const char* API_PATH_CLIPS = "/api/clips";
+static const char* API_PATH_PALETTES = "/api/palettes";
 static const char* API_PATH_PRESETS = "/api/presets";
 static const char* API_PATH_PRESETS_LOAD = "/api/presets/load";
+static const char* API_PATH_TIMELINE = "/api/timeline";
+static const char* API_PATH_PLAYLIST = "/api/playlist";
+static const char* API_PATH_PLAYLIST_SKIP = "/api/playlist/skip";
+static const char* API_PATH_TEMPO = "/api/tempo";
+static const char* API_PATH_TEMPO_TAP = "/api/tempo/tap";
 static const char* API_PATH_TIMERS = "/api/timers";
 static const char* API_PATH_RESTART = "/api/restart";
 static const char* API_PATH_RESET = "/api/reset";
@@ -75,6 +90,42 @@ static void sendGzippedResponse(AsyncWebServerRequest *request, const char *cont
     response->addHeader("Cache-Control", "max-age=86400");
     request->send(response);
 }
+
+// 400 with the compile error and where in the program it was found
+static void sendShaderError(AsyncWebServerRequest *request, const Support::Shader::Error &error) {
+    JsonDocument responseDoc;
+    responseDoc[JSON_KEY_SUCCESS] = false;
+    responseDoc[JSON_KEY_ERROR] = error.message;
+    responseDoc["position"] = error.position;
+
+    String response;
+    serializeJson(responseDoc, response);
+    request->send(400, CONTENT_TYPE_JSON, response);
+}
+
+// Playlist position, shared by /api/status and /api/playlist
+static void addPlaylistStatus(JsonObject out, const PlaylistStatus &status) {
+    out["active"] = status.active;
+    out["shuffle"] = status.shuffle;
+    out["count"] = status.count;
+    if (status.active && status.position < status.count) {
+        out["position"] = status.position;
+        out["preset"] = status.preset;
+        out["remaining_s"] = (status.remaining_ms + 999) / 1000;
+    }
+}
+
+// Tempo clock state, shared by /api/status and /api/tempo
+static void addTempoStatus(JsonObject out) {
+    Support::Tempo::Clock &tempo = Support::Tempo::clock();
+    Support::Tempo::Position position = tempo.at();
+    out["bpm"] = tempo.bpm();
+    out["beats_per_bar"] = tempo.beatsPerBar();
+    out["beat"] = position.beat;
+    out["bar"] = position.bar;
+    out["beat_in_bar"] = position.beat_in_bar;
+    out["phase"] = position.phase;
+}
 #endif
 
 // Web source files are in data/ directory
@@ -195,6 +246,9 @@ void WebServerManager::setupAPIRoutes() {
             }
         }
 
+        addPlaylistStatus(doc["playlist"].to<JsonObject>(), showController.getPlaylistStatus());
+        addTempoStatus(doc["tempo"].to<JsonObject>());
+
         // Network info
         doc["wifi_connected"] = WiFiClass::status() == WL_CONNECTED;
         if (WiFiClass::status() == WL_CONNECTED) {
@@ -212,20 +266,11 @@ void WebServerManager::setupAPIRoutes() {
     });
 
     // GET /api/shows - List available shows
-    server.on(API_PATH_SHOWS, HTTP_GET, [this](AsyncWebServerRequest *request) {
-        JsonDocument doc;
-        JsonArray shows = doc["shows"].to<JsonArray>();
-
-        const std::vector<ShowFactory::ShowInfo> &showList = showController.listShows();
-        for (const auto &showInfo: showList) {
-            JsonObject show = shows.add<JsonObject>();
-            show[JSON_KEY_NAME] = showInfo.name;
-            show["description"] = showInfo.description;
-        }
-
-        String response;
-        serializeJson(doc, response);
-        request->send(200, CONTENT_TYPE_JSON, response);
+    // Serialized at compile time, sent straight from flash
+    server.on(API_PATH_SHOWS, HTTP_GET, [](AsyncWebServerRequest *request) {
+        request->send(request->beginResponse(200, CONTENT_TYPE_JSON,
+                                             reinterpret_cast<const uint8_t *>(ShowFactory::catalogJson()),
+                                             ShowFactory::catalogJsonLength()));
     });
 
     // POST /api/show - Change current show
@@ -249,6 +294,23 @@ void WebServerManager::setupAPIRoutes() {
                     paramsJson = "{}";
                 }
 
+                // Parameters are persisted in a fixed size field, a truncated copy would not parse
+                if (static_cast<size_t>(paramsJson.length()) >= sizeof(Config::ShowConfig::params_json)) {
+                    request->send(400, CONTENT_TYPE_JSON,
+                                  R"({"success":false,"error":"Parameters too long to store"})");
+                    return;
+                }
+
+                // Reject programs that don't compile instead of showing black
+                if (strcmp(showName, "Shader") == 0) {
+                    Support::Shader::Program program;
+                    Support::Shader::Error error;
+                    if (!ShowFactory::compileShader(doc[JSON_KEY_PARAMS], program, error)) {
+                        sendShaderError(request, error);
+                        return;
+                    }
+                }
+
                 if (showController.queueShowChange(showName, paramsJson.c_str())) {
                     request->send(200, CONTENT_TYPE_JSON, JSON_RESPONSE_SUCCESS);
                 } else {
@@ -325,6 +387,395 @@ void WebServerManager::setupAPIRoutes() {
         request->send(200, CONTENT_TYPE_JSON, response);
     });
 
+    // POST /api/transition - Change how show switches are blended
+    {
+        auto *handler = new AsyncCallbackJsonWebHandler(
+            AsyncURIMatcher::exact(API_PATH_TRANSITION),
+            [this](AsyncWebServerRequest *request, JsonVariant &doc) {
+                Config::TransitionConfig transitionConfig = config.loadTransitionConfig();
+
+                if (!doc["type"].isNull()) {
+                    const char *type = doc["type"];
+                    if (type == nullptr ||
+                        strcmp(Show::Transition::typeName(Show::Transition::typeFromName(type)), type) != 0) {
+                        request->send(400, CONTENT_TYPE_JSON,
+                                      R"({"success":false,"error":"Type must be cut, crossfade, wipe or dissolve"})");
+                        return;
+                    }
+                    strncpy(transitionConfig.type, type, sizeof(transitionConfig.type) - 1);
+                    transitionConfig.type[sizeof(transitionConfig.type) - 1] = '\0';
+                }
+                if (!doc["duration_ms"].isNull()) {
+                    int duration_ms = doc["duration_ms"];
+                    if (duration_ms < 0 || duration_ms > 10000) {
+                        request->send(400, CONTENT_TYPE_JSON,
+                                      R"({"success":false,"error":"Duration must be between 0 and 10000 ms"})");
+                        return;
+                    }
+                    transitionConfig.duration_ms = duration_ms;
+                }
+
+                // Read by the LED task on the next show switch
+                config.saveTransitionConfig(transitionConfig);
+                request->send(200, CONTENT_TYPE_JSON, JSON_RESPONSE_SUCCESS);
+            });
+        handler->setMethod(HTTP_POST);
+        server.addHandler(handler);
+    }
+
+    // GET /api/transition - Get transition configuration
+    server.on(API_PATH_TRANSITION, HTTP_GET, [this](AsyncWebServerRequest *request) {
+        Config::TransitionConfig transitionConfig = config.loadTransitionConfig();
+
+        JsonDocument doc;
+        doc["type"] = transitionConfig.type;
+        doc["duration_ms"] = transitionConfig.duration_ms;
+
+        String response;
+        serializeJson(doc, response);
+        request->send(200, CONTENT_TYPE_JSON, response);
+    });
+
+    // POST /api/overlay - Draw a notification over the running show
+    {
+        auto *handler = new AsyncCallbackJsonWebHandler(
+            AsyncURIMatcher::exact(API_PATH_OVERLAY),
+            [this](AsyncWebServerRequest *request, JsonVariant &doc) {
+                Show::Overlay::Type type = Show::Overlay::typeFromName(doc["type"] | "");
+                if (type == Show::Overlay::Type::NONE) {
+                    request->send(400, CONTENT_TYPE_JSON,
+                                  R"({"success":false,"error":"Type must be flash, pulse or progress"})");
+                    return;
+                }
+
+                int duration_ms = doc["duration_ms"] | 1000;
+                if (duration_ms < 1 || duration_ms > 10000) {
+                    request->send(400, CONTENT_TYPE_JSON,
+                                  R"({"success":false,"error":"Duration must be between 1 and 10000 ms"})");
+                    return;
+                }
+
+                Strip::Color overlayColor = color(255, 255, 255);
+                JsonArrayConst rgb = doc["color"];
+                if (!rgb.isNull()) {
+                    if (rgb.size() != 3) {
+                        request->send(400, CONTENT_TYPE_JSON,
+                                      R"({"success":false,"error":"Color must be [r,g,b]"})");
+                        return;
+                    }
+                    overlayColor = color(rgb[0], rgb[1], rgb[2]);
+                }
+
+                uint8_t progress = doc["progress"] | 255;
+
+                if (showController.queueOverlay(type, overlayColor, duration_ms, progress)) {
+                    request->send(200, CONTENT_TYPE_JSON, JSON_RESPONSE_SUCCESS);
+                } else {
+                    request->send(503, CONTENT_TYPE_JSON, JSON_RESPONSE_ERROR_QUEUE_FULL);
+                }
+            });
+        handler->setMethod(HTTP_POST);
+        server.addHandler(handler);
+    }
+
+    // POST /api/shader/validate - Compile Shader parameters without running them
+    {
+        auto *handler = new AsyncCallbackJsonWebHandler(
+            AsyncURIMatcher::exact(API_PATH_SHADER_VALIDATE),
+            [](AsyncWebServerRequest *request, JsonVariant &doc) {
+                if (doc["program"].isNull()) {
+                    request->send(400, CONTENT_TYPE_JSON,
+                                  R"({"success":false,"error":"Program required"})");
+                    return;
+                }
+
+                Support::Shader::Program program;
+                Support::Shader::Error error;
+                if (!ShowFactory::compileShader(doc, program, error)) {
+                    sendShaderError(request, error);
+                    return;
+                }
+
+                JsonDocument responseDoc;
+                responseDoc[JSON_KEY_SUCCESS] = true;
+                responseDoc["frame_instructions"] = program.frameInstructions();
+                responseDoc["pixel_instructions"] = program.pixelInstructions();
+                responseDoc["registers"] = program.registerCount();
+                responseDoc["animated"] = program.isAnimated();
+
+                String response;
+                serializeJson(responseDoc, response);
+                request->send(200, CONTENT_TYPE_JSON, response);
+            });
+        handler->setMethod(HTTP_POST);
+        server.addHandler(handler);
+    }
+
+    // GET /api/clips - List uploaded animation clips and the space left for more
+    server.on(API_PATH_CLIPS, HTTP_GET, [](AsyncWebServerRequest *request) {
+        JsonDocument doc;
+        JsonArray clips = doc["clips"].to<JsonArray>();
+
+        File root = SPIFFS.open("/");
+        for (File file = root.openNextFile(); file; file = root.openNextFile()) {
+            // Older cores report names with the leading slash, newer ones without
+            std::string name = file.name();
+            if (!name.empty() && name[0] == '/') {
+                name.erase(0, 1);
+            }
+            size_t extension = strlen(Support::Clip::EXTENSION);
+            if (name.size() <= extension || name.compare(name.size() - extension, extension,
+                                                         Support::Clip::EXTENSION) != 0) {
+                continue;
+            }
+            name.resize(name.size() - extension);
+
+            Support::Clip::Header header;
+            if (!Support::Clip::readHeader(Support::Clip::path(name), header)) {
+                continue;
+            }
+            JsonObject clip = clips.add<JsonObject>();
+            clip[JSON_KEY_NAME] = name;
+            clip["size"] = file.size();
+            clip["frames"] = header.frames;
+            clip["fps"] = header.fps;
+            clip["pixels"] = header.pixels;
+        }
+        doc["total_bytes"] = SPIFFS.totalBytes();
+        doc["used_bytes"] = SPIFFS.usedBytes();
+
+        String response;
+        serializeJson(doc, response);
+        request->send(200, CONTENT_TYPE_JSON, response);
+    });
+
+    // POST /api/clips?name=<name> - Upload a clip (multipart file), replacing one of the same name.
+    // The upload goes to a temporary file that only replaces the clip once it checks out,
+    // so a failed upload never damages the clip that is already there.
+    server.on(API_PATH_CLIPS, HTTP_POST, [](AsyncWebServerRequest *request) {
+        std::string name = request->hasParam(JSON_KEY_NAME) ? request->getParam(JSON_KEY_NAME)->value().c_str() : "";
+        if (!Support::Clip::isValidName(name)) {
+            request->send(400, CONTENT_TYPE_JSON,
+                          R"({"success":false,"error":"Name of letters, digits, - and _ required"})");
+            return;
+        }
+        if (request->_tempFile) {
+            request->_tempFile.close();
+        }
+
+        std::string upload = "/" + name + ".part";
+        File file = SPIFFS.open(upload.c_str(), FILE_READ);
+        if (!file) {
+            if (request->contentLength() > SPIFFS.totalBytes() - SPIFFS.usedBytes()) {
+                request->send(507, CONTENT_TYPE_JSON, R"({"success":false,"error":"Not enough space"})");
+            } else {
+                request->send(500, CONTENT_TYPE_JSON, R"({"success":false,"error":"Upload failed"})");
+            }
+            return;
+        }
+        uint8_t bytes[Support::Clip::HEADER_SIZE];
+        Support::Clip::Header header;
+        bool valid = file.read(bytes, sizeof(bytes)) == sizeof(bytes) &&
+                     Support::Clip::parseHeader(bytes, file.size(), header);
+        file.close();
+        if (!valid) {
+            SPIFFS.remove(upload.c_str());
+            request->send(400, CONTENT_TYPE_JSON, R"({"success":false,"error":"Not a clip"})");
+            return;
+        }
+
+        std::string target = Support::Clip::fileName(name);
+        SPIFFS.remove(target.c_str());
+        if (!SPIFFS.rename(upload.c_str(), target.c_str())) {
+            SPIFFS.remove(upload.c_str());
+            request->send(500, CONTENT_TYPE_JSON, R"({"success":false,"error":"Failed to store clip"})");
+            return;
+        }
+        ESP_LOGI(TAG, "Stored clip %s: %u frames at %u fps, %u pixels",
+                 name.c_str(), header.frames, header.fps, header.pixels);
+        request->send(200, CONTENT_TYPE_JSON, JSON_RESPONSE_SUCCESS);
+    }, [](AsyncWebServerRequest *request, const String &filename, size_t index, uint8_t *data, size_t len,
+          bool final) {
+        if (index == 0) {
+            std::string name = request->hasParam(JSON_KEY_NAME) ? request->getParam(JSON_KEY_NAME)->value().c_str() : "";
+            // Refused uploads are reported once the request completes
+            if (!Support::Clip::isValidName(name)) {
+                return;
+            }
+            std::string upload = "/" + name + ".part";
+            SPIFFS.remove(upload.c_str()); // left over from an interrupted upload
+            if (request->contentLength() > SPIFFS.totalBytes() - SPIFFS.usedBytes()) {
+                return;
+            }
+            request->_tempFile = SPIFFS.open(upload.c_str(), FILE_WRITE);
+        }
+        if (!request->_tempFile) {
+            return;
+        }
+        if (request->_tempFile.write(data, len) != len) {
+            // Out of space after all: drop the partial file
+            std::string upload = request->_tempFile.path();
+            request->_tempFile.close();
+            SPIFFS.remove(upload.c_str());
+            return;
+        }
+        if (final) {
+            request->_tempFile.close();
+        }
+    });
+
+    // DELETE /api/clips - Delete a clip
+    {
+        auto *handler = new AsyncCallbackJsonWebHandler(
+            AsyncURIMatcher::exact(API_PATH_CLIPS),
+            [](AsyncWebServerRequest *request, JsonVariant &doc) {
+                std::string name = doc[JSON_KEY_NAME] | "";
+                if (!Support::Clip::isValidName(name)) {
+                    request->send(400, CONTENT_TYPE_JSON, R"({"success":false,"error":"Name required"})");
+                    return;
+                }
+                if (!SPIFFS.remove(Support::Clip::fileName(name).c_str())) {
+                    request->send(404, CONTENT_TYPE_JSON, R"({"success":false,"error":"Clip not found"})");
+                    return;
+                }
+                request->send(200, CONTENT_TYPE_JSON, JSON_RESPONSE_SUCCESS);
+            });
+        handler->setMethod(HTTP_DELETE);
+        server.addHandler(handler);
+    }
+
+    // GET /api/palettes - Built-in and custom palettes for the palette parameter of the shows
+    server.on(API_PATH_PALETTES, HTTP_GET, [](AsyncWebServerRequest *request) {
+        JsonDocument doc;
+        JsonArray palettes = doc["palettes"].to<JsonArray>();
+
+        auto add = [&palettes](const Support::Gradients::Gradient &gradient, bool custom) {
+            JsonObject palette = palettes.add<JsonObject>();
+            palette[JSON_KEY_NAME] = gradient.name;
+            palette["custom"] = custom;
+            JsonArray colors = palette["colors"].to<JsonArray>();
+            for (Strip::Color c: gradient.colors) {
+                JsonArray rgb = colors.add<JsonArray>();
+                rgb.add(red(c));
+                rgb.add(green(c));
+                rgb.add(blue(c));
+            }
+        };
+        for (const Support::Gradients::Gradient &gradient: Support::Gradients::builtIn()) {
+            add(gradient, false);
+        }
+        for (const Support::Gradients::Gradient &gradient: Support::Gradients::custom()) {
+            add(gradient, true);
+        }
+        doc["max_custom"] = Config::PalettesConfig::MAX_PALETTES;
+        doc["max_colors"] = Config::CustomPalette::MAX_COLORS;
+
+        String response;
+        serializeJson(doc, response);
+        request->send(200, CONTENT_TYPE_JSON, response);
+    });
+
+    // POST /api/palettes - Save a custom palette, replacing one of the same name
+    // {"name":"dusk","colors":[[r,g,b], ...]}
+    {
+        auto *handler = new AsyncCallbackJsonWebHandler(
+            AsyncURIMatcher::exact(API_PATH_PALETTES),
+            [this](AsyncWebServerRequest *request, JsonVariant &doc) {
+                std::string name = doc[JSON_KEY_NAME] | "";
+                if (!Support::Gradients::isValidName(name) || Support::Gradients::isBuiltIn(name)) {
+                    request->send(400, CONTENT_TYPE_JSON,
+                                  R"({"success":false,"error":"Name of up to 15 letters, digits, - and _ required, not a built-in one"})");
+                    return;
+                }
+
+                JsonArrayConst colors = doc["colors"].as<JsonArrayConst>();
+                if (colors.size() == 0 || colors.size() > Config::CustomPalette::MAX_COLORS) {
+                    request->send(400, CONTENT_TYPE_JSON,
+                                  R"({"success":false,"error":"1 to 16 colors of [r,g,b] required"})");
+                    return;
+                }
+
+                Config::CustomPalette palette;
+                strncpy(palette.name, name.c_str(), sizeof(palette.name) - 1);
+                palette.name[sizeof(palette.name) - 1] = '\0';
+                bool valid = true;
+                for (JsonVariantConst entry: colors) {
+                    JsonArrayConst rgb = entry.as<JsonArrayConst>();
+                    if (rgb.size() != 3 || !rgb[0].is<uint8_t>() || !rgb[1].is<uint8_t>() || !rgb[2].is<uint8_t>()) {
+                        valid = false;
+                        break;
+                    }
+                    palette.setColor(palette.count++, color(rgb[0].as<uint8_t>(), rgb[1].as<uint8_t>(),
+                                                            rgb[2].as<uint8_t>()));
+                }
+                if (!valid) {
+                    request->send(400, CONTENT_TYPE_JSON,
+                                  R"({"success":false,"error":"1 to 16 colors of [r,g,b] required"})");
+                    return;
+                }
+
+                // The slot of the same name, or else the first free one
+                Config::PalettesConfig palettesConfig = config.loadPalettesConfig();
+                int slot = -1;
+                for (uint8_t i = 0; i < Config::PalettesConfig::MAX_PALETTES; i++) {
+                    const Config::CustomPalette &stored = palettesConfig.palettes[i];
+                    if (stored.count > 0 && name == stored.name) {
+                        slot = i;
+                        break;
+                    }
+                    if (stored.count == 0 && slot < 0) {
+                        slot = i;
+                    }
+                }
+                if (slot < 0) {
+                    request->send(400, CONTENT_TYPE_JSON,
+                                  R"({"success":false,"error":"All palette slots are full"})");
+                    return;
+                }
+
+                std::vector<Strip::Color> gradient;
+                for (uint8_t i = 0; i < palette.count; i++) {
+                    gradient.push_back(palette.color(i));
+                }
+                if (!config.savePalette(slot, palette) || !Support::Gradients::store(name, gradient)) {
+                    request->send(500, CONTENT_TYPE_JSON,
+                                  R"({"success":false,"error":"Failed to save palette"})");
+                    return;
+                }
+                ESP_LOGI(TAG, "Saved palette %s in slot %d, %u colors", palette.name, slot, palette.count);
+                request->send(200, CONTENT_TYPE_JSON, JSON_RESPONSE_SUCCESS);
+            });
+        handler->setMethod(HTTP_POST);
+        server.addHandler(handler);
+    }
+
+    // DELETE /api/palettes - Delete a custom palette by name
+    {
+        auto *handler = new AsyncCallbackJsonWebHandler(
+            AsyncURIMatcher::exact(API_PATH_PALETTES),
+            [this](AsyncWebServerRequest *request, JsonVariant &doc) {
+                std::string name = doc[JSON_KEY_NAME] | "";
+                Config::PalettesConfig palettesConfig = config.loadPalettesConfig();
+                for (uint8_t i = 0; i < Config::PalettesConfig::MAX_PALETTES; i++) {
+                    const Config::CustomPalette &stored = palettesConfig.palettes[i];
+                    if (stored.count > 0 && name == stored.name) {
+                        // Shows already running keep the colors they baked
+                        if (!config.deletePalette(i)) {
+                            request->send(500, CONTENT_TYPE_JSON,
+                                          R"({"success":false,"error":"Failed to delete palette"})");
+                            return;
+                        }
+                        Support::Gradients::remove(name);
+                        request->send(200, CONTENT_TYPE_JSON, JSON_RESPONSE_SUCCESS);
+                        return;
+                    }
+                }
+                request->send(404, CONTENT_TYPE_JSON, R"({"success":false,"error":"Palette not found"})");
+            });
+        handler->setMethod(HTTP_DELETE);
+        server.addHandler(handler);
+    }
+
     // GET /api/presets - List all presets
     server.on(API_PATH_PRESETS, HTTP_GET, [this](AsyncWebServerRequest *request) {
         Config::PresetsConfig presetsConfig = config.loadPresetsConfig();
@@ -355,6 +806,287 @@ void WebServerManager::setupAPIRoutes() {
         request->send(200, CONTENT_TYPE_JSON, response);
     });
 
+    // GET /api/timeline - Stored timeline of a preset (?index=), or whether the show is animated
+    server.on(API_PATH_TIMELINE, HTTP_GET, [this](AsyncWebServerRequest *request) {
+        JsonDocument doc;
+        doc["active"] = showController.hasTimeline();
+
+        if (request->hasParam(JSON_KEY_INDEX)) {
+            int presetIndex = request->getParam(JSON_KEY_INDEX)->value().toInt();
+            if (presetIndex < 0 || presetIndex >= Config::PresetsConfig::MAX_PRESETS) {
+                request->send(400, CONTENT_TYPE_JSON, R"({"success":false,"error":"Invalid preset index"})");
+                return;
+            }
+            std::unique_ptr<char[]> json(new char[Config::PresetsConfig::MAX_TIMELINE_LENGTH]);
+            config.loadPresetTimeline(presetIndex, json.get(), Config::PresetsConfig::MAX_TIMELINE_LENGTH);
+            JsonDocument timelineDoc;
+            if (json[0] != '\0' && !deserializeJson(timelineDoc, json.get())) {
+                doc["timeline"] = timelineDoc.as<JsonObject>();
+            }
+        }
+
+        String response;
+        serializeJson(doc, response);
+        request->send(200, CONTENT_TYPE_JSON, response);
+    });
+
+    // POST /api/timeline - Animate the running show, or store a timeline with a preset
+    // {"timeline":{"loop":true,"tracks":{"cooling":[[0,0.05],[3600,0.2,"ease-in-out"]]}},"index":2}
+    {
+        auto *handler = new AsyncCallbackJsonWebHandler(
+            AsyncURIMatcher::exact(API_PATH_TIMELINE),
+            [this](AsyncWebServerRequest *request, JsonVariant &doc) {
+                auto timeline = std::make_unique<Support::Timeline>();
+                std::string error;
+                if (!ShowFactory::parseTimeline(doc["timeline"], *timeline, error)) {
+                    JsonDocument responseDoc;
+                    responseDoc[JSON_KEY_SUCCESS] = false;
+                    responseDoc[JSON_KEY_ERROR] = error;
+
+                    String response;
+                    serializeJson(responseDoc, response);
+                    request->send(400, CONTENT_TYPE_JSON, response);
+                    return;
+                }
+
+                if (doc[JSON_KEY_INDEX].isNull()) {
+                    if (showController.queueTimeline(std::move(timeline))) {
+                        request->send(200, CONTENT_TYPE_JSON, JSON_RESPONSE_SUCCESS);
+                    } else {
+                        request->send(503, CONTENT_TYPE_JSON, JSON_RESPONSE_ERROR_QUEUE_FULL);
+                    }
+                    return;
+                }
+
+                int presetIndex = doc[JSON_KEY_INDEX];
+                if (presetIndex < 0 || presetIndex >= Config::PresetsConfig::MAX_PRESETS) {
+                    request->send(400, CONTENT_TYPE_JSON, R"({"success":false,"error":"Invalid preset index"})");
+                    return;
+                }
+                String json;
+                serializeJson(doc["timeline"], json);
+                if (static_cast<size_t>(json.length()) >= Config::PresetsConfig::MAX_TIMELINE_LENGTH) {
+                    request->send(413, CONTENT_TYPE_JSON, R"({"success":false,"error":"Timeline too large"})");
+                    return;
+                }
+                // Takes effect the next time the preset is loaded
+                if (!config.savePresetTimeline(presetIndex, json.c_str())) {
+                    request->send(500, CONTENT_TYPE_JSON, R"({"success":false,"error":"Failed to save timeline"})");
+                    return;
+                }
+                request->send(200, CONTENT_TYPE_JSON, JSON_RESPONSE_SUCCESS);
+            });
+        handler->setMethod(HTTP_POST);
+        server.addHandler(handler);
+    }
+
+    // DELETE /api/timeline - Stop animating the running show, or {"index":2} remove a preset's timeline
+    {
+        auto *handler = new AsyncCallbackJsonWebHandler(
+            AsyncURIMatcher::exact(API_PATH_TIMELINE),
+            [this](AsyncWebServerRequest *request, JsonVariant &doc) {
+                if (doc[JSON_KEY_INDEX].isNull()) {
+                    if (showController.queueTimeline(nullptr)) {
+                        request->send(200, CONTENT_TYPE_JSON, JSON_RESPONSE_SUCCESS);
+                    } else {
+                        request->send(503, CONTENT_TYPE_JSON, JSON_RESPONSE_ERROR_QUEUE_FULL);
+                    }
+                    return;
+                }
+
+                int presetIndex = doc[JSON_KEY_INDEX];
+                if (presetIndex < 0 || presetIndex >= Config::PresetsConfig::MAX_PRESETS ||
+                    !config.savePresetTimeline(presetIndex, "")) {
+                    request->send(400, CONTENT_TYPE_JSON, R"({"success":false,"error":"Invalid preset index"})");
+                    return;
+                }
+                request->send(200, CONTENT_TYPE_JSON, JSON_RESPONSE_SUCCESS);
+            });
+        handler->setMethod(HTTP_DELETE);
+        server.addHandler(handler);
+    }
+
+    // GET /api/playlist - Get playlist entries and position
+    server.on(API_PATH_PLAYLIST, HTTP_GET, [this](AsyncWebServerRequest *request) {
+        Config::PlaylistConfig playlistConfig = config.loadPlaylistConfig();
+
+        JsonDocument doc;
+        JsonArray entries = doc["entries"].to<JsonArray>();
+        for (uint8_t i = 0; i < playlistConfig.count; i++) {
+            JsonObject entry = entries.add<JsonObject>();
+            entry["preset"] = playlistConfig.entries[i].preset_index;
+            entry["duration_s"] = playlistConfig.entries[i].duration_s;
+        }
+        doc["shuffle"] = playlistConfig.shuffle;
+        doc["enabled"] = playlistConfig.enabled;
+        doc["transition"] = playlistConfig.transition;
+        doc["transition_ms"] = playlistConfig.transition_ms;
+        addPlaylistStatus(doc["status"].to<JsonObject>(), showController.getPlaylistStatus());
+
+        String response;
+        serializeJson(doc, response);
+        request->send(200, CONTENT_TYPE_JSON, response);
+    });
+
+    // GET /api/tempo - Get the tempo clock
+    server.on(API_PATH_TEMPO, HTTP_GET, [](AsyncWebServerRequest *request) {
+        JsonDocument doc;
+        addTempoStatus(doc.to<JsonObject>());
+
+        String response;
+        serializeJson(doc, response);
+        request->send(200, CONTENT_TYPE_JSON, response);
+    });
+
+    // POST /api/tempo/tap - Tap tempo, every tap starts a beat
+    // NOTE: Must be registered BEFORE /api/tempo POST to avoid route conflict
+    server.on(API_PATH_TEMPO_TAP, HTTP_POST, [](AsyncWebServerRequest *request) {
+        Support::Tempo::Clock &tempo = Support::Tempo::clock();
+        size_t taps = tempo.tap();
+
+        JsonDocument doc;
+        doc[JSON_KEY_SUCCESS] = true;
+        doc["taps"] = taps;
+        doc["bpm"] = tempo.bpm();
+
+        String response;
+        serializeJson(doc, response);
+        request->send(200, CONTENT_TYPE_JSON, response);
+    });
+
+    // POST /api/tempo - Set the tempo in beats per minute and the beats per bar
+    {
+        auto *handler = new AsyncCallbackJsonWebHandler(
+            AsyncURIMatcher::exact(API_PATH_TEMPO),
+            [](AsyncWebServerRequest *request, JsonVariant &doc) {
+                Support::Tempo::Clock &tempo = Support::Tempo::clock();
+                if (!doc["bpm"].isNull()) {
+                    float bpm = doc["bpm"] | 0.0f;
+                    if (bpm < Support::Tempo::MIN_BPM || bpm > Support::Tempo::MAX_BPM) {
+                        request->send(400, CONTENT_TYPE_JSON,
+                                      R"({"success":false,"error":"BPM must be between 20 and 300"})");
+                        return;
+                    }
+                    tempo.setBpm(bpm);
+                }
+                if (!doc["beats_per_bar"].isNull()) {
+                    int beats = doc["beats_per_bar"] | 0;
+                    if (beats < 1 || beats > 16) {
+                        request->send(400, CONTENT_TYPE_JSON,
+                                      R"({"success":false,"error":"Beats per bar must be between 1 and 16"})");
+                        return;
+                    }
+                    tempo.setBeatsPerBar(static_cast<uint8_t>(beats));
+                }
+                request->send(200, CONTENT_TYPE_JSON, JSON_RESPONSE_SUCCESS);
+            });
+        handler->setMethod(HTTP_POST);
+        server.addHandler(handler);
+    }
+
+    // POST /api/playlist/skip - Move to the next or previous playlist entry
+    // NOTE: Must be registered BEFORE /api/playlist POST to avoid route conflict
+    {
+        auto *handler = new AsyncCallbackJsonWebHandler(
+            AsyncURIMatcher::exact(API_PATH_PLAYLIST_SKIP),
+            [this](AsyncWebServerRequest *request, JsonVariant &doc) {
+                const char *direction = doc["direction"] | "next";
+                bool forward = strcmp(direction, "next") == 0;
+                if (!forward && strcmp(direction, "previous") != 0) {
+                    request->send(400, CONTENT_TYPE_JSON,
+                                  R"({"success":false,"error":"Direction must be next or previous"})");
+                    return;
+                }
+                if (!showController.skipPlaylist(forward)) {
+                    request->send(409, CONTENT_TYPE_JSON,
+                                  R"({"success":false,"error":"No playlist is playing"})");
+                    return;
+                }
+                request->send(200, CONTENT_TYPE_JSON, JSON_RESPONSE_SUCCESS);
+            });
+        handler->setMethod(HTTP_POST);
+        server.addHandler(handler);
+    }
+
+    // POST /api/playlist - Change the playlist, start or stop it
+    {
+        auto *handler = new AsyncCallbackJsonWebHandler(
+            AsyncURIMatcher::exact(API_PATH_PLAYLIST),
+            [this](AsyncWebServerRequest *request, JsonVariant &doc) {
+                Config::PlaylistConfig playlistConfig = config.loadPlaylistConfig();
+
+                if (!doc["entries"].isNull()) {
+                    JsonArray entries = doc["entries"].as<JsonArray>();
+                    if (entries.isNull() || entries.size() > Config::PlaylistConfig::MAX_ENTRIES) {
+                        request->send(400, CONTENT_TYPE_JSON,
+                                      R"({"success":false,"error":"Entries must be a list of at most 16"})");
+                        return;
+                    }
+                    uint8_t count = 0;
+                    for (JsonObject entry: entries) {
+                        int preset = entry["preset"] | -1;
+                        long duration_s = entry["duration_s"] | 300L;
+                        if (preset < 0 || preset >= Config::PresetsConfig::MAX_PRESETS) {
+                            request->send(400, CONTENT_TYPE_JSON,
+                                          R"({"success":false,"error":"Invalid preset index"})");
+                            return;
+                        }
+                        if (duration_s < 1 || duration_s > 65535) {
+                            request->send(400, CONTENT_TYPE_JSON,
+                                          R"({"success":false,"error":"Duration must be between 1 and 65535 s"})");
+                            return;
+                        }
+                        playlistConfig.entries[count].preset_index = preset;
+                        playlistConfig.entries[count].duration_s = duration_s;
+                        count++;
+                    }
+                    playlistConfig.count = count;
+                }
+                if (!doc["shuffle"].isNull()) {
+                    playlistConfig.shuffle = doc["shuffle"];
+                }
+                if (!doc["transition"].isNull()) {
+                    const char *type = doc["transition"];
+                    if (type == nullptr ||
+                        strcmp(Show::Transition::typeName(Show::Transition::typeFromName(type)), type) != 0) {
+                        request->send(400, CONTENT_TYPE_JSON,
+                                      R"({"success":false,"error":"Transition must be cut, crossfade, wipe or dissolve"})");
+                        return;
+                    }
+                    strncpy(playlistConfig.transition, type, sizeof(playlistConfig.transition) - 1);
+                    playlistConfig.transition[sizeof(playlistConfig.transition) - 1] = '\0';
+                }
+                if (!doc["transition_ms"].isNull()) {
+                    int transition_ms = doc["transition_ms"];
+                    if (transition_ms < 0 || transition_ms > 10000) {
+                        request->send(400, CONTENT_TYPE_JSON,
+                                      R"({"success":false,"error":"Transition must be between 0 and 10000 ms"})");
+                        return;
+                    }
+                    playlistConfig.transition_ms = transition_ms;
+                }
+                if (!doc["enabled"].isNull()) {
+                    playlistConfig.enabled = doc["enabled"];
+                }
+                if (playlistConfig.enabled && playlistConfig.count == 0) {
+                    request->send(400, CONTENT_TYPE_JSON,
+                                  R"({"success":false,"error":"Playlist has no entries"})");
+                    return;
+                }
+
+                config.savePlaylistConfig(playlistConfig);
+                // Any change restarts from the top; the shows are built by the playlist task
+                if (playlistConfig.enabled) {
+                    showController.startPlaylist(playlistConfig);
+                } else {
+                    showController.stopPlaylist();
+                }
+                request->send(200, CONTENT_TYPE_JSON, JSON_RESPONSE_SUCCESS);
+            });
+        handler->setMethod(HTTP_POST);
+        server.addHandler(handler);
+    }
+
     // POST /api/presets/load - Load a preset by index or name
     // NOTE: Must be registered BEFORE /api/presets POST to avoid route conflict
     {
@@ -396,7 +1128,7 @@ void WebServerManager::setupAPIRoutes() {
                 }
 
                 // Queue preset load through ShowController for thread safety
-                if (showController.queuePresetLoad(preset)) {
+                if (showController.queuePresetLoad(preset, presetIndex)) {
                     JsonDocument responseDoc;
                     responseDoc["success"] = true;
                     responseDoc["name"] = preset.name;
@@ -465,6 +1197,8 @@ void WebServerManager::setupAPIRoutes() {
                 preset.layout_dead_leds = layoutConfig.dead_leds;
 
                 if (config.savePreset(slotIndex, preset)) {
+                    showController.queueOverlay(Show::Overlay::Type::PULSE, color(0, 255, 0), 600);
+
                     JsonDocument responseDoc;
                     responseDoc["success"] = true;
                     responseDoc["index"] = slotIndex;
@@ -720,6 +1454,15 @@ void WebServerManager::setupAPIRoutes() {
         statsJson["avg_cycle_time"] = stats.avg_cycle_time;
         statsJson["last_execution_time"] = stats.last_execution_time;
         statsJson["last_show_time"] = stats.last_show_time;
+        if (stats.layer_count > 0) {
+            JsonArray layersJson = statsJson["layers"].to<JsonArray>();
+            for (uint8_t i = 0; i < stats.layer_count; i++) {
+                JsonObject layerJson = layersJson.add<JsonObject>();
+                layerJson["name"] = stats.layers[i].name;
+                layerJson["render_us"] = stats.layers[i].render_us;
+                layerJson["blend_us"] = stats.layers[i].blend_us;
+            }
+        }
 
         // Chip info
         doc["chip_model"] = ESP.getChipModel();
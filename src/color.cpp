@@ -1,22 +1,39 @@
+#include "color.h"
 
-#include "strip/Strip.h"
+#include <array>
 
-Strip::Color wheel(unsigned char wheel_pos) {
-    if (wheel_pos > 254) {
-        wheel_pos = 254; // Safeguard
-    }
+namespace {
+    constexpr Strip::Color wheel_value(unsigned char wheel_pos) {
+        if (wheel_pos > 254) {
+            wheel_pos = 254; // Safeguard
+        }
 
-    if (wheel_pos < 85) {
-        // Green -> Red
-        return ((wheel_pos * 3) << 16) + ((255 - wheel_pos * 3) << 8);
+        if (wheel_pos < 85) {
+            // Green -> Red
+            return ((wheel_pos * 3) << 16) + ((255 - wheel_pos * 3) << 8);
+        }
+        if (wheel_pos < 170) {
+            // Red -> Blue
+            wheel_pos -= 85;
+            return ((255 - wheel_pos * 3) << 16) + wheel_pos * 3;
+        }
+        wheel_pos -= 170;
+        return ((wheel_pos * 3) << 8) + (255 - wheel_pos * 3);
     }
-    if (wheel_pos < 170) {
-        // Red -> Blue
-        wheel_pos -= 85;
-        return ((255 - wheel_pos * 3) << 16) + wheel_pos * 3;
+
+    constexpr std::array<Strip::Color, 256> wheel_table() {
+        std::array<Strip::Color, 256> table{};
+        for (unsigned int i = 0; i < 256; i++) {
+            table[i] = wheel_value(static_cast<unsigned char>(i));
+        }
+        return table;
     }
-    wheel_pos -= 170;
-    return ((wheel_pos * 3) << 8) + (255 - wheel_pos * 3);
+}
+
+const std::array<Strip::Color, 256> WHEEL_TABLE = wheel_table();
+
+Strip::Color wheel(unsigned char wheel_pos) {
+    return wheel_value(wheel_pos);
 }
 
 Strip::Color color(Strip::ColorComponent red, Strip::ColorComponent green, Strip::ColorComponent blue) {
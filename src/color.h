@@ -1,10 +1,15 @@
 #ifndef LEDZ_COLOR_H
 #define LEDZ_COLOR_H
 
+#include <array>
+
 #include "strip/Strip.h"
 
 Strip::Color wheel(unsigned char wheel_pos);
 
+// wheel() for every position, for shows that look up a hue per pixel
+extern const std::array<Strip::Color, 256> WHEEL_TABLE;
+
 Strip::Color color(Strip::ColorComponent red, Strip::ColorComponent green, Strip::ColorComponent blue);
 
 // Extract color components from a Color value
@@ -8,7 +8,16 @@
 #include "ShowController.h"
 #include "strip/Base.h"
 #include "task/LedShow.h"
+#include "task/Playlist.h"
 #include "OTAUpdater.h"
+#include "support/Gradients.h"
+#ifdef ARDUINO
+#include <SPIFFS.h>
+#endif
+#ifdef LEDZ_AUDIO
+#include "support/I2SSource.h"
+#include "task/Audio.h"
+#endif
 
 static const char* TAG = "main";
 
@@ -19,8 +28,24 @@ Config::ConfigManager config;
 ShowFactory showFactory;
 ShowController showController(showFactory, config);
 Task::LedShow ledShow(showController);
+Task::Playlist playlist(showController);
 Network network(config, showController);
 
+#ifdef LEDZ_AUDIO
+// I2S microphone for the audio reactive shows, pins set with build flags
+#ifndef LEDZ_I2S_SCK
+#define LEDZ_I2S_SCK 7
+#endif
+#ifndef LEDZ_I2S_WS
+#define LEDZ_I2S_WS 8
+#endif
+#ifndef LEDZ_I2S_SD
+#define LEDZ_I2S_SD 9
+#endif
+Support::Audio::I2SSource microphone(LEDZ_I2S_SCK, LEDZ_I2S_WS, LEDZ_I2S_SD);
+Task::Audio audio(microphone);
+#endif
+
 void setup() {
     delay(1000);
     Serial.println("");
@@ -29,6 +54,11 @@ void setup() {
     OTAUpdater::setConfig(&config);
 
 #ifdef ARDUINO
+    // Animation clips live on the spiffs partition; format it on first boot
+    if (!SPIFFS.begin(true)) {
+        ESP_LOGE(TAG, "Failed to mount the clip storage");
+    }
+
     // Load device configuration
     Config::DeviceConfig deviceConfig = config.loadDeviceConfig();
     uint16_t num_pixels = deviceConfig.num_pixels;
@@ -48,6 +78,17 @@ void setup() {
     }
 #endif
 
+    // Custom palettes, before the first show is created
+    Config::PalettesConfig palettesConfig = config.loadPalettesConfig();
+    for (const Config::CustomPalette &palette: palettesConfig.palettes) {
+        std::vector<Strip::Color> colors;
+        for (uint8_t i = 0; i < palette.count; i++) {
+            colors.push_back(palette.color(i));
+        }
+        if (!colors.empty() && !Support::Gradients::store(palette.name, colors)) {
+            ESP_LOGW(TAG, "Ignoring stored palette '%s'", palette.name);
+        }
+    }
 
     // Initialize show controller
     showController.begin();
@@ -64,6 +105,22 @@ void setup() {
         ESP_LOGE(TAG, "Unknown error starting LED show task");
     }
 
+    // Playlist task: Core 0, builds upcoming shows off the LED task
+    try {
+        playlist.startTask();
+    } catch (const std::exception &e) {
+        ESP_LOGE(TAG, "Error starting playlist task: %s", e.what());
+    } catch (...) {
+        ESP_LOGE(TAG, "Unknown error starting playlist task");
+    }
+
+#ifdef LEDZ_AUDIO
+    // Audio task: Core 0, publishes to the shows without locking
+    if (microphone.begin()) {
+        audio.startTask();
+    }
+#endif
+
     try {
         network.startTask();
     } catch (const std::exception &e) {
@@ -0,0 +1,93 @@
+#include "Automaton.h"
+#include "support/Palette.h"
+#include "support/PostProcess.h"
+
+#include <algorithm>
+
+namespace Show {
+    Automaton::Automaton(uint8_t rule, Strip::PixelIndex width, uint32_t seed,
+                         const std::vector<Strip::Color> &palette, unsigned int interval, unsigned int trail)
+        : line(rule), width(std::max<Strip::PixelIndex>(0, width)), seed(seed),
+          interval(std::max(1u, interval)) {
+        std::vector<Strip::Color> stops = palette.empty()
+                                              ? std::vector<Strip::Color>{0xFFFFFF, 0x40A0FF, 0x2000C0}
+                                              : palette;
+        Support::Palette gradient;
+        for (size_t i = 0; i < stops.size(); i++) {
+            gradient.addPoint(stops.size() > 1 ? static_cast<float>(i) / (stops.size() - 1) : 0.0f, stops[i]);
+        }
+        // alive, then trail generations fading to black; anything older stays black
+        trail = std::min(trail, 254u);
+        colors.resize(trail + 2, 0);
+        for (unsigned int a = 0; a <= trail; a++) {
+            float position = trail > 0 ? static_cast<float>(a) / trail : 0.0f;
+            Strip::Color shade = gradient.get_color(position);
+            colors[a] = a == 0 ? shade : Support::PostProcess::scale(shade, 255 * (trail + 1 - a) / (trail + 1));
+        }
+        gen.seed(seed != 0 ? seed : Support::randomSeed());
+    }
+
+    bool Automaton::alive(Strip::PixelIndex index) const {
+        if (width == 0) {
+            return line.get(index);
+        }
+        auto x = static_cast<size_t>(index % width);
+        auto y = static_cast<size_t>(index / width);
+        return y < grid.height() && grid.get(x, y);
+    }
+
+    void Automaton::reseed(bool random) {
+        // cells start alive with a chance of 3 in 10
+        if (width == 0) {
+            line.resize(length);
+            if (random) {
+                for (Strip::PixelIndex i = 0; i < length; i++) {
+                    line.set(i, gen.below(10) < 3);
+                }
+            } else {
+                line.set(length / 2, true);
+            }
+        } else {
+            grid.resize(width, length / width);
+            for (size_t y = 0; y < grid.height(); y++) {
+                for (size_t x = 0; x < grid.width(); x++) {
+                    grid.set(x, y, gen.below(10) < 3);
+                }
+            }
+        }
+    }
+
+    void Automaton::advance() {
+        bool changed = width == 0 ? line.step() : grid.step();
+        if (!changed || (width == 0 ? line.empty() : grid.empty())) {
+            reseed(true);
+        }
+    }
+
+    void Automaton::execute(Strip::Strip &strip, Iteration iteration) {
+        if (strip.length() != length) {
+            length = strip.length();
+            if (width > length) {
+                width = length;
+            }
+            age.assign(length, static_cast<uint8_t>(colors.size() - 1));
+            reseed(seed != 0 || width != 0);
+            last_step = iteration;
+        } else if (iteration - last_step >= interval) {
+            advance();
+            last_step = iteration;
+        } else {
+            // between generations the strip only needs repainting
+            for (Strip::PixelIndex i = 0; i < length; i++) {
+                strip.setPixelColor(i, colors[age[i]]);
+            }
+            return;
+        }
+
+        auto oldest = static_cast<uint8_t>(colors.size() - 1);
+        for (Strip::PixelIndex i = 0; i < length; i++) {
+            age[i] = alive(i) ? 0 : std::min<uint8_t>(age[i] + 1, oldest);
+            strip.setPixelColor(i, colors[age[i]]);
+        }
+    }
+} // namespace Show
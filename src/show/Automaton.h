@@ -0,0 +1,55 @@
+#ifndef LEDZ_AUTOMATON_H
+#define LEDZ_AUTOMATON_H
+
+#include <vector>
+
+#include "Show.h"
+#include "support/Automaton.h"
+#include "support/Random.h"
+
+namespace Show {
+    /**
+     * Automaton - Cellular automata: an elementary rule along the strip, or
+     * Conway's Game of Life when the strip is laid out as a matrix
+     * Cells that die leave a trail that fades through the palette. A pattern
+     * that dies out or stops changing is reseeded at random.
+     */
+    class Automaton : public Show {
+    private:
+        Support::Automaton::Elementary line;
+        Support::Automaton::Life grid;
+        Strip::PixelIndex width; // 0 for the elementary automaton
+        uint32_t seed;
+        unsigned int interval;
+        std::vector<Strip::Color> colors; // by generations since the cell was alive
+        std::vector<uint8_t> age;
+        Support::Random gen;
+        Strip::PixelIndex length = 0;
+        Iteration last_step = 0;
+
+        void reseed(bool random);
+
+        bool alive(Strip::PixelIndex index) const;
+
+        void advance();
+
+    public:
+        /**
+         * @param rule Wolfram rule of the elementary automaton (default: 30)
+         * @param width Pixels per row for Game of Life, 0 for an elementary automaton along the strip
+         * @param seed Start pattern: 0 for a single cell (random for Life), else the seed of a random pattern
+         * @param palette Colors a cell passes through as it fades, from alive to the end of its trail
+         * @param interval Frames per generation (default: 5)
+         * @param trail Generations a dead cell takes to fade out (default: 8)
+         */
+        Automaton(uint8_t rule = 30, Strip::PixelIndex width = 0, uint32_t seed = 0,
+                  const std::vector<Strip::Color> &palette = {}, unsigned int interval = 5,
+                  unsigned int trail = 8);
+
+        void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        const char *name() { return "Automaton"; }
+    };
+} // namespace Show
+
+#endif //LEDZ_AUTOMATON_H
@@ -0,0 +1,68 @@
+#include "Baked.h"
+#include "../Log.h"
+
+static const char* TAG = "show";
+
+namespace Show {
+    Baked::Baked(std::unique_ptr<Show> show, Iteration period, size_t budget_bytes)
+        : show(std::move(show)), frame_count(period), budget(budget_bytes),
+          state(period > 0 ? State::RECORDING : State::LIVE) {
+    }
+
+    void Baked::record(Strip::PixelIndex length) {
+        loop = std::make_unique<Support::FrameLoop>(length, budget);
+        canvas.resize(length);
+        state = State::RECORDING;
+    }
+
+    bool Baked::setParameter(const char *name, float value) {
+        if (!show->setParameter(name, value)) {
+            return false;
+        }
+        if (state != State::LIVE) {
+            ESP_LOGD(TAG, "Parameter %s changed, running live", name);
+            loop.reset();
+            canvas.resize(0);
+            frame_count = 0;
+            state = State::LIVE;
+        }
+        return true;
+    }
+
+    void Baked::execute(Strip::Strip &strip, Iteration iteration) {
+        if (state == State::LIVE) {
+            show->execute(strip, iteration);
+            return;
+        }
+
+        Strip::PixelIndex length = strip.length();
+        if (!loop || loop->length() != length) {
+            record(length);
+        }
+
+        if (state == State::RECORDING) {
+            show->execute(canvas, iteration);
+            canvas.copyTo(strip);
+
+            if (!loop->append(canvas.data())) {
+                ESP_LOGW(TAG, "Loop of %u frames exceeds %u bytes, running live",
+                         (unsigned) frame_count, (unsigned) budget);
+                loop.reset();
+                canvas.resize(0);
+                state = State::LIVE;
+            } else if (loop->frames() == frame_count) {
+                loop->finish();
+                canvas.resize(0);
+                state = State::PLAYBACK;
+                ESP_LOGI(TAG, "Baked %u frames into %u bytes",
+                         (unsigned) frame_count, (unsigned) loop->size());
+            }
+            return;
+        }
+
+        const Strip::Color *pixels = loop->next();
+        for (Strip::PixelIndex i = 0; i < length; i++) {
+            strip.setPixelColor(i, pixels[i]);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef LEDZ_BAKED_H
+#define LEDZ_BAKED_H
+
+#include <memory>
+
+#include "Show.h"
+#include "strip/Buffer.h"
+#include "support/FrameLoop.h"
+
+namespace Show {
+    /**
+     * Baked - Plays a periodic show from a precomputed frame loop
+     *
+     * The first period is rendered live into an offscreen buffer and recorded
+     * into a FrameLoop; from then on frames are decoded from the loop and the
+     * wrapped show is no longer executed. If the loop does not fit the budget
+     * the show simply keeps running live. A change of strip length records a
+     * new loop; parameter changes create a new show and thus a new Baked,
+     * except those set on the running show, which switch it to live.
+     *
+     * Assumes execute() is called once per frame with consecutive iterations.
+     */
+    class Baked : public Show {
+    private:
+        enum class State {
+            RECORDING,
+            PLAYBACK,
+            LIVE
+        };
+
+        std::unique_ptr<Show> show;
+        Iteration frame_count;
+        size_t budget;
+
+        State state;
+        Strip::Buffer canvas;
+        std::unique_ptr<Support::FrameLoop> loop;
+
+        void record(Strip::PixelIndex length);
+
+    public:
+        /**
+         * @param show Show to bake
+         * @param period Frames per loop, usually show->period()
+         * @param budget_bytes Maximum encoded size of the loop
+         */
+        Baked(std::unique_ptr<Show> show, Iteration period, size_t budget_bytes);
+
+        void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        bool isComplete() const override { return show->isComplete(); }
+
+        Iteration period() const override { return frame_count; }
+
+        size_t layerTimings(LayerTiming *timings, size_t max) const override {
+            return show->layerTimings(timings, max);
+        }
+
+        /**
+         * A changed parameter invalidates the loop, so the show runs live from then on
+         */
+        bool setParameter(const char *name, float value) override;
+
+        /**
+         * @return true once the loop is recorded and frames are replayed from it
+         */
+        bool isBaked() const { return state == State::PLAYBACK; }
+
+        /**
+         * @return Encoded loop size in bytes, 0 if not baked
+         */
+        size_t bakedSize() const { return isBaked() ? loop->size() : 0; }
+    };
+}
+
+#endif //LEDZ_BAKED_H
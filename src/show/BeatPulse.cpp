@@ -0,0 +1,37 @@
+#include "BeatPulse.h"
+#include "../color.h"
+#include "support/PostProcess.h"
+
+#include <cstdlib>
+
+namespace Show {
+    BeatPulse::BeatPulse(float decay, float spread, uint8_t hue_step, const Support::Audio::Channel &input)
+        : input(input), decay(decay), spread(spread), hue_step(hue_step) {
+    }
+
+    void BeatPulse::execute(Strip::Strip &strip, Iteration iteration) {
+        bool read = input.read(frame);
+        if (read && !synced) {
+            // beats from before the show started do not count
+            seen_beats = frame.beats;
+            synced = true;
+        } else if (read && frame.beats != seen_beats) {
+            seen_beats = frame.beats;
+            hue += hue_step;
+            brightness = 0.35f + 0.65f * frame.beat_strength;
+            radius = 0.0f;
+        } else {
+            brightness *= decay;
+            radius += spread;
+        }
+
+        Strip::PixelIndex length = strip.length();
+        Strip::Color pulse = Support::PostProcess::scale(wheel(hue), static_cast<uint8_t>(brightness * 255.0f));
+        // the strip is lit from the middle out to the radius
+        float reach = spread > 0.0f ? radius + spread : static_cast<float>(length);
+        for (Strip::PixelIndex i = 0; i < length; i++) {
+            float distance = std::abs(2.0f * i - (length - 1)) / 2.0f;
+            strip.setPixelColor(i, distance < reach ? pulse : 0);
+        }
+    }
+} // namespace Show
@@ -0,0 +1,43 @@
+#ifndef LEDZ_BEATPULSE_H
+#define LEDZ_BEATPULSE_H
+
+#include "Show.h"
+#include "support/Audio.h"
+
+namespace Show {
+    /**
+     * BeatPulse - Flashes on every beat of the music, spreading out from the
+     * middle of the strip and fading until the next one, in a new color each beat
+     * Reads the frames published by the audio task.
+     */
+    class BeatPulse : public Show {
+    private:
+        const Support::Audio::Channel &input;
+        Support::Audio::Frame frame;
+        float decay;
+        float spread;
+        uint8_t hue_step;
+
+        bool synced = false;
+        uint32_t seen_beats = 0;
+        uint8_t hue = 0;
+        float brightness = 0.0f;
+        float radius = 0.0f;
+
+    public:
+        /**
+         * @param decay Fraction of the brightness kept per frame (default: 0.9)
+         * @param spread Pixels per frame the pulse grows from the middle, 0 to light the strip at once (default: 3)
+         * @param hue_step Color wheel step per beat (default: 40)
+         * @param input Published audio analysis
+         */
+        explicit BeatPulse(float decay = 0.9f, float spread = 3.0f, uint8_t hue_step = 40,
+                           const Support::Audio::Channel &input = Support::Audio::channel());
+
+        void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        const char *name() { return "BeatPulse"; }
+    };
+} // namespace Show
+
+#endif //LEDZ_BEATPULSE_H
@@ -1,22 +1,89 @@
 #include "Chaos.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "color.h"
+#include "support/Gradients.h"
 
 namespace Show {
+    namespace {
+        // a hit in the density histogram; fractions of it are what fading leaves
+        constexpr uint32_t HIT = 256;
+
+        const std::vector<Strip::Color> DEFAULT_PALETTE = {0x300060, 0xC02050, 0xFFA000, 0xFFFFC0};
+
+        // log2 in 1/256: the integer part from the highest set bit, the next
+        // 8 bits below it as the fraction
+        uint32_t log2Q8(uint32_t value) {
+            uint32_t exponent = 0;
+            while (value >= 512) {
+                value >>= 1;
+                exponent++;
+            }
+            while (value < 256 && value != 0) {
+                value <<= 1;
+                exponent--;
+            }
+            return ((exponent + 8) << 8) + (value & 0xFF);
+        }
+
+        // r in Q2.30, kept just below 4 so that r x (1 - x) stays below 1
+        uint32_t fixedR(float r) {
+            return static_cast<uint32_t>(std::min(4294967295.0, std::max(0.0, r * 1073741824.0)));
+        }
+
+        // x = r x (1 - x) with x in Q0.32: x (1 - x) is at most 1/4, so both
+        // products fit and the result needs no clamping
+        inline uint32_t logistic(uint32_t x, uint32_t fixed_r) {
+            uint64_t x_one_minus_x = (static_cast<uint64_t>(x) * (0u - x)) >> 32;
+            return static_cast<uint32_t>((fixed_r * x_one_minus_x) >> 30);
+        }
+    }
+
     float Chaos::func(float x) const {
         return r * x * (1 - x);
     }
 
+    Chaos::Mode Chaos::modeFromName(const char *name) {
+        if (name != nullptr && strcmp(name, "density") == 0) {
+            return Mode::DENSITY;
+        }
+        return Mode::POINTS;
+    }
+
     Chaos::Chaos() : Chaos(2.95f, 4.0f, 0.0002f) {
         // Delegate to parameterized constructor with defaults
     }
 
-    Chaos::Chaos(float Rmin, float Rmax, float Rdelta)
-        : Rmin(Rmin), Rmax(Rmax), Rdelta(Rdelta), r(Rmin) {
-        // Initialize with provided parameters
+    Chaos::Chaos(float Rmin, float Rmax, float Rdelta, Mode mode, unsigned int density_iterations, float decay,
+                 const std::vector<Strip::Color> &palette)
+        : Rmin(Rmin), Rmax(Rmax), Rdelta(Rdelta), r(Rmin), mode(mode), density_iterations(density_iterations),
+          // a decay of 1 would let the histogram grow without bound
+          decay(std::min<uint32_t>(255, static_cast<uint32_t>(std::min(1.0f, std::max(0.0f, decay)) * 256.0f))) {
+        // no hits is always black, the palette runs from one hit to the most
+        std::vector<Strip::Color> stops = {0x000000};
+        const std::vector<Strip::Color> &density_colors = palette.empty() ? DEFAULT_PALETTE : palette;
+        stops.insert(stops.end(), density_colors.begin(), density_colors.end());
+        colors = Support::Gradients::bake(stops);
     }
 
-    void Chaos::execute(Strip::Strip &strip, Iteration iteration) {
+    void Chaos::execute(Strip::Strip &strip, [[maybe_unused]] Iteration iteration) {
+        if (mode == Mode::DENSITY) {
+            executeDensity(strip);
+        } else {
+            executePoints(strip);
+        }
+
+        r += Rdelta;
+        if (r > Rmax) {
+            r = Rmin;
+            settled = false;
+            x_fixed = 0;
+        }
+    }
+
+    void Chaos::executePoints(Strip::Strip &strip) {
         strip.fill(0x000000);
 
         auto num_leds = strip.length();
@@ -36,10 +103,74 @@ namespace Show {
             Strip::Color color = wheel((i * color_factor) % 255);
             strip.setPixelColor(led, color);
         }
+    }
+
+    void Chaos::executeDensity(Strip::Strip &strip) {
+        if (length != strip.length()) {
+            length = strip.length();
+            hits = std::make_unique<uint32_t[]>(std::max<Strip::PixelIndex>(1, length));
+            std::fill(hits.get(), hits.get() + std::max<Strip::PixelIndex>(1, length), 0);
+        }
 
-        r += Rdelta;
-        if (r > Rmax) {
-            r = Rmin;
+        // older hits fade out
+        for (Strip::PixelIndex i = 0; i < length; i++) {
+            hits[i] = static_cast<uint32_t>(static_cast<uint64_t>(hits[i]) * decay >> 8);
+        }
+
+        accumulate(density_iterations);
+
+        uint32_t max_density = 0;
+        for (Strip::PixelIndex i = 0; i < length; i++) {
+            max_density = std::max(max_density, hits[i]);
+        }
+        for (Strip::PixelIndex i = 0; i < length; i++) {
+            strip.setPixelColor(i, colorOf(hits[i], max_density));
+        }
+    }
+
+    void Chaos::accumulate(unsigned int count) {
+        if (length <= 0) {
+            return;
+        }
+        // 0 is a fixed point the orbit cannot leave: start over from x_initial
+        if (x_fixed == 0) {
+            x_fixed = static_cast<uint32_t>(x_initial * 4294967296.0);
+            settled = false;
+        }
+
+        uint32_t fixed_r = fixedR(r);
+        uint32_t x = x_fixed;
+        if (!settled) {
+            for (unsigned int i = 0; i < BURN_IN; i++) {
+                x = logistic(x, fixed_r);
+            }
+            settled = true;
+        }
+
+        uint32_t *histogram = hits.get();
+        const auto pixels = static_cast<uint32_t>(length);
+        for (unsigned int i = 0; i < count; i++) {
+            x = logistic(x, fixed_r);
+            // x in [0, 1) times the pixel count, as a high multiply
+            histogram[static_cast<uint64_t>(x) * pixels >> 32] += HIT;
+        }
+        x_fixed = x;
+    }
+
+    uint32_t Chaos::density(Strip::PixelIndex pixel) const {
+        if (pixel < 0 || pixel >= length) {
+            return 0;
+        }
+        return hits[pixel];
+    }
+
+    Strip::Color Chaos::colorOf(uint32_t density, uint32_t max_density) const {
+        if (density == 0) {
+            return colors[0];
         }
+        // log density, so that rarely visited branches stay visible next to the fixed points
+        uint32_t level = log2Q8(density + 1);
+        uint32_t top = std::max<uint32_t>(1, log2Q8(max_density + 1));
+        return colors[std::min<uint32_t>(255, level * 255 / top)];
     }
-}
\ No newline at end of file
+}
@@ -1,10 +1,39 @@
 #ifndef LEDZ_CHAOS_H
 #define LEDZ_CHAOS_H
+#include <memory>
+#include <vector>
+
 #include "Show.h"
 #include "strip/Strip.h"
+#include "support/Palette.h"
 
 namespace Show {
+    /**
+     * The logistic map x = r x (1 - x), drawn along the strip while r slowly
+     * rises. In points mode each frame paints the first iterations of one r
+     * as single pixels. In density mode thousands of iterations per frame
+     * fill a hit histogram that fades across frames and is shown by log
+     * density through a palette, so the bifurcation diagram appears as a
+     * steady glow rather than flickering dots.
+     */
     class Chaos : public Show {
+    public:
+        enum class Mode {
+            POINTS,
+            DENSITY,
+        };
+
+        /**
+         * @return Mode of a name, "points" or "density"; POINTS if unknown
+         */
+        static Mode modeFromName(const char *name);
+
+        /**
+         * Iterations run after r wraps around, before hits are counted
+         */
+        static constexpr unsigned int BURN_IN = 200;
+
+    private:
         unsigned int iterations = 60;
         unsigned int color_factor = 4;
         const float x_initial = 0.5;
@@ -13,8 +42,22 @@ namespace Show {
         float Rdelta; // r_incr - increment per iteration
         float r; // current R value
 
+        Mode mode;
+        unsigned int density_iterations;
+        uint32_t decay; // share of the histogram kept per frame, in 1/256
+        Support::Palette::Table colors; // palette baked into a lookup table
+
+        Strip::PixelIndex length = -1; // strip length the histogram was made for
+        std::unique_ptr<uint32_t[]> hits; // per pixel, in 1/256 of a hit
+        uint32_t x_fixed = 0; // orbit of density mode in Q0.32, carried across frames
+        bool settled = false; // burn-in done for the current orbit
+
         float func(float x) const;
 
+        void executePoints(Strip::Strip &strip);
+
+        void executeDensity(Strip::Strip &strip);
+
     public:
         /**
          * Create Chaos show with default parameters
@@ -26,11 +69,33 @@ namespace Show {
          * @param Rmin Starting R value (default: 2.95)
          * @param Rmax Maximum R value (default: 4.0)
          * @param Rdelta R increment per iteration (default: 0.0002)
+         * @param mode Single points per frame, or a fading density histogram
+         * @param density_iterations Iterations per frame in density mode
+         * @param decay Share of the density kept from one frame to the next, 0 - 1
+         * @param palette Colors from low to high density; empty for the default
          */
-        Chaos(float Rmin, float Rmax, float Rdelta);
+        Chaos(float Rmin, float Rmax, float Rdelta, Mode mode = Mode::POINTS,
+              unsigned int density_iterations = 10000, float decay = 0.8f,
+              const std::vector<Strip::Color> &palette = {});
 
         void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        /**
+         * Run the map in fixed point and count hits, without drawing
+         * @param count Iterations to run
+         */
+        void accumulate(unsigned int count);
+
+        /**
+         * @return Density histogram entry of a pixel, in 1/256 of a hit
+         */
+        uint32_t density(Strip::PixelIndex pixel) const;
+
+        /**
+         * @return Palette color of a density, relative to the highest density
+         */
+        Strip::Color colorOf(uint32_t density, uint32_t max_density) const;
     };
 }
 
-#endif //LEDZ_CHAOS_H
\ No newline at end of file
+#endif //LEDZ_CHAOS_H
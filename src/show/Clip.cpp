@@ -0,0 +1,46 @@
+#include "Clip.h"
+
+#include <algorithm>
+
+namespace Show {
+    // iterations per second at the default 10 ms cycle
+    static constexpr uint64_t CYCLES_PER_SECOND = 100;
+
+    Clip::Clip(const std::string &path, bool loop) : decoder(path, loop), loop(loop) {
+    }
+
+    void Clip::execute(Strip::Strip &strip, Iteration iteration) {
+        if (!started) {
+            start = iteration;
+            started = true;
+        }
+
+        if (decoder.isValid() && !finished) {
+            const Support::Clip::Header &header = decoder.header();
+            uint64_t due = (iteration - start) * header.fps / CYCLES_PER_SECOND + 1;
+            if (due > decoded + header.keyframe_interval) {
+                // far behind, e.g. after a stall: jump ahead from the nearest keyframe
+                uint64_t frame = loop ? due - 1 : std::min<uint64_t>(due - 1, header.frames - 1);
+                decoder.seek(static_cast<uint32_t>(frame % header.frames));
+                decoded = frame;
+            }
+            while (decoded < due) {
+                if (!decoder.next()) {
+                    finished = true;
+                    break;
+                }
+                decoded++;
+            }
+        }
+
+        if (!decoder.isValid()) {
+            strip.fill(0);
+            return;
+        }
+        const Strip::Color *pixels = decoder.frame();
+        Strip::PixelIndex clip_length = decoder.header().pixels;
+        for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+            strip.setPixelColor(i, i < clip_length ? pixels[i] : 0);
+        }
+    }
+} // namespace Show
@@ -0,0 +1,45 @@
+#ifndef LEDZ_CLIP_H
+#define LEDZ_CLIP_H
+
+#include <string>
+
+#include "Show.h"
+#include "support/Clip.h"
+
+namespace Show {
+    /**
+     * Clip - Plays an uploaded animation clip, streamed from flash
+     * Clip frames are shown at the clip's own frame rate, assuming the default
+     * 10 ms cycle. A clip shorter than the strip leaves the rest dark; a longer
+     * one is cut off.
+     */
+    class Clip : public Show {
+    private:
+        Support::Clip::Decoder decoder;
+        bool loop;
+        bool started = false;
+        bool finished = false;
+        Iteration start = 0;
+        uint64_t decoded = 0; // clip frames decoded since start
+
+    public:
+        /**
+         * @param path Clip file, see Support::Clip::path()
+         * @param loop Start over at the end instead of holding the last frame (default: true)
+         */
+        explicit Clip(const std::string &path, bool loop = true);
+
+        void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        bool isComplete() const override { return finished || !decoder.isValid(); }
+
+        /**
+         * @return false if the clip is missing or corrupt
+         */
+        bool isValid() const { return decoder.isValid(); }
+
+        const char *name() { return "Clip"; }
+    };
+} // namespace Show
+
+#endif //LEDZ_CLIP_H
@@ -1,56 +1,39 @@
 #include "ColorRun.h"
 
 #include <algorithm>
-#include <sstream>
+
 #ifdef ARDUINO
 #include <USBCDC.h>
 #endif
 
 namespace Show {
-    ColorRun::ColorRun() : randomPercent(0, 99), randomSpeed(20, 60) {
+    ColorRun::ColorRun(uint32_t seed) : gen(seed) {
         this->phases = {0x000000, 0x0000FF, 0x00FF00, 0x00FFFF, 0xFF0000, 0xFF00FF, 0xFFFF00, 0xFFFFFF};
-        this->states = std::vector<State>();
-
-        auto state = State{0, 0.5, 0xFF0000};
-        states.push_back(state);
-
-        this->randomPhase = std::uniform_int_distribution<>(0, phases.size() - 1);
-
-        gen.seed(Support::randomSeed());
     }
 
     void ColorRun::update_state(Iteration iteration) {
-        if (randomPercent(gen) >= 95) {
-            auto speed = randomSpeed(gen) / 100.0f;
-            auto color = phases[randomPhase(gen)];
-            auto state = State{iteration, speed, color};
-            states.push_back(state);
+        if (gen.below(100) >= 95) {
+            // 0.2 to 0.6 pixels per frame
+            auto velocity = static_cast<int32_t>(20 + gen.below(41)) * Support::Particles::ONE_PIXEL_PER_FRAME / 100;
+            auto color = phases[gen.below(phases.size())];
+            // the slowest dot takes length / 0.2 frames to cross the strip
+            runners.spawn(0, velocity, 0, color, 5 * length + 5, iteration);
         }
     }
 
     void ColorRun::execute(Strip::Strip &strip, Iteration iteration) {
-        update_state(iteration);
-
-        strip.fill(0x000000);
-
-        for (auto state: states) {
-            strip.setPixelColor(state.position(iteration), state.color);
+        if (strip.length() != length) {
+            length = strip.length();
+            // a new dot every 20 frames lives at most 5 * length frames, so on
+            // average a quarter of the pixels carry one; leave room for bursts
+            runners.reserve(std::max<Strip::PixelIndex>(16, length / 2));
+            runners.spawn(0, Support::Particles::ONE_PIXEL_PER_FRAME / 2, 0, 0xFF0000, 2 * length + 2, iteration);
         }
 
-        clean_up_state(strip.length(), iteration);
-    }
-
-    void ColorRun::clean_up_state(Strip::PixelIndex length, Iteration iteration) {
-        states.erase(
-            std::remove_if(states.begin(), states.end(), [&](const State &state) {
-                return state.position(iteration) >= length;
-            }),
-            states.end()
-        );
-    }
+        update_state(iteration);
 
+        strip.fill(0x000000);
 
-    Strip::PixelIndex ColorRun::State::position(Iteration iteration) const {
-        return speed * (iteration - start);
+        runners.step(strip, iteration, Support::Particles::Edge::EXPIRE);
     }
-} // Show
\ No newline at end of file
+} // Show
@@ -2,48 +2,39 @@
 #define LEDZ_COLORRUN_H
 
 #include <vector>
-#include <random>
 
 #include "strip/Strip.h"
 #include "Show.h"
+#include "support/Particles.h"
 #include "support/Random.h"
 
 namespace Show {
+    /**
+     * Colored dots appear at random and run along the strip at their own speed.
+     * Each dot is a particle that expires when it leaves the strip.
+     */
     class ColorRun : public Show {
-        class State {
-            Iteration start;
-            float speed;
-
-        public:
-            Strip::Color color;
-
-            State(Iteration start, float speed, Strip::Color color)
-                : start(start),
-                  speed(speed),
-                  color(color) {
-            }
-
-            Strip::PixelIndex position(Iteration iteration) const;
-        };
-
-        std::uniform_int_distribution<> randomPercent;
-        std::uniform_int_distribution<> randomPhase;
-        std::uniform_int_distribution<> randomSpeed;
-
     public:
-        ColorRun();
+        /**
+         * @param seed Seed of the dots' colors, speeds and timing
+         */
+        explicit ColorRun(uint32_t seed = Support::randomSeed());
 
         void update_state(Iteration iteration);
 
-        void clean_up_state(Strip::PixelIndex length, Iteration iteration);
-
         void execute(Strip::Strip &strip, Iteration iteration) override;
 
+        /**
+         * Number of dots currently running
+         */
+        Support::Particles::Index active() const { return runners.size(); }
+
     private:
         std::vector<Strip::Color> phases;
-        std::vector<State> states;
+        Support::Particles runners;
+        Strip::PixelIndex length = 0;
         Support::Random gen;
     };
 } // Show
 
-#endif //LEDZ_COLORRUN_H
\ No newline at end of file
+#endif //LEDZ_COLORRUN_H
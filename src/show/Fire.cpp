@@ -1,21 +1,84 @@
 #include "Fire.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <utility>
 
 #include "support/color.h"
+#include "support/Gradients.h"
 
 
 namespace Show {
-    // Maximum heat transfer per frame - limits how fast heat propagates upward
-    constexpr float MAX_SPREAD_PER_FRAME = 0.25f;
-    FireState::FireState(std::function<float()> randomFloat, Strip::PixelIndex length) :
-        randomFloat(std::move(randomFloat)),
-        _length(length),
-        temperature(std::make_unique<float[]>(length)),
-        prev_temperature(std::make_unique<float[]>(length)) {
-        std::fill(temperature.get(), temperature.get() + length, 0.0f);
-        std::fill(prev_temperature.get(), prev_temperature.get() + length, 0.0f);
+    namespace {
+        using Heat = FireState::Heat;
+
+        // Maximum heat transfer per frame - limits how fast heat propagates upward
+        constexpr Heat MAX_SPREAD_PER_FRAME = FireState::ONE / 4;
+
+        Heat toHeat(float value) {
+            float limit = static_cast<float>(FireState::MAX_HEAT) / FireState::ONE;
+            return static_cast<Heat>(std::lround(std::min(limit, std::max(-limit, value)) * FireState::ONE));
+        }
+
+        Support::Palette::Table bake(Fire::Fuel fuel) {
+            Support::Palette::Table palette;
+            if (fuel == Fire::Fuel::WOOD) {
+                for (size_t i = 0; i < palette.size(); i++) {
+                    palette[i] = Support::Color::black_body_color(static_cast<float>(i) / 255.0f);
+                }
+                return palette;
+            }
+
+            Support::Palette gradient;
+            gradient.addPoint(0.0f, 0x000000);
+            if (fuel == Fire::Fuel::GAS) {
+                gradient.addPoint(0.3f, 0x0010A0);
+                gradient.addPoint(0.6f, 0x1060FF);
+                gradient.addPoint(0.85f, 0x60C0FF);
+                gradient.addPoint(1.0f, 0xD0F0FF);
+            } else {
+                gradient.addPoint(0.3f, 0x005010);
+                gradient.addPoint(0.6f, 0x10C030);
+                gradient.addPoint(0.85f, 0x80FF40);
+                gradient.addPoint(1.0f, 0xE0FFB0);
+            }
+            return gradient.bake();
+        }
+    }
+
+    FireState::FireState(Strip::PixelIndex length, const std::vector<float> &weights) :
+        _length(std::max<Strip::PixelIndex>(0, length)),
+        temperature(std::make_unique<Heat[]>(_length)),
+        prev_temperature(std::make_unique<Heat[]>(_length)) {
+        std::fill(temperature.get(), temperature.get() + _length, 0);
+        std::fill(prev_temperature.get(), prev_temperature.get() + _length, 0);
+
+        // Pixels near the bottom have fewer pixels below them; each gets a
+        // kernel of just those weights, normalized on its own
+        for (size_t reach = 1; reach <= weights.size(); reach++) {
+            kernel_start.push_back(kernels.size());
+            float total = 0.0f;
+            for (size_t w = 0; w < reach; w++) {
+                total += std::max(0.0f, weights[w]);
+            }
+            if (total <= 0.0f) {
+                kernels.insert(kernels.end(), reach, 0);
+                continue;
+            }
+            Heat sum = 0;
+            size_t largest = kernels.size();
+            for (size_t w = 0; w < reach; w++) {
+                auto share = static_cast<Heat>(std::max(0.0f, weights[w]) / total * ONE);
+                kernels.push_back(share);
+                sum += share;
+                if (share > kernels[largest]) {
+                    largest = kernels.size() - 1;
+                }
+            }
+            // rounding leftovers go to the largest weight, so the kernel sums to ONE exactly
+            kernels[largest] += ONE - sum;
+        }
     }
 
     Strip::PixelIndex FireState::length() const {
@@ -23,104 +86,168 @@ namespace Show {
     }
 
     void FireState::cooldown(float value) {
+        Heat loss = toHeat(value);
         for (Strip::PixelIndex i = 0; i < length(); i++) {
-            temperature[i] = std::max(0.0f, temperature[i] - value);
+            temperature[i] = std::max<Heat>(0, temperature[i] - loss);
         }
     }
 
-    void FireState::spread(float spread_rate, float ignition, Strip::PixelIndex spark_range, float spark_amount,
-                           const std::vector<float> &weights) {
+    void FireState::spread(const uint32_t *noise, float spread_rate) {
         // Copy current state to previous buffer for consistent reads during this frame
         std::copy(temperature.get(), temperature.get() + length(), prev_temperature.get());
 
-        for (Strip::PixelIndex i = 0; i < length(); i++) {
-            float weighted_previous = 0.0f;
-            float available_energy = 0.0f;
-            float local_total_weight = 0.0f;
-
-            for (size_t w_idx = 0; w_idx < weights.size(); ++w_idx) {
-                int prev_idx = i - 1 - (int) w_idx;
-                if (prev_idx >= 0) {
-                    local_total_weight += weights[w_idx];
-                }
-            }
+        // spread rate in 1/256, so every product below fits 32 bits
+        auto rate = static_cast<uint32_t>(std::min(65535L, std::max(0L, std::lround(spread_rate * 256.0f))));
+        size_t weight_count = kernel_start.size();
 
-            if (local_total_weight > 0) {
-                for (size_t w_idx = 0; w_idx < weights.size(); ++w_idx) {
-                    int prev_idx = i - 1 - (int) w_idx;
-                    if (prev_idx >= 0) {
-                        float w = weights[w_idx] / local_total_weight;
-                        // Read from previous frame snapshot
-                        weighted_previous += prev_temperature[prev_idx] * w;
-                        available_energy += prev_temperature[prev_idx];
-                    }
-                }
+        for (Strip::PixelIndex i = 1; i < length(); i++) {
+            size_t reach = std::min<size_t>(i, weight_count);
+            if (reach == 0) {
+                break;
+            }
+            const Heat *kernel = &kernels[kernel_start[reach - 1]];
+
+            int64_t weighted_previous = 0;
+            int64_t available_energy = 0;
+            for (size_t w = 0; w < reach; w++) {
+                // Read from previous frame snapshot
+                Heat below = prev_temperature[i - 1 - w];
+                weighted_previous += static_cast<int64_t>(below) * kernel[w];
+                available_energy += below;
+            }
+            weighted_previous >>= HEAT_BITS;
+            if (weighted_previous <= 0) {
+                continue;
             }
 
-            auto spread_value = std::min(MAX_SPREAD_PER_FRAME, weighted_previous) * spread_rate * randomFloat();
-            // We can't take more than what's available in any of the contributing pixels if we want to be safe,
-            // but the weighted_previous already gives us a good limit.
+            auto limited = static_cast<uint32_t>(std::min<int64_t>(MAX_SPREAD_PER_FRAME, weighted_previous));
+            auto spread_value = static_cast<Heat>((limited * (noise[i] >> 16) >> 16) * rate >> 8);
             // To ensure energy conservation, we must ensure spread_amount <= sum of contributing temperatures.
-            auto spread_amount = std::min(available_energy, spread_value);
-
-            if (spread_amount > 0) {
-                temperature[i] += spread_amount;
-                for (size_t w_idx = 0; w_idx < weights.size(); ++w_idx) {
-                    int prev_idx = i - 1 - (int) w_idx;
-                    if (prev_idx >= 0) {
-                        float w = weights[w_idx] / local_total_weight;
-                        temperature[prev_idx] -= spread_amount * w;
-                    }
-                }
+            auto spread_amount = static_cast<Heat>(std::min<int64_t>(available_energy, spread_value));
+            if (spread_amount <= 0) {
+                continue;
             }
 
-            if (i < spark_range && randomFloat() <= ignition) {
-                temperature[i] += spark_amount;
+            // the pixel gains exactly the sum of what the pixels below give
+            Heat moved = 0;
+            for (size_t w = 0; w < reach; w++) {
+                auto part = static_cast<Heat>(static_cast<int64_t>(spread_amount) * kernel[w] >> HEAT_BITS);
+                temperature[i - 1 - w] -= part;
+                moved += part;
+            }
+            temperature[i] = std::min(MAX_HEAT, temperature[i] + moved);
+        }
+    }
+
+    void FireState::ignite(const uint32_t *noise, float ignition, Strip::PixelIndex spark_range, float spark_amount,
+                           const std::vector<Strip::PixelIndex> &sources) {
+        // a spark when the random word is below the chance in 1/2^32
+        auto chance = static_cast<uint64_t>(std::min(1.0f, std::max(0.0f, ignition)) * 4294967296.0);
+        Heat spark = toHeat(spark_amount);
+        for (Strip::PixelIndex source: sources) {
+            for (Strip::PixelIndex j = 0; j < spark_range; j++, noise++) {
+                Strip::PixelIndex pixel = source + j;
+                if (pixel >= 0 && pixel < length() && *noise < chance) {
+                    temperature[pixel] = std::min(MAX_HEAT, temperature[pixel] + spark);
+                }
             }
         }
     }
 
     float FireState::get_temperature(Strip::PixelIndex pixel_index) const {
+        return static_cast<float>(heat(pixel_index)) / ONE;
+    }
+
+    void FireState::set_temperature(Strip::PixelIndex pixel_index, float value) {
+        if (pixel_index >= 0 && pixel_index < length()) {
+            temperature[pixel_index] = toHeat(value);
+        }
+    }
+
+    FireState::Heat FireState::heat(Strip::PixelIndex pixel_index) const {
         if (pixel_index < 0 || pixel_index >= length()) {
-            return 0.0f;
+            return 0;
         }
         return temperature[pixel_index];
     }
 
-    void FireState::set_temperature(Strip::PixelIndex pixel_index, float value) {
-        if (pixel_index >= 0 && pixel_index < length()) {
-            temperature[pixel_index] = value;
+    int64_t FireState::total() const {
+        int64_t sum = 0;
+        for (Strip::PixelIndex i = 0; i < length(); i++) {
+            sum += temperature[i];
         }
+        return sum;
     }
 
 
+    Fire::Fuel Fire::fuelFromName(const char *name) {
+        if (name == nullptr) {
+            return Fuel::WOOD;
+        }
+        if (strcmp(name, "gas") == 0) {
+            return Fuel::GAS;
+        }
+        if (strcmp(name, "chemical") == 0) {
+            return Fuel::CHEMICAL;
+        }
+        return Fuel::WOOD;
+    }
+
     Fire::Fire(float cooling, float spread, float ignition, float spark_amount, std::vector<float> weights,
-                Strip::PixelIndex start_offset, Strip::PixelIndex spark_range) :
+                Strip::PixelIndex start_offset, Strip::PixelIndex spark_range, Fuel fuel,
+                std::vector<Strip::PixelIndex> sources, uint32_t seed, const std::vector<Strip::Color> &palette) :
+        gen(seed),
+        palette(palette.empty() ? bake(fuel) : Support::Gradients::bake(palette)),
         cooling(cooling),
         spread(spread), ignition(ignition), spark_amount(spark_amount),
         weights(std::move(weights)),
         start_offset(start_offset),
-        spark_range(spark_range),
-        randomFloat(0.0f, 1.0f) {
-        gen.seed(Support::randomSeed());
+        spark_range(std::max<Strip::PixelIndex>(0, spark_range)),
+        sources(std::move(sources)) {
     }
 
     void Fire::ensureState(Strip::Strip &strip) {
         if (!state || state->length() != strip.length() + start_offset) {
-            state = std::make_unique<FireState>([this] { return randomFloat(gen); }, strip.length() + start_offset);
+            state = std::make_unique<FireState>(strip.length() + start_offset, weights);
+            noise_length = state->length() + sources.size() * spark_range;
+            noise = std::make_unique<uint32_t[]>(noise_length);
         }
     }
 
     void Fire::execute(Strip::Strip &strip, [[maybe_unused]] Iteration iteration) {
         ensureState(strip);
 
-        state->cooldown(cooling * randomFloat(gen));
+        state->cooldown(cooling * gen.nextFloat());
 
-        state->spread(spread, ignition, spark_range, spark_amount, weights);
+        gen.fill(noise.get(), noise_length);
+        state->spread(noise.get(), spread);
+        state->ignite(noise.get() + state->length(), ignition, spark_range, spark_amount, sources);
 
         for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
             // Mapping strip index i to state index i + start_offset
-            strip.setPixelColor(i, Support::Color::black_body_color(state->get_temperature(i + start_offset)));
+            strip.setPixelColor(i, colorOf(state->heat(i + start_offset)));
+        }
+    }
+
+    Strip::Color Fire::colorOf(FireState::Heat heat) const {
+        if (heat <= 0) {
+            return palette[0];
+        }
+        return palette[std::min<FireState::Heat>(255, heat >> (FireState::HEAT_BITS - 8))];
+    }
+
+    bool Fire::setParameter(const char *name, float value) {
+        if (strcmp(name, "cooling") == 0) {
+            cooling = value;
+        } else if (strcmp(name, "spread") == 0) {
+            spread = value;
+        } else if (strcmp(name, "ignition") == 0) {
+            ignition = value;
+        } else if (strcmp(name, "spark_amount") == 0) {
+            spark_amount = value;
+        } else {
+            return false;
         }
+        return true;
     }
 } // Show
@@ -1,23 +1,34 @@
 #ifndef LEDZ_FIRE_H
 #define LEDZ_FIRE_H
-#include <random>
-#include <functional>
+#include <array>
 #include <memory>
 
 #include <vector>
 #include "Show.h"
+#include "support/Palette.h"
 #include "support/Random.h"
 
 namespace Show {
+    /**
+     * Heat of every pixel of a fire, in fixed point. Heat rises: each frame
+     * a pixel draws heat from the pixels below it, weighted by a kernel that
+     * is normalized once up front (including the shorter kernels at the
+     * bottom end). What a pixel gains is exactly what the pixels below lose,
+     * so spreading never creates or destroys heat - unless a pixel is at
+     * MAX_HEAT, where sparks and rising heat saturate instead of overflowing.
+     */
     class FireState {
-        Strip::PixelIndex _length;
-        std::function<float()> randomFloat;
-        std::unique_ptr<float[]> temperature;
-        std::unique_ptr<float[]> prev_temperature;
-
     public:
-        explicit FireState(std::function<float()> randomFloat,
-                  Strip::PixelIndex length);
+        using Heat = int32_t;
+        static constexpr int HEAT_BITS = 16;
+        static constexpr Heat ONE = 1 << HEAT_BITS; // full heat, white hot for the palette
+        static constexpr Heat MAX_HEAT = ONE << 8; // far above white hot, with room for a sum over the kernel
+
+        /**
+         * @param length Number of pixels
+         * @param weights Weights of the pixels 1, 2, ... below each pixel
+         */
+        explicit FireState(Strip::PixelIndex length, const std::vector<float> &weights = {1.0f});
 
         ~FireState() = default;
         FireState(const FireState&) = delete;
@@ -29,17 +40,103 @@ namespace Show {
 
         void cooldown(float value);
 
-        void spread(float spread_rate, float ignition, Strip::PixelIndex spark_range, float spark_amount,
-                    const std::vector<float> &weights = {1.0f});
+        /**
+         * Move heat up the strip
+         * @param noise One random word per pixel for this frame
+         * @param spread_rate Share of the heat below that moves up per frame
+         */
+        void spread(const uint32_t *noise, float spread_rate);
+
+        /**
+         * Add sparks above each source
+         * @param noise One random word per source and pixel of spark_range
+         * @param ignition Chance of a spark per pixel, 0 - 1
+         * @param spark_range Number of pixels above each source that can ignite
+         * @param spark_amount Heat of a spark
+         * @param sources Pixels the sparks start from
+         */
+        void ignite(const uint32_t *noise, float ignition, Strip::PixelIndex spark_range, float spark_amount,
+                    const std::vector<Strip::PixelIndex> &sources = {0});
 
         float get_temperature(Strip::PixelIndex pixel_index) const;
         void set_temperature(Strip::PixelIndex pixel_index, float value);
+
+        /**
+         * @return Heat of a pixel in 1/ONE, 0 outside the fire
+         */
+        Heat heat(Strip::PixelIndex pixel_index) const;
+
+        /**
+         * @return Heat of all pixels together in 1/ONE
+         */
+        int64_t total() const;
+
+    private:
+        Strip::PixelIndex _length;
+        std::unique_ptr<Heat[]> temperature;
+        std::unique_ptr<Heat[]> prev_temperature;
+        // kernels for 1 to weight_count pixels below, each summing to ONE (or
+        // all zero), stored one after the other
+        std::vector<Heat> kernels;
+        std::vector<size_t> kernel_start;
     };
 
     class Fire : public Show {
+    public:
+        /**
+         * What the flames look like: a 256 step palette from cold to hot
+         */
+        enum class Fuel {
+            WOOD, // black body glow, red to yellow
+            GAS, // blue flames with a pale core
+            CHEMICAL // green flames, like copper or boric acid
+        };
+
+        /**
+         * @param name "wood", "gas" or "chemical"
+         * @return Matching fuel, WOOD if unknown
+         */
+        static Fuel fuelFromName(const char *name);
+
+        /**
+         * @param cooling Heat lost per frame, at most
+         * @param spread Share of the heat below that moves up per frame
+         * @param ignition Chance of a spark per pixel above a source
+         * @param spark_amount Heat of a spark
+         * @param weights Weights of the pixels 1, 2, ... below each pixel
+         * @param start_offset Pixels of fire below the strip, so the flames are formed when they show
+         * @param spark_range Number of pixels above each source that can ignite
+         * @param fuel Palette of the flames
+         * @param sources Pixels of the fire (start_offset below the strip start) where sparks start
+         * @param seed Seed of the flicker
+         * @param palette Colors from cold to hot, in place of the fuel's; empty for the fuel
+         */
+        Fire(float cooling = 0.1f, float spread = 10.0f, float ignition = .5f, float spark_amount = 0.5f,
+             std::vector<float> weights = {1.0f}, Strip::PixelIndex start_offset = 5,
+             Strip::PixelIndex spark_range = 5, Fuel fuel = Fuel::WOOD,
+             std::vector<Strip::PixelIndex> sources = {0}, uint32_t seed = Support::randomSeed(),
+             const std::vector<Strip::Color> &palette = {});
+
+        void ensureState(Strip::Strip &strip);
+
+        void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        /**
+         * cooling, spread, ignition and spark_amount
+         */
+        bool setParameter(const char *name, float value) override;
+
+        /**
+         * @return Color of a heat in 1/FireState::ONE, from the baked palette
+         */
+        Strip::Color colorOf(FireState::Heat heat) const;
+
+    private:
         std::unique_ptr<FireState> state;
         Support::Random gen;
-        std::uniform_real_distribution<float> randomFloat;
+        std::unique_ptr<uint32_t[]> noise; // filled in one go every frame
+        size_t noise_length = 0;
+        Support::Palette::Table palette;
 
         float cooling;
         float spread;
@@ -48,15 +145,7 @@ namespace Show {
         std::vector<float> weights;
         Strip::PixelIndex start_offset;
         Strip::PixelIndex spark_range;
-
-    public:
-        Fire(float cooling = 0.1f, float spread = 10.0f, float ignition = .5f, float spark_amount = 0.5f,
-             std::vector<float> weights = {1.0f}, Strip::PixelIndex start_offset = 5,
-             Strip::PixelIndex spark_range = 5);
-
-        void ensureState(Strip::Strip &strip);
-
-        void execute(Strip::Strip &strip, Iteration iteration) override;
+        std::vector<Strip::PixelIndex> sources;
     };
 } // Show
 
@@ -1,48 +1,101 @@
 #include "Jump.h"
 
+#include <algorithm>
 #include <cmath>
 #ifdef ARDUINO
 #include <USBCDC.h>
 #endif
 
 namespace Show {
-    void Jump::execute(Strip::Strip &strip, Iteration iteration) {
-        strip.fill(0x000000);
-
-        for (Ball &ball: balls) {
-            auto pos = ball.get_position(iteration, strip.length());
-            strip.setPixelColor(pos, ball.get_color());
+    namespace {
+        // 0.02 pixel per frame squared, the curvature of the original parabola
+        constexpr Support::Particles::Velocity GRAVITY = -1311;
+    }
 
-            if (ball.is_next()) {
-                ball.swap_color(spare_colors);
+    void Jump::execute(Strip::Strip &strip, Iteration iteration) {
+        if (strip.length() != length || iteration != last_iteration + 1) {
+            // new strip or a jump in time: put every ball where it is due
+            length = strip.length();
+            particles.clear();
+            for (Ball &ball: balls) {
+                ball.bounce(iteration, length);
+                launch(ball, iteration);
+            }
+        } else {
+            for (Ball &ball: balls) {
+                if (ball.bounce(iteration, length)) {
+                    ball.swap_color(spare_colors);
+                    launch(ball, iteration);
+                }
             }
         }
+        last_iteration = iteration;
+
+        strip.fill(0x000000);
+        particles.step(strip, static_cast<uint32_t>(iteration), Support::Particles::Edge::CLAMP);
     }
 
-    Jump::Jump() {
+    void Jump::launch(Ball &ball, Iteration iteration) {
+        unsigned int period_length = ball.get_period_length(length);
+        auto birth = static_cast<uint32_t>(iteration - iteration % period_length);
+        // thrown up just fast enough to land again after one period
+        Support::Particles::Velocity velocity = -GRAVITY * static_cast<int32_t>(period_length) / 2;
+        particles.spawn(0, velocity, GRAVITY, ball.get_color(), period_length, birth);
+    }
+
+    // a ball's next flight is launched while the last one is still in the
+    // pool, it expires in the step that draws the new one
+    Jump::Jump() : particles(2 * sizeof(balls) / sizeof(balls[0])) {
         spare_colors.push(0xffff00);
     }
 
     Jump::Ball::Ball(const float peak_factor, Strip::Color color) : peak_factor(peak_factor), color(color) {
     }
 
-
-    Strip::PixelIndex Jump::Ball::get_position(Iteration iteration, Strip::PixelIndex stripe_size) {
+    void Jump::Ball::resize(Strip::PixelIndex stripe_size) {
+        if (stripe_size == this->stripe_size) {
+            return;
+        }
+        this->stripe_size = stripe_size;
         auto factor = 10.0f;
-        float amplitude = peak_factor * stripe_size;
+        amplitude = peak_factor * stripe_size;
         auto duration = 2.0f * std::sqrt(amplitude) * factor;
-        auto center = duration / 2.0f;
-        auto period_length = static_cast<uint>(duration);
-        unsigned int current_period = iteration / period_length;
+        center = duration / 2.0f;
+        period_length = std::max(1u, static_cast<unsigned int>(duration));
+    }
 
-        if (period != current_period && !next) {
-            period = current_period;
-            next = true;
-        }
+    float Jump::Ball::height(Iteration iteration, Strip::PixelIndex stripe_size) {
+        bounce(iteration, stripe_size);
 
         unsigned int position = iteration % period_length;
+        float distance = (position - center) / 10.0f;
+
+        return amplitude - distance * distance;
+    }
+
+    Strip::PixelIndex Jump::Ball::get_position(Iteration iteration, Strip::PixelIndex stripe_size) {
+        return static_cast<Strip::PixelIndex>(height(iteration, stripe_size));
+    }
+
+    Support::Draw::Position Jump::Ball::get_subpixel_position(Iteration iteration, Strip::PixelIndex stripe_size) {
+        // bounce on pixel 0 and peak at most on the last pixel
+        float top = static_cast<float>(stripe_size - 1);
+        return Support::Draw::fromPixels(std::min(top, std::max(0.0f, height(iteration, stripe_size))));
+    }
 
-        return static_cast<Strip::PixelIndex>(amplitude - std::pow((position - center) / factor, 2));
+    unsigned int Jump::Ball::get_period_length(Strip::PixelIndex stripe_size) {
+        resize(stripe_size);
+        return period_length;
+    }
+
+    bool Jump::Ball::bounce(Iteration iteration, Strip::PixelIndex stripe_size) {
+        resize(stripe_size);
+        unsigned int current_period = iteration / period_length;
+        if (current_period == period) {
+            return false;
+        }
+        period = current_period;
+        return true;
     }
 
     void Jump::Ball::swap_color(std::queue<Strip::Color> &colors) {
@@ -52,14 +105,6 @@ namespace Show {
         colors.pop();
     }
 
-    bool Jump::Ball::is_next() {
-        if (next) {
-            next = false;
-            return true;
-        }
-        return false;
-    }
-
     unsigned int Jump::Ball::get_period() const {
         return period;
     }
@@ -5,24 +5,59 @@
 
 #include "Show.h"
 #include "strip/Strip.h"
+#include "support/Draw.h"
+#include "support/Particles.h"
 
 namespace Show {
+    /**
+     * Balls bounce along the strip, each one a particle thrown up under constant
+     * gravity at every bounce.
+     */
     class Jump : public Show {
     public:
         class Ball {
             const float peak_factor;
             Strip::Color color;
             unsigned int period = 0;
-            bool next = false;
+
+            // flight constants for the strip length they were computed for
+            Strip::PixelIndex stripe_size = 0;
+            float amplitude = 0;
+            float center = 0;
+            unsigned int period_length = 1;
+
+            void resize(Strip::PixelIndex stripe_size);
+
+            float height(Iteration iteration, Strip::PixelIndex stripe_size);
 
         public:
             Ball(float peak_factor, Strip::Color color);
 
             Strip::PixelIndex get_position(Iteration iteration, Strip::PixelIndex stripe_size);
 
-            void swap_color(std::queue<Strip::Color> &colors);
+            /**
+             * Height of the ball in 1/256 pixel
+             * @param iteration Frame counter
+             * @param stripe_size Number of pixels
+             * @return Sub-pixel position, truncated by get_position()
+             */
+            Support::Draw::Position get_subpixel_position(Iteration iteration, Strip::PixelIndex stripe_size);
+
+            /**
+             * Number of frames from one bounce to the next
+             * @param stripe_size Number of pixels
+             */
+            unsigned int get_period_length(Strip::PixelIndex stripe_size);
 
-            bool is_next();
+            /**
+             * Track the bounce count
+             * @param iteration Frame counter
+             * @param stripe_size Number of pixels
+             * @return true if the ball bounced since the last call
+             */
+            bool bounce(Iteration iteration, Strip::PixelIndex stripe_size);
+
+            void swap_color(std::queue<Strip::Color> &colors);
 
             unsigned int get_period() const;
 
@@ -40,10 +75,21 @@ namespace Show {
 
         std::queue<Strip::Color> spare_colors;
 
+        Support::Particles particles;
+        Strip::PixelIndex length = 0;
+        Iteration last_iteration = 0;
+
+        void launch(Ball &ball, Iteration iteration);
+
     public:
         Jump();
 
         void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        /**
+         * @return Number of balls drawn by the last execute()
+         */
+        Support::Particles::Index ballsInFlight() const { return particles.size(); }
     };
 } // Show
 
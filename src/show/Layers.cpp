@@ -0,0 +1,82 @@
+#include "Layers.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+namespace Show {
+    namespace {
+        // Exponential moving average over ~16 frames
+        void average(uint32_t &avg, uint32_t sample) {
+            avg = static_cast<uint32_t>(static_cast<int32_t>(avg) + (static_cast<int32_t>(sample - avg) >> 4));
+        }
+    }
+
+    bool Layers::addLayer(std::unique_ptr<Show> show, const char *name, Support::Blend::Mode mode,
+                          uint8_t opacity) {
+        if (!show || layers.size() >= MAX_LAYERS) {
+            return false;
+        }
+        Layer layer{std::move(show), mode, opacity, Strip::Buffer(), LayerTiming{}};
+        strncpy(layer.timing.name, name, sizeof(layer.timing.name) - 1);
+        layer.timing.name[sizeof(layer.timing.name) - 1] = '\0';
+        layers.push_back(std::move(layer));
+        return true;
+    }
+
+    void Layers::execute(Strip::Strip &strip, Iteration iteration) {
+        Strip::PixelIndex length = strip.length();
+        composite.resize(length);
+        composite.fill(0x000000);
+
+        for (auto &layer: layers) {
+            layer.canvas.resize(length);
+
+            unsigned long start = micros();
+            layer.show->execute(layer.canvas, iteration);
+            unsigned long rendered = micros();
+            Support::Blend::composite(layer.mode, layer.canvas.data(), composite.data(), length, layer.opacity);
+            unsigned long blended = micros();
+
+            average(layer.timing.render_us, rendered - start);
+            average(layer.timing.blend_us, blended - rendered);
+        }
+
+        composite.copyTo(strip);
+    }
+
+    bool Layers::isComplete() const {
+        for (const auto &layer: layers) {
+            if (!layer.show->isComplete()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Layers::setParameter(const char *name, float value) {
+        const char *dot = strchr(name, '.');
+        bool found = false;
+        for (auto &layer: layers) {
+            if (dot == nullptr) {
+                found |= layer.show->setParameter(name, value);
+            } else if (strlen(layer.timing.name) == static_cast<size_t>(dot - name) &&
+                       strncmp(layer.timing.name, name, dot - name) == 0) {
+                found |= layer.show->setParameter(dot + 1, value);
+            }
+        }
+        return found;
+    }
+
+    size_t Layers::layerTimings(LayerTiming *timings, size_t max) const {
+        size_t count = std::min(max, layers.size());
+        for (size_t i = 0; i < count; i++) {
+            timings[i] = layers[i].timing;
+        }
+        return count;
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef LEDZ_LAYERS_H
+#define LEDZ_LAYERS_H
+
+#include <memory>
+#include <vector>
+
+#include "Show.h"
+#include "strip/Buffer.h"
+#include "support/Blend.h"
+
+namespace Show {
+    /**
+     * Layers - Stacks several shows and composites them with blend modes
+     *
+     * Each layer renders into its own offscreen buffer, so shows that rely on
+     * the strip keeping their last frame (e.g. Solid once its blend is done)
+     * behave as they do on a real strip. The layers are then combined bottom
+     * to top onto black with their blend mode and opacity.
+     */
+    class Layers : public Show {
+    public:
+        static constexpr size_t MAX_LAYERS = 4;
+
+        /**
+         * Add a layer on top of the stack
+         * @param show Show rendering the layer
+         * @param name Label reported in the stats
+         * @param mode How the layer combines with the layers below
+         * @param opacity Layer opacity (0-255)
+         * @return false if the stack is full
+         */
+        bool addLayer(std::unique_ptr<Show> show, const char *name, Support::Blend::Mode mode, uint8_t opacity);
+
+        size_t size() const { return layers.size(); }
+
+        void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        /**
+         * @return true once every layer is static
+         */
+        bool isComplete() const override;
+
+        size_t layerTimings(LayerTiming *timings, size_t max) const override;
+
+        /**
+         * @param name "layer.parameter" for the layer of that name, a plain
+         * parameter name for every layer that has it
+         */
+        bool setParameter(const char *name, float value) override;
+
+    private:
+        struct Layer {
+            std::unique_ptr<Show> show;
+            Support::Blend::Mode mode;
+            uint8_t opacity;
+            Strip::Buffer canvas;
+            LayerTiming timing;
+        };
+
+        std::vector<Layer> layers;
+        Strip::Buffer composite;
+    };
+}
+
+#endif //LEDZ_LAYERS_H
@@ -1,70 +1,154 @@
-#include <sstream>
-
 #include "Mandelbrot.h"
-#include "../Log.h"
 
-#ifdef ARDUINO
-#include <USBCDC.h>
-#endif
+#include <cmath>
+#include <cstring>
 
 #include "color.h"
-
-static const char* TAG = "show";
+#include "support/Blend.h"
+#include "support/Gradients.h"
 
 namespace Show {
-    std::tuple<float, float> Mandelbrot::func(float zre, float zim, float cre, float cim) {
-        // z_n+1 = z_n^2 + c
-        return std::make_tuple<float, float>(zre * zre - zim * zim + cre, 2 * zre * zim + cim);
+    namespace {
+        // |z|^2 beyond which a point escapes; large enough for the smooth
+        // escape time to be continuous
+        constexpr float BAILOUT = 256.0f;
+        constexpr int64_t FIXED_BAILOUT = static_cast<int64_t>(BAILOUT) << Mandelbrot::FIXED_BITS;
+
+        // orbits closer than this to the remembered point are taken as cycles
+        constexpr float CYCLE_EPSILON = 1e-6f;
+
+        // first periodicity check after this many iterations, then twice as long each time
+        constexpr unsigned int FIRST_CHECK = 8;
+
+        // log2 from the float's exponent and a quadratic through the mantissa;
+        // within 0.01 and continuous, plenty for picking a color
+        float fastLog2(float value) {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            auto exponent = static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+            bits = (bits & 0x007FFFFF) | 0x3F800000;
+            float fraction;
+            memcpy(&fraction, &bits, sizeof(fraction));
+            fraction -= 1.0f;
+            return exponent + fraction * (1.3465f - 0.3465f * fraction);
+        }
+
+        float smoothTime(unsigned int k, float magnitude_squared) {
+            // k + 1 - log2(ln |z|), which rises continuously across iteration
+            // boundaries; ln |z| = log2(|z|^2) * ln(2) / 2
+            float smooth = static_cast<float>(k) + 1.0f - fastLog2(fastLog2(magnitude_squared) * 0.34657359f);
+            return smooth > 0.0f ? smooth : 0.0f;
+        }
+
+        int32_t toFixed(float value) {
+            return static_cast<int32_t>(std::lround(value * (1 << Mandelbrot::FIXED_BITS)));
+        }
     }
 
     Mandelbrot::Mandelbrot(float cReMin, float cImMin, float cImMax, unsigned int scale,
-                           unsigned int max_iterations, unsigned int colorScale) : c_re_min(cReMin),
-        c_im_min(cImMin), c_im_max(cImMax), scale(scale), max_iterations(max_iterations), color_scale(colorScale) {
+                           unsigned int max_iterations, unsigned int colorScale, bool fixed_point,
+                           const std::vector<Strip::Color> &palette) : c_re_min(cReMin),
+        c_im_min(cImMin), c_im_max(cImMax), scale(scale), max_iterations(max_iterations), color_scale(colorScale),
+        fixed_point(fixed_point) {
+        // the palette wraps around: the last color blends back into the first
+        colors = palette.empty() ? WHEEL_TABLE : Support::Gradients::bakeCyclic(palette);
     }
 
-    void Mandelbrot::log_result(unsigned long long j, float cre) {
-        std::stringstream ss;
-        ss << j << "(" << cre << ") [" << c_im_min << ", " << c_im_max << "], " << max_iterations;
-        ESP_LOGD(TAG, "%s", ss.str().c_str());
+    bool Mandelbrot::inMainBulbs(float cre, float cim) {
+        float cim2 = cim * cim;
+        // main cardioid
+        float x = cre - 0.25f;
+        float q = x * x + cim2;
+        if (q * (q + x) <= 0.25f * cim2) {
+            return true;
+        }
+        // period-2 bulb: the disk of radius 1/4 around -1
+        float y = cre + 1.0f;
+        return y * y + cim2 <= 0.0625f;
     }
 
-    void Mandelbrot::execute(Strip::Strip &strip, Iteration iteration) {
-        float cDelta = abs(c_im_max - c_im_min) / strip.length();
-
-        auto j = iteration % (strip.length() * scale);
-        float cre = c_re_min + (cDelta / scale) * j;
-
-        unsigned int line_max_iterations = 0;
+    Mandelbrot::Escape Mandelbrot::escape(float cre, float cim) const {
+        if (inMainBulbs(cre, cim)) {
+            return {true, 0.0f, 0};
+        }
 
-        for (unsigned int i = 0; i < strip.length(); i++) {
-            float cim = c_im_min + cDelta * i;
+        float zre = 0.0f, zim = 0.0f;
+        float zre2 = 0.0f, zim2 = 0.0f;
+        float cycle_re = 0.0f, cycle_im = 0.0f;
+        unsigned int check = FIRST_CHECK;
+        for (unsigned int k = 0; k < max_iterations; k++) {
+            // z_n+1 = z_n^2 + c
+            zim = 2.0f * zre * zim + cim;
+            zre = zre2 - zim2 + cre;
+            zre2 = zre * zre;
+            zim2 = zim * zim;
+            if (zre2 + zim2 > BAILOUT) {
+                return {false, smoothTime(k, zre2 + zim2), k + 1};
+            }
 
-            float zre = 0.0, zim = 0.0;
+            if (std::fabs(zre - cycle_re) < CYCLE_EPSILON && std::fabs(zim - cycle_im) < CYCLE_EPSILON) {
+                return {true, 0.0f, k + 1};
+            }
+            if (k + 1 == check) {
+                cycle_re = zre;
+                cycle_im = zim;
+                check *= 2;
+            }
+        }
+        return {true, 0.0f, max_iterations};
+    }
 
-            unsigned int iterations = max_iterations;
-            for (int k = 0; k < max_iterations; k++) {
-                auto [zre1, zim1] = func(zre, zim, cre, cim);
-                zre = zre1;
-                zim = zim1;
+    Mandelbrot::Escape Mandelbrot::escapeFixed(float cre, float cim) const {
+        if (inMainBulbs(cre, cim)) {
+            return {true, 0.0f, 0};
+        }
 
-                if (zre * zre + zim * zim > 10) {
-                    iterations = k;
-                    break;
-                }
+        const int32_t c_re = toFixed(cre);
+        const int32_t c_im = toFixed(cim);
+        int32_t zre = 0, zim = 0;
+        int64_t zre2 = 0, zim2 = 0;
+        int32_t cycle_re = 0, cycle_im = 0;
+        unsigned int check = FIRST_CHECK;
+        for (unsigned int k = 0; k < max_iterations; k++) {
+            // |z|^2 <= BAILOUT here, so the new z stays within +-512
+            zim = static_cast<int32_t>((static_cast<int64_t>(zre) * zim) >> (FIXED_BITS - 1)) + c_im;
+            zre = static_cast<int32_t>(zre2 - zim2) + c_re;
+            zre2 = (static_cast<int64_t>(zre) * zre) >> FIXED_BITS;
+            zim2 = (static_cast<int64_t>(zim) * zim) >> FIXED_BITS;
+            if (zre2 + zim2 > FIXED_BAILOUT) {
+                return {false, smoothTime(k, static_cast<float>(zre2 + zim2) / (1 << FIXED_BITS)), k + 1};
             }
 
-            Strip::Color color;
-            if (iterations < max_iterations) {
-                color = wheel((iterations * color_scale) % 255);
-            } else {
-                color = 0x000000;
+            // integer orbits repeat exactly once they settle into a cycle
+            if (zre == cycle_re && zim == cycle_im) {
+                return {true, 0.0f, k + 1};
+            }
+            if (k + 1 == check) {
+                cycle_re = zre;
+                cycle_im = zim;
+                check *= 2;
             }
+        }
+        return {true, 0.0f, max_iterations};
+    }
 
-            strip.setPixelColor(i, color);
+    Strip::Color Mandelbrot::colorOf(float smooth) const {
+        // palette position in 1/256 steps: the whole part picks two neighbours, the rest mixes them
+        auto position = static_cast<uint32_t>(smooth * static_cast<float>(color_scale) * 256.0f);
+        uint32_t index = position >> 8;
+        return Support::Blend::mix(colors[index & 0xFF], colors[(index + 1) & 0xFF], position & 0xFF);
+    }
 
-            line_max_iterations = std::max(line_max_iterations, iterations);
-        }
+    void Mandelbrot::execute(Strip::Strip &strip, Iteration iteration) {
+        float cDelta = std::fabs(c_im_max - c_im_min) / strip.length();
+
+        auto j = iteration % (strip.length() * scale);
+        float cre = c_re_min + (cDelta / scale) * j;
 
-        // log_result(j, cre);
+        for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+            float cim = c_im_min + cDelta * i;
+            Escape result = fixed_point ? escapeFixed(cre, cim) : escape(cre, cim);
+            strip.setPixelColor(i, result.inside ? 0x000000 : colorOf(result.smooth));
+        }
     }
 }
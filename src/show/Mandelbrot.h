@@ -1,25 +1,81 @@
 #ifndef LEDZ_MANDELBROT_H
 #define LEDZ_MANDELBROT_H
+#include <array>
+#include <vector>
+
 #include "strip/Strip.h"
 #include "Show.h"
 
 namespace Show {
+    /**
+     * Scans across the Mandelbrot set one vertical slice per frame.
+     *
+     * Points in the main cardioid and the period-2 bulb are recognized
+     * without iterating, and orbits that settle into a cycle are caught by
+     * Brent-style periodicity checks, so interior points rarely run to
+     * max_iterations. Escaping points are colored by their continuous
+     * (smooth) escape time through a palette, without banding.
+     */
     class Mandelbrot : public Show {
-        float c_re_min, c_im_min, c_im_max;
-        unsigned int scale;
-        unsigned int max_iterations;
-        unsigned int color_scale;
+    public:
+        /**
+         * Fractional bits of the fixed-point kernel: z up to +-512 in an int32
+         */
+        static constexpr int FIXED_BITS = 22;
 
-        std::tuple<float, float> func(float zre, float zim, float cre, float cim);
+        /**
+         * Outcome of iterating one point
+         */
+        struct Escape {
+            bool inside; // never escaped: in the set, or out of iterations
+            float smooth; // continuous escape time, 0 if inside
+            unsigned int iterations; // iterations actually run
+        };
 
-    public:
+        /**
+         * @param cReMin Real part of the first slice
+         * @param cImMin Imaginary part of the first pixel
+         * @param cImMax Imaginary part past the last pixel
+         * @param scale Frames per pixel width of the scan
+         * @param max_iterations Iterations before a point counts as inside
+         * @param colorScale Palette steps per escape iteration
+         * @param fixed_point Iterate in Q9.22 integers instead of floats
+         * @param palette Colors cycled through with rising escape time; empty for the color wheel
+         */
         Mandelbrot(float cReMin, float cImMin, float cImMax, unsigned int scale = 5, unsigned int max_iterations = 50,
-                   unsigned int colorScale = 10);
-
-        void log_result(unsigned long long j, float cre);
+                   unsigned int colorScale = 10, bool fixed_point = false,
+                   const std::vector<Strip::Color> &palette = {});
 
         void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        /**
+         * @return true if c lies in the main cardioid or the period-2 bulb
+         */
+        static bool inMainBulbs(float cre, float cim);
+
+        /**
+         * Iterate z = z^2 + c in floats
+         */
+        Escape escape(float cre, float cim) const;
+
+        /**
+         * Iterate z = z^2 + c in Q9.22 fixed point
+         */
+        Escape escapeFixed(float cre, float cim) const;
+
+        /**
+         * @return Palette color of a smooth escape time
+         */
+        Strip::Color colorOf(float smooth) const;
+
+    private:
+        float c_re_min, c_im_min, c_im_max;
+        unsigned int scale;
+        unsigned int max_iterations;
+        unsigned int color_scale;
+        bool fixed_point;
+        std::array<Strip::Color, 256> colors; // palette baked into a lookup table
     };
 }
 
-#endif //LEDZ_MANDELBROT_H
\ No newline at end of file
+#endif //LEDZ_MANDELBROT_H
@@ -2,6 +2,8 @@
 #include "../color.h"
 #include <algorithm>
 #include <cctype>
+#include <cmath>
+#include <numeric>
 
 namespace Show {
     // International Morse Code dictionary
@@ -63,7 +65,7 @@ namespace Show {
     }
 
     void MorseCode::buildPattern() {
-        pattern.clear();
+        const uint8_t dark = pattern.addColor(color(0, 0, 0));
 
         // Split message into words
         std::vector<std::string> words;
@@ -92,7 +94,7 @@ namespace Show {
         for (size_t word_idx = 0; word_idx < words.size(); word_idx++) {
             // Assign color from wheel based on word index
             uint8_t color_index = (uint8_t) ((word_idx * 255) / std::max(1, (int) words.size()));
-            Strip::Color word_color = wheel(color_index);
+            const uint8_t word_color = pattern.addColor(wheel(color_index));
 
             const std::string &word = words[word_idx];
 
@@ -107,37 +109,29 @@ namespace Show {
                 for (size_t symbol_idx = 0; morse[symbol_idx] != '\0'; symbol_idx++) {
                     // Add the symbol LEDs
                     unsigned int symbol_len = (morse[symbol_idx] == '.') ? dot_length : dash_length;
-                    for (unsigned int i = 0; i < symbol_len; i++) {
-                        pattern.push_back(word_color);
-                    }
+                    pattern.append(word_color, symbol_len);
 
                     // Add symbol space (except after last symbol in letter)
                     if (morse[symbol_idx + 1] != '\0') {
-                        for (unsigned int i = 0; i < symbol_space; i++) {
-                            pattern.push_back(color(0, 0, 0));
-                        }
+                        pattern.append(dark, symbol_space);
                     }
                 }
 
                 // Add letter space (except after last letter in word)
                 if (char_idx < word.length() - 1) {
-                    for (unsigned int i = 0; i < letter_space; i++) {
-                        pattern.push_back(color(0, 0, 0));
-                    }
+                    pattern.append(dark, letter_space);
                 }
             }
 
             // Add word space (except after last word)
             if (word_idx < words.size() - 1) {
-                for (unsigned int i = 0; i < word_space; i++) {
-                    pattern.push_back(color(0, 0, 0));
-                }
+                pattern.append(dark, word_space);
             }
         }
 
         // Ensure pattern is not empty
-        if (pattern.empty()) {
-            pattern.push_back(color(255, 255, 255));
+        if (pattern.length() == 0) {
+            pattern.append(pattern.addColor(color(255, 255, 255)), 1);
         }
     }
 
@@ -147,7 +141,8 @@ namespace Show {
                          unsigned int word_space)
         : message(message), speed(speed), dot_length(dot_length),
           dash_length(dash_length), symbol_space(symbol_space),
-          letter_space(letter_space), word_space(word_space), index(0) {
+          letter_space(letter_space), word_space(word_space),
+          speed_units(speed > 0.0f ? static_cast<uint32_t>(lroundf(speed * 256.0f)) : 0), index(0) {
         // Convert message to uppercase
         std::transform(this->message.begin(), this->message.end(),
                        this->message.begin(), ::toupper);
@@ -157,19 +152,21 @@ namespace Show {
     }
 
     void MorseCode::execute(Strip::Strip &strip, Iteration iteration) {
-        uint16_t num_leds = strip.length();
-        unsigned int pattern_length = pattern.size();
-
-        // Calculate scroll offset
-        unsigned int offset = (unsigned int) (index * speed) % pattern_length;
-
-        // Map pattern to strip with scrolling
-        for (uint16_t i = 0; i < num_leds; i++) {
-            unsigned int pattern_idx = (offset + i) % pattern_length;
-            strip.setPixelColor(i, pattern[pattern_idx]);
-        }
+        // Scroll offset in 1/256 LED
+        scroller.emit(strip, pattern, static_cast<uint64_t>(index) * speed_units);
 
         // Increment index for next frame
         index++;
     }
+
+    Iteration MorseCode::period() const {
+        static constexpr uint64_t MAX_PERIOD = 4096;
+        if (speed_units == 0) {
+            return 0;
+        }
+        // smallest P with P * speed a whole number of pattern lengths
+        uint64_t pattern_units = static_cast<uint64_t>(pattern.length()) * 256;
+        uint64_t frames = pattern_units / std::gcd(pattern_units, static_cast<uint64_t>(speed_units));
+        return frames <= MAX_PERIOD ? static_cast<Iteration>(frames) : 0;
+    }
 } // namespace Show
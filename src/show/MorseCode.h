@@ -2,13 +2,16 @@
 #define LEDZ_MORSECODE_H
 
 #include "Show.h"
+#include "support/Scroll.h"
 #include <vector>
 #include <string>
 
 namespace Show {
     /**
      * MorseCode - Scrolling International Morse Code text display
-     * Encodes text as dots and dashes with color-coded words
+     * Encodes text as dots and dashes with color-coded words. The message is
+     * kept as runs of colored and dark LEDs rather than one color per LED, and
+     * scrolls at sub-LED speeds by mixing neighbouring LEDs.
      */
     class MorseCode : public Show {
     private:
@@ -20,7 +23,9 @@ namespace Show {
         unsigned int letter_space; // Space between letters
         unsigned int word_space; // Space between words
 
-        std::vector<Strip::Color> pattern; // Precomputed color pattern
+        Support::Scroll::RunPattern pattern; // Runs of word colors and gaps
+        Support::Scroll::Scroller scroller;
+        uint32_t speed_units; // speed in 1/256 LED per frame
         unsigned int index; // Current frame index
 
         // Morse code encoding
@@ -54,6 +59,12 @@ namespace Show {
          */
         void execute(Strip::Strip &strip, Iteration iteration) override;
 
+        /**
+         * Frames until the scroll offset wraps around the pattern,
+         * 0 if that takes more than a few thousand frames
+         */
+        Iteration period() const override;
+
         const char *name() { return "MorseCode"; }
     };
 } // namespace Show
@@ -0,0 +1,54 @@
+#include "Noise.h"
+#include "support/Gradients.h"
+
+#include <cstring>
+
+namespace Show {
+    // fractal noise rarely leaves [-0.6, 0.6]; stretch it over the whole palette
+    static constexpr int32_t CONTRAST = 384;
+
+    static Support::Noise::Fixed pixelStep(float scale) {
+        return static_cast<Support::Noise::Fixed>(Support::Noise::ONE / (scale < 1.0f ? 1.0f : scale));
+    }
+
+    static Support::Noise::Fixed timeStep(float speed) {
+        // one frame per 10 ms cycle
+        return static_cast<Support::Noise::Fixed>(speed * Support::Noise::ONE / 100.0f);
+    }
+
+    Noise::Noise(const std::vector<Strip::Color> &palette, float scale, float speed, uint8_t octaves, uint32_t seed)
+        : colors(Support::Gradients::bake(palette.empty() ? Support::Gradients::find("lava") : palette)),
+          pixel_step(pixelStep(scale)),
+          time_step(timeStep(speed)),
+          seed(static_cast<Support::Noise::Fixed>(seed & 0xFFFFFF)),
+          octaves(octaves) {
+    }
+
+    uint32_t Noise::timeAt(Iteration iteration) const {
+        // unsigned wrap-around is seamless, the noise lattice repeats every 256 units
+        return anchor_time + static_cast<uint32_t>(iteration - anchor_iteration) * static_cast<uint32_t>(time_step);
+    }
+
+    void Noise::execute(Strip::Strip &strip, Iteration iteration) {
+        last_iteration = iteration;
+        auto time = static_cast<Support::Noise::Fixed>(timeAt(iteration));
+        line.begin(octaves, 0, pixel_step, time, seed);
+        for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+            strip.setPixelColor(i, colors[Support::Noise::toByte(line.next(), CONTRAST)]);
+        }
+    }
+
+    bool Noise::setParameter(const char *name, float value) {
+        if (strcmp(name, "speed") == 0) {
+            anchor_time = timeAt(last_iteration);
+            anchor_iteration = last_iteration;
+            time_step = timeStep(value);
+            return true;
+        }
+        if (strcmp(name, "scale") == 0) {
+            pixel_step = pixelStep(value);
+            return true;
+        }
+        return false;
+    }
+} // namespace Show
@@ -0,0 +1,53 @@
+#ifndef LEDZ_NOISE_H
+#define LEDZ_NOISE_H
+
+#include <vector>
+
+#include "Show.h"
+#include "support/Noise.h"
+#include "support/Palette.h"
+
+namespace Show {
+    /**
+     * Noise - Slowly changing fractal gradient noise seen through a color palette
+     * Gives organic effects like lava, clouds or water. The strip is one row of a
+     * 2D noise field that scrolls through time.
+     */
+    class Noise : public Show {
+    private:
+        Support::Palette::Table colors; // palette baked into a lookup table
+        Support::Noise::Line line;
+        Support::Noise::Fixed pixel_step; // noise units per pixel
+        Support::Noise::Fixed time_step; // noise units per frame
+        Support::Noise::Fixed seed; // z coordinate, so shows with other seeds differ
+        uint8_t octaves;
+        // time of anchor_iteration; a new speed continues from the last frame
+        uint32_t anchor_time = 0;
+        Iteration anchor_iteration = 0;
+        Iteration last_iteration = 0;
+
+        uint32_t timeAt(Iteration iteration) const;
+
+    public:
+        /**
+         * @param palette Colors spread evenly from low to high noise values; empty for "lava"
+         * @param scale Size of the features in pixels (default: 20)
+         * @param speed Rate of change in features per second (default: 0.3)
+         * @param octaves Levels of finer detail, 1 to 8 (default: 3)
+         * @param seed Selects one of many independent noise fields
+         */
+        explicit Noise(const std::vector<Strip::Color> &palette = {}, float scale = 20.0f, float speed = 0.3f,
+                       uint8_t octaves = 3, uint32_t seed = 0);
+
+        void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        /**
+         * scale and speed
+         */
+        bool setParameter(const char *name, float value) override;
+
+        const char *name() { return "Noise"; }
+    };
+} // namespace Show
+
+#endif //LEDZ_NOISE_H
@@ -0,0 +1,102 @@
+#include "Overlay.h"
+#include "support/Blend.h"
+
+#include <cstring>
+
+namespace Show {
+    Overlay::Type Overlay::typeFromName(const char *name) {
+        if (name == nullptr) {
+            return Type::NONE;
+        }
+        if (strcmp(name, "flash") == 0) {
+            return Type::FLASH;
+        }
+        if (strcmp(name, "pulse") == 0) {
+            return Type::PULSE;
+        }
+        if (strcmp(name, "progress") == 0) {
+            return Type::PROGRESS;
+        }
+        return Type::NONE;
+    }
+
+    const char *Overlay::typeName(Type type) {
+        switch (type) {
+            case Type::FLASH:
+                return "flash";
+            case Type::PULSE:
+                return "pulse";
+            case Type::PROGRESS:
+                return "progress";
+            case Type::NONE:
+            default:
+                return "none";
+        }
+    }
+
+    void Overlay::start(Strip::PixelIndex length, Type type, Strip::Color color, Iteration frames,
+                        uint8_t progress) {
+        saved.resize(length);
+        this->type = type;
+        this->color = color;
+        this->progress = progress;
+        this->frames = type == Type::NONE ? 0 : frames;
+        frame = 0;
+    }
+
+    void Overlay::restore(Strip::Strip &strip) {
+        if (dirty && strip.length() == saved.length()) {
+            saved.copyTo(strip);
+        }
+        dirty = false;
+    }
+
+    uint8_t Overlay::amount() const {
+        uint32_t elapsed = frame * 255 / frames;
+        switch (type) {
+            case Type::FLASH:
+                return static_cast<uint8_t>(255 - elapsed);
+            case Type::PULSE: {
+                // two triangles
+                uint32_t phase = (frame * 512 / frames) & 0xFF;
+                return static_cast<uint8_t>(phase < 128 ? phase * 2 : (255 - phase) * 2);
+            }
+            case Type::PROGRESS:
+                // hold, then fade out over the last quarter
+                return elapsed < 192 ? 255 : static_cast<uint8_t>((255 - elapsed) * 4);
+            case Type::NONE:
+            default:
+                return 0;
+        }
+    }
+
+    void Overlay::apply(Strip::Strip &strip) {
+        if (!isActive()) {
+            return;
+        }
+        Strip::PixelIndex length = saved.length();
+        if (strip.length() != length) {
+            // layout changed underneath; the saved frame no longer fits
+            frame = frames;
+            return;
+        }
+
+        for (Strip::PixelIndex i = 0; i < length; i++) {
+            saved.setPixelColor(i, strip.getPixelColor(i));
+        }
+        dirty = true;
+
+        uint8_t weight = amount();
+        if (type == Type::PROGRESS) {
+            for (Strip::PixelIndex i = 0; i < length; i++) {
+                uint8_t edge = Support::Blend::wipeWeight(i, length, progress);
+                strip.setPixelColor(i, Support::Blend::mix(saved.getPixelColor(i), color, edge * weight / 255));
+            }
+        } else {
+            for (Strip::PixelIndex i = 0; i < length; i++) {
+                strip.setPixelColor(i, Support::Blend::mix(saved.getPixelColor(i), color, weight));
+            }
+        }
+        frame++;
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef LEDZ_OVERLAY_H
+#define LEDZ_OVERLAY_H
+
+#include "Show.h"
+#include "strip/Buffer.h"
+
+namespace Show {
+    /**
+     * Overlay - Short notification drawn on top of the running show
+     *
+     * The frame the show rendered is saved before the overlay draws and put back
+     * before the show renders again, so shows that only draw on change keep
+     * their content. The save buffer is sized in start(); apply() and restore()
+     * never allocate.
+     */
+    class Overlay {
+    public:
+        enum class Type {
+            NONE,
+            FLASH, // full strip in the color, fading out
+            PULSE, // full strip fading in and out twice
+            PROGRESS // bar over the given fraction of the strip, fading out at the end
+        };
+
+        /**
+         * @param name "flash", "pulse" or "progress"
+         * @return Matching type, NONE if unknown
+         */
+        static Type typeFromName(const char *name);
+
+        static const char *typeName(Type type);
+
+        /**
+         * Begin an overlay, replacing any running one
+         * @param length Number of pixels of the strip it will be applied to
+         * @param type Overlay to draw
+         * @param color Overlay color
+         * @param frames Duration in frames
+         * @param progress Filled fraction of a PROGRESS bar (0-255)
+         */
+        void start(Strip::PixelIndex length, Type type, Strip::Color color, Iteration frames,
+                   uint8_t progress = 255);
+
+        /**
+         * Stop drawing; the next restore() still puts the show's frame back
+         */
+        void cancel() { frame = frames; }
+
+        bool isActive() const { return frame < frames; }
+
+        /**
+         * Put back the frame the show rendered before the last apply()
+         * @param strip Strip the overlay was applied to
+         */
+        void restore(Strip::Strip &strip);
+
+        /**
+         * Save the show's frame and draw the next overlay frame over it
+         * @param strip Strip the show rendered into
+         */
+        void apply(Strip::Strip &strip);
+
+    private:
+        Type type = Type::NONE;
+        Strip::Color color = 0;
+        uint8_t progress = 0;
+        Iteration frames = 0;
+        Iteration frame = 0;
+
+        Strip::Buffer saved;
+        bool dirty = false; // strip holds overlay pixels
+
+        uint8_t amount() const;
+    };
+}
+
+#endif //LEDZ_OVERLAY_H
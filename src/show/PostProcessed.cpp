@@ -0,0 +1,40 @@
+#include "PostProcessed.h"
+
+#include <cstring>
+
+namespace Show {
+    PostProcessed::PostProcessed(std::unique_ptr<Show> show, const Settings &settings)
+        : show(std::move(show)), settings(settings) {
+    }
+
+    void PostProcessed::execute(Strip::Strip &strip, Iteration iteration) {
+        Strip::PixelIndex length = strip.length();
+        if (canvas.length() != length) {
+            canvas.resize(length);
+            history.resize(length);
+        }
+
+        show->execute(canvas, iteration);
+
+        Strip::Color *output = history.data();
+        if (settings.trail > 0) {
+            Support::PostProcess::trail(canvas.data(), output, length, settings.trail);
+        } else if (settings.decay > 0) {
+            Support::PostProcess::decay(canvas.data(), output, length, settings.decay);
+        } else {
+            memcpy(output, canvas.data(), length * sizeof(Strip::Color));
+        }
+        for (uint8_t pass = 0; pass < settings.blur_passes; pass++) {
+            Support::PostProcess::blur(output, length, settings.kernel);
+        }
+
+        uint32_t sum = 0;
+        for (Strip::PixelIndex i = 0; i < length; i++) {
+            sum = (sum << 1 | sum >> 31) ^ output[i];
+        }
+        settled = sum == checksum;
+        checksum = sum;
+
+        history.copyTo(strip);
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef LEDZ_POSTPROCESSED_H
+#define LEDZ_POSTPROCESSED_H
+
+#include <memory>
+
+#include "Show.h"
+#include "strip/Buffer.h"
+#include "support/PostProcess.h"
+
+namespace Show {
+    /**
+     * PostProcessed - Runs the framebuffer of a show through trail, decay and blur kernels
+     *
+     * The wrapped show renders into its own canvas, so it never sees the
+     * processed pixels. The output is kept between frames as the history the
+     * trail or decay kernel works from; blur is applied to that history and
+     * therefore also spreads into the trails.
+     */
+    class PostProcessed : public Show {
+    public:
+        struct Settings {
+            uint8_t trail = 0; // fraction of the last output kept as a trail (0 = off)
+            uint8_t decay = 0; // fraction of the last output mixed into the new frame (0 = off, ignored with trail)
+            uint8_t blur_passes = 0;
+            Support::PostProcess::Kernel kernel = Support::PostProcess::Kernel::GAUSSIAN;
+
+            bool isActive() const { return trail > 0 || decay > 0 || blur_passes > 0; }
+        };
+
+        /**
+         * @param show Show to process
+         * @param settings Kernels to apply
+         */
+        PostProcessed(std::unique_ptr<Show> show, const Settings &settings);
+
+        void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        /**
+         * @return true once the show is complete and its processed output no longer changes
+         */
+        bool isComplete() const override { return show->isComplete() && settled; }
+
+        size_t layerTimings(LayerTiming *timings, size_t max) const override {
+            return show->layerTimings(timings, max);
+        }
+
+        bool setParameter(const char *name, float value) override {
+            if (!show->setParameter(name, value)) {
+                return false;
+            }
+            settled = false;
+            return true;
+        }
+
+    private:
+        std::unique_ptr<Show> show;
+        Settings settings;
+
+        Strip::Buffer canvas;
+        Strip::Buffer history;
+        uint32_t checksum = 0;
+        bool settled = false;
+    };
+}
+
+#endif //LEDZ_POSTPROCESSED_H
@@ -1,19 +1,63 @@
 #include <cmath>
+#include <cstring>
+#include <numeric>
 #include "color.h"
 #include "Rainbow.h"
+#include "support/Gradients.h"
 
 namespace Show {
-    Rainbow::Rainbow(float time_step, float pixel_step)
-        : time_step(time_step), pixel_step(pixel_step) {
+    // One turn of the wheel in 1/256 hue steps
+    static constexpr int64_t WHEEL_UNITS = 255 * 256;
+
+    static uint32_t toUnits(float step) {
+        auto units = static_cast<int64_t>(lroundf(step * 256.0f)) % WHEEL_UNITS;
+        return static_cast<uint32_t>(units < 0 ? units + WHEEL_UNITS : units);
+    }
+
+    Rainbow::Rainbow(float time_step, float pixel_step, const std::vector<Strip::Color> &palette)
+        : time_step(time_step), pixel_step(pixel_step),
+          colors(palette.empty() ? WHEEL_TABLE : Support::Gradients::bakeCyclic(palette, 255.0f)),
+          time_units(toUnits(time_step)), pixel_units(toUnits(pixel_step)) {
+    }
+
+    uint32_t Rainbow::hueAt(Iteration iteration) const {
+        return static_cast<uint32_t>((anchor_hue + (iteration - anchor_iteration) % WHEEL_UNITS * time_units) %
+                                     WHEEL_UNITS);
     }
 
     void Rainbow::execute(Strip::Strip &strip, Iteration iteration) {
+        last_iteration = iteration;
+        uint32_t hue = hueAt(iteration);
         for (Strip::PixelIndex index = 0; index < strip.length(); index++) {
-            float hue_position = static_cast<float>(iteration) * time_step
-                               + static_cast<float>(index) * pixel_step;
-            uint8_t hue_index = static_cast<uint8_t>(fmodf(hue_position, 255.0f));
+            strip.setPixelColor(index, colors[hue >> 8]);
+            hue += pixel_units;
+            if (hue >= WHEEL_UNITS) {
+                hue -= WHEEL_UNITS;
+            }
+        }
+    }
+
+    bool Rainbow::setParameter(const char *name, float value) {
+        if (strcmp(name, "time_step") == 0) {
+            anchor_hue = hueAt(last_iteration);
+            anchor_iteration = last_iteration;
+            time_step = value;
+            time_units = toUnits(value);
+            return true;
+        }
+        if (strcmp(name, "pixel_step") == 0) {
+            pixel_step = value;
+            pixel_units = toUnits(value);
+            return true;
+        }
+        return false;
+    }
 
-            strip.setPixelColor(index, wheel(hue_index));
+    Iteration Rainbow::period() const {
+        if (time_units == 0) {
+            return 0;
         }
+        // smallest P with P * time_units a whole number of wheel turns
+        return WHEEL_UNITS / std::gcd(WHEEL_UNITS, static_cast<int64_t>(time_units));
     }
 }
\ No newline at end of file
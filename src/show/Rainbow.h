@@ -1,18 +1,53 @@
 #ifndef LEDZ_RAINBOW_H
 #define LEDZ_RAINBOW_H
+#include <cstdint>
+#include <vector>
+
 #include "Show.h"
 #include "strip/Strip.h"
+#include "support/Palette.h"
 
 namespace Show {
+    /**
+     * Rainbow - Hue wheel drifting along the strip
+     * Hues are tracked in 1/256 wheel steps and looked up in WHEEL_TABLE,
+     * or a palette baked onto the same 255 step wheel, so steps are
+     * effectively rounded to multiples of 1/256.
+     */
     class Rainbow : public Show {
     private:
         float time_step;
         float pixel_step;
+        Support::Palette::Table colors; // by hue, entries 0 - 254
+        uint32_t time_units; // time_step in 1/256 hue, modulo one wheel turn
+        uint32_t pixel_units; // pixel_step in 1/256 hue, modulo one wheel turn
+        // hue of anchor_iteration; a new time_step continues from the last frame's hue
+        uint32_t anchor_hue = 0;
+        Iteration anchor_iteration = 0;
+        Iteration last_iteration = 0;
+
+        uint32_t hueAt(Iteration iteration) const;
 
     public:
-        Rainbow(float time_step = 1.0f, float pixel_step = 1.0f);
+        /**
+         * @param time_step Wheel steps the colors move per frame
+         * @param pixel_step Wheel steps from one pixel to the next
+         * @param palette Colors around the wheel, the last blending back into the first; empty for the color wheel
+         */
+        Rainbow(float time_step = 1.0f, float pixel_step = 1.0f, const std::vector<Strip::Color> &palette = {});
 
         void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        /**
+         * Derived from time_step rounded to 1/256 hue, the step the integer hue
+         * arithmetic actually takes; 0 if the colors stand still
+         */
+        Iteration period() const override;
+
+        /**
+         * time_step and pixel_step
+         */
+        bool setParameter(const char *name, float value) override;
     };
 }
 
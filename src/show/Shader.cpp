@@ -0,0 +1,13 @@
+#include "Shader.h"
+
+#include <utility>
+
+namespace Show {
+    Shader::Shader(Support::Shader::Program program) : program(std::move(program)) {
+    }
+
+    void Shader::execute(Strip::Strip &strip, Iteration iteration) {
+        program.render(strip, static_cast<uint32_t>(iteration));
+        rendered = true;
+    }
+} // namespace Show
@@ -0,0 +1,31 @@
+#ifndef LEDZ_SHADER_H
+#define LEDZ_SHADER_H
+
+#include "Show.h"
+#include "support/Shader.h"
+
+namespace Show {
+    /**
+     * Shader - Runs a user supplied per-pixel program (see Support::Shader::Program)
+     * Programs that do not use f or t are static after their first frame.
+     */
+    class Shader : public Show {
+    private:
+        Support::Shader::Program program;
+        bool rendered = false;
+
+    public:
+        /**
+         * @param program Compiled program; a program that failed to compile renders black
+         */
+        explicit Shader(Support::Shader::Program program);
+
+        void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        bool isComplete() const override { return rendered && !program.isAnimated(); }
+
+        const char *name() { return "Shader"; }
+    };
+} // namespace Show
+
+#endif //LEDZ_SHADER_H
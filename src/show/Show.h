@@ -1,12 +1,23 @@
 #ifndef LEDZ_SHOW_H
 #define LEDZ_SHOW_H
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include "strip/Strip.h"
 
 namespace Show {
     typedef uint64_t Iteration;
 
+    /**
+     * Average per-frame cost of one layer of a composite show
+     */
+    struct LayerTiming {
+        char name[16];
+        uint32_t render_us;
+        uint32_t blend_us;
+    };
+
     class Show {
     public:
         virtual ~Show() = default;
@@ -19,6 +30,30 @@ namespace Show {
          * @return true if display is static, false if still animating (default)
          */
         virtual bool isComplete() const { return false; }
+
+        /**
+         * Number of frames after which the show repeats itself exactly
+         * Periodic shows can be baked into a precomputed frame loop (see Baked)
+         * @return period in frames, 0 if the show is not periodic (default)
+         */
+        virtual Iteration period() const { return 0; }
+
+        /**
+         * Report per-layer timings of a composite show
+         * @param timings Array to fill
+         * @param max Capacity of timings
+         * @return Number of entries filled, 0 for plain shows (default)
+         */
+        virtual size_t layerTimings(LayerTiming *timings, size_t max) const { return 0; }
+
+        /**
+         * Change a numeric parameter of the running show, e.g. from a timeline
+         * Called up to once per frame and parameter, so it must not allocate
+         * @param name Parameter name as in the show's JSON parameters
+         * @param value New value
+         * @return true if the show has that parameter, false otherwise (default)
+         */
+        virtual bool setParameter(const char *name, float value) { return false; }
     };
 }
 #endif //LEDZ_SHOW_H
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include "Spectrum.h"
+#include "../color.h"
+#include "support/PostProcess.h"
+
+#include <algorithm>
+
+namespace Show {
+    // peaks fall a full bar in two seconds
+    static constexpr float PEAK_FALL = 0.005f;
+
+    Spectrum::Spectrum(float release, bool peaks, const Support::Audio::Channel &input)
+        : input(input), release(release), peaks(peaks) {
+    }
+
+    void Spectrum::execute(Strip::Strip &strip, Iteration iteration) {
+        input.read(frame);
+
+        Strip::PixelIndex length = strip.length();
+        for (size_t b = 0; b < Support::Audio::BANDS; b++) {
+            shown[b] = std::max(frame.bands[b], shown[b] * release);
+            peak[b] = std::max(shown[b], peak[b] - PEAK_FALL);
+
+            auto start = static_cast<Strip::PixelIndex>(b * length / Support::Audio::BANDS);
+            auto end = static_cast<Strip::PixelIndex>((b + 1) * length / Support::Audio::BANDS);
+            auto size = static_cast<float>(end - start);
+            auto lit = static_cast<Strip::PixelIndex>(shown[b] * size + 0.5f);
+            auto top = static_cast<Strip::PixelIndex>(std::min(size - 1.0f, peak[b] * size));
+
+            Strip::Color bar = wheel(static_cast<unsigned char>(b * 170 / Support::Audio::BANDS));
+            for (Strip::PixelIndex i = start; i < end; i++) {
+                Strip::Color pixel = 0;
+                if (i - start < lit) {
+                    // brighter towards the top of the bar
+                    pixel = Support::PostProcess::scale(bar, 96 + 159 * (i - start + 1) / std::max<Strip::PixelIndex>(1, lit));
+                } else if (peaks && i - start == top && peak[b] > 0.02f) {
+                    pixel = 0xFFFFFF;
+                }
+                strip.setPixelColor(i, pixel);
+            }
+        }
+        // pixels past the last whole band
+        for (auto i = static_cast<Strip::PixelIndex>(Support::Audio::BANDS * length / Support::Audio::BANDS); i < length; i++) {
+            strip.setPixelColor(i, 0);
+        }
+    }
+} // namespace Show
@@ -0,0 +1,39 @@
+#ifndef LEDZ_SPECTRUM_H
+#define LEDZ_SPECTRUM_H
+
+#include <array>
+
+#include "Show.h"
+#include "support/Audio.h"
+
+namespace Show {
+    /**
+     * Spectrum - Audio spectrum analyzer: one bar per frequency band, bass at
+     * the start of the strip, with peak markers that slowly fall back
+     * Reads the frames published by the audio task.
+     */
+    class Spectrum : public Show {
+    private:
+        const Support::Audio::Channel &input;
+        Support::Audio::Frame frame;
+        float release;
+        bool peaks;
+        std::array<float, Support::Audio::BANDS> shown{};
+        std::array<float, Support::Audio::BANDS> peak{};
+
+    public:
+        /**
+         * @param release Fraction of a bar kept per frame as it falls (default: 0.85)
+         * @param peaks Mark the recent maximum of each band (default: true)
+         * @param input Published audio analysis
+         */
+        explicit Spectrum(float release = 0.85f, bool peaks = true,
+                          const Support::Audio::Channel &input = Support::Audio::channel());
+
+        void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        const char *name() { return "Spectrum"; }
+    };
+} // namespace Show
+
+#endif //LEDZ_SPECTRUM_H
@@ -1,41 +1,26 @@
 #include "Starlight.h"
 #include "../color.h"
+#include "support/Draw.h"
+
+#include <cstring>
 
 #ifdef ARDUINO
 #include <Arduino.h>
-#else
-#include <cstdlib>  // For rand(), RAND_MAX
 #endif
 
 namespace Show {
     Starlight::Starlight(float probability, unsigned long length_ms, unsigned long fade_ms,
-                         uint8_t r, uint8_t g, uint8_t b)
+                         uint8_t r, uint8_t g, uint8_t b, uint32_t seed)
         : probability(probability), length_ms(length_ms), fade_ms(fade_ms),
-          star_color(color(r, g, b)) {
+          star_color(color(r, g, b)), gen(seed) {
     }
 
-    float Starlight::calculateBrightness(unsigned long elapsed_ms) {
-        // Phase 1: Fade-in (0 to fade_ms)
-        if (elapsed_ms < fade_ms) {
-            return (float) elapsed_ms / (float) fade_ms;
-        }
-
-        // Phase 2: Hold at full brightness (fade_ms to fade_ms + length_ms)
-        unsigned long hold_end = fade_ms + length_ms;
-        if (elapsed_ms < hold_end) {
-            return 1.0f;
-        }
-
-        // Phase 3: Fade-out (hold_end to hold_end + fade_ms)
-        unsigned long fade_out_start = hold_end;
-        unsigned long fade_out_end = fade_out_start + fade_ms;
-        if (elapsed_ms < fade_out_end) {
-            unsigned long fade_out_elapsed = elapsed_ms - fade_out_start;
-            return 1.0f - ((float) fade_out_elapsed / (float) fade_ms);
-        }
-
-        // Star has completed its lifecycle
-        return 0.0f;
+    void Starlight::twinkle(Star &star, uint32_t now) const {
+        CO_BEGIN(star.script, now);
+        CO_FADE(star.script, now, fade_ms, star.brightness, 0, Support::Draw::ONE_PIXEL);
+        CO_WAIT(star.script, now, length_ms);
+        CO_FADE(star.script, now, fade_ms, star.brightness, Support::Draw::ONE_PIXEL, 0);
+        CO_END(star.script);
     }
 
     void Starlight::execute(Strip::Strip &strip, Iteration iteration) {
@@ -47,51 +32,43 @@ namespace Show {
 #endif
         uint16_t num_leds = strip.length();
 
-        // Spawn new stars based on probability
-        // Use a random float between 0.0 and 1.0
-#ifdef ARDUINO
-        float spawn_chance = (float) random(1000) / 1000.0f;
-#else
-        float spawn_chance = (float) rand() / (float) RAND_MAX;
-#endif
-        if (spawn_chance < probability) {
-            // Pick a random LED that's not already an active star
-#ifdef ARDUINO
-            uint16_t led = random(num_leds);
-#else
-            uint16_t led = rand() % num_leds;
-#endif
-            if (active_stars.find(led) == active_stars.end()) {
-                active_stars[led] = current_time;
+        if (stars.size() != num_leds) {
+            stars.assign(num_leds, Star());
+            for (Star &star: stars) {
+                star.script.stop();
             }
         }
 
-        // Clear the strip
-        for (uint16_t i = 0; i < num_leds; i++) {
-            strip.setPixelColor(i, color(0, 0, 0));
+        // Stars run their script before new ones are picked, so an LED
+        // whose star just went out can light up again at once
+        for (uint16_t led = 0; led < num_leds; led++) {
+            Star &star = stars[led];
+            if (!star.script.isFinished()) {
+                twinkle(star, current_time);
+            }
+            strip.setPixelColor(led, star.script.isFinished()
+                                         ? 0x000000
+                                         : Support::Draw::scale(star_color, star.brightness));
         }
 
-        // Update and render all active stars
-        auto it = active_stars.begin();
-        while (it != active_stars.end()) {
-            uint16_t led = it->first;
-            unsigned long start_time = it->second;
-            unsigned long elapsed = current_time - start_time;
-
-            // Check if star has expired
-            if (elapsed >= getTotalLifetime()) {
-                it = active_stars.erase(it);
-                continue;
+        // Spawn new stars based on probability
+        if (num_leds > 0 && gen.nextFloat() < probability) {
+            // Pick a random LED that's not already an active star
+            uint16_t led = gen.below(num_leds);
+            Star &star = stars[led];
+            if (star.script.isFinished()) {
+                star.script.restart();
+                twinkle(star, current_time);
+                strip.setPixelColor(led, Support::Draw::scale(star_color, star.brightness));
             }
+        }
+    }
 
-            // Calculate brightness and apply to LED
-            float brightness = calculateBrightness(elapsed);
-            auto r = (uint8_t)(red(star_color) * brightness);
-            auto g = (uint8_t)(green(star_color) * brightness);
-            auto b = (uint8_t)(blue(star_color) * brightness);
-
-            strip.setPixelColor(led, color(r, g, b));
-            ++it;
+    bool Starlight::setParameter(const char *name, float value) {
+        if (strcmp(name, "probability") != 0) {
+            return false;
         }
+        probability = value;
+        return true;
     }
-} // namespace Show
\ No newline at end of file
+} // namespace Show
@@ -1,13 +1,18 @@
 #ifndef LEDZ_STARLIGHT_H
 #define LEDZ_STARLIGHT_H
 
+#include <vector>
+
 #include "Show.h"
-#include <map>
+#include "support/Coroutine.h"
+#include "support/Random.h"
 
 namespace Show {
     /**
      * Starlight - Creates a twinkling stars effect
-     * LEDs randomly activate with fade-in, hold, and fade-out phases
+     * LEDs randomly activate with fade-in, hold, and fade-out phases.
+     * Each LED holds at most one star, whose life is a coroutine script timed
+     * in milliseconds; nothing is allocated after the first frame.
      */
     class Starlight : public Show {
     private:
@@ -15,24 +20,22 @@ namespace Show {
         unsigned long length_ms; // Duration at full brightness (milliseconds)
         unsigned long fade_ms; // Fade-in/fade-out duration (milliseconds)
         Strip::Color star_color; // Color of the stars
+        Support::Random gen;
 
-        // Track active stars: LED index -> start time (milliseconds)
-        std::map<uint16_t, unsigned long> active_stars;
+        struct Star {
+            Support::Coroutine script;
+            int32_t brightness = 0; // coverage, 0 to 256
+        };
 
-        /**
-         * Calculate brightness for a star based on elapsed time
-         * @param elapsed_ms Time since star started (milliseconds)
-         * @return Brightness factor (0.0 to 1.0)
-         */
-        float calculateBrightness(unsigned long elapsed_ms);
+        // One star per LED, finished while the LED is dark
+        std::vector<Star> stars;
 
         /**
-         * Get total star lifetime (fade-in + hold + fade-out)
-         * @return Total lifetime in milliseconds
+         * Advance a star by one frame: fade in, hold, fade out
+         * @param star Star to advance
+         * @param now Current time (milliseconds)
          */
-        unsigned long getTotalLifetime() const {
-            return fade_ms + length_ms + fade_ms;
-        }
+        void twinkle(Star &star, uint32_t now) const;
 
     public:
         /**
@@ -43,13 +46,15 @@ namespace Show {
          * @param r Red component of star color (default: 255)
          * @param g Green component of star color (default: 180)
          * @param b Blue component of star color (default: 50)
+         * @param seed Seed of where and when stars appear
          */
         Starlight(float probability = 0.01f,
                   unsigned long length_ms = 5000,
                   unsigned long fade_ms = 1000,
                   uint8_t r = 255,
                   uint8_t g = 180,
-                  uint8_t b = 50);
+                  uint8_t b = 50,
+                  uint32_t seed = Support::randomSeed());
 
         /**
          * Execute the show - update twinkling stars
@@ -58,6 +63,11 @@ namespace Show {
          */
         void execute(Strip::Strip &strip, Iteration iteration) override;
 
+        /**
+         * probability
+         */
+        bool setParameter(const char *name, float value) override;
+
         const char *name() { return "Starlight"; }
     };
 } // namespace Show
@@ -3,30 +3,42 @@
 
 namespace Show {
     Stroboscope::Stroboscope(uint8_t r, uint8_t g, uint8_t b,
-                             unsigned int on_cycles, unsigned int off_cycles)
+                             unsigned int on_cycles, unsigned int off_cycles, float flashes_per_beat,
+                             const Support::Tempo::Clock &tempo)
         : r(r), g(g), b(b), on_cycles(on_cycles), off_cycles(off_cycles),
-          current_cycle(0) {
+          flashes_per_beat(flashes_per_beat), tempo(tempo) {
     }
 
-    void Stroboscope::execute(Strip::Strip &strip, Iteration iteration) {
-        // Calculate total cycle length
-        unsigned int total_cycles = on_cycles + off_cycles;
-
-        // Determine current position in cycle
-        unsigned int cycle_position = current_cycle % total_cycles;
+    uint64_t Stroboscope::beatSlot() const {
+        return static_cast<uint64_t>(tempo.at().beats() * flashes_per_beat);
+    }
 
-        // Check if we're in the "on" phase
-        if (cycle_position < on_cycles) {
-            // Flash the color
-            Strip::Color flash_color = color(r, g, b);
-            strip.fill(flash_color);
-        } else {
-            // Stay black
-            Strip::Color black = color(0, 0, 0);
-            strip.fill(black);
+    void Stroboscope::flash() {
+        CO_BEGIN(script, frame);
+        for (;;) {
+            if (flashes_per_beat > 0.0f) {
+                // A flash starts whenever the clock enters the next beat division
+                slot = beatSlot();
+                CO_WAIT_UNTIL(script, frame, beatSlot() != slot);
+            }
+            lit = true;
+            CO_WAIT(script, frame, on_cycles);
+            lit = false;
+            if (flashes_per_beat <= 0.0f) {
+                CO_WAIT(script, frame, off_cycles);
+            }
         }
+        CO_END(script);
+    }
 
-        // Increment cycle counter
-        current_cycle++;
+    void Stroboscope::execute(Strip::Strip &strip, Iteration iteration) {
+        if (on_cycles + off_cycles == 0 && flashes_per_beat <= 0.0f) {
+            // nothing would ever wait
+            strip.fill(color(0, 0, 0));
+            return;
+        }
+        flash();
+        frame++;
+        strip.fill(lit ? color(r, g, b) : color(0, 0, 0));
     }
-} // namespace Show
\ No newline at end of file
+} // namespace Show
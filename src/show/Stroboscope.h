@@ -2,18 +2,35 @@
 #define LEDZ_STROBOSCOPE_H
 
 #include "Show.h"
+#include "support/Coroutine.h"
+#include "support/Tempo.h"
 
 namespace Show {
     /**
      * Stroboscope - Flashing strobe effect with configurable on/off cycles
      * Flashes a color for a specified number of cycles, then stays black
+     * With flashes_per_beat set, a flash starts on every beat division of the
+     * tempo clock instead, and lasts on_cycles frames.
      */
     class Stroboscope : public Show {
     private:
         uint8_t r, g, b; // Color to flash
         unsigned int on_cycles; // Number of cycles to stay on
         unsigned int off_cycles; // Number of cycles to stay off
-        unsigned int current_cycle; // Current cycle counter
+        float flashes_per_beat; // 0 to count frames
+        const Support::Tempo::Clock &tempo;
+
+        Support::Coroutine script;
+        uint32_t frame = 0; // frames shown so far, the script's time
+        uint64_t slot = 0; // beat division the script waits to end
+        bool lit = false;
+
+        uint64_t beatSlot() const;
+
+        /**
+         * Advance the flash sequence by one frame
+         */
+        void flash();
 
     public:
         /**
@@ -23,9 +40,12 @@ namespace Show {
          * @param b Blue component (0-255, default: 255)
          * @param on_cycles Number of cycles to flash on (default: 1)
          * @param off_cycles Number of cycles to stay off (default: 10)
+         * @param flashes_per_beat Flashes per beat of the tempo clock, 0 to use off_cycles (default: 0)
+         * @param tempo Beat clock
          */
         Stroboscope(uint8_t r = 255, uint8_t g = 255, uint8_t b = 255,
-                    unsigned int on_cycles = 1, unsigned int off_cycles = 10);
+                    unsigned int on_cycles = 1, unsigned int off_cycles = 10, float flashes_per_beat = 0.0f,
+                    const Support::Tempo::Clock &tempo = Support::Tempo::clock());
 
         /**
          * Execute the show - update stroboscope effect
@@ -34,6 +54,8 @@ namespace Show {
          */
         void execute(Strip::Strip &strip, Iteration iteration) override;
 
+        Iteration period() const override { return flashes_per_beat > 0.0f ? 0 : on_cycles + off_cycles; }
+
         const char *name() { return "Stroboscope"; }
     };
 } // namespace Show
@@ -1,35 +1,45 @@
 #include "TheaterChase.h"
 #include "../color.h"
 
+#include <numeric>
+
 namespace Show {
-    TheaterChase::TheaterChase(unsigned int num_steps_per_cycle)
-        : num_steps_per_cycle(num_steps_per_cycle) {
+    // Pattern: 2 LEDs dark, 5 LEDs lit in each 7-LED segment
+    static constexpr unsigned int SEGMENT = 7;
+    static constexpr unsigned int DARK = 2;
+
+    TheaterChase::TheaterChase(unsigned int num_steps_per_cycle, float steps_per_beat,
+                               const Support::Tempo::Clock &tempo)
+        : num_steps_per_cycle(num_steps_per_cycle), steps_per_beat(steps_per_beat), tempo(tempo),
+          pattern(SEGMENT) {
     }
 
     void TheaterChase::execute(Strip::Strip &strip, Iteration iteration) {
-        uint16_t num_leds = strip.length();
+        if (steps_per_beat > 0.0f) {
+            index = static_cast<unsigned int>(static_cast<uint64_t>(tempo.at().beats() * steps_per_beat));
+        }
 
         // Calculate color progression through the wheel
         float cycle_position = (float) (index % num_steps_per_cycle) / (float) num_steps_per_cycle;
         uint8_t color_index = (uint8_t)(cycle_position * 255.0f);
         Strip::Color chase_color = wheel(color_index);
 
-        // Apply theater chase pattern
-        // Pattern: 2 LEDs dark, 5 LEDs lit in each 7-LED segment
-        // The pattern shifts by one position each frame
-        for (uint16_t i = 0; i < num_leds; i++) {
-            // Calculate segment offset
-            unsigned int offset = (i + index) % 7;
-
-            // Set pixel: dark for first 2 positions in each 7-LED segment, colored otherwise
-            if (offset < 2) {
-                strip.setPixelColor(i, color(0, 0, 0));
-            } else {
-                strip.setPixelColor(i, chase_color);
-            }
+        for (unsigned int i = DARK; i < SEGMENT; i++) {
+            pattern.set(i, chase_color);
         }
 
+        // The pattern shifts by one position each frame
+        scroller.emit(strip, pattern, static_cast<uint64_t>(index) * Support::Draw::ONE_PIXEL);
+
         // Increment index for next frame
         index++;
     }
+
+    Iteration TheaterChase::period() const {
+        if (steps_per_beat > 0.0f) {
+            return 0; // follows the clock, not the frames
+        }
+        // 7-LED segment pattern combined with the color rotation
+        return num_steps_per_cycle > 0 ? std::lcm(SEGMENT, num_steps_per_cycle) : 0;
+    }
 } // namespace Show
\ No newline at end of file
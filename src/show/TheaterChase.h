@@ -2,23 +2,34 @@
 #define LEDZ_THEATERCHASE_H
 
 #include "Show.h"
+#include "support/Scroll.h"
+#include "support/Tempo.h"
 
 namespace Show {
     /**
      * TheaterChase - Classic marquee-style LED animation with rotating rainbow colors
      * Creates a chase pattern where groups of LEDs light up in sequence with smooth color transitions
+     * Steps once per frame, or with steps_per_beat set, in time with the tempo clock.
      */
     class TheaterChase : public Show {
     private:
         unsigned int num_steps_per_cycle; // Steps needed for one complete color rotation
         unsigned int index = 0; // Current animation step
+        float steps_per_beat; // 0 to step every frame
+        const Support::Tempo::Clock &tempo;
+
+        Support::Scroll::RingPattern pattern; // one 7-LED segment
+        Support::Scroll::Scroller scroller;
 
     public:
         /**
          * Constructor with configurable parameters
          * @param num_steps_per_cycle Steps per complete color rotation (default: 21, should be multiple of 7)
+         * @param steps_per_beat Steps per beat of the tempo clock, 0 for one step per frame (default: 0)
+         * @param tempo Beat clock
          */
-        TheaterChase(unsigned int num_steps_per_cycle = 21);
+        TheaterChase(unsigned int num_steps_per_cycle = 21, float steps_per_beat = 0.0f,
+                     const Support::Tempo::Clock &tempo = Support::Tempo::clock());
 
         /**
          * Execute the show - update theater chase animation
@@ -27,6 +38,8 @@ namespace Show {
          */
         void execute(Strip::Strip &strip, Iteration iteration) override;
 
+        Iteration period() const override;
+
         const char *name() { return "TheaterChase"; }
     };
 } // namespace Show
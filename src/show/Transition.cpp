@@ -0,0 +1,130 @@
+#include "Transition.h"
+#include "../Log.h"
+#include "support/Blend.h"
+
+#include <cstring>
+
+static const char* TAG = "show";
+
+namespace Show {
+    Transition::Type Transition::typeFromName(const char *name) {
+        if (name == nullptr) {
+            return Type::CROSSFADE;
+        }
+        if (strcmp(name, "cut") == 0) {
+            return Type::CUT;
+        }
+        if (strcmp(name, "wipe") == 0) {
+            return Type::WIPE;
+        }
+        if (strcmp(name, "dissolve") == 0) {
+            return Type::DISSOLVE;
+        }
+        return Type::CROSSFADE;
+    }
+
+    const char *Transition::typeName(Type type) {
+        switch (type) {
+            case Type::CUT:
+                return "cut";
+            case Type::WIPE:
+                return "wipe";
+            case Type::DISSOLVE:
+                return "dissolve";
+            case Type::CROSSFADE:
+            default:
+                return "crossfade";
+        }
+    }
+
+    Transition::Transition(std::unique_ptr<Show> from, std::unique_ptr<Show> to, Type type, Iteration frames,
+                           size_t budget_bytes)
+        : from(std::move(from)), to(std::move(to)), type(type),
+          frames(type == Type::CUT ? 0 : frames), budget(budget_bytes) {
+    }
+
+    void Transition::prepare(Strip::Strip &strip) {
+        Strip::PixelIndex length = strip.length();
+        size_t buffer_bytes = static_cast<size_t>(length) * sizeof(Strip::Color);
+
+        if (from && 3 * buffer_bytes <= budget) {
+            from_buffer.resize(length);
+            to_buffer.resize(length);
+            blend_buffer.resize(length);
+            mode = Mode::DUAL;
+        } else if (buffer_bytes <= budget) {
+            // Freeze the last frame of the outgoing show
+            from_buffer.resize(length);
+            for (Strip::PixelIndex i = 0; i < length; i++) {
+                from_buffer.setPixelColor(i, strip.getPixelColor(i));
+            }
+            from.reset();
+            mode = Mode::SNAPSHOT;
+        } else {
+            ESP_LOGW(TAG, "No memory for a transition over %d pixels, cutting", length);
+            frame = frames;
+        }
+    }
+
+    void Transition::execute(Strip::Strip &strip, Iteration iteration) {
+        if (mode == Mode::PENDING && !isFinished()) {
+            prepare(strip);
+        }
+        if (isFinished()) {
+            to->execute(strip, iteration);
+            return;
+        }
+
+        frame++;
+        auto amount = static_cast<uint8_t>(frame * 255 / frames);
+        Strip::PixelIndex length = from_buffer.length();
+
+        if (mode == Mode::DUAL) {
+            from->execute(from_buffer, iteration);
+            to->execute(to_buffer, iteration);
+
+            // Both frames stay as drawn: shows that only draw on changes, or
+            // fade their previous frame, read them back next time
+            Strip::Color *out = blend_buffer.data();
+            switch (type) {
+                case Type::WIPE:
+                    Support::Blend::wipe(from_buffer.data(), to_buffer.data(), out, length, amount);
+                    break;
+                case Type::DISSOLVE:
+                    Support::Blend::dissolve(from_buffer.data(), to_buffer.data(), out, length, amount);
+                    break;
+                default:
+                    Support::Blend::crossfade(from_buffer.data(), to_buffer.data(), out, length, amount);
+                    break;
+            }
+            blend_buffer.copyTo(strip);
+        } else {
+            // The incoming show draws straight to the strip, then each pixel is
+            // blended with the snapshot through the strip's readback
+            to->execute(strip, iteration);
+            const Strip::Color *snapshot = from_buffer.data();
+            for (Strip::PixelIndex i = 0; i < length; i++) {
+                uint8_t weight;
+                switch (type) {
+                    case Type::WIPE:
+                        weight = Support::Blend::wipeWeight(i, length, amount);
+                        break;
+                    case Type::DISSOLVE:
+                        weight = amount > Support::Blend::dissolveThreshold(i) ? 255 : 0;
+                        break;
+                    default:
+                        weight = amount;
+                        break;
+                }
+                strip.setPixelColor(i, Support::Blend::mix(snapshot[i], strip.getPixelColor(i), weight));
+            }
+        }
+
+        if (isFinished()) {
+            from.reset();
+            from_buffer.resize(0);
+            to_buffer.resize(0);
+            blend_buffer.resize(0);
+        }
+    }
+}
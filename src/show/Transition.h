@@ -0,0 +1,97 @@
+#ifndef LEDZ_TRANSITION_H
+#define LEDZ_TRANSITION_H
+
+#include <memory>
+
+#include "Show.h"
+#include "strip/Buffer.h"
+
+namespace Show {
+    /**
+     * Transition - Blends from an outgoing to an incoming show over a number of frames
+     *
+     * Both shows render into offscreen buffers and a Support::Blend kernel mixes
+     * them into a third, so each show finds its own previous frame on the next
+     * call. If three buffers exceed the memory budget, or there is no outgoing
+     * show, the current strip content is frozen into a single snapshot buffer
+     * and the incoming show blends against that. If even one buffer does not
+     * fit, the transition degrades to a cut.
+     *
+     * Once isFinished() the owner should release() the incoming show and drop
+     * the transition.
+     */
+    class Transition : public Show {
+    public:
+        enum class Type {
+            CUT,
+            CROSSFADE,
+            WIPE,
+            DISSOLVE
+        };
+
+        /**
+         * @param name "cut", "crossfade", "wipe" or "dissolve"
+         * @return Matching type, CROSSFADE if unknown
+         */
+        static Type typeFromName(const char *name);
+
+        static const char *typeName(Type type);
+
+        /**
+         * @param from Outgoing show, nullptr to blend from a snapshot of the strip
+         * @param to Incoming show
+         * @param type Blend to use
+         * @param frames Duration in frames
+         * @param budget_bytes Maximum memory for offscreen buffers
+         */
+        Transition(std::unique_ptr<Show> from, std::unique_ptr<Show> to, Type type, Iteration frames,
+                   size_t budget_bytes);
+
+        void execute(Strip::Strip &strip, Iteration iteration) override;
+
+        /**
+         * @return true once the incoming show is fully visible
+         */
+        bool isFinished() const { return frame >= frames; }
+
+        size_t layerTimings(LayerTiming *timings, size_t max) const override {
+            return to ? to->layerTimings(timings, max) : 0;
+        }
+
+        /**
+         * Parameters go to the incoming show
+         */
+        bool setParameter(const char *name, float value) override {
+            return to && to->setParameter(name, value);
+        }
+
+        /**
+         * Hand over the incoming show
+         * @return Incoming show; the transition must not be executed afterwards
+         */
+        std::unique_ptr<Show> release() { return std::move(to); }
+
+    private:
+        enum class Mode {
+            PENDING,
+            DUAL,
+            SNAPSHOT
+        };
+
+        std::unique_ptr<Show> from;
+        std::unique_ptr<Show> to;
+        Type type;
+        Iteration frames;
+        Iteration frame = 0;
+        size_t budget;
+
+        Mode mode = Mode::PENDING;
+        Strip::Buffer from_buffer;
+        Strip::Buffer to_buffer;
+        Strip::Buffer blend_buffer;
+
+        void prepare(Strip::Strip &strip);
+    };
+}
+
+#endif //LEDZ_TRANSITION_H
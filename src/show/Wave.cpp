@@ -1,5 +1,7 @@
 #include "Wave.h"
 #include "../color.h"
+#include "support/Gradients.h"
+#include <algorithm>
 #include <cmath>
 
 #ifndef M_PI
@@ -7,46 +9,118 @@
 #endif
 
 namespace Show {
-    Wave::Wave(float wave_speed, float decay_rate, float brightness_frequency, float wavelength)
-        : wave_speed(wave_speed), decay_rate(decay_rate),
-          brightness_frequency(brightness_frequency), wavelength(wavelength),
-          time(0.0f), color_time(0.0f) {
+    namespace {
+        constexpr float TIME_STEP = 0.05f;
+        constexpr float TWO_PI = 2.0f * static_cast<float>(M_PI);
+
+        // the wheel has 255 positions; hues are kept in 1/65536 of one
+        constexpr uint32_t HUE_TURN = 255u << 16;
+
+        // the color at the source moves 20 wheel positions per time unit
+        constexpr auto HUE_PER_FRAME = static_cast<uint32_t>(TIME_STEP * 20.0f * 65536.0f + 0.5f);
+
+        uint32_t toHue(float positions) {
+            float wrapped = std::fmod(positions, 255.0f);
+            if (wrapped < 0.0f) {
+                wrapped += 255.0f;
+            }
+            return std::min(HUE_TURN - 1, static_cast<uint32_t>(wrapped * 65536.0f));
+        }
+
+        uint32_t hueAdd(uint32_t hue, uint32_t step) {
+            hue += step;
+            return hue >= HUE_TURN ? hue - HUE_TURN : hue;
+        }
+
+        uint32_t hueSub(uint32_t hue, uint32_t step) {
+            return hue >= step ? hue - step : hue + HUE_TURN - step;
+        }
     }
 
-    void Wave::execute(Strip::Strip &strip, Iteration iteration) {
-        // Increment time counters
-        time += 0.05f;
-        color_time += 0.05f;
+    Wave::Wave(float wave_speed, float decay_rate, float brightness_frequency, float wavelength,
+               const std::vector<Source> &sources, const std::vector<Strip::Color> &palette)
+        : decay_rate(decay_rate), brightness_frequency(brightness_frequency), time(0.0f),
+          colors(palette.empty() ? WHEEL_TABLE : Support::Gradients::bakeCyclic(palette, 255.0f)) {
+        std::vector<Source> all = sources;
+        if (all.empty()) {
+            all.push_back({0, wavelength, wave_speed});
+        }
+        for (const Source &source: all) {
+            Emitter emitter{};
+            emitter.source = source;
+            // one pixel further from the source is 1/wavelength further along the sine
+            emitter.step_cos = cosf(1.0f / source.wavelength);
+            emitter.step_sin = sinf(1.0f / source.wavelength);
+            // and was emitted 1/(10 speed) earlier, 20 wheel positions per time unit
+            emitter.hue_step = source.speed != 0.0f ? toHue(2.0f / source.speed) : 0;
+            emitters.push_back(emitter);
+        }
+    }
+
+    void Wave::ensureDecay(Strip::Strip &strip) {
+        if (length == strip.length()) {
+            return;
+        }
+        length = strip.length();
+        decay = std::make_unique<float[]>(std::max<Strip::PixelIndex>(1, length));
+        for (Strip::PixelIndex d = 0; d < length; d++) {
+            // exponential decay towards the ends
+            decay[d] = expf(-decay_rate * static_cast<float>(d) / static_cast<float>(length));
+        }
+    }
 
-        uint16_t num_leds = strip.length();
+    void Wave::execute(Strip::Strip &strip, [[maybe_unused]] Iteration iteration) {
+        ensureDecay(strip);
+        time += TIME_STEP;
 
         // Calculate source brightness using sine wave (oscillates between 0.3 and 1.0)
-        float source_brightness = 0.65f + 0.35f * sinf(time * brightness_frequency * 2.0f * M_PI);
+        float source_brightness = 0.65f + 0.35f * sinf(time * brightness_frequency * TWO_PI);
 
-        // Clear strip
-        for (uint16_t i = 0; i < num_leds; i++) {
-            // Create wave pattern: sine wave propagates outward from center
-            float wave_position = (float) (i - (time * wave_speed * 10.0f)) / wavelength;
-            float wave_brightness = (sinf(wave_position) + 1.0f) / 2.0f; // Normalize to 0-1
+        for (Emitter &emitter: emitters) {
+            emitter.phase = std::fmod(emitter.phase - TIME_STEP * emitter.source.speed * 10.0f / emitter.source.wavelength,
+                                      TWO_PI);
+            emitter.hue = hueAdd(emitter.hue, HUE_PER_FRAME);
 
-            // Calculate when this wave element was at the center (emission time)
-            // This determines what color it should have
-            float emission_time = color_time - ((float) i / (wave_speed * 10.0f));
-            uint8_t color_index = (uint8_t)((int) (emission_time * 20.0f) % 255);
-            Strip::Color pixel_color = wheel(color_index);
-
-            // Apply distance-based decay (exponential decay towards the ends)
-            float distance_factor = expf(-decay_rate * (float) i / (float) num_leds);
+            // the walk starts at pixel 0, as far from the source as the source is from it
+            emitter.position = std::min<Strip::PixelIndex>(std::max<Strip::PixelIndex>(0, emitter.source.position),
+                                                           length - 1);
+            emitter.distance = emitter.position;
+            float phase = emitter.phase + static_cast<float>(emitter.distance) / emitter.source.wavelength;
+            emitter.sin_walk = sinf(phase);
+            emitter.cos_walk = cosf(phase);
+            emitter.hue_walk = hueSub(emitter.hue,
+                                      static_cast<uint64_t>(emitter.distance) * emitter.hue_step % HUE_TURN);
+        }
 
-            // Combine source brightness, wave pattern, and distance decay
-            float final_brightness = source_brightness * wave_brightness * distance_factor;
+        for (Strip::PixelIndex i = 0; i < length; i++) {
+            float r = 0.0f, g = 0.0f, b = 0.0f;
+            for (Emitter &emitter: emitters) {
+                // Combine wave pattern (normalized to 0-1) and distance decay
+                float brightness = (emitter.sin_walk + 1.0f) * 0.5f * decay[emitter.distance];
+                Strip::Color pixel_color = colors[emitter.hue_walk >> 16];
+                r += static_cast<float>(red(pixel_color)) * brightness;
+                g += static_cast<float>(green(pixel_color)) * brightness;
+                b += static_cast<float>(blue(pixel_color)) * brightness;
 
-            // Apply brightness to color
-            uint8_t r = (uint8_t)(red(pixel_color) * final_brightness);
-            uint8_t g = (uint8_t)(green(pixel_color) * final_brightness);
-            uint8_t b = (uint8_t)(blue(pixel_color) * final_brightness);
+                // one pixel on: rotate the phase by one step, back towards the source or away from it
+                bool towards = i < emitter.position;
+                float step_sin = towards ? -emitter.step_sin : emitter.step_sin;
+                float sin_walk = emitter.sin_walk * emitter.step_cos + emitter.cos_walk * step_sin;
+                emitter.cos_walk = emitter.cos_walk * emitter.step_cos - emitter.sin_walk * step_sin;
+                emitter.sin_walk = sin_walk;
+                if (towards) {
+                    emitter.distance--;
+                    emitter.hue_walk = hueAdd(emitter.hue_walk, emitter.hue_step);
+                } else {
+                    emitter.distance++;
+                    emitter.hue_walk = hueSub(emitter.hue_walk, emitter.hue_step);
+                }
+            }
 
-            strip.setPixelColor(i, color(r, g, b));
+            // Apply source brightness to color
+            strip.setPixelColor(i, color(static_cast<uint8_t>(std::min(255.0f, r * source_brightness)),
+                                         static_cast<uint8_t>(std::min(255.0f, g * source_brightness)),
+                                         static_cast<uint8_t>(std::min(255.0f, b * source_brightness))));
         }
     }
-} // namespace Show
\ No newline at end of file
+} // namespace Show
@@ -1,22 +1,56 @@
 #ifndef LEDZ_WAVE_H
 #define LEDZ_WAVE_H
 
+#include <memory>
+#include <vector>
+
 #include "Show.h"
+#include "support/Palette.h"
 
 namespace Show {
     /**
-     * Wave - Creates a propagating wave effect with color cycling
-     * Wave emanates from the start with changing brightness and exponential decay
+     * Wave - Creates propagating waves with color cycling
+     * Waves run outward from one or more sources with changing brightness and
+     * exponential decay. Where waves of several sources meet, their sine parts
+     * add up: they reinforce and cancel each other.
      */
     class Wave : public Show {
+    public:
+        /**
+         * A point waves run out from, in both directions
+         */
+        struct Source {
+            Strip::PixelIndex position; // pixel of the source, clamped to the strip
+            float wavelength; // Wavelength of the wave pattern (higher = longer waves)
+            float speed; // Speed of wave propagation (higher = faster)
+        };
+
     private:
-        float wave_speed; // Speed of wave propagation (higher = faster)
+        // Per source state, advanced once per frame
+        struct Emitter {
+            Source source;
+            float phase; // sine argument at the source, kept within one turn
+            float step_cos, step_sin; // rotation by one pixel of distance
+            uint32_t hue; // wheel position at the source in 1/65536, within one turn
+            uint32_t hue_step; // wheel positions per pixel of distance in 1/65536
+
+            // walking the strip from pixel 0: towards the source first, then away from it
+            Strip::PixelIndex position, distance;
+            float sin_walk, cos_walk;
+            uint32_t hue_walk;
+        };
+
         float decay_rate; // Rate of brightness decay towards ends (higher = faster decay)
         float brightness_frequency; // Frequency of brightness oscillation at source
-        float wavelength; // Wavelength of the wave pattern (higher = longer waves)
 
-        float time; // Time counter for wave position
-        float color_time; // Time counter for color cycling
+        float time; // Time counter for source brightness
+        std::vector<Emitter> emitters;
+        Support::Palette::Table colors; // by wheel position, entries 0 - 254
+
+        Strip::PixelIndex length = -1; // strip length the decay table was built for
+        std::unique_ptr<float[]> decay; // brightness factor by distance from a source
+
+        void ensureDecay(Strip::Strip &strip);
 
     public:
         /**
@@ -25,11 +59,15 @@ namespace Show {
          * @param decay_rate Rate of brightness decay (default: 2.0)
          * @param brightness_frequency Frequency of source brightness oscillation (default: 0.1)
          * @param wavelength Wavelength of wave pattern (default: 6.0)
+         * @param sources Wave sources; empty for a single one at the start with wave_speed and wavelength
+         * @param palette Colors the waves cycle through, the last blending back into the first; empty for the color wheel
          */
         Wave(float wave_speed = 1.0f,
              float decay_rate = 2.0f,
              float brightness_frequency = 0.1f,
-             float wavelength = 6.0f);
+             float wavelength = 6.0f,
+             const std::vector<Source> &sources = {},
+             const std::vector<Strip::Color> &palette = {});
 
         /**
          * Execute the show - update wave animation
@@ -42,4 +80,4 @@ namespace Show {
     };
 } // namespace Show
 
-#endif //LEDZ_WAVE_H
\ No newline at end of file
+#endif //LEDZ_WAVE_H
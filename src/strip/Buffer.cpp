@@ -0,0 +1,54 @@
+#include "Buffer.h"
+
+#include <algorithm>
+
+namespace Strip {
+    Buffer::Buffer(PixelIndex length) : pixel_count(0) {
+        resize(length);
+    }
+
+    void Buffer::resize(PixelIndex length) {
+        length = std::max<PixelIndex>(0, length);
+        if (pixels && length == pixel_count) {
+            return;
+        }
+        pixels = std::unique_ptr<Color[]>(new Color[length > 0 ? length : 1]);
+        pixel_count = length;
+        fill(0x000000);
+    }
+
+    void Buffer::fill(Color color) {
+        std::fill(pixels.get(), pixels.get() + pixel_count, color);
+    }
+
+    void Buffer::setPixelColor(PixelIndex pixel_index, Color color) {
+        if (pixel_index >= 0 && pixel_index < pixel_count) {
+            pixels[pixel_index] = color;
+        }
+    }
+
+    Color Buffer::getPixelColor(PixelIndex pixel_index) const {
+        if (pixel_index >= 0 && pixel_index < pixel_count) {
+            return pixels[pixel_index];
+        }
+        return 0;
+    }
+
+    PixelIndex Buffer::length() const {
+        return pixel_count;
+    }
+
+    void Buffer::show() {
+        // Offscreen: nothing to transmit
+    }
+
+    void Buffer::setBrightness(uint8_t brightness) {
+        // Offscreen: brightness is applied by the real strip
+    }
+
+    void Buffer::copyTo(Strip &target) const {
+        for (PixelIndex i = 0; i < pixel_count; i++) {
+            target.setPixelColor(i, pixels[i]);
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef LEDZ_BUFFER_H
+#define LEDZ_BUFFER_H
+
+#include <memory>
+
+#include "Strip.h"
+
+namespace Strip {
+    /**
+     * Offscreen framebuffer with the Strip interface.
+     * Shows render into it exactly as they would into a real strip, and the
+     * owner then copies or blends the packed 0xRRGGBB pixels onwards.
+     * show() and setBrightness() are no-ops: a buffer never reaches hardware.
+     */
+    class Buffer : public Strip {
+        std::unique_ptr<Color[]> pixels;
+        PixelIndex pixel_count;
+
+    public:
+        explicit Buffer(PixelIndex length = 0);
+
+        /**
+         * Reallocate for a new length; contents are cleared to black.
+         * A no-op if the length is unchanged.
+         * @param length New number of pixels
+         */
+        void resize(PixelIndex length);
+
+        void fill(Color color) override;
+
+        void setPixelColor(PixelIndex pixel_index, Color color) override;
+
+        Color getPixelColor(PixelIndex pixel_index) const override;
+
+        PixelIndex length() const override;
+
+        void show() override;
+
+        void setBrightness(uint8_t brightness) override;
+
+        /**
+         * Copy the whole buffer into another strip, pixel by pixel
+         * @param target Strip to write to (must be at least as long)
+         */
+        void copyTo(Strip &target) const;
+
+        Color *data() { return pixels.get(); }
+
+        const Color *data() const { return pixels.get(); }
+    };
+}
+
+#endif //LEDZ_BUFFER_H
@@ -0,0 +1,304 @@
+#include "Audio.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace Support::Audio {
+    namespace {
+        // band scale: RANGE_DB below the loudest recent band is silent
+        constexpr float RANGE_DB = 45.0f;
+        // the scale falls back by this per analysis once the music gets quieter, ~10 dB/s
+        constexpr float CEILING_RELEASE_DB = 0.12f;
+        // never scale up below this, so silence stays dark
+        constexpr float MIN_CEILING_DB = 20.0f;
+
+        // a beat is bass energy at BEAT_RATIO times its average of the last second,
+        // and ONSET_RATIO times what it was one window earlier, so a held note is not
+        constexpr float BEAT_RATIO = 2.0f;
+        constexpr float ONSET_RATIO = 1.5f;
+        constexpr float MIN_BEAT_ENERGY = 0.5f;
+        constexpr float MIN_BEAT_SECONDS = 0.25f;
+        constexpr float BASS_HZ = 160.0f;
+
+        inline float clamp01(float value) {
+            return value < 0.0f ? 0.0f : value > 1.0f ? 1.0f : value;
+        }
+
+        uint32_t readLittleEndian(std::FILE *file, int bytes) {
+            uint32_t value = 0;
+            for (int i = 0; i < bytes; i++) {
+                int c = std::fgetc(file);
+                if (c == EOF) {
+                    return 0;
+                }
+                value |= static_cast<uint32_t>(c) << (8 * i);
+            }
+            return value;
+        }
+    }
+
+    Channel &channel() {
+        static Channel shared;
+        return shared;
+    }
+
+    // --- SyntheticSource ----------------------------------------------------
+
+    SyntheticSource::SyntheticSource(uint32_t sample_rate, std::vector<Tone> tones, float bpm, float noise,
+                                     uint32_t seed)
+        : rate(sample_rate), tones(std::move(tones)), bpm(bpm), noise(noise), gen(seed) {
+    }
+
+    size_t SyntheticSource::read(int16_t *samples, size_t count) {
+        auto beat_length = static_cast<uint64_t>(bpm > 0.0f ? rate * 60.0f / bpm : 0.0f);
+        for (size_t i = 0; i < count; i++, position++) {
+            float t = static_cast<float>(position % (rate * 1000ull)) / rate;
+            float value = 0.0f;
+            for (const Tone &tone: tones) {
+                value += tone.amplitude * std::sin(2.0f * static_cast<float>(M_PI) * tone.frequency * t);
+            }
+            if (beat_length > 0) {
+                // a 55 Hz thump dying away within about 150 ms
+                float since = static_cast<float>(position % beat_length) / rate;
+                value += 0.8f * std::exp(-since * 30.0f) * std::sin(2.0f * static_cast<float>(M_PI) * 55.0f * since);
+            }
+            if (noise > 0.0f) {
+                value += noise * (2.0f * gen.nextFloat() - 1.0f);
+            }
+            samples[i] = static_cast<int16_t>(std::max(-1.0f, std::min(1.0f, value)) * 32767.0f);
+        }
+        return count;
+    }
+
+    // --- WavSource ----------------------------------------------------------
+
+    WavSource::WavSource(const std::string &path, bool loop) : loop(loop) {
+        file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            return;
+        }
+        char tag[4];
+        bool riff = std::fread(tag, 1, 4, file) == 4 && std::memcmp(tag, "RIFF", 4) == 0;
+        readLittleEndian(file, 4);
+        riff = riff && std::fread(tag, 1, 4, file) == 4 && std::memcmp(tag, "WAVE", 4) == 0;
+
+        bool pcm16 = false;
+        while (riff && std::fread(tag, 1, 4, file) == 4) {
+            uint32_t chunk = readLittleEndian(file, 4);
+            if (std::memcmp(tag, "fmt ", 4) == 0) {
+                uint16_t format = readLittleEndian(file, 2);
+                channels = readLittleEndian(file, 2);
+                rate = readLittleEndian(file, 4);
+                readLittleEndian(file, 6); // byte rate, block align
+                uint16_t bits = readLittleEndian(file, 2);
+                pcm16 = format == 1 && bits == 16 && channels > 0;
+                std::fseek(file, static_cast<long>(chunk - 16 + (chunk & 1)), SEEK_CUR);
+            } else if (std::memcmp(tag, "data", 4) == 0) {
+                if (pcm16) {
+                    data_start = std::ftell(file);
+                    data_frames = chunk / (2 * channels);
+                    frames_left = data_frames;
+                    return;
+                }
+                break;
+            } else {
+                std::fseek(file, static_cast<long>(chunk + (chunk & 1)), SEEK_CUR);
+            }
+        }
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    WavSource::~WavSource() {
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+    }
+
+    size_t WavSource::read(int16_t *samples, size_t count) {
+        size_t done = 0;
+        while (file != nullptr && done < count) {
+            if (frames_left == 0) {
+                if (!loop || data_frames == 0) {
+                    break;
+                }
+                std::fseek(file, data_start, SEEK_SET);
+                frames_left = data_frames;
+            }
+            int32_t sum = 0;
+            for (uint16_t c = 0; c < channels; c++) {
+                sum += static_cast<int16_t>(readLittleEndian(file, 2));
+            }
+            samples[done++] = static_cast<int16_t>(sum / channels);
+            frames_left--;
+        }
+        return done;
+    }
+
+    // --- RealFFT ------------------------------------------------------------
+
+    RealFFT::RealFFT(size_t size) : size(size), cosines(size / 2 + 1), sines(size / 2 + 1),
+                                    reversed(size / 2), re(size / 2), im(size / 2) {
+        for (size_t k = 0; k <= size / 2; k++) {
+            cosines[k] = static_cast<float>(std::cos(2.0 * M_PI * k / size));
+            sines[k] = static_cast<float>(std::sin(2.0 * M_PI * k / size));
+        }
+        size_t half = size / 2;
+        unsigned int bits = 0;
+        while ((1u << bits) < half) {
+            bits++;
+        }
+        for (size_t i = 0; i < half; i++) {
+            uint16_t r = 0;
+            for (unsigned int b = 0; b < bits; b++) {
+                r |= ((i >> b) & 1) << (bits - 1 - b);
+            }
+            reversed[i] = r;
+        }
+    }
+
+    void RealFFT::power(const float *input, float *power) {
+        const size_t half = size / 2;
+        // even samples as real, odd as imaginary parts, in bit reversed order
+        for (size_t i = 0; i < half; i++) {
+            re[reversed[i]] = input[2 * i];
+            im[reversed[i]] = input[2 * i + 1];
+        }
+
+        for (size_t length = 2; length <= half; length <<= 1) {
+            size_t step = size / length; // twiddle stride in units of 2 pi / size
+            size_t middle = length / 2;
+            for (size_t start = 0; start < half; start += length) {
+                for (size_t j = 0; j < middle; j++) {
+                    float wr = cosines[j * step];
+                    float wi = -sines[j * step];
+                    size_t a = start + j;
+                    size_t b = a + middle;
+                    float vr = re[b] * wr - im[b] * wi;
+                    float vi = re[b] * wi + im[b] * wr;
+                    re[b] = re[a] - vr;
+                    im[b] = im[a] - vi;
+                    re[a] += vr;
+                    im[a] += vi;
+                }
+            }
+        }
+
+        // split the half size spectrum Z into the spectrum X of the real input
+        for (size_t k = 0; k <= half; k++) {
+            size_t i = k % half;
+            size_t j = (half - k) % half;
+            float even_re = (re[i] + re[j]) / 2;
+            float even_im = (im[i] - im[j]) / 2;
+            float odd_re = (im[i] + im[j]) / 2;
+            float odd_im = (re[j] - re[i]) / 2;
+            float wr = cosines[k];
+            float wi = -sines[k];
+            float x_re = even_re + odd_re * wr - odd_im * wi;
+            float x_im = even_im + odd_re * wi + odd_im * wr;
+            power[k] = x_re * x_re + x_im * x_im;
+        }
+    }
+
+    // --- Analyzer -----------------------------------------------------------
+
+    Analyzer::Analyzer(uint32_t sample_rate)
+        : rate(sample_rate), fft(SIZE), ceiling_db(MIN_CEILING_DB),
+          since_beat(static_cast<uint32_t>(sample_rate * MIN_BEAT_SECONDS)) {
+        for (size_t i = 0; i < SIZE; i++) {
+            window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * M_PI * i / SIZE));
+        }
+        // log spaced from the first bin to the last below Nyquist, at least one bin each
+        const float last = SIZE / 2;
+        edges[0] = 1;
+        for (size_t b = 1; b <= BANDS; b++) {
+            auto edge = static_cast<uint16_t>(std::lround(std::pow(last, static_cast<float>(b) / BANDS)));
+            edges[b] = std::max<uint16_t>(edge, edges[b - 1] + 1);
+        }
+        edges[BANDS] = SIZE / 2;
+        bass_end = static_cast<uint16_t>(std::max(2.0f, BASS_HZ * SIZE / rate + 1));
+    }
+
+    size_t Analyzer::push(const int16_t *samples, size_t count) {
+        size_t analyses = 0;
+        for (size_t i = 0; i < count; i++) {
+            history[filled++] = samples[i] / 32768.0f;
+            if (filled == SIZE) {
+                analyze();
+                analyses++;
+                std::memmove(history.data(), history.data() + HOP, (SIZE - HOP) * sizeof(float));
+                filled = SIZE - HOP;
+            }
+        }
+        return analyses;
+    }
+
+    void Analyzer::analyze() {
+        float square_sum = 0.0f;
+        for (size_t i = SIZE - HOP; i < SIZE; i++) {
+            square_sum += history[i] * history[i];
+        }
+        for (size_t i = 0; i < SIZE; i++) {
+            input[i] = history[i] * window[i];
+        }
+        fft.power(input.data(), spectrum.data());
+
+        float loudest = -200.0f;
+        std::array<float, BANDS> band_db{};
+        for (size_t b = 0; b < BANDS; b++) {
+            float energy = 0.0f;
+            for (uint16_t k = edges[b]; k < edges[b + 1]; k++) {
+                energy += spectrum[k];
+            }
+            band_db[b] = 10.0f * std::log10(energy / (edges[b + 1] - edges[b]) + 1e-12f);
+            loudest = std::max(loudest, band_db[b]);
+        }
+        ceiling_db = std::max({loudest, ceiling_db - CEILING_RELEASE_DB, MIN_CEILING_DB});
+        for (size_t b = 0; b < BANDS; b++) {
+            current.bands[b] = clamp01((band_db[b] - (ceiling_db - RANGE_DB)) / RANGE_DB);
+        }
+
+        // -60 dBFS RMS is silent, full scale is 1
+        float rms_db = 10.0f * std::log10(square_sum / HOP + 1e-12f);
+        current.level = clamp01((rms_db + 60.0f) / 60.0f);
+
+        float bass = 0.0f;
+        for (uint16_t k = 1; k < bass_end; k++) {
+            bass += spectrum[k];
+        }
+        since_beat += HOP;
+        // SIZE / HOP analyses back the windows no longer overlap
+        float window_ago = bass_history[0];
+        std::rotate(bass_history.begin(), bass_history.begin() + 1, bass_history.end());
+        bass_history.back() = bass;
+        if (bass > MIN_BEAT_ENERGY && bass > BEAT_RATIO * bass_average && bass > ONSET_RATIO * window_ago &&
+            since_beat >= rate * MIN_BEAT_SECONDS) {
+            current.beats++;
+            float ratio = bass / std::max(bass_average, 1e-6f);
+            current.beat_strength = clamp01(std::log2(ratio) / 5.0f);
+            since_beat = 0;
+        }
+        // averaged over about a second
+        float alpha = static_cast<float>(HOP) / rate;
+        bass_average += alpha * (bass - bass_average);
+
+        current.analyses++;
+    }
+
+    bool pump(Source &source, Analyzer &analyzer, Channel &output) {
+        int16_t samples[Analyzer::HOP];
+        size_t count = source.read(samples, Analyzer::HOP);
+        if (count == 0) {
+            return false;
+        }
+        if (analyzer.push(samples, count) > 0) {
+            output.write(analyzer.frame());
+        }
+        return true;
+    }
+} // Support::Audio
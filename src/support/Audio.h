@@ -0,0 +1,203 @@
+#ifndef LEDZ_SUPPORT_AUDIO_H
+#define LEDZ_SUPPORT_AUDIO_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "SeqLock.h"
+#include "Random.h"
+
+namespace Support::Audio {
+    static constexpr size_t BANDS = 16;
+
+    /**
+     * One analysis of the latest audio, as published to the shows
+     */
+    struct Frame {
+        std::array<float, BANDS> bands{}; // loudness per band, 0-1, low to high frequencies
+        float level = 0.0f; // overall loudness, 0-1
+        float beat_strength = 0.0f; // of the latest beat, 0-1
+        uint32_t beats = 0; // beats detected so far; a show sees a new beat when this changes
+        uint32_t analyses = 0; // analyses so far
+    };
+
+    typedef SeqLock<Frame> Channel;
+
+    /**
+     * The channel the audio task publishes to and reactive shows read by default
+     */
+    Channel &channel();
+
+    /**
+     * Mono 16 bit sample input
+     */
+    class Source {
+    public:
+        virtual ~Source() = default;
+
+        virtual uint32_t sampleRate() const = 0;
+
+        /**
+         * Read samples, blocking until they are available if the source is live
+         * @param samples Receives the samples
+         * @param count Number of samples wanted
+         * @return Number of samples read, 0 once a finite source is exhausted
+         */
+        virtual size_t read(int16_t *samples, size_t count) = 0;
+    };
+
+    /**
+     * Generated test signal: steady tones, noise and a kick drum at a tempo
+     */
+    class SyntheticSource : public Source {
+    public:
+        struct Tone {
+            float frequency; // Hz
+            float amplitude; // 0-1 of full scale
+        };
+
+        /**
+         * @param sample_rate Samples per second
+         * @param tones Steady sine tones
+         * @param bpm Kick drums per minute, 0 for none
+         * @param noise Amplitude of white noise, 0-1
+         * @param seed Noise seed
+         */
+        explicit SyntheticSource(uint32_t sample_rate = 22050, std::vector<Tone> tones = {}, float bpm = 0.0f,
+                                 float noise = 0.0f, uint32_t seed = 1);
+
+        uint32_t sampleRate() const override { return rate; }
+
+        size_t read(int16_t *samples, size_t count) override;
+
+    private:
+        uint32_t rate;
+        std::vector<Tone> tones;
+        float bpm;
+        float noise;
+        Random gen;
+        uint64_t position = 0;
+    };
+
+    /**
+     * 16 bit PCM WAV file, mixed down to mono
+     */
+    class WavSource : public Source {
+    public:
+        /**
+         * @param path File to play
+         * @param loop Start over at the end instead of running dry
+         */
+        explicit WavSource(const std::string &path, bool loop = false);
+
+        ~WavSource() override;
+
+        WavSource(const WavSource &) = delete;
+
+        WavSource &operator=(const WavSource &) = delete;
+
+        /**
+         * @return false if the file is missing or not 16 bit PCM
+         */
+        bool isValid() const { return file != nullptr; }
+
+        uint32_t sampleRate() const override { return rate; }
+
+        size_t read(int16_t *samples, size_t count) override;
+
+    private:
+        std::FILE *file = nullptr;
+        bool loop;
+        uint32_t rate = 0;
+        uint16_t channels = 0;
+        long data_start = 0;
+        uint32_t data_frames = 0;
+        uint32_t frames_left = 0;
+    };
+
+    /**
+     * Power spectrum of real input, computed as a complex FFT of half the size
+     * plus a split step, with precomputed twiddles and bit reversal
+     */
+    class RealFFT {
+    public:
+        /**
+         * @param size Number of input samples, a power of two of at least 4
+         */
+        explicit RealFFT(size_t size);
+
+        /**
+         * @param input size samples
+         * @param power Receives |X[k]|^2 for k = 0 .. size / 2
+         */
+        void power(const float *input, float *power);
+
+    private:
+        size_t size;
+        std::vector<float> cosines; // cos(2 pi k / size), k = 0 .. size / 2
+        std::vector<float> sines;
+        std::vector<uint16_t> reversed;
+        std::vector<float> re;
+        std::vector<float> im;
+    };
+
+    /**
+     * Turns samples into published frames: a Hann windowed FFT every HOP
+     * samples over the last SIZE, log spaced band loudness with automatic
+     * gain, and beats from jumps in bass energy over its recent average.
+     */
+    class Analyzer {
+    public:
+        static constexpr size_t SIZE = 512;
+        static constexpr size_t HOP = 256;
+
+        explicit Analyzer(uint32_t sample_rate = 22050);
+
+        /**
+         * Add samples, analysing every time another HOP is complete
+         * @return Number of analyses run
+         */
+        size_t push(const int16_t *samples, size_t count);
+
+        /**
+         * @return The latest analysis
+         */
+        const Frame &frame() const { return current; }
+
+        /**
+         * @return The first FFT bin of each band, plus the end of the last band
+         */
+        const std::array<uint16_t, BANDS + 1> &bandEdges() const { return edges; }
+
+    private:
+        uint32_t rate;
+        RealFFT fft;
+        std::array<float, SIZE> window;
+        std::array<float, SIZE> history{};
+        std::array<float, SIZE> input{};
+        std::array<float, SIZE / 2 + 1> spectrum{};
+        std::array<uint16_t, BANDS + 1> edges{};
+        size_t filled = SIZE - HOP;
+        uint16_t bass_end; // bass bins are 1 .. bass_end - 1
+
+        Frame current;
+        float ceiling_db; // loudest recent band, the top of the band scale
+        float bass_average = 0.0f;
+        std::array<float, SIZE / HOP> bass_history{}; // bass energy of the last analyses, oldest first
+        uint32_t since_beat; // samples
+
+        void analyze();
+    };
+
+    /**
+     * One step of the audio task: read a hop of samples, analyze and publish
+     * @return false if the source ran dry
+     */
+    bool pump(Source &source, Analyzer &analyzer, Channel &output);
+} // Support::Audio
+
+#endif //LEDZ_SUPPORT_AUDIO_H
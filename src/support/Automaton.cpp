@@ -0,0 +1,174 @@
+#include "Automaton.h"
+
+namespace Support::Automaton {
+    namespace {
+        inline size_t wordsFor(size_t cells) {
+            return (cells + WORD_BITS - 1) / WORD_BITS;
+        }
+
+        // valid bits of the last word of a row
+        inline Word tailMask(size_t cells) {
+            size_t used = cells % WORD_BITS;
+            return used == 0 ? ~Word(0) : (Word(1) << used) - 1;
+        }
+
+        inline bool anyAlive(const std::vector<Word> &cells) {
+            for (Word word: cells) {
+                if (word != 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // sum of minterms, each neighbourhood l c r as a number 0-7
+        inline Word sumOfMinterms(const uint8_t *minterms, uint8_t count, Word l, Word c, Word r) {
+            Word result = 0;
+            for (uint8_t j = 0; j < count; j++) {
+                uint8_t k = minterms[j];
+                result |= (k & 4 ? l : ~l) & (k & 2 ? c : ~c) & (k & 1 ? r : ~r);
+            }
+            return result;
+        }
+    }
+
+    void neighbours(const Word *row, size_t words, size_t width, Word *left, Word *right) {
+        size_t last = words - 1;
+        size_t tail = (width - 1) % WORD_BITS;
+        Word first_cell = row[0] & 1;
+        Word last_cell = (row[last] >> tail) & 1;
+        for (size_t k = 0; k < words; k++) {
+            Word previous = k == 0 ? last_cell << (WORD_BITS - 1) : row[k - 1];
+            left[k] = (row[k] << 1) | (previous >> (WORD_BITS - 1));
+            if (k == last) {
+                // unused bits above tail are clear, so cell 0 can be put in place directly
+                right[k] = (row[k] >> 1) | (first_cell << tail);
+            } else {
+                right[k] = (row[k] >> 1) | (row[k + 1] << (WORD_BITS - 1));
+            }
+        }
+    }
+
+    Elementary::Elementary(uint8_t rule) : rule(rule) {
+    }
+
+    void Elementary::resize(size_t new_count) {
+        count = new_count;
+        cells.assign(wordsFor(count), 0);
+        left.assign(cells.size(), 0);
+        right.assign(cells.size(), 0);
+    }
+
+    void Elementary::set(size_t index, bool alive) {
+        Word bit = Word(1) << (index % WORD_BITS);
+        if (alive) {
+            cells[index / WORD_BITS] |= bit;
+        } else {
+            cells[index / WORD_BITS] &= ~bit;
+        }
+    }
+
+    bool Elementary::step() {
+        if (count == 0) {
+            return false;
+        }
+        neighbours(cells.data(), cells.size(), count, left.data(), right.data());
+
+        // the live neighbourhoods of the rule, or the dead ones if there are fewer
+        uint8_t live[8], dead[8];
+        uint8_t live_count = 0, dead_count = 0;
+        for (uint8_t k = 0; k < 8; k++) {
+            if ((rule >> k) & 1) {
+                live[live_count++] = k;
+            } else {
+                dead[dead_count++] = k;
+            }
+        }
+        bool invert = live_count > dead_count;
+        const uint8_t *minterms = invert ? dead : live;
+        uint8_t minterm_count = invert ? dead_count : live_count;
+        Word flip = invert ? ~Word(0) : 0;
+
+        Word changed = 0;
+        for (size_t k = 0; k < cells.size(); k++) {
+            Word updated = sumOfMinterms(minterms, minterm_count, left[k], cells[k], right[k]) ^ flip;
+            if (k == cells.size() - 1) {
+                updated &= tailMask(count);
+            }
+            changed |= updated ^ cells[k];
+            cells[k] = updated;
+        }
+        return changed != 0;
+    }
+
+    bool Elementary::empty() const {
+        return !anyAlive(cells);
+    }
+
+    void Life::resize(size_t width, size_t height) {
+        columns = width;
+        rows = height;
+        stride = wordsFor(width);
+        cells.assign(stride * rows, 0);
+        next.assign(cells.size(), 0);
+        left.assign(cells.size(), 0);
+        right.assign(cells.size(), 0);
+    }
+
+    void Life::set(size_t x, size_t y, bool alive) {
+        Word bit = Word(1) << (x % WORD_BITS);
+        Word &word = cells[y * stride + x / WORD_BITS];
+        word = alive ? word | bit : word & ~bit;
+    }
+
+    bool Life::step() {
+        if (cells.empty()) {
+            return false;
+        }
+        for (size_t y = 0; y < rows; y++) {
+            size_t offset = y * stride;
+            neighbours(&cells[offset], stride, columns, &left[offset], &right[offset]);
+        }
+
+        Word mask = tailMask(columns);
+        Word changed = 0;
+        for (size_t y = 0; y < rows; y++) {
+            size_t up = (y == 0 ? rows - 1 : y - 1) * stride;
+            size_t middle = y * stride;
+            size_t down = (y + 1 == rows ? 0 : y + 1) * stride;
+            for (size_t k = 0; k < stride; k++) {
+                // column sums of the rows above and below, 0-3 as two bits
+                Word a = left[up + k], b = cells[up + k], c = right[up + k];
+                Word up_ones = a ^ b ^ c;
+                Word up_twos = (a & b) | (c & (a ^ b));
+                a = left[down + k], b = cells[down + k], c = right[down + k];
+                Word down_ones = a ^ b ^ c;
+                Word down_twos = (a & b) | (c & (a ^ b));
+                // the row itself, 0-2
+                Word middle_ones = left[middle + k] ^ right[middle + k];
+                Word middle_twos = left[middle + k] & right[middle + k];
+
+                Word ones = up_ones ^ down_ones ^ middle_ones;
+                Word carry = (up_ones & down_ones) | (middle_ones & (up_ones ^ down_ones));
+                // 2 or 3 neighbours: exactly one of the four twos is set
+                Word pair1 = up_twos ^ down_twos, both1 = up_twos & down_twos;
+                Word pair2 = middle_twos ^ carry, both2 = middle_twos & carry;
+                Word one_two = (pair1 ^ pair2) & ~(both1 | both2);
+
+                Word alive = cells[middle + k];
+                Word updated = one_two & (ones | alive);
+                if (k == stride - 1) {
+                    updated &= mask;
+                }
+                changed |= updated ^ alive;
+                next[middle + k] = updated;
+            }
+        }
+        cells.swap(next);
+        return changed != 0;
+    }
+
+    bool Life::empty() const {
+        return !anyAlive(cells);
+    }
+} // Support::Automaton
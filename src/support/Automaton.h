@@ -0,0 +1,125 @@
+#ifndef LEDZ_SUPPORT_AUTOMATON_H
+#define LEDZ_SUPPORT_AUTOMATON_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Support::Automaton {
+    /**
+     * 32 cells, cell i of a row in bit i % 32 of word i / 32
+     */
+    typedef uint32_t Word;
+
+    static constexpr size_t WORD_BITS = 32;
+
+    /**
+     * Elementary (Wolfram) cellular automaton on a ring of cells.
+     *
+     * Cells are bit-packed and a generation is computed a word at a time: the
+     * left and right neighbours are the row shifted by one, and the rule is
+     * applied as a sum of its minterms, at most four ANDs of three words (the
+     * complement is used for rules with more than four bits set).
+     */
+    class Elementary {
+    public:
+        /**
+         * @param rule Wolfram rule number, e.g. 30, 90 or 110
+         */
+        explicit Elementary(uint8_t rule = 30);
+
+        /**
+         * Resize the ring, all cells dead
+         * @param cells Number of cells
+         */
+        void resize(size_t cells);
+
+        size_t size() const { return count; }
+
+        bool get(size_t index) const { return (cells[index / WORD_BITS] >> (index % WORD_BITS)) & 1; }
+
+        void set(size_t index, bool alive);
+
+        void setRule(uint8_t new_rule) { rule = new_rule; }
+
+        uint8_t getRule() const { return rule; }
+
+        /**
+         * Compute the next generation
+         * @return true if any cell changed
+         */
+        bool step();
+
+        /**
+         * @return true if no cell is alive
+         */
+        bool empty() const;
+
+        const std::vector<Word> &words() const { return cells; }
+
+    private:
+        uint8_t rule;
+        size_t count = 0;
+        std::vector<Word> cells;
+        std::vector<Word> left;
+        std::vector<Word> right;
+    };
+
+    /**
+     * Conway's Game of Life on a torus of width x height cells.
+     *
+     * Each row is bit-packed like Elementary. The eight neighbour counts of a
+     * word of cells are added bit-sliced with full adders, so a generation
+     * costs a few dozen bitwise operations per 32 cells.
+     */
+    class Life {
+    public:
+        /**
+         * Resize the grid, all cells dead
+         */
+        void resize(size_t width, size_t height);
+
+        size_t width() const { return columns; }
+
+        size_t height() const { return rows; }
+
+        bool get(size_t x, size_t y) const {
+            return (cells[y * stride + x / WORD_BITS] >> (x % WORD_BITS)) & 1;
+        }
+
+        void set(size_t x, size_t y, bool alive);
+
+        /**
+         * Compute the next generation
+         * @return true if any cell changed
+         */
+        bool step();
+
+        /**
+         * @return true if no cell is alive
+         */
+        bool empty() const;
+
+    private:
+        size_t columns = 0;
+        size_t rows = 0;
+        size_t stride = 0; // words per row
+        std::vector<Word> cells;
+        std::vector<Word> next;
+        std::vector<Word> left;
+        std::vector<Word> right;
+    };
+
+    /**
+     * The row as seen from each cell's left and right neighbour, wrapping
+     * around at the ends
+     * @param row Bit-packed cells, unused bits of the last word clear
+     * @param words Words in the row
+     * @param width Cells in the row
+     * @param left Receives bit i = cell i - 1
+     * @param right Receives bit i = cell i + 1
+     */
+    void neighbours(const Word *row, size_t words, size_t width, Word *left, Word *right);
+} // Support::Automaton
+
+#endif //LEDZ_SUPPORT_AUTOMATON_H
@@ -0,0 +1,122 @@
+#include "Blend.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Support::Blend {
+    void crossfade(const Strip::Color *from, const Strip::Color *to, Strip::Color *out, size_t length,
+                   uint8_t amount) {
+        for (size_t i = 0; i < length; i++) {
+            out[i] = mix(from[i], to[i], amount);
+        }
+    }
+
+    void wipe(const Strip::Color *from, const Strip::Color *to, Strip::Color *out, size_t length,
+              uint8_t amount) {
+        for (size_t i = 0; i < length; i++) {
+            out[i] = mix(from[i], to[i], wipeWeight(i, length, amount));
+        }
+    }
+
+    void dissolve(const Strip::Color *from, const Strip::Color *to, Strip::Color *out, size_t length,
+                  uint8_t amount) {
+        for (size_t i = 0; i < length; i++) {
+            out[i] = amount > dissolveThreshold(i) ? to[i] : from[i];
+        }
+    }
+
+    namespace {
+        // Per-lane saturating add of two pixels
+        inline Strip::Color add_saturate(Strip::Color a, Strip::Color b) {
+            uint32_t rb = (a & 0xFF00FF) + (b & 0xFF00FF);
+            uint32_t g = (a & 0x00FF00) + (b & 0x00FF00);
+            // a carry out of a lane becomes 0xFF in that lane
+            uint32_t rb_carry = rb & 0x1000100;
+            uint32_t g_carry = g & 0x0010000;
+            rb = (rb | (rb_carry - (rb_carry >> 8))) & 0xFF00FF;
+            g = (g | (g_carry - (g_carry >> 8))) & 0x00FF00;
+            return rb | g;
+        }
+
+        // Per-lane product of two pixels, scaled back to 0-255
+        inline Strip::Color multiply(Strip::Color a, Strip::Color b) {
+            uint32_t r = ((a >> 16 & 0xFF) * (b >> 16 & 0xFF) + 255) >> 8;
+            uint32_t g = ((a >> 8 & 0xFF) * (b >> 8 & 0xFF) + 255) >> 8;
+            uint32_t bl = ((a & 0xFF) * (b & 0xFF) + 255) >> 8;
+            return r << 16 | g << 8 | bl;
+        }
+
+        inline Strip::Color maximum(Strip::Color a, Strip::Color b) {
+            uint32_t r = std::max(a & 0xFF0000, b & 0xFF0000);
+            uint32_t g = std::max(a & 0x00FF00, b & 0x00FF00);
+            uint32_t bl = std::max(a & 0x0000FF, b & 0x0000FF);
+            return r | g | bl;
+        }
+    }
+
+    Mode modeFromName(const char *name) {
+        if (name == nullptr) {
+            return Mode::NORMAL;
+        }
+        if (strcmp(name, "add") == 0) {
+            return Mode::ADD;
+        }
+        if (strcmp(name, "multiply") == 0) {
+            return Mode::MULTIPLY;
+        }
+        if (strcmp(name, "screen") == 0) {
+            return Mode::SCREEN;
+        }
+        if (strcmp(name, "max") == 0) {
+            return Mode::MAX;
+        }
+        return Mode::NORMAL;
+    }
+
+    const char *modeName(Mode mode) {
+        switch (mode) {
+            case Mode::ADD:
+                return "add";
+            case Mode::MULTIPLY:
+                return "multiply";
+            case Mode::SCREEN:
+                return "screen";
+            case Mode::MAX:
+                return "max";
+            case Mode::NORMAL:
+            default:
+                return "normal";
+        }
+    }
+
+    void composite(Mode mode, const Strip::Color *layer, Strip::Color *base, size_t length, uint8_t opacity) {
+        switch (mode) {
+            case Mode::NORMAL:
+                for (size_t i = 0; i < length; i++) {
+                    base[i] = mix(base[i], layer[i], opacity);
+                }
+                break;
+            case Mode::ADD:
+                for (size_t i = 0; i < length; i++) {
+                    base[i] = add_saturate(base[i], mix(0, layer[i], opacity));
+                }
+                break;
+            case Mode::MULTIPLY:
+                for (size_t i = 0; i < length; i++) {
+                    base[i] = mix(base[i], multiply(base[i], layer[i]), opacity);
+                }
+                break;
+            case Mode::SCREEN:
+                for (size_t i = 0; i < length; i++) {
+                    Strip::Color screened = ~multiply(~base[i] & 0xFFFFFF, ~layer[i] & 0xFFFFFF) & 0xFFFFFF;
+                    base[i] = mix(base[i], screened, opacity);
+                }
+                break;
+            case Mode::MAX:
+                for (size_t i = 0; i < length; i++) {
+                    base[i] = mix(base[i], maximum(base[i], layer[i]), opacity);
+                }
+                break;
+        }
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef LEDZ_SUPPORT_BLEND_H
+#define LEDZ_SUPPORT_BLEND_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "strip/Strip.h"
+
+namespace Support::Blend {
+    /**
+     * Mix two packed 0xRRGGBB colors.
+     * Red and blue are weighted together in one multiply, green in another.
+     * @param from Color at amount 0
+     * @param to Color at amount 255
+     * @param amount Weight of to (0-255, 255 yields to exactly)
+     */
+    inline Strip::Color mix(Strip::Color from, Strip::Color to, uint8_t amount) {
+        uint32_t w = amount + (amount >> 7); // 0..256
+        uint32_t rb = ((from & 0xFF00FF) * (256 - w) + (to & 0xFF00FF) * w) >> 8;
+        uint32_t g = ((from & 0x00FF00) * (256 - w) + (to & 0x00FF00) * w) >> 8;
+        return (rb & 0xFF00FF) | (g & 0x00FF00);
+    }
+
+    /**
+     * Per-pixel weight of a wipe: pixels before the edge show to, pixels after
+     * it from, with one pixel of anti-aliasing at the edge
+     * @param index Pixel index
+     * @param length Number of pixels
+     * @param amount Progress (0-255)
+     * @return Weight of to for this pixel
+     */
+    inline uint8_t wipeWeight(size_t index, size_t length, uint8_t amount) {
+        // edge position in 1/256 pixel
+        uint32_t edge = (static_cast<uint32_t>(length) * 256 * amount) / 255;
+        uint32_t position = static_cast<uint32_t>(index) * 256;
+        if (position + 256 <= edge) {
+            return 255;
+        }
+        if (position >= edge) {
+            return 0;
+        }
+        return static_cast<uint8_t>(edge - position - 1);
+    }
+
+    /**
+     * Per-pixel switch-over point of a dissolve, a fixed hash of the index so the
+     * pattern needs no storage and is stable across frames
+     * @param index Pixel index
+     * @return Progress (0-254) at which the pixel turns to the incoming show
+     */
+    inline uint8_t dissolveThreshold(size_t index) {
+        uint32_t h = static_cast<uint32_t>(index) * 0x9E3779B1u;
+        h ^= h >> 15;
+        h *= 0x85EBCA77u;
+        h ^= h >> 13;
+        return static_cast<uint8_t>((h >> 24) % 255);
+    }
+
+    /**
+     * Crossfade all pixels by the same amount
+     * out may alias from or to.
+     */
+    void crossfade(const Strip::Color *from, const Strip::Color *to, Strip::Color *out, size_t length,
+                   uint8_t amount);
+
+    /**
+     * Sweep the incoming pixels in from index 0 upwards
+     * out may alias from or to.
+     */
+    void wipe(const Strip::Color *from, const Strip::Color *to, Strip::Color *out, size_t length,
+              uint8_t amount);
+
+    /**
+     * Switch pixels over one by one in a scattered order
+     * out may alias from or to.
+     */
+    void dissolve(const Strip::Color *from, const Strip::Color *to, Strip::Color *out, size_t length,
+                  uint8_t amount);
+
+    /**
+     * Layer blend modes, applied per channel
+     */
+    enum class Mode {
+        NORMAL, // layer over base, weighted by opacity
+        ADD, // base + layer, saturating
+        MULTIPLY, // base * layer / 255
+        SCREEN, // 255 - (255 - base) * (255 - layer) / 255
+        MAX // brighter of base and layer
+    };
+
+    /**
+     * @param name "normal", "add", "multiply", "screen" or "max"
+     * @return Matching mode, NORMAL if unknown
+     */
+    Mode modeFromName(const char *name);
+
+    const char *modeName(Mode mode);
+
+    /**
+     * Composite a layer onto a base in place, one tight loop per mode
+     * @param mode Blend mode
+     * @param layer Layer pixels
+     * @param base Base pixels, overwritten with the result
+     * @param length Number of pixels
+     * @param opacity Layer opacity (0-255)
+     */
+    void composite(Mode mode, const Strip::Color *layer, Strip::Color *base, size_t length, uint8_t opacity);
+}
+
+#endif //LEDZ_SUPPORT_BLEND_H
@@ -0,0 +1,276 @@
+#include "Clip.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Delta.h"
+
+namespace Support::Clip {
+    namespace {
+        const char MAGIC[4] = {'L', 'E', 'D', 'C'};
+
+        inline uint16_t read16(const uint8_t *bytes) {
+            return bytes[0] | (bytes[1] << 8);
+        }
+
+        inline uint32_t read32(const uint8_t *bytes) {
+            return read16(bytes) | (static_cast<uint32_t>(read16(bytes + 2)) << 16);
+        }
+
+        inline void write16(std::vector<uint8_t> &out, uint16_t value) {
+            out.push_back(value & 0xFF);
+            out.push_back(value >> 8);
+        }
+
+        inline void write32(std::vector<uint8_t> &out, uint32_t value) {
+            write16(out, value & 0xFFFF);
+            write16(out, value >> 16);
+        }
+
+        // header of an open clip, leaves the file at the palette
+        bool readHeader(std::FILE *file, Header &header) {
+            uint8_t bytes[HEADER_SIZE];
+            if (std::fread(bytes, 1, HEADER_SIZE, file) != HEADER_SIZE || std::fseek(file, 0, SEEK_END) != 0) {
+                return false;
+            }
+            long size = std::ftell(file);
+            return size >= 0 && parseHeader(bytes, size, header) && std::fseek(file, HEADER_SIZE, SEEK_SET) == 0;
+        }
+    }
+
+    bool isValidName(const std::string &name) {
+        if (name.empty() || name.size() > MAX_NAME_LENGTH) {
+            return false;
+        }
+        return std::all_of(name.begin(), name.end(), [](char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+        });
+    }
+
+    std::string fileName(const std::string &name) {
+        return "/" + name + EXTENSION;
+    }
+
+    std::string path(const std::string &name) {
+#ifdef ARDUINO
+        // where the SPIFFS library mounts the spiffs partition
+        return "/spiffs" + fileName(name);
+#else
+        return name + EXTENSION;
+#endif
+    }
+
+    bool parseHeader(const uint8_t *bytes, size_t file_size, Header &header) {
+        if (file_size < HEADER_SIZE || std::memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0 || bytes[4] != VERSION) {
+            return false;
+        }
+        header.fps = bytes[5];
+        header.pixels = read16(bytes + 6);
+        header.frames = read32(bytes + 8);
+        header.colors = read16(bytes + 12);
+        header.keyframe_interval = read16(bytes + 14);
+        if (header.fps == 0 || header.fps > MAX_FPS || header.pixels == 0 || header.pixels > INT16_MAX ||
+            header.frames == 0 || header.colors == 0 || header.colors > MAX_COLORS) {
+            return false;
+        }
+        // every frame takes at least its record header
+        uint64_t minimum = HEADER_SIZE + header.colors * sizeof(Strip::Color) +
+                           static_cast<uint64_t>(header.frames) * FRAME_HEADER_SIZE;
+        return file_size >= minimum;
+    }
+
+    bool readHeader(const std::string &path, Header &header) {
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            return false;
+        }
+        bool valid = readHeader(file, header);
+        std::fclose(file);
+        return valid;
+    }
+
+    // --- Encoder ------------------------------------------------------------
+
+    Encoder::Encoder(Strip::PixelIndex length, uint8_t fps, uint16_t keyframe_interval)
+        : previous(std::max<Strip::PixelIndex>(0, length), 0), black(previous.size(), 0) {
+        header.fps = std::max<uint8_t>(1, std::min(fps, MAX_FPS));
+        header.pixels = static_cast<uint16_t>(previous.size());
+        header.keyframe_interval = std::max<uint16_t>(1, keyframe_interval);
+    }
+
+    bool Encoder::append(const Strip::Color *frame) {
+        const bool keyframe = frame_count % header.keyframe_interval == 0;
+        const size_t known_colors = palette.size();
+        auto index = [this](Strip::Color color, uint8_t &index) {
+            auto it = palette_lookup.find(color);
+            if (it != palette_lookup.end()) {
+                index = it->second;
+                return true;
+            }
+            if (palette.size() >= MAX_COLORS) {
+                return false;
+            }
+            index = static_cast<uint8_t>(palette.size());
+            palette.push_back(color);
+            palette_lookup.emplace(color, index);
+            return true;
+        };
+
+        std::vector<uint8_t> ops;
+        if (!Delta::encode(frame, keyframe ? black.data() : previous.data(), header.pixels, index, ops)) {
+            // forget the colors of the rejected frame
+            for (size_t i = known_colors; i < palette.size(); i++) {
+                palette_lookup.erase(palette[i]);
+            }
+            palette.resize(known_colors);
+            return false;
+        }
+
+        data.push_back(keyframe ? KEYFRAME : DELTA);
+        write16(data, static_cast<uint16_t>(ops.size()));
+        data.insert(data.end(), ops.begin(), ops.end());
+        std::copy(frame, frame + header.pixels, previous.begin());
+        frame_count++;
+        return true;
+    }
+
+    std::vector<uint8_t> Encoder::finish() const {
+        std::vector<uint8_t> out(MAGIC, MAGIC + sizeof(MAGIC));
+        out.push_back(VERSION);
+        out.push_back(header.fps);
+        write16(out, header.pixels);
+        write32(out, static_cast<uint32_t>(frame_count));
+        write16(out, static_cast<uint16_t>(palette.size()));
+        write16(out, header.keyframe_interval);
+        for (Strip::Color color: palette) {
+            write32(out, color);
+        }
+        out.insert(out.end(), data.begin(), data.end());
+        return out;
+    }
+
+    // --- Decoder ------------------------------------------------------------
+
+    Decoder::Decoder(const std::string &path, bool loop) : loop(loop) {
+        file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            return;
+        }
+        if (!readHeader(file, info)) {
+            fail();
+            return;
+        }
+
+        palette.resize(info.colors);
+        for (Strip::Color &color: palette) {
+            uint8_t bytes[sizeof(Strip::Color)];
+            if (std::fread(bytes, 1, sizeof(bytes), file) != sizeof(bytes)) {
+                fail();
+                return;
+            }
+            color = read32(bytes);
+        }
+        data_start = offset = std::ftell(file);
+        current.assign(info.pixels, 0);
+        previous.assign(info.pixels, 0);
+        ops.resize(info.pixels * Delta::MAX_BYTES_PER_PIXEL);
+    }
+
+    Decoder::~Decoder() {
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+    }
+
+    void Decoder::fail() {
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    bool Decoder::readRecord(uint8_t &kind, uint16_t &bytes) {
+        uint8_t record[FRAME_HEADER_SIZE];
+        if (std::fread(record, 1, sizeof(record), file) != sizeof(record)) {
+            return false;
+        }
+        kind = record[0];
+        bytes = read16(record + 1);
+        return kind <= KEYFRAME && bytes <= ops.size();
+    }
+
+    bool Decoder::next() {
+        if (file == nullptr) {
+            return false;
+        }
+        if (cursor == info.frames) {
+            if (!loop) {
+                return false;
+            }
+            cursor = 0;
+            offset = data_start;
+            if (std::fseek(file, offset, SEEK_SET) != 0) {
+                fail();
+                return false;
+            }
+        }
+
+        uint8_t kind;
+        uint16_t bytes;
+        if (!readRecord(kind, bytes) || (cursor == 0 && kind != KEYFRAME) ||
+            std::fread(ops.data(), 1, bytes, file) != bytes) {
+            fail();
+            return false;
+        }
+
+        current.swap(previous);
+        if (kind == KEYFRAME) {
+            std::fill(previous.begin(), previous.end(), 0);
+        }
+        if (!Delta::decode(ops.data(), ops.data() + bytes, palette.data(), palette.size(),
+                           previous.data(), current.data(), info.pixels)) {
+            fail();
+            return false;
+        }
+        offset += FRAME_HEADER_SIZE + bytes;
+        cursor++;
+        return true;
+    }
+
+    bool Decoder::seek(uint32_t frame) {
+        if (file == nullptr || frame >= info.frames) {
+            return false;
+        }
+        if (frame < cursor) {
+            cursor = 0;
+            offset = data_start;
+        }
+
+        // skip over the records up to frame, remembering the last keyframe
+        uint32_t at = cursor;
+        long scan = offset;
+        while (at <= frame) {
+            uint8_t kind;
+            uint16_t bytes;
+            if (std::fseek(file, scan, SEEK_SET) != 0 || !readRecord(kind, bytes)) {
+                fail();
+                return false;
+            }
+            if (kind == KEYFRAME) {
+                cursor = at;
+                offset = scan;
+            }
+            scan += FRAME_HEADER_SIZE + bytes;
+            at++;
+        }
+
+        if (std::fseek(file, offset, SEEK_SET) != 0) {
+            fail();
+            return false;
+        }
+        while (cursor < frame) {
+            if (!next()) {
+                return false;
+            }
+        }
+        return true;
+    }
+} // Support::Clip
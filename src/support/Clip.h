@@ -0,0 +1,179 @@
+#ifndef LEDZ_SUPPORT_CLIP_H
+#define LEDZ_SUPPORT_CLIP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../strip/Strip.h"
+
+namespace Support::Clip {
+    /**
+     * A clip is a file of animation frames, all numbers little-endian:
+     *
+     *   header   "LEDC", version (1), frames per second (1-100), pixels (2),
+     *            frames (4), palette colors (2, 1-256), keyframe interval (2)
+     *   palette  colors x 4 bytes, packed Strip::Color
+     *   frames   kind (1, DELTA or KEYFRAME), op bytes (2), Delta ops
+     *
+     * A delta frame is encoded against the frame before it, a keyframe against
+     * black, so playback can start at any keyframe. The first frame is always
+     * a keyframe.
+     */
+    static constexpr uint8_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t FRAME_HEADER_SIZE = 3;
+    static constexpr uint8_t MAX_FPS = 100;
+    static constexpr size_t MAX_COLORS = 256;
+    static constexpr size_t MAX_NAME_LENGTH = 24;
+    static constexpr const char *EXTENSION = ".ledc";
+
+    enum FrameKind : uint8_t {
+        DELTA = 0,
+        KEYFRAME = 1
+    };
+
+    struct Header {
+        uint8_t fps = 0;
+        uint16_t pixels = 0;
+        uint32_t frames = 0;
+        uint16_t colors = 0;
+        uint16_t keyframe_interval = 0;
+    };
+
+    /**
+     * @return true if name is 1 to MAX_NAME_LENGTH letters, digits, '-' and '_'
+     */
+    bool isValidName(const std::string &name);
+
+    /**
+     * @return The clip's file name on the spiffs partition, as the SPIFFS library sees it
+     */
+    std::string fileName(const std::string &name);
+
+    /**
+     * @return Where the clip of that name is opened from: the spiffs partition
+     * on the device, the working directory otherwise
+     */
+    std::string path(const std::string &name);
+
+    /**
+     * Check the header of a clip file
+     * @param bytes The first HEADER_SIZE bytes of the file
+     * @param file_size Size of the whole file
+     * @return false if it is not a clip or too short for its frames
+     */
+    bool parseHeader(const uint8_t *bytes, size_t file_size, Header &header);
+
+    /**
+     * Read and check the header of a clip file
+     * @return false if the file is missing or not a clip
+     */
+    bool readHeader(const std::string &path, Header &header);
+
+    /**
+     * Builds a clip in memory, for tools and tests
+     */
+    class Encoder {
+    public:
+        /**
+         * @param length Pixels per frame
+         * @param fps Frames per second, 1-MAX_FPS
+         * @param keyframe_interval Frames from one keyframe to the next
+         */
+        Encoder(Strip::PixelIndex length, uint8_t fps, uint16_t keyframe_interval = 100);
+
+        /**
+         * Encode one frame and append it to the clip
+         * @param frame length packed colors
+         * @return false if the frame would take the clip past MAX_COLORS colors
+         */
+        bool append(const Strip::Color *frame);
+
+        size_t frames() const { return frame_count; }
+
+        /**
+         * @return The complete clip file
+         */
+        std::vector<uint8_t> finish() const;
+
+    private:
+        Header header;
+        size_t frame_count = 0;
+        std::vector<uint8_t> data; // frame records
+        std::vector<Strip::Color> palette;
+        std::unordered_map<Strip::Color, uint8_t> palette_lookup;
+        std::vector<Strip::Color> previous;
+        std::vector<Strip::Color> black;
+    };
+
+    /**
+     * Plays a clip file frame by frame, reading one frame record at a time so
+     * memory use depends on the pixel count only, never on the clip length.
+     */
+    class Decoder {
+    public:
+        /**
+         * @param path Clip file
+         * @param loop Start over after the last frame instead of stopping
+         */
+        explicit Decoder(const std::string &path, bool loop = true);
+
+        ~Decoder();
+
+        Decoder(const Decoder &) = delete;
+
+        Decoder &operator=(const Decoder &) = delete;
+
+        /**
+         * @return false if the file is missing, not a clip, or turned out to be corrupt
+         */
+        bool isValid() const { return file != nullptr; }
+
+        const Header &header() const { return info; }
+
+        /**
+         * Decode the next frame into frame()
+         * @return false at the end of a clip that does not loop, or on corrupt data
+         */
+        bool next();
+
+        /**
+         * Position the clip so next() decodes the given frame, starting from
+         * the nearest keyframe before it
+         * @return false if frame is out of range or the data is corrupt
+         */
+        bool seek(uint32_t frame);
+
+        /**
+         * @return The frame next() decodes
+         */
+        uint32_t position() const { return cursor; }
+
+        /**
+         * @return The latest frame, header().pixels colors, black before the first
+         */
+        const Strip::Color *frame() const { return current.data(); }
+
+    private:
+        std::FILE *file = nullptr;
+        bool loop;
+        Header info;
+        long data_start = 0;
+        long offset = 0; // of the record of frame cursor
+        uint32_t cursor = 0;
+        std::vector<Strip::Color> palette;
+        std::vector<Strip::Color> current;
+        std::vector<Strip::Color> previous;
+        std::vector<uint8_t> ops; // one frame record
+
+        bool readRecord(uint8_t &kind, uint16_t &bytes);
+
+        void fail();
+    };
+} // Support::Clip
+
+#endif //LEDZ_SUPPORT_CLIP_H
@@ -0,0 +1,137 @@
+#ifndef LEDZ_SUPPORT_COROUTINE_H
+#define LEDZ_SUPPORT_COROUTINE_H
+
+#include <cstdint>
+
+namespace Support {
+    /**
+     * State of a stackless coroutine: lets a show write a sequence of steps
+     * ("fade in over 2 s, hold, fade out, repeat") as a straight script that
+     * resumes where it left off on the next frame.
+     *
+     * The script is a void function (usually called from execute) framed by
+     * CO_BEGIN and CO_END. CO_WAIT, CO_WAIT_UNTIL, CO_FADE and CO_YIELD return
+     * from the function and continue at the same spot on the next call, so
+     * resuming costs one switch jump. Loops and ifs around them are fine.
+     *
+     * Like any protothread: local variables do not survive a wait (keep state
+     * in members), at most one wait per source line, and no switch statement
+     * around a wait.
+     *
+     * Time is whatever the show passes as now, milliseconds or frames. A step
+     * ends at the deadline it was due, not at the frame that noticed, so
+     * sequences of steps do not drift however coarse the frames are.
+     */
+    class Coroutine {
+    public:
+        static constexpr int FINISHED = -1;
+
+        /**
+         * Start the script from the top on the next call
+         */
+        void restart() { line = 0; }
+
+        /**
+         * Stop the script; it does nothing until restarted
+         */
+        void stop() { line = FINISHED; }
+
+        bool isFinished() const { return line == FINISHED; }
+
+        /**
+         * Interpolate for a fade, exact at both ends
+         * @param from Value at elapsed 0
+         * @param to Value at duration
+         * @param elapsed Time into the fade
+         * @param duration Length of the fade, 0 to reach to at once
+         */
+        static int32_t lerp(int32_t from, int32_t to, uint32_t elapsed, uint32_t duration) {
+            if (elapsed >= duration) {
+                return to;
+            }
+            return static_cast<int32_t>((static_cast<int64_t>(from) * (duration - elapsed) +
+                                         static_cast<int64_t>(to) * elapsed) / duration);
+        }
+
+        int line = 0; // resume point, the source line of the latest wait
+        uint32_t mark = 0; // time the current step started
+    };
+} // Support
+
+/**
+ * Open the script
+ * @param co Coroutine state
+ * @param now Current time; the first step starts now
+ */
+#define CO_BEGIN(co, now) \
+    switch ((co).line) { \
+    case 0: \
+        (co).mark = static_cast<uint32_t>(now);
+
+/**
+ * Close the script; it is finished once it gets here
+ */
+#define CO_END(co) \
+        (co).line = ::Support::Coroutine::FINISHED; \
+        [[fallthrough]]; \
+    default: \
+        break; \
+    }
+
+/**
+ * Resume here on the next call, and start the next step then
+ */
+#define CO_YIELD(co, now) \
+    do { \
+        (co).line = __LINE__; \
+        return; \
+    case __LINE__: \
+        (co).mark = static_cast<uint32_t>(now); \
+    } while (0)
+
+/**
+ * Resume on the first call where condition holds, checked right away
+ */
+#define CO_WAIT_UNTIL(co, now, condition) \
+    do { \
+        (co).line = __LINE__; \
+        [[fallthrough]]; \
+    case __LINE__: \
+        if (!(condition)) { \
+            return; \
+        } \
+        (co).mark = static_cast<uint32_t>(now); \
+    } while (0)
+
+/**
+ * Do nothing for duration, then go on with the step due at its end
+ */
+#define CO_WAIT(co, now, duration) \
+    do { \
+        (co).line = __LINE__; \
+        [[fallthrough]]; \
+    case __LINE__: \
+        if (static_cast<uint32_t>(now) - (co).mark < static_cast<uint32_t>(duration)) { \
+            return; \
+        } \
+        (co).mark += static_cast<uint32_t>(duration); \
+    } while (0)
+
+/**
+ * Move value from one number to another over duration, one step per call
+ * @param value Member set on every call, and to exactly to at the end
+ */
+#define CO_FADE(co, now, duration, value, from, to) \
+    do { \
+        (co).line = __LINE__; \
+        [[fallthrough]]; \
+    case __LINE__: \
+        (value) = ::Support::Coroutine::lerp((from), (to), static_cast<uint32_t>(now) - (co).mark, \
+                                             static_cast<uint32_t>(duration)); \
+        if (static_cast<uint32_t>(now) - (co).mark < static_cast<uint32_t>(duration)) { \
+            return; \
+        } \
+        (co).mark += static_cast<uint32_t>(duration); \
+    } while (0)
+
+#endif //LEDZ_SUPPORT_COROUTINE_H
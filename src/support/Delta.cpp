@@ -0,0 +1,74 @@
+#include "Delta.h"
+
+namespace Support::Delta {
+    int8_t bestShift(const Strip::Color *frame, const Strip::Color *previous, Strip::PixelIndex length) {
+        int best_shift = 0;
+        unsigned best_score = 0;
+        for (Strip::PixelIndex i = 0; i < length; i++) {
+            best_score += frame[i] == previous[i];
+        }
+        for (int shift = -MAX_SHIFT; shift <= MAX_SHIFT; shift++) {
+            if (shift == 0) {
+                continue;
+            }
+            unsigned score = 0;
+            Strip::PixelIndex begin = std::max(0, -shift);
+            Strip::PixelIndex end = std::min<int>(length, length - shift);
+            for (Strip::PixelIndex i = begin; i < end; i++) {
+                score += frame[i] == previous[i + shift];
+            }
+            if (score > best_score) {
+                best_score = score;
+                best_shift = shift;
+            }
+        }
+        return static_cast<int8_t>(best_shift);
+    }
+
+    bool decode(const uint8_t *op, const uint8_t *end, const Strip::Color *palette, size_t colors,
+                const Strip::Color *previous, Strip::Color *current, Strip::PixelIndex length) {
+        Strip::PixelIndex i = 0;
+        while (op < end) {
+            uint8_t kind = *op & OP_MASK;
+            int n = (*op++ & ~OP_MASK) + 1;
+            if (n > length - i || (kind != SKIP && op == end)) {
+                return false;
+            }
+            switch (kind) {
+                case SKIP:
+                    std::copy(previous + i, previous + i + n, current + i);
+                    break;
+                case RUN: {
+                    uint8_t color = *op++;
+                    if (color >= colors) {
+                        return false;
+                    }
+                    std::fill(current + i, current + i + n, palette[color]);
+                    break;
+                }
+                case LITERAL:
+                    if (end - op < n) {
+                        return false;
+                    }
+                    for (int k = 0; k < n; k++) {
+                        uint8_t color = *op++;
+                        if (color >= colors) {
+                            return false;
+                        }
+                        current[i + k] = palette[color];
+                    }
+                    break;
+                case SHIFT: {
+                    int source = i + static_cast<int8_t>(*op++);
+                    if (source < 0 || source + n > length) {
+                        return false;
+                    }
+                    std::copy(previous + source, previous + source + n, current + i);
+                    break;
+                }
+            }
+            i += n;
+        }
+        return i == length;
+    }
+} // Support::Delta
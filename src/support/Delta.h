@@ -0,0 +1,144 @@
+#ifndef LEDZ_SUPPORT_DELTA_H
+#define LEDZ_SUPPORT_DELTA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../strip/Strip.h"
+
+namespace Support::Delta {
+    /**
+     * A frame encoded against the previous one is a stream of byte ops. The
+     * top two bits of an op select its kind, the low six bits hold the pixel
+     * count minus one:
+     *   00 SKIP    n pixels unchanged
+     *   01 RUN     n pixels of one palette color (1 index byte follows)
+     *   10 LITERAL n pixels of individual colors (n index bytes follow)
+     *   11 SHIFT   n pixels copied from the previous frame at an offset (1 signed byte follows)
+     * SHIFT makes scrolling patterns almost free; SKIP makes mostly static ones free.
+     * An encoded frame is at most MAX_BYTES_PER_PIXEL bytes per pixel.
+     */
+    enum Op : uint8_t {
+        SKIP = 0x00,
+        RUN = 0x40,
+        LITERAL = 0x80,
+        SHIFT = 0xC0
+    };
+
+    static constexpr uint8_t OP_MASK = 0xC0;
+    static constexpr unsigned MAX_OP_PIXELS = 64;
+    static constexpr int MAX_SHIFT = 8;
+    static constexpr size_t MAX_BYTES_PER_PIXEL = 2;
+
+    /**
+     * The offset under which most pixels match the previous frame, but only if
+     * it beats leaving the pixels in place
+     * @return -MAX_SHIFT .. MAX_SHIFT, 0 for no shift
+     */
+    int8_t bestShift(const Strip::Color *frame, const Strip::Color *previous, Strip::PixelIndex length);
+
+    /**
+     * Encode a frame against the previous one and append the ops
+     * @param index bool(Strip::Color color, uint8_t &index), the palette index of a color
+     * @return false if index failed, with ops left as they were
+     */
+    template<typename PaletteIndex>
+    bool encode(const Strip::Color *frame, const Strip::Color *previous, Strip::PixelIndex length,
+                PaletteIndex index, std::vector<uint8_t> &ops) {
+        const size_t frame_start = ops.size();
+        const int8_t shift = bestShift(frame, previous, length);
+
+        // ops only ever start at i < length
+        auto matching = [&](Strip::PixelIndex i, int offset) {
+            auto remaining = static_cast<unsigned>(length - i);
+            unsigned n = 0;
+            while (n < MAX_OP_PIXELS && n < remaining) {
+                int source = i + static_cast<int>(n) + offset;
+                if (source < 0 || source >= length || frame[i + n] != previous[source]) {
+                    break;
+                }
+                n++;
+            }
+            return n;
+        };
+        auto repeating = [&](Strip::PixelIndex i) {
+            auto remaining = static_cast<unsigned>(length - i);
+            unsigned n = 1;
+            while (n < MAX_OP_PIXELS && n < remaining && frame[i + n] == frame[i]) {
+                n++;
+            }
+            return n;
+        };
+
+        uint8_t literal[MAX_OP_PIXELS];
+        unsigned literal_count = 0;
+        auto flush = [&]() {
+            if (literal_count > 0) {
+                ops.push_back(LITERAL | (literal_count - 1));
+                ops.insert(ops.end(), literal, literal + literal_count);
+                literal_count = 0;
+            }
+        };
+
+        Strip::PixelIndex i = 0;
+        while (i < length) {
+            unsigned skip = matching(i, 0);
+            unsigned shifted = shift != 0 ? matching(i, shift) : 0;
+            unsigned run = repeating(i);
+
+            // Breaking up a pending literal costs an extra header byte, so the
+            // competing op has to cover one more pixel to be worth it
+            unsigned pending = literal_count > 0 ? 1 : 0;
+
+            if (skip >= 1 + pending && skip >= shifted && skip >= run) {
+                flush();
+                ops.push_back(SKIP | (skip - 1));
+                i += skip;
+            } else if (shifted >= 2 + pending && shifted >= run) {
+                flush();
+                ops.push_back(SHIFT | (shifted - 1));
+                ops.push_back(static_cast<uint8_t>(shift));
+                i += shifted;
+            } else if (run >= 2 + pending) {
+                uint8_t color;
+                if (!index(frame[i], color)) {
+                    ops.resize(frame_start);
+                    return false;
+                }
+                flush();
+                ops.push_back(RUN | (run - 1));
+                ops.push_back(color);
+                i += run;
+            } else {
+                if (!index(frame[i], literal[literal_count])) {
+                    ops.resize(frame_start);
+                    return false;
+                }
+                if (++literal_count == MAX_OP_PIXELS) {
+                    flush();
+                }
+                i++;
+            }
+        }
+        flush();
+        return true;
+    }
+
+    /**
+     * Decode a frame, checking every op against the frame and palette bounds
+     * so untrusted input cannot read or write out of range
+     * @param op First op of the frame
+     * @param end End of the frame's ops
+     * @param palette Colors the index bytes refer to
+     * @param colors Number of palette colors
+     * @param previous The previous frame, length colors
+     * @param current Receives the frame, length colors
+     * @return false if the ops are malformed or do not cover exactly length pixels
+     */
+    bool decode(const uint8_t *op, const uint8_t *end, const Strip::Color *palette, size_t colors,
+                const Strip::Color *previous, Strip::Color *current, Strip::PixelIndex length);
+} // Support::Delta
+
+#endif //LEDZ_SUPPORT_DELTA_H
@@ -0,0 +1,67 @@
+#include "Draw.h"
+#include "Blend.h"
+
+#include <algorithm>
+
+namespace Support::Draw {
+    namespace {
+        // Pixel whose area contains a position
+        inline int32_t pixelAt(Position position) {
+            // arithmetic shift floors negative positions too
+            return (position + ONE_PIXEL / 2) >> 8;
+        }
+
+        inline Position pixelStart(int32_t index) {
+            return index * ONE_PIXEL - ONE_PIXEL / 2;
+        }
+
+        inline Strip::Color addSaturate(Strip::Color a, Strip::Color b) {
+            uint32_t r = std::min<uint32_t>(255, (a >> 16 & 0xFF) + (b >> 16 & 0xFF));
+            uint32_t g = std::min<uint32_t>(255, (a >> 8 & 0xFF) + (b >> 8 & 0xFF));
+            uint32_t bl = std::min<uint32_t>(255, (a & 0xFF) + (b & 0xFF));
+            return r << 16 | g << 8 | bl;
+        }
+    }
+
+    void plot(Strip::Strip &strip, Strip::PixelIndex index, Strip::Color color, uint32_t coverage, Op op) {
+        if (index < 0 || index >= strip.length() || coverage == 0) {
+            return;
+        }
+        if (op == Op::ADD) {
+            strip.setPixelColor(index, addSaturate(strip.getPixelColor(index), scale(color, coverage)));
+        } else if (coverage >= ONE_PIXEL) {
+            strip.setPixelColor(index, color);
+        } else {
+            strip.setPixelColor(index, Blend::mix(strip.getPixelColor(index), color, coverage));
+        }
+    }
+
+    void span(Strip::Strip &strip, Position start, Position end, Strip::Color color, Op op) {
+        gradient(strip, start, end, color, color, op);
+    }
+
+    void gradient(Strip::Strip &strip, Position start, Position end, Strip::Color from, Strip::Color to,
+                  Op op) {
+        if (end <= start) {
+            return;
+        }
+        int32_t first = std::max<int32_t>(0, pixelAt(start));
+        int32_t last = std::min<int32_t>(strip.length() - 1, pixelAt(end - 1));
+        Position width = end - start;
+
+        for (int32_t i = first; i <= last; i++) {
+            Position pixel_start = pixelStart(i);
+            Position covered_start = std::max(start, pixel_start);
+            Position covered_end = std::min(end, pixel_start + ONE_PIXEL);
+            auto coverage = static_cast<uint32_t>(covered_end - covered_start);
+
+            Strip::Color color = from;
+            if (from != to) {
+                // color at the middle of the covered part
+                Position middle = (covered_start + covered_end) / 2 - start;
+                color = Blend::mix(from, to, static_cast<uint8_t>(middle * 255 / width));
+            }
+            plot(strip, static_cast<Strip::PixelIndex>(i), color, coverage, op);
+        }
+    }
+}
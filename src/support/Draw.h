@@ -0,0 +1,91 @@
+#ifndef LEDZ_SUPPORT_DRAW_H
+#define LEDZ_SUPPORT_DRAW_H
+
+#include <cstdint>
+
+#include "strip/Strip.h"
+
+namespace Support::Draw {
+    /**
+     * Sub-pixel position in 1/256 pixel. Pixel i is centered on i * 256 and
+     * covers [i * 256 - 128, i * 256 + 128).
+     */
+    typedef int32_t Position;
+
+    static constexpr Position ONE_PIXEL = 256;
+
+    inline Position fromPixels(float pixels) {
+        return static_cast<Position>(pixels * ONE_PIXEL + (pixels < 0 ? -0.5f : 0.5f));
+    }
+
+    /**
+     * How drawn pixels combine with what is already on the strip
+     */
+    enum class Op {
+        OVER, // mix towards the color by coverage
+        ADD // add the color scaled by coverage, saturating
+    };
+
+    /**
+     * Scale a packed 0xRRGGBB color by a coverage
+     * @param color Color to scale
+     * @param coverage 0-256, 256 returns color unchanged
+     */
+    inline Strip::Color scale(Strip::Color color, uint32_t coverage) {
+        uint32_t rb = ((color & 0xFF00FF) * coverage >> 8) & 0xFF00FF;
+        uint32_t g = ((color & 0x00FF00) * coverage >> 8) & 0x00FF00;
+        return rb | g;
+    }
+
+    /**
+     * Combine a color into one pixel; pixels outside the strip are ignored
+     * @param strip Strip to draw into
+     * @param index Pixel index
+     * @param color Color to draw
+     * @param coverage 0-256
+     * @param op How to combine with the existing pixel
+     */
+    void plot(Strip::Strip &strip, Strip::PixelIndex index, Strip::Color color, uint32_t coverage, Op op);
+
+    /**
+     * Fill [start, end) with a color, the end pixels weighted by how much of
+     * them is covered
+     * @param strip Strip to draw into
+     * @param start Start position
+     * @param end End position (exclusive)
+     * @param color Color to draw
+     * @param op How to combine with the existing pixels
+     */
+    void span(Strip::Strip &strip, Position start, Position end, Strip::Color color, Op op = Op::OVER);
+
+    /**
+     * Fill [start, end) with colors running from one to another, the end pixels
+     * weighted by coverage like span()
+     * @param strip Strip to draw into
+     * @param start Start position
+     * @param end End position (exclusive)
+     * @param from Color at start
+     * @param to Color at end
+     * @param op How to combine with the existing pixels
+     */
+    void gradient(Strip::Strip &strip, Position start, Position end, Strip::Color from, Strip::Color to,
+                  Op op = Op::OVER);
+
+    /**
+     * Antialiased dot: a span of the given width centered on a position, spread
+     * over the neighbouring pixels in proportion to their overlap (Wu style).
+     * A dot one pixel wide lights at most two pixels, and exactly one when it
+     * sits on a pixel center.
+     * @param strip Strip to draw into
+     * @param center Center position
+     * @param color Color to draw
+     * @param width Width of the dot (default one pixel)
+     * @param op How to combine with the existing pixels
+     */
+    inline void dot(Strip::Strip &strip, Position center, Strip::Color color, Position width = ONE_PIXEL,
+                    Op op = Op::OVER) {
+        span(strip, center - width / 2, center - width / 2 + width, color, op);
+    }
+}
+
+#endif //LEDZ_SUPPORT_DRAW_H
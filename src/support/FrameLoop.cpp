@@ -0,0 +1,76 @@
+#include "FrameLoop.h"
+
+#include <algorithm>
+
+#include "Delta.h"
+
+namespace Support {
+    FrameLoop::FrameLoop(Strip::PixelIndex length, size_t budget_bytes)
+        : pixel_count(std::max<Strip::PixelIndex>(0, length)), budget(budget_bytes),
+          current(pixel_count, 0), previous(pixel_count, 0) {
+    }
+
+    size_t FrameLoop::size() const {
+        return ops.size() + offsets.size() * sizeof(uint32_t) + palette.size() * sizeof(Strip::Color);
+    }
+
+    bool FrameLoop::paletteIndex(Strip::Color color, uint8_t &index) {
+        auto it = palette_lookup.find(color);
+        if (it != palette_lookup.end()) {
+            index = it->second;
+            return true;
+        }
+        if (palette.size() >= 256) {
+            return false;
+        }
+        index = static_cast<uint8_t>(palette.size());
+        palette.push_back(color);
+        palette_lookup.emplace(color, index);
+        return true;
+    }
+
+    bool FrameLoop::append(const Strip::Color *frame) {
+        const size_t frame_start = ops.size();
+        auto index = [this](Strip::Color color, uint8_t &index) { return paletteIndex(color, index); };
+        if (!Delta::encode(frame, previous.data(), pixel_count, index, ops)) {
+            return false;
+        }
+
+        offsets.push_back(static_cast<uint32_t>(frame_start));
+        if (size() > budget) {
+            offsets.pop_back();
+            ops.resize(frame_start);
+            return false;
+        }
+
+        std::copy(frame, frame + pixel_count, previous.begin());
+        return true;
+    }
+
+    void FrameLoop::finish() {
+        std::unordered_map<Strip::Color, uint8_t>().swap(palette_lookup);
+        ops.shrink_to_fit();
+        offsets.shrink_to_fit();
+        palette.shrink_to_fit();
+        cursor = 0;
+    }
+
+    void FrameLoop::decode(size_t frame) {
+        if (frame == 0) {
+            std::fill(previous.begin(), previous.end(), 0);
+        }
+
+        const uint8_t *op = ops.data() + offsets[frame];
+        const uint8_t *end = ops.data() + (frame + 1 < offsets.size() ? offsets[frame + 1] : ops.size());
+        Delta::decode(op, end, palette.data(), palette.size(), previous.data(), current.data(), pixel_count);
+        current.swap(previous);
+    }
+
+    const Strip::Color *FrameLoop::next() {
+        if (!offsets.empty()) {
+            decode(cursor);
+            cursor = (cursor + 1) % offsets.size();
+        }
+        return previous.data();
+    }
+} // Support
@@ -0,0 +1,75 @@
+#ifndef LEDZ_FRAMELOOP_H
+#define LEDZ_FRAMELOOP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "../strip/Strip.h"
+
+namespace Support {
+    /**
+     * FrameLoop stores a sequence of frames as palette indexed deltas.
+     *
+     * Every frame is encoded against the previous one (the first against black)
+     * as a stream of Delta ops.
+     *
+     * Frames are appended until the loop is finished, after which next() replays
+     * them in order, wrapping around at the end.
+     */
+    class FrameLoop {
+    public:
+        /**
+         * @param length Number of pixels per frame
+         * @param budget_bytes Maximum encoded size (ops, frame offsets and palette)
+         */
+        FrameLoop(Strip::PixelIndex length, size_t budget_bytes);
+
+        /**
+         * Encode one frame and append it to the loop
+         * @param frame length() packed colors
+         * @return false if the frame does not fit the budget or the 256 color palette
+         */
+        bool append(const Strip::Color *frame);
+
+        /**
+         * Stop recording: release encoder state and rewind playback to the first frame
+         */
+        void finish();
+
+        /**
+         * Decode the next frame of the loop
+         * @return length() packed colors, valid until the next call
+         */
+        const Strip::Color *next();
+
+        Strip::PixelIndex length() const { return pixel_count; }
+
+        size_t frames() const { return offsets.size(); }
+
+        /**
+         * @return Encoded size in bytes, as counted against the budget
+         */
+        size_t size() const;
+
+    private:
+        Strip::PixelIndex pixel_count;
+        size_t budget;
+
+        std::vector<uint8_t> ops;
+        std::vector<uint32_t> offsets; // start of each frame in ops
+        std::vector<Strip::Color> palette;
+        std::unordered_map<Strip::Color, uint8_t> palette_lookup; // recording only
+
+        std::vector<Strip::Color> current;
+        std::vector<Strip::Color> previous;
+        size_t cursor = 0;
+
+        bool paletteIndex(Strip::Color color, uint8_t &index);
+
+        void decode(size_t frame);
+    };
+} // Support
+
+#endif //LEDZ_FRAMELOOP_H
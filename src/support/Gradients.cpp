@@ -0,0 +1,113 @@
+#include "Gradients.h"
+#include "../color.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace Support::Gradients {
+    namespace {
+        std::mutex mutex;
+        std::vector<Gradient> stored; // guarded by mutex
+    }
+
+    std::vector<Gradient> builtIn() {
+        return {
+            {"lava", {0x000000, 0x600000, 0xD02000, 0xFF7000, 0xFFD040}},
+            {"clouds", {0x0830A0, 0x2060D0, 0x80A8E8, 0xE0E8F8, 0xFFFFFF}},
+            {"ocean", {0x000418, 0x002060, 0x0060A0, 0x10B0C8, 0x90F0FF}},
+            {"forest", {0x001000, 0x0A4010, 0x308020, 0x70A030, 0xC0D060}},
+            {"rainbow", {wheel(0), wheel(43), wheel(85), wheel(128), wheel(170), wheel(213), wheel(255)}},
+            {"heat", {0x000000, 0x800000, 0xFF3000, 0xFF9000, 0xFFE080, 0xFFFFFF}},
+            {"sunset", {0x100020, 0x502060, 0xC03050, 0xFF7030, 0xFFD070}},
+        };
+    }
+
+    bool isValidName(const std::string &name) {
+        if (name.empty() || name.size() > MAX_NAME_LENGTH) {
+            return false;
+        }
+        return std::all_of(name.begin(), name.end(), [](char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+        });
+    }
+
+    bool isBuiltIn(const std::string &name) {
+        for (const Gradient &gradient: builtIn()) {
+            if (gradient.name == name) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<Strip::Color> find(const std::string &name) {
+        for (const Gradient &gradient: builtIn()) {
+            if (gradient.name == name) {
+                return gradient.colors;
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const Gradient &gradient: stored) {
+            if (gradient.name == name) {
+                return gradient.colors;
+            }
+        }
+        return {};
+    }
+
+    bool store(const std::string &name, const std::vector<Strip::Color> &colors) {
+        if (!isValidName(name) || isBuiltIn(name) || colors.empty() || colors.size() > MAX_COLORS) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Gradient &gradient: stored) {
+            if (gradient.name == name) {
+                gradient.colors = colors;
+                return true;
+            }
+        }
+        if (stored.size() >= MAX_CUSTOM) {
+            return false;
+        }
+        stored.push_back({name, colors});
+        return true;
+    }
+
+    bool remove(const std::string &name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto gradient = std::find_if(stored.begin(), stored.end(),
+                                     [&name](const Gradient &gradient) { return gradient.name == name; });
+        if (gradient == stored.end()) {
+            return false;
+        }
+        stored.erase(gradient);
+        return true;
+    }
+
+    std::vector<Gradient> custom() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stored;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        stored.clear();
+    }
+
+    Palette::Table bake(const std::vector<Strip::Color> &colors) {
+        Palette gradient;
+        for (size_t i = 0; i < colors.size(); i++) {
+            gradient.addPoint(colors.size() > 1 ? static_cast<float>(i) / (colors.size() - 1) : 0.0f, colors[i]);
+        }
+        return gradient.bake();
+    }
+
+    Palette::Table bakeCyclic(const std::vector<Strip::Color> &colors, float turn) {
+        // the first color once more at the end of the turn
+        Palette gradient;
+        for (size_t i = 0; !colors.empty() && i <= colors.size(); i++) {
+            gradient.addPoint(static_cast<float>(i) / colors.size(), colors[i % colors.size()]);
+        }
+        return gradient.bake(turn);
+    }
+}
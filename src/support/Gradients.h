@@ -0,0 +1,86 @@
+#ifndef LEDZ_SUPPORT_GRADIENTS_H
+#define LEDZ_SUPPORT_GRADIENTS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "../strip/Strip.h"
+#include "Palette.h"
+
+namespace Support::Gradients {
+    /**
+     * Named color gradients for the palette parameter of the shows: the
+     * built-in ones, and custom ones uploaded through the API. A gradient is
+     * a list of colors spread evenly; shows bake it into a Palette::Table once,
+     * when they are created, and never look at it again.
+     *
+     * The custom gradients are kept here for the show factory and stored in
+     * NVS by the config manager, which loads them back at startup. They may be
+     * changed from the network task while another task creates a show, so
+     * every access is locked and hands out copies.
+     */
+    static constexpr size_t MAX_COLORS = 16;
+    static constexpr size_t MAX_CUSTOM = 8;
+    static constexpr size_t MAX_NAME_LENGTH = 15;
+
+    struct Gradient {
+        std::string name;
+        std::vector<Strip::Color> colors;
+    };
+
+    /**
+     * @return The built-in gradients, in display order
+     */
+    std::vector<Gradient> builtIn();
+
+    /**
+     * @return true if name is 1 to MAX_NAME_LENGTH letters, digits, '-' and '_'
+     */
+    bool isValidName(const std::string &name);
+
+    bool isBuiltIn(const std::string &name);
+
+    /**
+     * @param name Built-in or custom gradient
+     * @return Its colors, empty if there is no gradient of that name
+     */
+    std::vector<Strip::Color> find(const std::string &name);
+
+    /**
+     * Add a custom gradient, or replace the one of the same name
+     * @param name Valid name that is not a built-in one
+     * @param colors 1 to MAX_COLORS colors
+     * @return false if the gradient is invalid, or MAX_CUSTOM are stored already
+     */
+    bool store(const std::string &name, const std::vector<Strip::Color> &colors);
+
+    /**
+     * @return false if there is no custom gradient of that name
+     */
+    bool remove(const std::string &name);
+
+    /**
+     * @return The custom gradients, in the order they were first stored
+     */
+    std::vector<Gradient> custom();
+
+    /**
+     * Forget every custom gradient
+     */
+    void clear();
+
+    /**
+     * @param colors Spread evenly from entry 0 to entry 255
+     */
+    Palette::Table bake(const std::vector<Strip::Color> &colors);
+
+    /**
+     * @param colors Spread evenly around one turn, the last blending back into the first
+     * @param turn Entries in one turn: 256, or 255 for hues on the wheel() scale
+     *             where entry 255 repeats entry 0
+     */
+    Palette::Table bakeCyclic(const std::vector<Strip::Color> &colors, float turn = 256.0f);
+}
+
+#endif //LEDZ_SUPPORT_GRADIENTS_H
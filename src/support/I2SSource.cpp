@@ -0,0 +1,76 @@
+#ifdef ARDUINO
+
+#include "I2SSource.h"
+#include "../Log.h"
+
+#include <algorithm>
+
+static const char* TAG = "audio";
+
+namespace Support::Audio {
+    I2SSource::I2SSource(int clock_pin, int select_pin, int data_pin, uint32_t sample_rate, i2s_port_t port)
+        : clock_pin(clock_pin), select_pin(select_pin), data_pin(data_pin), rate(sample_rate), port(port) {
+    }
+
+    I2SSource::~I2SSource() {
+        if (installed) {
+            i2s_driver_uninstall(port);
+        }
+    }
+
+    bool I2SSource::begin() {
+        i2s_config_t config = {};
+        config.mode = static_cast<i2s_mode_t>(I2S_MODE_MASTER | I2S_MODE_RX);
+        config.sample_rate = rate;
+        config.bits_per_sample = I2S_BITS_PER_SAMPLE_32BIT;
+        config.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
+        config.communication_format = I2S_COMM_FORMAT_STAND_I2S;
+        config.intr_alloc_flags = ESP_INTR_FLAG_LEVEL1;
+        config.dma_buf_count = 4;
+        config.dma_buf_len = 256;
+
+        esp_err_t result = i2s_driver_install(port, &config, 0, nullptr);
+        if (result != ESP_OK) {
+            ESP_LOGE(TAG, "I2S driver install failed: %d", result);
+            return false;
+        }
+        installed = true;
+
+        i2s_pin_config_t pins = {};
+        pins.mck_io_num = I2S_PIN_NO_CHANGE;
+        pins.bck_io_num = clock_pin;
+        pins.ws_io_num = select_pin;
+        pins.data_out_num = I2S_PIN_NO_CHANGE;
+        pins.data_in_num = data_pin;
+        result = i2s_set_pin(port, &pins);
+        if (result != ESP_OK) {
+            ESP_LOGE(TAG, "I2S pin setup failed: %d", result);
+            return false;
+        }
+        ESP_LOGI(TAG, "I2S microphone on SCK=%d WS=%d SD=%d at %u Hz", clock_pin, select_pin, data_pin, rate);
+        return true;
+    }
+
+    size_t I2SSource::read(int16_t *samples, size_t count) {
+        if (!installed) {
+            return 0;
+        }
+        int32_t words[64];
+        size_t done = 0;
+        while (done < count) {
+            size_t wanted = std::min(count - done, sizeof(words) / sizeof(words[0]));
+            size_t bytes = 0;
+            if (i2s_read(port, words, wanted * sizeof(int32_t), &bytes, portMAX_DELAY) != ESP_OK) {
+                break;
+            }
+            for (size_t i = 0; i < bytes / sizeof(int32_t); i++) {
+                // 24 bit samples in the upper bits; keep 2 bits of headroom less for quiet microphones
+                int32_t sample = words[i] >> 14;
+                samples[done++] = static_cast<int16_t>(std::max(-32768, std::min(32767, sample)));
+            }
+        }
+        return done;
+    }
+} // Support::Audio
+
+#endif
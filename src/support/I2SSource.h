@@ -0,0 +1,51 @@
+#ifndef LEDZ_SUPPORT_I2SSOURCE_H
+#define LEDZ_SUPPORT_I2SSOURCE_H
+
+#ifdef ARDUINO
+
+#include <driver/i2s.h>
+
+#include "Audio.h"
+
+namespace Support::Audio {
+    /**
+     * I2S MEMS microphone such as the INMP441 or SPH0645, left channel, read
+     * as 32 bit words and scaled to 16 bit samples
+     */
+    class I2SSource : public Source {
+    public:
+        /**
+         * @param clock_pin Bit clock (SCK)
+         * @param select_pin Word select (WS)
+         * @param data_pin Data out of the microphone (SD)
+         * @param sample_rate Samples per second
+         * @param port I2S peripheral to use
+         */
+        I2SSource(int clock_pin, int select_pin, int data_pin, uint32_t sample_rate = 22050,
+                  i2s_port_t port = I2S_NUM_0);
+
+        ~I2SSource() override;
+
+        /**
+         * Install the driver
+         * @return false if the I2S driver could not be started
+         */
+        bool begin();
+
+        uint32_t sampleRate() const override { return rate; }
+
+        size_t read(int16_t *samples, size_t count) override;
+
+    private:
+        int clock_pin;
+        int select_pin;
+        int data_pin;
+        uint32_t rate;
+        i2s_port_t port;
+        bool installed = false;
+    };
+} // Support::Audio
+
+#endif
+
+#endif //LEDZ_SUPPORT_I2SSOURCE_H
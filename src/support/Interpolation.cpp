@@ -0,0 +1,126 @@
+#include "Interpolation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Support::Interpolation {
+    namespace {
+        constexpr double PI = 3.14159265358979323846;
+
+        // cos(x) for 0 <= x <= pi, as a series: std::cos is not constexpr
+        constexpr double cosine(double x) {
+            double sign = 1.0;
+            if (x > PI / 2) {
+                x = PI - x;
+                sign = -1.0;
+            }
+            double term = 1.0;
+            double sum = 1.0;
+            for (int n = 1; n < 12; n++) {
+                term *= -x * x / ((2 * n - 1) * (2 * n));
+                sum += term;
+            }
+            return sign * sum;
+        }
+
+        constexpr double curve(Easing easing, double t) {
+            switch (easing) {
+                case Easing::EASE_IN:
+                    return t * t;
+                case Easing::EASE_OUT:
+                    return 1 - (1 - t) * (1 - t);
+                case Easing::QUAD:
+                    return t < 0.5 ? 2 * t * t : 1 - 2 * (1 - t) * (1 - t);
+                case Easing::CUBIC:
+                    return t < 0.5 ? 4 * t * t * t : 1 - 4 * (1 - t) * (1 - t) * (1 - t);
+                case Easing::SINE:
+                    return (1 - cosine(PI * t)) / 2;
+                default:
+                    return t;
+            }
+        }
+
+        constexpr std::array<uint32_t, 257> sample(Easing easing) {
+            std::array<uint32_t, 257> table{};
+            for (int i = 0; i <= 256; i++) {
+                table[i] = static_cast<uint32_t>(curve(easing, i / 256.0) * ONE + 0.5);
+            }
+            return table;
+        }
+
+        constexpr std::array<uint32_t, 257> EASE_IN_TABLE = sample(Easing::EASE_IN);
+        constexpr std::array<uint32_t, 257> EASE_OUT_TABLE = sample(Easing::EASE_OUT);
+        constexpr std::array<uint32_t, 257> QUAD_TABLE = sample(Easing::QUAD);
+        constexpr std::array<uint32_t, 257> CUBIC_TABLE = sample(Easing::CUBIC);
+        constexpr std::array<uint32_t, 257> SINE_TABLE = sample(Easing::SINE);
+
+        struct EasingName {
+            Easing easing;
+            const char *name;
+        };
+
+        // the first name of a curve is the one easingName() returns
+        const EasingName EASING_NAMES[] = {
+            {Easing::LINEAR, "linear"},
+            {Easing::STEP, "step"},
+            {Easing::EASE_IN, "ease-in"},
+            {Easing::EASE_OUT, "ease-out"},
+            {Easing::QUAD, "quad"},
+            {Easing::CUBIC, "cubic"},
+            {Easing::SINE, "sine"},
+            {Easing::SINE, "ease-in-out"},
+        };
+    }
+
+    bool easingFromName(const char *name, Easing &easing) {
+        for (const EasingName &entry: EASING_NAMES) {
+            if (name != nullptr && strcmp(name, entry.name) == 0) {
+                easing = entry.easing;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Easing easingFromName(const char *name) {
+        Easing easing = Easing::LINEAR;
+        easingFromName(name, easing);
+        return easing;
+    }
+
+    const char *easingName(Easing easing) {
+        for (const EasingName &entry: EASING_NAMES) {
+            if (entry.easing == easing) {
+                return entry.name;
+            }
+        }
+        return "linear";
+    }
+
+    PowerCurve::PowerCurve(float power) {
+        for (size_t i = 0; i < table.size(); i++) {
+            // 0 to a negative power is infinite: cap at 1
+            table[i] = static_cast<uint32_t>(std::lround(std::min(1.0, std::pow(i / 256.0, power)) * ONE));
+        }
+    }
+
+    uint32_t ease(Easing easing, uint32_t t) {
+        switch (easing) {
+            case Easing::STEP:
+                return t < ONE ? 0 : ONE;
+            case Easing::EASE_IN:
+                return lookup(EASE_IN_TABLE, t);
+            case Easing::EASE_OUT:
+                return lookup(EASE_OUT_TABLE, t);
+            case Easing::QUAD:
+                return lookup(QUAD_TABLE, t);
+            case Easing::CUBIC:
+                return lookup(CUBIC_TABLE, t);
+            case Easing::SINE:
+                return lookup(SINE_TABLE, t);
+            default:
+                return t < ONE ? t : ONE;
+        }
+    }
+}
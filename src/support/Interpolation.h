@@ -0,0 +1,122 @@
+#ifndef LEDZ_SUPPORT_INTERPOLATION_H
+#define LEDZ_SUPPORT_INTERPOLATION_H
+
+#include <array>
+#include <cstdint>
+
+#include "strip/Strip.h"
+
+namespace Support::Interpolation {
+    /**
+     * 1.0 in the Q16 fractions used throughout: an amount runs from 0 to ONE inclusive
+     */
+    constexpr uint32_t ONE = 1u << 16;
+
+    /**
+     * Interpolate in 1/65536 steps. The result is rounded down, as a float
+     * interpolation truncated to an integer would be.
+     * @param from Value at amount 0
+     * @param to Value at amount ONE
+     * @param amount Weight of to (0-ONE)
+     */
+    inline int32_t lerp16(int32_t from, int32_t to, uint32_t amount) {
+        return from + static_cast<int32_t>(static_cast<int64_t>(to - from) * amount >> 16);
+    }
+
+    /**
+     * Interpolate each channel of two packed 0xRRGGBB colors in 1/65536 steps
+     * @param from Color at amount 0
+     * @param to Color at amount ONE
+     * @param amount Weight of to (0-ONE)
+     */
+    inline Strip::Color lerpColor(Strip::Color from, Strip::Color to, uint32_t amount) {
+        auto r = static_cast<uint32_t>(lerp16(from >> 16 & 0xFF, to >> 16 & 0xFF, amount));
+        auto g = static_cast<uint32_t>(lerp16(from >> 8 & 0xFF, to >> 8 & 0xFF, amount));
+        auto b = static_cast<uint32_t>(lerp16(from & 0xFF, to & 0xFF, amount));
+        return r << 16 | g << 8 | b;
+    }
+
+    /**
+     * @return A progress of 0 - 1 in Q16, clamped
+     */
+    inline uint32_t toQ16(float progress) {
+        if (!(progress > 0.0f)) {
+            return 0;
+        }
+        if (progress >= 1.0f) {
+            return ONE;
+        }
+        return static_cast<uint32_t>(progress * static_cast<float>(ONE));
+    }
+
+    /**
+     * Easing curves, all running from 0 to 1
+     */
+    enum class Easing : uint8_t {
+        LINEAR,
+        STEP, // hold 0 until the end
+        EASE_IN, // t^2
+        EASE_OUT, // 1 - (1 - t)^2
+        QUAD, // 2t^2 up to the middle, mirrored after it
+        CUBIC, // 4t^3 up to the middle, mirrored after it
+        SINE, // (1 - cos(pi t)) / 2
+    };
+
+    /**
+     * @param name "linear", "step", "ease-in", "ease-out", "quad", "cubic" or
+     *             "sine"; "ease-in-out" is another name for "sine"
+     * @param easing Set to the named curve
+     * @return false if the name is unknown
+     */
+    bool easingFromName(const char *name, Easing &easing);
+
+    /**
+     * @return Curve of that name, LINEAR if unknown
+     */
+    Easing easingFromName(const char *name);
+
+    const char *easingName(Easing easing);
+
+    /**
+     * Look up a curve sampled at 257 points, interpolating linearly between them
+     * @param table Curve values in Q16 at t = 0, 1/256, ... 1
+     * @param t Position on the curve in Q16 (0-ONE)
+     * @return Curve value in Q16
+     */
+    inline uint32_t lookup(const std::array<uint32_t, 257> &table, uint32_t t) {
+        if (t >= ONE) {
+            return table[256];
+        }
+        uint32_t index = t >> 8;
+        return static_cast<uint32_t>(lerp16(static_cast<int32_t>(table[index]), static_cast<int32_t>(table[index + 1]),
+                                            (t & 0xFF) << 8));
+    }
+
+    /**
+     * t^power sampled once, for curves with an arbitrary exponent
+     */
+    class PowerCurve {
+    public:
+        explicit PowerCurve(float power);
+
+        /**
+         * @param t Position on the curve in Q16 (0-ONE)
+         * @return t^power in Q16
+         */
+        uint32_t operator()(uint32_t t) const {
+            return lookup(table, t);
+        }
+
+    private:
+        std::array<uint32_t, 257> table;
+    };
+
+    /**
+     * @param easing Curve
+     * @param t Progress in Q16 (0-ONE)
+     * @return Eased progress in Q16, exactly 0 and ONE at the ends
+     */
+    uint32_t ease(Easing easing, uint32_t t);
+}
+
+#endif //LEDZ_SUPPORT_INTERPOLATION_H
@@ -0,0 +1,178 @@
+#include "Noise.h"
+
+namespace Support::Noise {
+    namespace {
+        // Interpolation runs on Q12 fractions so every product fits 32 bits
+        constexpr int32_t UNIT = 4096;
+
+        // Ken Perlin's reference permutation
+        const uint8_t PERM[256] = {
+            151, 160, 137, 91, 90, 15, 131, 13, 201, 95, 96, 53, 194, 233, 7, 225,
+            140, 36, 103, 30, 69, 142, 8, 99, 37, 240, 21, 10, 23, 190, 6, 148,
+            247, 120, 234, 75, 0, 26, 197, 62, 94, 252, 219, 203, 117, 35, 11, 32,
+            57, 177, 33, 88, 237, 149, 56, 87, 174, 20, 125, 136, 171, 168, 68, 175,
+            74, 165, 71, 134, 139, 48, 27, 166, 77, 146, 158, 231, 83, 111, 229, 122,
+            60, 211, 133, 230, 220, 105, 92, 41, 55, 46, 245, 40, 244, 102, 143, 54,
+            65, 25, 63, 161, 1, 216, 80, 73, 209, 76, 132, 187, 208, 89, 18, 169,
+            200, 196, 135, 130, 116, 188, 159, 86, 164, 100, 109, 198, 173, 186, 3, 64,
+            52, 217, 226, 250, 124, 123, 5, 202, 38, 147, 118, 126, 255, 82, 85, 212,
+            207, 206, 59, 227, 47, 16, 58, 17, 182, 189, 28, 42, 223, 183, 170, 213,
+            119, 248, 152, 2, 44, 154, 163, 70, 221, 153, 101, 155, 167, 43, 172, 9,
+            129, 22, 39, 253, 19, 98, 108, 110, 79, 113, 224, 232, 178, 185, 112, 104,
+            218, 246, 97, 228, 251, 34, 242, 193, 238, 210, 144, 12, 191, 179, 162, 241,
+            81, 51, 145, 235, 249, 14, 239, 107, 49, 192, 214, 31, 181, 199, 106, 157,
+            184, 84, 204, 176, 115, 121, 50, 45, 127, 4, 150, 254, 138, 236, 205, 93,
+            222, 114, 67, 29, 24, 72, 243, 141, 128, 195, 78, 66, 215, 61, 156, 180,
+        };
+
+        // the twelve cube edge directions of improved Perlin noise, padded to 16
+        const int8_t GRAD3[16][3] = {
+            {1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0},
+            {1, 0, 1}, {-1, 0, 1}, {1, 0, -1}, {-1, 0, -1},
+            {0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1},
+            {1, 1, 0}, {0, -1, 1}, {-1, 1, 0}, {0, -1, -1},
+        };
+
+        // 1D slopes in 1/8
+        const int8_t GRAD1[16] = {1, 2, 3, 4, 5, 6, 7, 8, -1, -2, -3, -4, -5, -6, -7, -8};
+
+        // decorrelates the octaves, which would otherwise all be zero at the origin
+        constexpr uint32_t OCTAVE_OFFSET = 0x2A5F3C17;
+
+        // quintic fade 6t^5 - 15t^4 + 10t^3 in Q12
+        inline int32_t fade(int32_t t) {
+            int32_t t3 = (t * t >> 12) * t >> 12;
+            int32_t p = (t * (6 * t - 15 * UNIT) >> 12) + 10 * UNIT;
+            return t3 * p >> 12;
+        }
+
+        inline int32_t lerp(int32_t a, int32_t b, int32_t u) {
+            return a + ((b - a) * u >> 12);
+        }
+
+        inline uint8_t hash(uint8_t i, uint8_t j, uint8_t k) {
+            return PERM[static_cast<uint8_t>(PERM[static_cast<uint8_t>(PERM[i] + j)] + k)];
+        }
+
+        // ONE over the sum of the octave amplitudes 1 + 1/2 + ... in Q16
+        int32_t normalization(uint8_t octaves) {
+            uint32_t total = (1u << octaves) - 1;
+            return static_cast<int32_t>(((static_cast<uint32_t>(ONE) << (octaves - 1)) + total / 2) / total);
+        }
+
+        inline uint8_t clampOctaves(uint8_t octaves) {
+            return octaves < 1 ? 1 : octaves > MAX_OCTAVES ? MAX_OCTAVES : octaves;
+        }
+
+        inline uint32_t octaveCoordinate(Fixed v, uint8_t octave) {
+            return (static_cast<uint32_t>(v) << octave) + octave * OCTAVE_OFFSET;
+        }
+
+        inline Fixed combine(int32_t sum, int32_t normalize) {
+            return (sum >> 4) * normalize >> 12;
+        }
+    }
+
+    void Line::Octave::begin(uint32_t x_, uint32_t dx_, uint32_t y, uint32_t z) {
+        x = x_;
+        dx = dx_;
+        fy = static_cast<int32_t>((y & 0xFFFF) >> 4);
+        fz = static_cast<int32_t>((z & 0xFFFF) >> 4);
+        uy = fade(fy);
+        uz = fade(fz);
+        iy = static_cast<uint8_t>(y >> 16);
+        iz = static_cast<uint8_t>(z >> 16);
+        // on a lattice plane the upper z edges are weighted 0, skip them
+        edges = fz == 0 ? 2 : 4;
+        valid = false;
+    }
+
+    void Line::Octave::enter(uint8_t new_cell) {
+        cell = new_cell;
+        valid = true;
+        for (uint8_t edge = 0; edge < edges; edge++) {
+            uint8_t dy = edge & 1;
+            uint8_t dz = edge >> 1;
+            for (uint8_t side = 0; side < 2; side++) {
+                const int8_t *g = GRAD3[hash(cell + side, iy + dy, iz + dz) & 15];
+                gx[edge][side] = g[0];
+                c[edge][side] = g[1] * (fy - dy * UNIT) + g[2] * (fz - dz * UNIT);
+            }
+        }
+    }
+
+    Fixed Line::Octave::sample() {
+        auto sample_cell = static_cast<uint8_t>(x >> 16);
+        if (!valid || sample_cell != cell) {
+            enter(sample_cell);
+        }
+        auto fx = static_cast<int32_t>((x & 0xFFFF) >> 4);
+        int32_t u = fade(fx);
+        x += dx;
+
+        int32_t v[4] = {};
+        for (uint8_t edge = 0; edge < edges; edge++) {
+            int32_t a = gx[edge][0] * fx + c[edge][0];
+            int32_t b = gx[edge][1] * (fx - UNIT) + c[edge][1];
+            v[edge] = lerp(a, b, u);
+        }
+        int32_t bottom = lerp(v[0], v[1], uy);
+        return (edges == 2 ? bottom : lerp(bottom, lerp(v[2], v[3], uy), uz)) << 4;
+    }
+
+    void Line::begin(uint8_t octave_count, Fixed x, Fixed dx, Fixed y, Fixed z) {
+        count = clampOctaves(octave_count);
+        normalize = normalization(count);
+        for (uint8_t o = 0; o < count; o++) {
+            octaves[o].begin(octaveCoordinate(x, o), static_cast<uint32_t>(dx) << o,
+                             octaveCoordinate(y, o), octaveCoordinate(z, o));
+        }
+    }
+
+    Fixed Line::next() {
+        int32_t sum = 0;
+        for (uint8_t o = 0; o < count; o++) {
+            sum += octaves[o].sample() >> o;
+        }
+        return combine(sum, normalize);
+    }
+
+    Fixed noise(Fixed x) {
+        auto cell = static_cast<uint8_t>(static_cast<uint32_t>(x) >> 16);
+        auto fx = static_cast<int32_t>((static_cast<uint32_t>(x) & 0xFFFF) >> 4);
+        int32_t a = GRAD1[PERM[cell] & 15] * fx;
+        int32_t b = GRAD1[PERM[static_cast<uint8_t>(cell + 1)] & 15] * (fx - UNIT);
+        // slopes are in 1/8 and 1D noise peaks at half a slope: scale by 16 / 8 * 2
+        return lerp(a, b, fade(fx)) << 2;
+    }
+
+    Fixed noise(Fixed x, Fixed y) {
+        return noise(x, y, 0);
+    }
+
+    Fixed noise(Fixed x, Fixed y, Fixed z) {
+        Line::Octave octave;
+        octave.begin(static_cast<uint32_t>(x), 0, static_cast<uint32_t>(y), static_cast<uint32_t>(z));
+        return octave.sample();
+    }
+
+    Fixed fractal(uint8_t octaves, Fixed x) {
+        octaves = clampOctaves(octaves);
+        int32_t sum = 0;
+        for (uint8_t o = 0; o < octaves; o++) {
+            sum += noise(static_cast<Fixed>(octaveCoordinate(x, o))) >> o;
+        }
+        return combine(sum, normalization(octaves));
+    }
+
+    Fixed fractal(uint8_t octaves, Fixed x, Fixed y, Fixed z) {
+        octaves = clampOctaves(octaves);
+        int32_t sum = 0;
+        for (uint8_t o = 0; o < octaves; o++) {
+            Line::Octave octave;
+            octave.begin(octaveCoordinate(x, o), 0, octaveCoordinate(y, o), octaveCoordinate(z, o));
+            sum += octave.sample() >> o;
+        }
+        return combine(sum, normalization(octaves));
+    }
+} // Support::Noise
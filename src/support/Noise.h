@@ -0,0 +1,105 @@
+#ifndef LEDZ_SUPPORT_NOISE_H
+#define LEDZ_SUPPORT_NOISE_H
+
+#include <cstdint>
+
+namespace Support::Noise {
+    /**
+     * Q16.16 fixed point coordinate or noise value, 1.0 == ONE
+     */
+    typedef int32_t Fixed;
+
+    static constexpr Fixed ONE = 65536;
+
+    static constexpr uint8_t MAX_OCTAVES = 8;
+
+    /**
+     * Integer gradient (Perlin) noise over a 256 unit lattice.
+     *
+     * Values are roughly within [-ONE, ONE] and zero on every lattice point. The
+     * lattice repeats every 256 units and coordinates wrap like unsigned numbers,
+     * so time based coordinates can grow forever without a seam. Results only
+     * depend on the arguments: the permutation table is fixed, not seeded.
+     */
+    Fixed noise(Fixed x);
+
+    Fixed noise(Fixed x, Fixed y);
+
+    Fixed noise(Fixed x, Fixed y, Fixed z);
+
+    /**
+     * Fractal noise: octaves of noise at doubling frequency and halving
+     * amplitude, normalized back to roughly [-ONE, ONE]
+     * @param octaves 1 to MAX_OCTAVES
+     */
+    Fixed fractal(uint8_t octaves, Fixed x);
+
+    Fixed fractal(uint8_t octaves, Fixed x, Fixed y, Fixed z = 0);
+
+    /**
+     * Map a noise value to 0-255, 128 for 0
+     * @param contrast Stretch in 1/256, 256 maps [-ONE, ONE] onto the whole range
+     */
+    inline uint8_t toByte(Fixed value, int32_t contrast = 256) {
+        int32_t level = 128 + ((value >> 8) * contrast >> 9);
+        return static_cast<uint8_t>(level < 0 ? 0 : level > 255 ? 255 : level);
+    }
+
+    /**
+     * Fractal 3D noise sampled at evenly spaced points along x, for one row of
+     * pixels per frame. y and z stay fixed for the row, so their lattice hashes
+     * and gradient terms are computed once per cell instead of once per pixel;
+     * each pixel then only costs the x fade and the interpolation.
+     *
+     * Yields exactly the values of fractal(octaves, x + k * dx, y, z).
+     */
+    class Line {
+    public:
+        /**
+         * Start a new row
+         * @param octaves 1 to MAX_OCTAVES
+         * @param x First sample
+         * @param dx Distance between samples
+         */
+        void begin(uint8_t octaves, Fixed x, Fixed dx, Fixed y, Fixed z = 0);
+
+        /**
+         * @return The next sample along the row
+         */
+        Fixed next();
+
+        /**
+         * One octave of one row. Public for the free functions, which share it.
+         */
+        struct Octave {
+            uint32_t x = 0;
+            uint32_t dx = 0;
+            int32_t fy = 0; // fractions in Q12
+            int32_t fz = 0;
+            int32_t uy = 0; // faded fractions in Q12
+            int32_t uz = 0;
+            uint8_t iy = 0;
+            uint8_t iz = 0;
+            uint8_t cell = 0;
+            uint8_t edges = 4;
+            bool valid = false;
+            // per y/z edge of the current cell: x gradients and the y/z dot products
+            int8_t gx[4][2] = {};
+            int32_t c[4][2] = {};
+
+            void begin(uint32_t x, uint32_t dx, uint32_t y, uint32_t z);
+
+            Fixed sample();
+
+        private:
+            void enter(uint8_t cell);
+        };
+
+    private:
+        Octave octaves[MAX_OCTAVES];
+        uint8_t count = 0;
+        int32_t normalize = 0; // ONE / sum of amplitudes in Q16
+    };
+} // Support::Noise
+
+#endif //LEDZ_SUPPORT_NOISE_H
@@ -1,18 +1,8 @@
 #include "Palette.h"
-#include "../color.h"
-#include <cmath>
+#include <algorithm>
 
 namespace Support {
 
-    namespace {
-        Strip::Color linear_blend(Strip::Color start_color, Strip::Color end_color, float progress) {
-            auto r = static_cast<Strip::ColorComponent>(red(start_color) * (1.0f - progress) + red(end_color) * progress);
-            auto g = static_cast<Strip::ColorComponent>(green(start_color) * (1.0f - progress) + green(end_color) * progress);
-            auto b = static_cast<Strip::ColorComponent>(blue(start_color) * (1.0f - progress) + blue(end_color) * progress);
-            return color(r, g, b);
-        }
-    }
-
     Palette::Palette(std::vector<ColorPoint> points) : points(std::move(points)) {
         sortPoints();
     }
@@ -28,7 +18,17 @@ namespace Support {
     }
 
     void Palette::sortPoints() {
-        std::sort(points.begin(), points.end());
+        // stable: points at the same position keep the order they were added in
+        std::stable_sort(points.begin(), points.end());
+
+        curves.clear();
+        curve_index.assign(points.size(), -1);
+        for (size_t i = 0; i < points.size(); i++) {
+            if (points[i].interpolation == InterpolationType::Power) {
+                curve_index[i] = static_cast<int>(curves.size());
+                curves.emplace_back(points[i].power);
+            }
+        }
     }
 
     Strip::Color Palette::get_color(float position) const {
@@ -44,27 +44,33 @@ namespace Support {
             return points.back().color;
         }
 
-        for (size_t i = 0; i < points.size() - 1; ++i) {
-            if (position >= points[i].position && position < points[i + 1].position) {
-                const auto& p1 = points[i];
-                const auto& p2 = points[i + 1];
-
-                if (p1.interpolation == InterpolationType::Step) {
-                    return p1.color;
-                }
+        // the segment starts at the last point at or before position
+        auto next = std::upper_bound(points.begin(), points.end(), position,
+                                     [](float value, const ColorPoint &point) { return value < point.position; });
+        size_t i = next - points.begin() - 1;
+        const auto &p1 = points[i];
+        const auto &p2 = points[i + 1];
 
-                float range = p2.position - p1.position;
-                float progress = (position - p1.position) / range;
+        if (p1.interpolation == InterpolationType::Step) {
+            return p1.color;
+        }
 
-                if (p1.interpolation == InterpolationType::Power) {
-                    progress = std::pow(progress, p1.power);
-                }
+        float range = p2.position - p1.position;
+        uint32_t progress = Interpolation::toQ16((position - p1.position) / range);
 
-                return linear_blend(p1.color, p2.color, progress);
-            }
+        if (p1.interpolation == InterpolationType::Power) {
+            progress = curves[curve_index[i]](progress);
         }
 
-        return points.back().color;
+        return Interpolation::lerpColor(p1.color, p2.color, progress);
+    }
+
+    Palette::Table Palette::bake(float span) const {
+        Table table;
+        for (size_t i = 0; i < table.size(); i++) {
+            table[i] = get_color(static_cast<float>(i) / span);
+        }
+        return table;
     }
 
 } // namespace Support
@@ -1,9 +1,11 @@
 #ifndef LEDZ_SUPPORT_PALETTE_H
 #define LEDZ_SUPPORT_PALETTE_H
 
+#include <array>
 #include <vector>
 #include <algorithm>
 #include "../strip/Strip.h"
+#include "Interpolation.h"
 
 namespace Support {
 
@@ -29,16 +31,36 @@ namespace Support {
 
     class Palette {
     public:
+        /**
+         * A palette sampled at 256 steps, so that a color is one indexed load
+         */
+        using Table = std::array<Strip::Color, 256>;
+
         Palette() = default;
         explicit Palette(std::vector<ColorPoint> points);
 
         void addPoint(const ColorPoint& point);
         void addPoint(float position, Strip::Color color, InterpolationType interpolation = InterpolationType::Linear, float power = 1.0f);
 
+        /**
+         * @param position Position along the palette; before the first point
+         *                 and after the last the end colors continue
+         * @return Color at position
+         */
         [[nodiscard]] Strip::Color get_color(float position) const;
 
+        /**
+         * Sample the palette into a lookup table, entry i at position i / span
+         * @param span 255 to end on the last point; 256 for a palette that wraps
+         *             around, where position 1 would repeat entry 0
+         */
+        [[nodiscard]] Table bake(float span = 255.0f) const;
+
     private:
         std::vector<ColorPoint> points;
+        // t^power of each Power point, sampled once; -1 for other points
+        std::vector<int> curve_index;
+        std::vector<Interpolation::PowerCurve> curves;
         void sortPoints();
     };
 
@@ -0,0 +1,45 @@
+#include "Particles.h"
+
+namespace Support {
+    Particles::Particles(Index capacity) {
+        reserve(capacity);
+    }
+
+    void Particles::reserve(Index capacity) {
+        origins.assign(capacity, 0);
+        velocities.assign(capacity, 0);
+        accelerations.assign(capacity, 0);
+        colors.assign(capacity, 0);
+        births.assign(capacity, 0);
+        lifetimes.assign(capacity, 0);
+        count = 0;
+    }
+
+    bool Particles::spawn(Draw::Position origin, Velocity velocity, Velocity acceleration, Strip::Color color,
+                          uint32_t lifetime, uint32_t birth) {
+        if (count >= capacity()) {
+            return false;
+        }
+        origins[count] = origin;
+        velocities[count] = velocity;
+        accelerations[count] = acceleration;
+        colors[count] = color;
+        births[count] = birth;
+        lifetimes[count] = lifetime;
+        count++;
+        return true;
+    }
+
+    void Particles::remove(Index index) {
+        Index last = --count;
+        if (index == last) {
+            return;
+        }
+        origins[index] = origins[last];
+        velocities[index] = velocities[last];
+        accelerations[index] = accelerations[last];
+        colors[index] = colors[last];
+        births[index] = births[last];
+        lifetimes[index] = lifetimes[last];
+    }
+} // Support
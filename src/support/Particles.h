@@ -0,0 +1,145 @@
+#ifndef LEDZ_SUPPORT_PARTICLES_H
+#define LEDZ_SUPPORT_PARTICLES_H
+
+#include <cstdint>
+#include <vector>
+
+#include "strip/Strip.h"
+#include "Draw.h"
+
+namespace Support {
+    /**
+     * Fixed-capacity particle system with struct-of-arrays storage.
+     *
+     * Memory is allocated by reserve() only; spawning and expiring particles
+     * never allocate. Expired particles are replaced by the last live one, so
+     * the live particles always occupy [0, size()) and draw order is not stable.
+     *
+     * Particles record their birth time and motion is evaluated in closed form
+     * from the spawn position, so nothing drifts however long a particle lives:
+     *   position(age) = origin + velocity * age + acceleration * age^2 / 2
+     * Time is counted in whatever unit the show passes, frames or milliseconds;
+     * unsigned arithmetic keeps ages right across wrap-around.
+     */
+    class Particles {
+    public:
+        typedef uint16_t Index;
+
+        /**
+         * Velocity in 1/65536 pixel per time unit, acceleration in 1/65536 pixel
+         * per time unit squared
+         */
+        typedef int32_t Velocity;
+
+        static constexpr Velocity ONE_PIXEL_PER_FRAME = 65536;
+
+        /**
+         * What happens to particles that move off the strip
+         */
+        enum class Edge {
+            EXPIRE, // removed once fully off the strip
+            CLAMP // held on the first or last pixel
+        };
+
+        explicit Particles(Index capacity = 0);
+
+        /**
+         * Allocate storage for a number of particles, dropping all live ones
+         * @param capacity Maximum number of concurrent particles
+         */
+        void reserve(Index capacity);
+
+        Index capacity() const { return static_cast<Index>(colors.size()); }
+
+        Index size() const { return count; }
+
+        /**
+         * Remove all particles, keeping the storage
+         */
+        void clear() { count = 0; }
+
+        /**
+         * Add a particle
+         * @param origin Position at age 0
+         * @param velocity Velocity at age 0
+         * @param acceleration Constant acceleration
+         * @param color Color of the particle
+         * @param lifetime Age at which the particle expires
+         * @param birth Time of age 0, earlier than now to spawn a particle part way through its life
+         * @return false if the system is full and the particle was dropped
+         */
+        bool spawn(Draw::Position origin, Velocity velocity, Velocity acceleration, Strip::Color color,
+                   uint32_t lifetime, uint32_t birth);
+
+        /**
+         * Position of a live particle
+         * @param index Particle index, below size()
+         * @param now Current time
+         */
+        Draw::Position position(Index index, uint32_t now) const {
+            if (accelerations[index] == 0) {
+                return origins[index] + static_cast<Draw::Position>(
+                           static_cast<int64_t>(velocities[index]) * (now - births[index]) >> 8);
+            }
+            // (2 v t + a t^2) / 2 in 1/65536 pixel, 64 bit so long lives don't overflow
+            int64_t age = now - births[index];
+            int64_t offset = 2 * velocities[index] * age + accelerations[index] * age * age;
+            return origins[index] + static_cast<Draw::Position>(offset >> 9);
+        }
+
+        /**
+         * Update and draw every particle in one pass: particles that reached
+         * their lifetime or left the strip are removed, the rest are drawn as
+         * one pixel wide dots.
+         * @param strip Strip to draw into
+         * @param now Current time
+         * @param edge What happens to particles that leave the strip
+         * @param shade Callable (color, age, lifetime) -> color applied before drawing
+         * @param op How dots combine with the strip
+         */
+        template<typename Shade>
+        void step(Strip::Strip &strip, uint32_t now, Edge edge, Shade &&shade, Draw::Op op = Draw::Op::OVER) {
+            const Draw::Position last = (strip.length() - 1) * Draw::ONE_PIXEL;
+            Index i = 0;
+            while (i < count) {
+                uint32_t age = now - births[i];
+                if (age >= lifetimes[i]) {
+                    remove(i);
+                    continue;
+                }
+                Draw::Position pos = position(i, now);
+                if (pos < 0 || pos > last) {
+                    if (edge == Edge::EXPIRE && (pos <= -Draw::ONE_PIXEL || pos >= last + Draw::ONE_PIXEL)) {
+                        remove(i);
+                        continue;
+                    }
+                    if (edge == Edge::CLAMP) {
+                        pos = pos < 0 ? 0 : last;
+                    }
+                }
+                Draw::dot(strip, pos, shade(colors[i], age, lifetimes[i]), Draw::ONE_PIXEL, op);
+                i++;
+            }
+        }
+
+        /**
+         * step() drawing every particle in its own color
+         */
+        void step(Strip::Strip &strip, uint32_t now, Edge edge, Draw::Op op = Draw::Op::OVER) {
+            step(strip, now, edge, [](Strip::Color color, uint32_t, uint32_t) { return color; }, op);
+        }
+
+    private:
+        std::vector<Draw::Position> origins;
+        std::vector<Velocity> velocities;
+        std::vector<Velocity> accelerations;
+        std::vector<Strip::Color> colors;
+        std::vector<uint32_t> births;
+        std::vector<uint32_t> lifetimes;
+        Index count = 0;
+
+        void remove(Index index);
+    };
+} // Support
+
+#endif //LEDZ_SUPPORT_PARTICLES_H
@@ -0,0 +1,100 @@
+#include "Playlist.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Support {
+    Playlist::Playlist(Random::result_type seed) : random(seed) {
+    }
+
+    void Playlist::start(const std::vector<Entry> &list, bool shuffled, uint32_t now) {
+        entries = list;
+        shuffle = shuffled;
+        started = false;
+        cursor = 0;
+        since = now;
+        order = makePass(-1);
+        following = makePass(order.empty() ? -1 : order.back());
+    }
+
+    void Playlist::stop() {
+        entries.clear();
+        order.clear();
+        following.clear();
+        started = false;
+        cursor = 0;
+    }
+
+    const Playlist::Entry &Playlist::current() const {
+        return entries[order[cursor]];
+    }
+
+    const Playlist::Entry &Playlist::upcoming() const {
+        if (!started) {
+            return entries[order[0]];
+        }
+        return cursor + 1 < order.size() ? entries[order[cursor + 1]] : entries[following[0]];
+    }
+
+    const Playlist::Entry &Playlist::preceding() const {
+        if (!started) {
+            return entries[order[0]];
+        }
+        return entries[order[cursor > 0 ? cursor - 1 : order.size() - 1]];
+    }
+
+    uint32_t Playlist::remaining(uint32_t now) const {
+        if (!started) {
+            return 0;
+        }
+        uint32_t elapsed = now - since;
+        return elapsed < current().duration_ms ? current().duration_ms - elapsed : 0;
+    }
+
+    void Playlist::next(uint32_t now) {
+        if (!isActive()) {
+            return;
+        }
+        since = now;
+        if (!started) {
+            started = true;
+            return;
+        }
+        if (++cursor == order.size()) {
+            order.swap(following);
+            following = makePass(order.back());
+            cursor = 0;
+        }
+    }
+
+    void Playlist::previous(uint32_t now) {
+        if (!isActive()) {
+            return;
+        }
+        since = now;
+        if (!started) {
+            started = true;
+            return;
+        }
+        cursor = cursor > 0 ? cursor - 1 : order.size() - 1;
+    }
+
+    std::vector<uint8_t> Playlist::makePass(int after) {
+        std::vector<uint8_t> pass(entries.size());
+        std::iota(pass.begin(), pass.end(), 0);
+        if (!shuffle || pass.size() < 2) {
+            return pass;
+        }
+
+        // Fisher-Yates with the engine directly: the distribution of
+        // std::shuffle differs between standard libraries, this does not
+        for (size_t i = pass.size() - 1; i > 0; i--) {
+            std::swap(pass[i], pass[random.below(i + 1)]);
+        }
+        // never play the same entry twice in a row across passes
+        if (pass[0] == after) {
+            std::swap(pass[0], pass[1 + random.below(pass.size() - 1)]);
+        }
+        return pass;
+    }
+} // Support
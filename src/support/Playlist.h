@@ -0,0 +1,104 @@
+#ifndef LEDZ_SUPPORT_PLAYLIST_H
+#define LEDZ_SUPPORT_PLAYLIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Random.h"
+
+namespace Support {
+    /**
+     * Order and timing of a playlist: which entry plays, for how long, and
+     * which one follows. It knows nothing about shows, so the caller can build
+     * the upcoming entry's show ahead of time and swap it in when it is due.
+     *
+     * Times are milliseconds from a free-running clock such as millis(); the
+     * arithmetic is wrap-safe.
+     */
+    class Playlist {
+    public:
+        struct Entry {
+            uint8_t preset; // preset index
+            uint32_t duration_ms;
+        };
+
+        explicit Playlist(Random::result_type seed = randomSeed());
+
+        /**
+         * Start playing from the top. Nothing plays until the first next():
+         * the first entry is due immediately.
+         * @param entries Entries in playlist order, empty stops
+         * @param shuffle Play each pass in a new random order
+         * @param now Current time
+         */
+        void start(const std::vector<Entry> &entries, bool shuffle, uint32_t now);
+
+        void stop();
+
+        bool isActive() const { return !entries.empty(); }
+
+        size_t size() const { return entries.size(); }
+
+        bool isShuffled() const { return shuffle; }
+
+        /**
+         * @return Position of the playing entry in the current pass, size() before the first entry
+         */
+        size_t position() const { return started ? cursor : entries.size(); }
+
+        /**
+         * @return The playing entry, only valid once started
+         */
+        const Entry &current() const;
+
+        /**
+         * @return The entry next() moves to, which may be the first of the next pass
+         */
+        const Entry &upcoming() const;
+
+        /**
+         * @return The entry previous() moves to, the first entry before the first next()
+         */
+        const Entry &preceding() const;
+
+        /**
+         * @return Time left of the playing entry, 0 when it is due
+         */
+        uint32_t remaining(uint32_t now) const;
+
+        /**
+         * @return true if the playing entry has run its duration, or nothing plays yet
+         */
+        bool isDue(uint32_t now) const { return isActive() && remaining(now) == 0; }
+
+        /**
+         * Move to upcoming(), starting a new pass after the last entry
+         * @param now Start time of the entry
+         */
+        void next(uint32_t now);
+
+        /**
+         * Move to preceding(), wrapping to the end of the current pass
+         * @param now Start time of the entry
+         */
+        void previous(uint32_t now);
+
+    private:
+        std::vector<Entry> entries;
+        std::vector<uint8_t> order; // entry indices of the current pass
+        std::vector<uint8_t> following; // and of the next one, so upcoming() is known in time
+        Random random;
+        bool shuffle = false;
+        bool started = false;
+        size_t cursor = 0;
+        uint32_t since = 0;
+
+        /**
+         * @return A pass over all entries, shuffled if enabled, not starting with after
+         */
+        std::vector<uint8_t> makePass(int after);
+    };
+} // Support
+
+#endif //LEDZ_SUPPORT_PLAYLIST_H
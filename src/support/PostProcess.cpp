@@ -0,0 +1,81 @@
+#include "PostProcess.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Support::PostProcess {
+    Kernel kernelFromName(const char *name) {
+        if (name != nullptr && strcmp(name, "box") == 0) {
+            return Kernel::BOX;
+        }
+        return Kernel::GAUSSIAN;
+    }
+
+    void fade(Strip::Color *pixels, size_t length, uint8_t keep) {
+        for (size_t i = 0; i < length; i++) {
+            pixels[i] = scale(pixels[i], keep);
+        }
+    }
+
+    void trail(const Strip::Color *frame, Strip::Color *history, size_t length, uint8_t keep) {
+        for (size_t i = 0; i < length; i++) {
+            Strip::Color faded = scale(history[i], keep);
+            Strip::Color current = frame[i];
+            history[i] = std::max(faded & 0xFF0000, current & 0xFF0000) |
+                         std::max(faded & 0x00FF00, current & 0x00FF00) |
+                         std::max(faded & 0x0000FF, current & 0x0000FF);
+        }
+    }
+
+    namespace {
+        // Step one channel towards its target, always by at least 1 so it converges exactly
+        inline int32_t approach(int32_t current, int32_t target, int32_t weight) {
+            int32_t difference = target - current;
+            return current + ((difference * weight + (difference > 0 ? 255 : 0)) >> 8);
+        }
+    }
+
+    void decay(const Strip::Color *frame, Strip::Color *history, size_t length, uint8_t keep) {
+        int32_t weight = 256 - keep;
+        for (size_t i = 0; i < length; i++) {
+            Strip::Color h = history[i];
+            Strip::Color f = frame[i];
+            if (h == f) {
+                continue;
+            }
+            int32_t r = approach(h >> 16 & 0xFF, f >> 16 & 0xFF, weight);
+            int32_t g = approach(h >> 8 & 0xFF, f >> 8 & 0xFF, weight);
+            int32_t b = approach(h & 0xFF, f & 0xFF, weight);
+            history[i] = r << 16 | g << 8 | b;
+        }
+    }
+
+    void blur(Strip::Color *pixels, size_t length, Kernel kernel) {
+        if (length < 2) {
+            return;
+        }
+
+        // Lane sums of three pixels stay below 1 << 10, so red and blue share
+        // one 32 bit word and green another without carries between lanes.
+        // The box kernel multiplies by 85/256, just under a third, and rounds
+        // to nearest; the binomial kernel adds a quarter before dividing by 4,
+        // rounding up only a remainder of 3. Either way a lone pixel at level 1
+        // blurs away to black.
+        Strip::Color left = pixels[0];
+        for (size_t i = 0; i < length; i++) {
+            Strip::Color center = pixels[i];
+            Strip::Color right = i + 1 < length ? pixels[i + 1] : center;
+
+            uint32_t rb, g;
+            if (kernel == Kernel::BOX) {
+                rb = (((left & 0xFF00FF) + (center & 0xFF00FF) + (right & 0xFF00FF)) * 85 + 0x800080) >> 8;
+                g = (((left & 0x00FF00) + (center & 0x00FF00) + (right & 0x00FF00)) * 85 + 0x008000) >> 8;
+            } else {
+                rb = ((left & 0xFF00FF) + 2 * (center & 0xFF00FF) + (right & 0xFF00FF) + 0x010001) >> 2;
+                g = ((left & 0x00FF00) + 2 * (center & 0x00FF00) + (right & 0x00FF00) + 0x000100) >> 2;
+            }
+            pixels[i] = (rb & 0xFF00FF) | (g & 0x00FF00);
+            left = center;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef LEDZ_SUPPORT_POSTPROCESS_H
+#define LEDZ_SUPPORT_POSTPROCESS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "strip/Strip.h"
+
+namespace Support::PostProcess {
+    /**
+     * Scale a packed 0xRRGGBB color towards black
+     * @param color Color to scale
+     * @param keep Fraction kept (0-255, 255 keeps 255/256)
+     */
+    inline Strip::Color scale(Strip::Color color, uint8_t keep) {
+        uint32_t rb = ((color & 0xFF00FF) * keep >> 8) & 0xFF00FF;
+        uint32_t g = ((color & 0x00FF00) * keep >> 8) & 0x00FF00;
+        return rb | g;
+    }
+
+    enum class Kernel {
+        BOX, // [1 1 1] / 3
+        GAUSSIAN // [1 2 1] / 4
+    };
+
+    /**
+     * @param name "box" or "gaussian"
+     * @return Matching kernel, GAUSSIAN if unknown
+     */
+    Kernel kernelFromName(const char *name);
+
+    /**
+     * Fade all pixels towards black in place
+     * @param pixels Pixels to fade
+     * @param length Number of pixels
+     * @param keep Fraction kept per call (0-255)
+     */
+    void fade(Strip::Color *pixels, size_t length, uint8_t keep);
+
+    /**
+     * Persistent trails: fade the previous output and keep whichever is brighter
+     * per channel, the faded history or the new frame
+     * @param frame New frame
+     * @param history Previous output, overwritten with the new output
+     * @param length Number of pixels
+     * @param keep Fraction of the history kept per frame (0-255)
+     */
+    void trail(const Strip::Color *frame, Strip::Color *history, size_t length, uint8_t keep);
+
+    /**
+     * Exponential decay: move the previous output towards the new frame,
+     * smoothing changes in both directions
+     * @param frame New frame
+     * @param history Previous output, overwritten with the new output
+     * @param length Number of pixels
+     * @param keep Fraction of the history kept per frame (0-255)
+     */
+    void decay(const Strip::Color *frame, Strip::Color *history, size_t length, uint8_t keep);
+
+    /**
+     * 1D blur in place with edge pixels repeated, one pass per call
+     * @param pixels Pixels to blur
+     * @param length Number of pixels
+     * @param kernel Filter taps
+     */
+    void blur(Strip::Color *pixels, size_t length, Kernel kernel);
+}
+
+#endif //LEDZ_SUPPORT_POSTPROCESS_H
@@ -1,8 +1,8 @@
 #ifndef LEDZ_RANDOM_H
 #define LEDZ_RANDOM_H
 
+#include <cstddef>
 #include <cstdint>
-#include <random>
 
 #ifdef ARDUINO
 #include <esp_system.h>
@@ -12,15 +12,113 @@
 
 namespace Support {
     /**
-     * Lightweight PRNG for shows.
+     * Lightweight PRNG for shows: PCG32 (XSH-RR), 16 bytes of state.
      *
      * std::mt19937 is deliberately avoided: its state is ~2.5 KB, and seeding it
      * from std::random_device costs another ~2.5 KB of stack (this toolchain has
      * no entropy device, so random_device falls back to an embedded mt19937).
      * That combination overflows the 8 KB Arduino loop task stack when a show is
-     * constructed from setup(). minstd_rand holds 4 bytes and is ample here.
+     * constructed from setup().
+     *
+     * Shows call the inline helpers directly (or fill a whole frame's worth of
+     * numbers at once) instead of going through std::function and the
+     * <random> distributions. It still is a UniformRandomBitGenerator, so the
+     * standard algorithms and distributions take it where convenient.
+     *
+     * Generators with the same seed but different streams give independent
+     * sequences, so several shows can be seeded from one value.
      */
-    using Random = std::minstd_rand;
+    class Random {
+    public:
+        using result_type = uint32_t;
+
+        static constexpr uint64_t DEFAULT_STREAM = 0xda3e39cb94b95bdbULL;
+
+        static constexpr result_type min() { return 0; }
+
+        static constexpr result_type max() { return UINT32_MAX; }
+
+        /**
+         * @param seed Start of the sequence
+         * @param stream Selects one of 2^63 independent sequences
+         */
+        explicit Random(uint64_t seed = 0x853c49e6748fea9bULL, uint64_t stream = DEFAULT_STREAM) {
+            this->seed(seed, stream);
+        }
+
+        void seed(uint64_t seed, uint64_t stream = DEFAULT_STREAM) {
+            state = 0;
+            increment = (stream << 1) | 1;
+            next();
+            state += seed;
+            next();
+        }
+
+        result_type operator()() { return next(); }
+
+        /**
+         * @return Uniform 32 bit value
+         */
+        uint32_t next() {
+            uint64_t old = state;
+            state = old * MULTIPLIER + increment;
+            auto xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+            auto rotation = static_cast<uint32_t>(old >> 59);
+            return (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+        }
+
+        /**
+         * Unbiased integer below a bound (Lemire's multiply and reject)
+         * @param bound Number of possible values, at least 1
+         * @return Value in [0, bound)
+         */
+        uint32_t below(uint32_t bound) {
+            uint64_t product = static_cast<uint64_t>(next()) * bound;
+            auto low = static_cast<uint32_t>(product);
+            if (low < bound) {
+                uint32_t threshold = -bound % bound;
+                while (low < threshold) {
+                    product = static_cast<uint64_t>(next()) * bound;
+                    low = static_cast<uint32_t>(product);
+                }
+            }
+            return static_cast<uint32_t>(product >> 32);
+        }
+
+        /**
+         * @return Uniform float in [0, 1), in steps of 2^-24
+         */
+        float nextFloat() { return toFloat(next()); }
+
+        /**
+         * Fill a buffer with uniform 32 bit values
+         */
+        void fill(uint32_t *values, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                values[i] = next();
+            }
+        }
+
+        /**
+         * Fill a buffer with uniform floats in [0, 1)
+         */
+        void fill(float *values, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                values[i] = toFloat(next());
+            }
+        }
+
+    private:
+        static constexpr uint64_t MULTIPLIER = 6364136223846793005ULL;
+
+        uint64_t state;
+        uint64_t increment;
+
+        static float toFloat(uint32_t bits) {
+            // the top 24 bits fit the mantissa exactly
+            return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f);
+        }
+    };
 
     /**
      * Obtain a seed for Random.
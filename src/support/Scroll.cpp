@@ -0,0 +1,121 @@
+#include "Scroll.h"
+#include "Blend.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Support::Scroll {
+    RingPattern::RingPattern(uint32_t length) {
+        resize(length);
+    }
+
+    void RingPattern::resize(uint32_t length) {
+        pixel_count = std::max<uint32_t>(1, length);
+        pixels = std::unique_ptr<Strip::Color[]>(new Strip::Color[pixel_count]());
+    }
+
+    void RingPattern::render(uint32_t start, Strip::Color *out, size_t count) const {
+        // one period from start, wrapping once
+        size_t head = std::min<size_t>(count, pixel_count - start);
+        memcpy(out, pixels.get() + start, head * sizeof(Strip::Color));
+        size_t tail = std::min<size_t>(count - head, start);
+        memcpy(out + head, pixels.get(), tail * sizeof(Strip::Color));
+
+        // the output repeats with the pattern length; double what is done
+        size_t done = head + tail;
+        while (done < count) {
+            size_t chunk = std::min(done, count - done);
+            memcpy(out + done, out, chunk * sizeof(Strip::Color));
+            done += chunk;
+        }
+    }
+
+    uint8_t RunPattern::addColor(Strip::Color color) {
+        auto found = std::find(palette.begin(), palette.end(), color);
+        if (found != palette.end()) {
+            return static_cast<uint8_t>(found - palette.begin());
+        }
+        if (palette.size() > UINT8_MAX) {
+            return UINT8_MAX; // palette full, reuse the last entry
+        }
+        palette.push_back(color);
+        return static_cast<uint8_t>(palette.size() - 1);
+    }
+
+    void RunPattern::append(uint8_t color, uint32_t length) {
+        total += length;
+        if (!runs.empty() && runs.back().color == color) {
+            length += runs.back().length;
+            runs.pop_back();
+        }
+        while (length > 0) {
+            auto chunk = static_cast<uint16_t>(std::min<uint32_t>(length, UINT16_MAX));
+            runs.push_back({chunk, color});
+            length -= chunk;
+        }
+    }
+
+    void RunPattern::render(uint32_t start, Strip::Color *out, size_t count) const {
+        if (runs.empty()) {
+            std::fill(out, out + count, 0);
+            return;
+        }
+
+        // resume at the run the last window started in unless start lies before it
+        if (start < cursor_start) {
+            cursor_run = 0;
+            cursor_start = 0;
+        }
+        while (start >= cursor_start + runs[cursor_run].length) {
+            cursor_start += runs[cursor_run].length;
+            cursor_run++;
+        }
+
+        size_t run = cursor_run;
+        uint32_t run_start = cursor_start;
+        uint32_t position = start;
+        while (count > 0) {
+            const Run &current = runs[run];
+            size_t chunk = std::min<size_t>(count, run_start + current.length - position);
+            std::fill(out, out + chunk, palette[current.color]);
+            out += chunk;
+            count -= chunk;
+            position += chunk;
+
+            if (position == run_start + current.length) {
+                run_start = position;
+                run++;
+                if (run == runs.size()) {
+                    run = 0;
+                    run_start = 0;
+                    position = 0;
+                }
+            }
+        }
+    }
+
+    void Scroller::emit(Strip::Strip &strip, const Pattern &pattern, uint64_t offset) {
+        Strip::PixelIndex length = strip.length();
+        if (window.length() != length + 1) {
+            window.resize(length + 1);
+        }
+
+        uint64_t pattern_units = static_cast<uint64_t>(pattern.length()) * Draw::ONE_PIXEL;
+        offset %= pattern_units;
+        auto start = static_cast<uint32_t>(offset >> 8);
+        auto fraction = static_cast<uint8_t>(offset & 0xFF);
+
+        Strip::Color *pixels = window.data();
+        pattern.render(start, pixels, length + 1);
+
+        if (fraction == 0) {
+            for (Strip::PixelIndex i = 0; i < length; i++) {
+                strip.setPixelColor(i, pixels[i]);
+            }
+        } else {
+            for (Strip::PixelIndex i = 0; i < length; i++) {
+                strip.setPixelColor(i, Blend::mix(pixels[i], pixels[i + 1], fraction));
+            }
+        }
+    }
+}
@@ -0,0 +1,121 @@
+#ifndef LEDZ_SUPPORT_SCROLL_H
+#define LEDZ_SUPPORT_SCROLL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "strip/Buffer.h"
+#include "strip/Strip.h"
+#include "support/Draw.h"
+
+namespace Support::Scroll {
+    /**
+     * A repeating 1D pattern of pixels
+     */
+    class Pattern {
+    public:
+        virtual ~Pattern() = default;
+
+        /**
+         * @return Pixels until the pattern repeats (at least 1)
+         */
+        virtual uint32_t length() const = 0;
+
+        /**
+         * Write consecutive pattern pixels, wrapping around the end
+         * @param start First pattern pixel (less than length())
+         * @param out Output pixels
+         * @param count Number of pixels to write
+         */
+        virtual void render(uint32_t start, Strip::Color *out, size_t count) const = 0;
+    };
+
+    /**
+     * Pattern stored pixel by pixel in a ring buffer
+     */
+    class RingPattern : public Pattern {
+        std::unique_ptr<Strip::Color[]> pixels;
+        uint32_t pixel_count = 0;
+
+    public:
+        explicit RingPattern(uint32_t length = 1);
+
+        /**
+         * Reallocate for a new length; contents are cleared to black
+         * @param length Pixels in the pattern (at least 1)
+         */
+        void resize(uint32_t length);
+
+        void set(uint32_t index, Strip::Color color) { pixels[index] = color; }
+
+        Strip::Color get(uint32_t index) const { return pixels[index]; }
+
+        uint32_t length() const override { return pixel_count; }
+
+        void render(uint32_t start, Strip::Color *out, size_t count) const override;
+    };
+
+    /**
+     * Pattern stored as runs of palette colors, for long patterns made of few
+     * distinct stretches. Rendering resumes from the run the previous window
+     * started in, so windows that advance steadily cost O(pixels + runs crossed).
+     */
+    class RunPattern : public Pattern {
+    public:
+        struct Run {
+            uint16_t length;
+            uint8_t color; // palette index
+        };
+
+    private:
+        std::vector<Strip::Color> palette;
+        std::vector<Run> runs;
+        uint32_t total = 0;
+
+        // run containing the first pixel of the last render()
+        mutable size_t cursor_run = 0;
+        mutable uint32_t cursor_start = 0;
+
+    public:
+        /**
+         * @param color Palette entry, reused if already present
+         * @return Palette index; the last one once 256 colors are in use
+         */
+        uint8_t addColor(Strip::Color color);
+
+        /**
+         * Append pixels, merged into the last run if it has the same color
+         * @param color Palette index
+         * @param length Number of pixels
+         */
+        void append(uint8_t color, uint32_t length);
+
+        size_t runCount() const { return runs.size(); }
+
+        uint32_t length() const override { return total; }
+
+        void render(uint32_t start, Strip::Color *out, size_t count) const override;
+    };
+
+    /**
+     * Emits a window of a pattern at a sub-pixel offset. The window buffer is
+     * sized on the first frame and whenever the strip length changes.
+     */
+    class Scroller {
+        Strip::Buffer window;
+
+    public:
+        /**
+         * Fill the strip from the pattern. Pixel i shows the pattern at
+         * offset + i pixels; fractional offsets mix neighbouring pattern pixels.
+         * @param strip Strip to fill
+         * @param pattern Pattern to scroll
+         * @param offset Pattern position of pixel 0 in 1/256 pixel (may exceed the pattern length)
+         */
+        void emit(Strip::Strip &strip, const Pattern &pattern, uint64_t offset);
+    };
+}
+
+#endif //LEDZ_SUPPORT_SCROLL_H
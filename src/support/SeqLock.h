@@ -0,0 +1,67 @@
+#ifndef LEDZ_SUPPORT_SEQLOCK_H
+#define LEDZ_SUPPORT_SEQLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Support {
+    /**
+     * Single writer, many reader publication of a plain value without locks.
+     *
+     * The writer never waits: it makes the sequence odd, copies the value and
+     * makes it even again. A reader copies the value between two reads of the
+     * sequence and retries if a write overlapped, so it never sees a torn value.
+     * Suited to small values written often and read on another core, like the
+     * latest audio analysis read by the LED task.
+     */
+    template<typename T>
+    class SeqLock {
+        static_assert(std::is_trivially_copyable<T>::value, "SeqLock needs a trivially copyable value");
+
+    public:
+        /**
+         * Publish a new value, from the single writer only
+         */
+        void write(const T &value) {
+            uint32_t sequence = counter.load(std::memory_order_relaxed);
+            counter.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(&data, &value, sizeof(T));
+            counter.store(sequence + 2, std::memory_order_release);
+        }
+
+        /**
+         * Copy the latest value
+         * @param value Receives the value
+         * @param attempts Give up after this many overlapping writes
+         * @return false if nothing was published yet or every attempt overlapped a write
+         */
+        bool read(T &value, unsigned int attempts = 16) const {
+            for (unsigned int attempt = 0; attempt < attempts; attempt++) {
+                uint32_t before = counter.load(std::memory_order_acquire);
+                if (before & 1) {
+                    continue;
+                }
+                std::memcpy(&value, &data, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (counter.load(std::memory_order_relaxed) == before) {
+                    return before != 0;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @return Number of values written so far
+         */
+        uint32_t writes() const { return counter.load(std::memory_order_acquire) / 2; }
+
+    private:
+        std::atomic<uint32_t> counter{0};
+        T data{};
+    };
+} // Support
+
+#endif //LEDZ_SUPPORT_SEQLOCK_H
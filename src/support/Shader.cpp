@@ -0,0 +1,731 @@
+#include "Shader.h"
+#include "Blend.h"
+#include "Noise.h"
+#include "../color.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+namespace Support::Shader {
+    namespace {
+        enum Op : uint8_t {
+            ADD, SUB, MUL, DIV, MOD, NEG,
+            LT, LE, GT, GE, EQ, NE, SELECT,
+            SIN, COS, WAVE, TRI, ABS, FLOOR, FRAC, SQRT,
+            MIN, MAX, CLAMP, MIX, NOISE1, NOISE2,
+            RGB, HSV, WHEEL, PALETTE, GRAY, CSCALE, CADD, CMIX
+        };
+
+        // Registers set by beginFrame() and pixel(), followed by constants and temporaries
+        enum : uint8_t {
+            REG_I, REG_X, REG_N, REG_F, REG_T, FIXED_REGISTERS
+        };
+
+        // 1 / (2 pi) for sin and cos in radians
+        constexpr Fixed INV_TWO_PI = 10430;
+
+        std::array<Fixed, 257> makeSinTable() {
+            std::array<Fixed, 257> table{};
+            for (size_t i = 0; i < table.size(); i++) {
+                table[i] = static_cast<Fixed>(std::lround(std::sin(i * 2.0 * M_PI / 256.0) * ONE));
+            }
+            return table;
+        }
+
+        // one turn of sin in Q16.16, with a guard entry for interpolation
+        const std::array<Fixed, 257> SIN_TABLE = makeSinTable();
+
+        // wrapping arithmetic, overflow is not undefined behaviour for programs
+        inline Fixed add(Fixed a, Fixed b) { return static_cast<Fixed>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b)); }
+
+        inline Fixed sub(Fixed a, Fixed b) { return static_cast<Fixed>(static_cast<uint32_t>(a) - static_cast<uint32_t>(b)); }
+
+        inline Fixed mul(Fixed a, Fixed b) { return static_cast<Fixed>(static_cast<int64_t>(a) * b >> 16); }
+
+        inline Fixed div(Fixed a, Fixed b) {
+            return b == 0 ? 0 : static_cast<Fixed>(static_cast<int64_t>(a) * ONE / b);
+        }
+
+        inline Fixed mod(Fixed a, Fixed b) {
+            if (b == 0 || b == -1) {
+                return 0;
+            }
+            // floored, so the result has the sign of b like a wrapping coordinate
+            Fixed r = a % b;
+            return r != 0 && (r < 0) != (b < 0) ? r + b : r;
+        }
+
+        inline Fixed clamp(Fixed v, Fixed lo, Fixed hi) { return v < lo ? lo : v > hi ? hi : v; }
+
+        inline Fixed sinTurns(Fixed turns) {
+            uint32_t phase = static_cast<uint32_t>(turns) & 0xFFFF;
+            Fixed a = SIN_TABLE[phase >> 8];
+            Fixed b = SIN_TABLE[(phase >> 8) + 1];
+            return a + ((b - a) * static_cast<Fixed>(phase & 0xFF) >> 8);
+        }
+
+        inline Fixed tri(Fixed x) {
+            Fixed f = x & 0xFFFF;
+            return f < ONE / 2 ? 2 * f : 2 * (ONE - f);
+        }
+
+        Fixed squareRoot(Fixed a) {
+            if (a <= 0) {
+                return 0;
+            }
+            uint64_t v = static_cast<uint64_t>(a) << 16;
+            uint64_t root = 0;
+            uint64_t bit = 1ull << 46;
+            while (bit > v) {
+                bit >>= 2;
+            }
+            while (bit != 0) {
+                if (v >= root + bit) {
+                    v -= root + bit;
+                    root = (root >> 1) + bit;
+                } else {
+                    root >>= 1;
+                }
+                bit >>= 2;
+            }
+            return static_cast<Fixed>(root);
+        }
+
+        inline Fixed lerp(Fixed a, Fixed b, Fixed t) { return a + mul(b - a, t); }
+
+        // gradient noise (Support::Noise) shifted to 0-1
+        Fixed noise1(Fixed x) { return Noise::noise(x) / 2 + ONE / 2; }
+
+        Fixed noise2(Fixed x, Fixed y) { return Noise::noise(x, y) / 2 + ONE / 2; }
+
+        // 0-1 to 0-255
+        inline uint32_t channel(Fixed v) {
+            return static_cast<uint32_t>(clamp(v, 0, ONE) * 255 + ONE / 2) >> 16;
+        }
+
+        Strip::Color hsv(Fixed h, Fixed s, Fixed v) {
+            uint32_t hue = (static_cast<uint32_t>(h) & 0xFFFF) * 6;
+            uint32_t sector = hue >> 16;
+            uint32_t rest = (hue & 0xFFFF) >> 8;
+            uint32_t sat = channel(s);
+            uint32_t val = channel(v);
+            uint32_t p = val * (255 - sat) / 255;
+            uint32_t q = val * (255 - sat * rest / 255) / 255;
+            uint32_t t = val * (255 - sat * (255 - rest) / 255) / 255;
+            switch (sector) {
+                case 0: return val << 16 | t << 8 | p;
+                case 1: return q << 16 | val << 8 | p;
+                case 2: return p << 16 | val << 8 | t;
+                case 3: return p << 16 | q << 8 | val;
+                case 4: return t << 16 | p << 8 | val;
+                default: return val << 16 | p << 8 | q;
+            }
+        }
+
+        inline Strip::Color scaleColor(Strip::Color color, Fixed factor) {
+            uint32_t k = static_cast<uint32_t>(clamp(factor, 0, ONE)) >> 8;
+            uint32_t rb = ((color & 0xFF00FF) * k >> 8) & 0xFF00FF;
+            uint32_t g = ((color & 0x00FF00) * k >> 8) & 0x00FF00;
+            return rb | g;
+        }
+
+        inline Strip::Color addColors(Strip::Color a, Strip::Color b) {
+            uint32_t r = std::min<uint32_t>(255, (a >> 16 & 0xFF) + (b >> 16 & 0xFF));
+            uint32_t g = std::min<uint32_t>(255, (a >> 8 & 0xFF) + (b >> 8 & 0xFF));
+            uint32_t bl = std::min<uint32_t>(255, (a & 0xFF) + (b & 0xFF));
+            return r << 16 | g << 8 | bl;
+        }
+
+        inline Fixed apply(uint8_t op, Fixed a, Fixed b, Fixed c, const Strip::Color *palette) {
+            switch (op) {
+                case ADD: return add(a, b);
+                case SUB: return sub(a, b);
+                case MUL: return mul(a, b);
+                case DIV: return div(a, b);
+                case MOD: return mod(a, b);
+                case NEG: return sub(0, a);
+                case LT: return a < b ? ONE : 0;
+                case LE: return a <= b ? ONE : 0;
+                case GT: return a > b ? ONE : 0;
+                case GE: return a >= b ? ONE : 0;
+                case EQ: return a == b ? ONE : 0;
+                case NE: return a != b ? ONE : 0;
+                case SELECT: return a != 0 ? b : c;
+                case SIN: return sinTurns(mul(a, INV_TWO_PI));
+                case COS: return sinTurns(mul(a, INV_TWO_PI) + ONE / 4);
+                case WAVE: return (ONE + sinTurns(a)) / 2;
+                case TRI: return tri(a);
+                case ABS: return a < 0 ? sub(0, a) : a;
+                case FLOOR: return static_cast<Fixed>(static_cast<uint32_t>(a) & 0xFFFF0000u);
+                case FRAC: return a & 0xFFFF;
+                case SQRT: return squareRoot(a);
+                case MIN: return a < b ? a : b;
+                case MAX: return a > b ? a : b;
+                case CLAMP: return clamp(a, b, c);
+                case MIX: return lerp(a, b, c);
+                case NOISE1: return noise1(a);
+                case NOISE2: return noise2(a, b);
+                case RGB: return static_cast<Fixed>(channel(a) << 16 | channel(b) << 8 | channel(c));
+                case HSV: return static_cast<Fixed>(hsv(a, b, c));
+                case WHEEL: return static_cast<Fixed>(WHEEL_TABLE[(static_cast<uint32_t>(a) & 0xFFFF) * 255 >> 16]);
+                case PALETTE: return static_cast<Fixed>(palette[(static_cast<uint32_t>(a) & 0xFFFF) >> 8]);
+                case GRAY: return static_cast<Fixed>(channel(a) * 0x010101);
+                case CSCALE: return static_cast<Fixed>(scaleColor(a, b));
+                case CADD: return static_cast<Fixed>(addColors(a, b));
+                case CMIX: return static_cast<Fixed>(Blend::mix(a, b, channel(c)));
+                default: return 0;
+            }
+        }
+
+        enum class Type { NUMBER, COLOR };
+
+        struct Value {
+            Type type = Type::NUMBER;
+            bool constant = true;
+            bool varying = false; // depends on the pixel
+            Fixed value = 0;
+            uint8_t reg = 0;
+        };
+
+        struct Function {
+            const char *name;
+            uint8_t op;
+            uint8_t arguments;
+            Type result;
+        };
+
+        // functions on numbers only; min, max, mix and noise are resolved by hand
+        constexpr Function FUNCTIONS[] = {
+            {"sin", SIN, 1, Type::NUMBER},
+            {"cos", COS, 1, Type::NUMBER},
+            {"wave", WAVE, 1, Type::NUMBER},
+            {"tri", TRI, 1, Type::NUMBER},
+            {"abs", ABS, 1, Type::NUMBER},
+            {"floor", FLOOR, 1, Type::NUMBER},
+            {"frac", FRAC, 1, Type::NUMBER},
+            {"sqrt", SQRT, 1, Type::NUMBER},
+            {"min", MIN, 2, Type::NUMBER},
+            {"max", MAX, 2, Type::NUMBER},
+            {"clamp", CLAMP, 3, Type::NUMBER},
+            {"rgb", RGB, 3, Type::COLOR},
+            {"hsv", HSV, 3, Type::COLOR},
+            {"wheel", WHEEL, 1, Type::COLOR},
+            {"palette", PALETTE, 1, Type::COLOR},
+        };
+
+        bool isReserved(const std::string &name) {
+            return name == "i" || name == "x" || name == "n" || name == "f" || name == "t";
+        }
+    }
+
+    /**
+     * Single pass recursive descent compiler: every expression is folded,
+     * emitted into frame code or emitted into pixel code as it is parsed.
+     */
+    class Compiler {
+    public:
+        static constexpr int MAX_DEPTH = 24;
+
+        Compiler(Program &program, const char *source, Error &error)
+            : program(program), source(source), p(source), error(error) {
+        }
+
+        void bind(const std::string &name, Fixed value) {
+            Value v;
+            v.value = value;
+            names[name] = v;
+        }
+
+        bool compile() {
+            Value result;
+            bool has_result = false;
+            while (!failed) {
+                skipSpace();
+                if (*p == '\0') {
+                    break;
+                }
+                if (*p == ';') {
+                    p++;
+                    continue;
+                }
+
+                const char *start = p;
+                std::string name;
+                if (identifier(name)) {
+                    skipSpace();
+                    if (p[0] == '=' && p[1] != '=') {
+                        p++;
+                        if (isReserved(name)) {
+                            return fail("Cannot assign to built-in " + name, start);
+                        }
+                        Value v = expression();
+                        names[name] = v;
+                        has_result = false;
+                        endStatement();
+                        continue;
+                    }
+                    p = start;
+                }
+                result = expression();
+                has_result = true;
+                endStatement();
+            }
+            if (failed) {
+                return false;
+            }
+            if (!has_result) {
+                return fail("The last statement must be the pixel color");
+            }
+            if (result.type == Type::NUMBER) {
+                result = emit(GRAY, Type::COLOR, 1, result);
+            }
+            program.output = reg(result);
+            return !failed;
+        }
+
+    private:
+        Program &program;
+        const char *source;
+        const char *p;
+        Error &error;
+        bool failed = false;
+        int depth = 0;
+        std::map<std::string, Value> names;
+        std::map<Fixed, uint8_t> constants;
+
+        bool fail(const std::string &message, const char *at = nullptr) {
+            if (!failed) {
+                failed = true;
+                error.message = message;
+                error.position = (at != nullptr ? at : p) - source;
+            }
+            return false;
+        }
+
+        void skipSpace() {
+            while (true) {
+                while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') {
+                    p++;
+                }
+                if (p[0] == '/' && p[1] == '/') {
+                    while (*p != '\0' && *p != '\n') {
+                        p++;
+                    }
+                    continue;
+                }
+                return;
+            }
+        }
+
+        bool accept(const char *token) {
+            skipSpace();
+            size_t length = strlen(token);
+            if (strncmp(p, token, length) == 0) {
+                p += length;
+                return true;
+            }
+            return false;
+        }
+
+        void expect(const char *token) {
+            if (!accept(token)) {
+                fail(std::string("Expected ") + token);
+            }
+        }
+
+        void endStatement() {
+            skipSpace();
+            if (!failed && *p != '\0' && *p != ';') {
+                fail("Expected ; or end of program");
+            }
+        }
+
+        bool identifier(std::string &name) {
+            skipSpace();
+            if (!isalpha(static_cast<unsigned char>(*p)) && *p != '_') {
+                return false;
+            }
+            const char *start = p;
+            while (isalnum(static_cast<unsigned char>(*p)) || *p == '_') {
+                p++;
+            }
+            name.assign(start, p - start);
+            return true;
+        }
+
+        uint8_t allocate() {
+            if (program.registers.size() >= Program::MAX_REGISTERS) {
+                fail("Program too large: out of registers");
+                return 0;
+            }
+            program.registers.push_back(0);
+            return static_cast<uint8_t>(program.registers.size() - 1);
+        }
+
+        uint8_t reg(const Value &v) {
+            if (!v.constant) {
+                return v.reg;
+            }
+            auto it = constants.find(v.value);
+            if (it != constants.end()) {
+                return it->second;
+            }
+            uint8_t r = allocate();
+            program.registers[r] = v.value;
+            constants[v.value] = r;
+            return r;
+        }
+
+        Value emit(uint8_t op, Type type, int arguments, const Value &a, const Value &b = Value(),
+                   const Value &c = Value()) {
+            if (failed) {
+                return {};
+            }
+            Value result;
+            result.type = type;
+            result.constant = a.constant && (arguments < 2 || b.constant) && (arguments < 3 || c.constant);
+            if (result.constant) {
+                result.value = apply(op, a.value, b.value, c.value, program.palette.data());
+                return result;
+            }
+
+            result.varying = a.varying || (arguments >= 2 && b.varying) || (arguments >= 3 && c.varying);
+            Instruction instruction{op, 0, reg(a), 0, 0};
+            if (arguments >= 2) {
+                instruction.b = reg(b);
+            }
+            if (arguments >= 3) {
+                instruction.c = reg(c);
+            }
+            instruction.dst = allocate();
+            if (program.frame_code.size() + program.pixel_code.size() >= Program::MAX_INSTRUCTIONS) {
+                fail("Program too large: too many instructions");
+                return {};
+            }
+            (result.varying ? program.pixel_code : program.frame_code).push_back(instruction);
+            result.reg = instruction.dst;
+            return result;
+        }
+
+        Value builtin(uint8_t r, bool varying) {
+            Value v;
+            v.constant = false;
+            v.varying = varying;
+            v.reg = r;
+            return v;
+        }
+
+        bool numbers(const Value &a, const Value &b, const char *what) {
+            if (a.type != Type::NUMBER || b.type != Type::NUMBER) {
+                return fail(std::string(what) + " needs numbers");
+            }
+            return true;
+        }
+
+        Value expression() {
+            // the web server compiles on a small task stack
+            if (depth >= MAX_DEPTH) {
+                fail("Program nested too deeply");
+                return {};
+            }
+            depth++;
+            Value v = ternary();
+            depth--;
+            return v;
+        }
+
+        Value ternary() {
+            Value condition = comparison();
+            if (!accept("?")) {
+                return condition;
+            }
+            Value a = expression();
+            expect(":");
+            Value b = expression();
+            if (condition.type != Type::NUMBER) {
+                fail("Condition must be a number");
+            } else if (a.type != b.type) {
+                fail("Both branches must be numbers or both colors");
+            }
+            return emit(SELECT, a.type, 3, condition, a, b);
+        }
+
+        Value comparison() {
+            Value a = additive();
+            static const std::pair<const char *, uint8_t> OPERATORS[] = {
+                {"<=", LE}, {">=", GE}, {"==", EQ}, {"!=", NE}, {"<", LT}, {">", GT}
+            };
+            for (auto &[token, op]: OPERATORS) {
+                if (accept(token)) {
+                    Value b = additive();
+                    numbers(a, b, "Comparison");
+                    return emit(op, Type::NUMBER, 2, a, b);
+                }
+            }
+            return a;
+        }
+
+        Value additive() {
+            Value a = term();
+            while (!failed) {
+                if (accept("+")) {
+                    Value b = term();
+                    if (a.type == Type::COLOR && b.type == Type::COLOR) {
+                        a = emit(CADD, Type::COLOR, 2, a, b);
+                    } else if (numbers(a, b, "+")) {
+                        a = emit(ADD, Type::NUMBER, 2, a, b);
+                    }
+                } else if (accept("-")) {
+                    Value b = term();
+                    if (numbers(a, b, "-")) {
+                        a = emit(SUB, Type::NUMBER, 2, a, b);
+                    }
+                } else {
+                    break;
+                }
+            }
+            return a;
+        }
+
+        Value term() {
+            Value a = unary();
+            while (!failed) {
+                if (accept("*")) {
+                    Value b = unary();
+                    if (a.type == Type::COLOR && b.type == Type::NUMBER) {
+                        a = emit(CSCALE, Type::COLOR, 2, a, b);
+                    } else if (a.type == Type::NUMBER && b.type == Type::COLOR) {
+                        a = emit(CSCALE, Type::COLOR, 2, b, a);
+                    } else if (numbers(a, b, "*")) {
+                        a = emit(MUL, Type::NUMBER, 2, a, b);
+                    }
+                } else if (accept("/")) {
+                    Value b = unary();
+                    if (numbers(a, b, "/")) {
+                        a = emit(DIV, Type::NUMBER, 2, a, b);
+                    }
+                } else if (accept("%")) {
+                    Value b = unary();
+                    if (numbers(a, b, "%")) {
+                        a = emit(MOD, Type::NUMBER, 2, a, b);
+                    }
+                } else {
+                    break;
+                }
+            }
+            return a;
+        }
+
+        Value unary() {
+            bool negate = false;
+            while (accept("-")) {
+                negate = !negate;
+            }
+            Value a = primary();
+            if (!negate) {
+                return a;
+            }
+            if (a.type != Type::NUMBER) {
+                fail("- needs a number");
+            }
+            return emit(NEG, Type::NUMBER, 1, a);
+        }
+
+        Value number() {
+            const char *start = p;
+            char *end = nullptr;
+            double value = strtod(start, &end);
+            p = end;
+            if (std::fabs(value) >= 32768.0) {
+                fail("Number out of range", start);
+                return {};
+            }
+            Value v;
+            v.value = static_cast<Fixed>(std::lround(value * ONE));
+            return v;
+        }
+
+        Value primary() {
+            if (failed) {
+                return {};
+            }
+            if (accept("(")) {
+                Value v = expression();
+                expect(")");
+                return v;
+            }
+            skipSpace();
+            if (isdigit(static_cast<unsigned char>(*p)) || (*p == '.' && isdigit(static_cast<unsigned char>(p[1])))) {
+                return number();
+            }
+
+            const char *start = p;
+            std::string name;
+            if (!identifier(name)) {
+                fail(*p == '\0' ? "Unexpected end of program" : "Expected a number, name or (");
+                return {};
+            }
+            if (accept("(")) {
+                return call(name, start);
+            }
+
+            auto it = names.find(name);
+            if (it != names.end()) {
+                return it->second;
+            }
+            if (name == "i") return builtin(REG_I, true);
+            if (name == "x") return builtin(REG_X, true);
+            if (name == "n") return builtin(REG_N, false);
+            if (name == "f" || name == "t") {
+                program.animated = true;
+                return builtin(name == "f" ? REG_F : REG_T, false);
+            }
+            fail("Unknown name " + name, start);
+            return {};
+        }
+
+        Value call(const std::string &name, const char *start) {
+            Value arguments[3];
+            int count = 0;
+            if (!accept(")")) {
+                do {
+                    if (count == 3) {
+                        fail("Too many arguments to " + name, start);
+                        return {};
+                    }
+                    arguments[count++] = expression();
+                } while (!failed && accept(","));
+                expect(")");
+            }
+            if (failed) {
+                return {};
+            }
+            const Value &a = arguments[0];
+            const Value &b = arguments[1];
+            const Value &c = arguments[2];
+
+            if (name == "mix") {
+                if (count != 3) {
+                    fail("mix expects 3 arguments", start);
+                } else if (a.type != b.type || c.type != Type::NUMBER) {
+                    fail("mix expects two numbers or two colors and a number", start);
+                }
+                return emit(a.type == Type::COLOR ? CMIX : MIX, a.type, 3, a, b, c);
+            }
+            if (name == "noise") {
+                if (count < 1 || count > 2) {
+                    fail("noise expects 1 or 2 arguments", start);
+                } else if (a.type != Type::NUMBER || b.type != Type::NUMBER) {
+                    fail("noise expects numbers", start);
+                }
+                return count == 1 ? emit(NOISE1, Type::NUMBER, 1, a) : emit(NOISE2, Type::NUMBER, 2, a, b);
+            }
+            for (const Function &function: FUNCTIONS) {
+                if (name != function.name) {
+                    continue;
+                }
+                if (count != function.arguments) {
+                    fail(name + " expects " + std::to_string(function.arguments) +
+                         (function.arguments == 1 ? " argument" : " arguments"), start);
+                    return {};
+                }
+                for (int k = 0; k < count; k++) {
+                    if (arguments[k].type != Type::NUMBER) {
+                        fail(name + " expects numbers", start);
+                        return {};
+                    }
+                }
+                return emit(function.op, function.result, count, a, b, c);
+            }
+            fail("Unknown function " + name, start);
+            return {};
+        }
+    };
+
+    Program::Program() {
+        palette = WHEEL_TABLE;
+        registers.assign(FIXED_REGISTERS + 1, 0);
+        output = FIXED_REGISTERS;
+    }
+
+    bool Program::compile(const char *source, const std::vector<Variable> &variables, Error &error) {
+        auto palette = this->palette;
+        *this = Program();
+        this->palette = palette;
+        registers.resize(FIXED_REGISTERS);
+
+        Compiler compiler(*this, source, error);
+        bool valid = true;
+        for (const Variable &variable: variables) {
+            if (isReserved(variable.name) || std::fabs(variable.value) >= 32768.0f) {
+                error.message = "Invalid variable " + variable.name;
+                error.position = 0;
+                valid = false;
+                break;
+            }
+            compiler.bind(variable.name, static_cast<Fixed>(std::lround(variable.value * ONE)));
+        }
+
+        if (!valid || !compiler.compile()) {
+            // render black
+            *this = Program();
+            this->palette = palette;
+            return false;
+        }
+        return true;
+    }
+
+    void Program::setPalette(const std::vector<Strip::Color> &colors) {
+        if (colors.empty()) {
+            palette = WHEEL_TABLE;
+            return;
+        }
+        size_t segments = colors.size() - 1;
+        for (size_t k = 0; k < palette.size(); k++) {
+            // position along the colors in 1/256
+            size_t scaled = k * segments * 256 / (palette.size() - 1);
+            size_t segment = scaled >> 8;
+            palette[k] = segment >= segments
+                             ? colors.back()
+                             : Blend::mix(colors[segment], colors[segment + 1], scaled & 0xFF);
+        }
+    }
+
+    void Program::run(const std::vector<Instruction> &code, Fixed *r, const Strip::Color *palette) {
+        for (const Instruction &instruction: code) {
+            r[instruction.dst] = apply(instruction.op, r[instruction.a], r[instruction.b], r[instruction.c], palette);
+        }
+    }
+
+    void Program::beginFrame(uint32_t frame, Strip::PixelIndex length) {
+        Fixed *r = registers.data();
+        r[REG_N] = length * ONE;
+        r[REG_F] = static_cast<Fixed>(frame * static_cast<uint32_t>(ONE));
+        r[REG_T] = static_cast<Fixed>(static_cast<int64_t>(frame) * ONE / 100);
+        // rounded up so x lands on exact fractions such as 50 / 100
+        x_step = length > 0 ? ((1ull << 32) + length - 1) / length : 0;
+        run(frame_code, r, palette.data());
+    }
+
+    Strip::Color Program::pixel(Strip::PixelIndex index) {
+        Fixed *r = registers.data();
+        r[REG_I] = index * ONE;
+        r[REG_X] = static_cast<Fixed>(index * x_step >> 16);
+        run(pixel_code, r, palette.data());
+        return static_cast<Strip::Color>(r[output]);
+    }
+
+    void Program::render(Strip::Strip &strip, uint32_t frame) {
+        beginFrame(frame, strip.length());
+        if (pixel_code.empty()) {
+            strip.fill(static_cast<Strip::Color>(registers[output]));
+            return;
+        }
+        for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+            strip.setPixelColor(i, pixel(i));
+        }
+    }
+} // Support::Shader
@@ -0,0 +1,146 @@
+#ifndef LEDZ_SUPPORT_SHADER_H
+#define LEDZ_SUPPORT_SHADER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "strip/Strip.h"
+
+namespace Support::Shader {
+    /**
+     * Q16.16 fixed point number, 1.0 == ONE
+     */
+    typedef int32_t Fixed;
+
+    static constexpr Fixed ONE = 65536;
+
+    /**
+     * Named number made available to a program, e.g. from the show parameters
+     */
+    struct Variable {
+        std::string name;
+        float value;
+    };
+
+    /**
+     * Compile error with the byte offset into the source where it was found
+     */
+    struct Error {
+        std::string message;
+        size_t position = 0;
+    };
+
+    /**
+     * One register machine instruction: dst = op(a, b, c)
+     */
+    struct Instruction {
+        uint8_t op;
+        uint8_t dst;
+        uint8_t a;
+        uint8_t b;
+        uint8_t c;
+    };
+
+    /**
+     * A per-pixel color function compiled to register bytecode.
+     *
+     * The source is a list of statements separated by ';'. Statements of the form
+     * `name = expression` bind a name, the last statement is the pixel color:
+     *
+     *   w = wave(x * 3 - t * speed); wheel(x + t / 10) * w
+     *
+     * Numbers are Q16.16 fixed point. Built in names are
+     *   i  pixel index            n  number of pixels       x  i / n
+     *   f  frame counter          t  f / 100 (seconds at the default 10 ms cycle)
+     * and functions
+     *   sin cos (radians), wave tri (0-1 over a period of 1), abs floor frac sqrt,
+     *   min max clamp mix, noise(x) noise(x, y) (smooth gradient noise 0-1),
+     *   rgb(r, g, b) hsv(h, s, v) (channels 0-1), wheel(x) palette(x) (wrap every 1)
+     * Colors can be scaled by a number, added together and mixed. Operators are
+     * + - * / % < <= > >= == != and a ? b : c; division by zero yields 0. A number
+     * as the final result is shown as a gray level. f wraps after 32768 frames
+     * and t after about nine hours.
+     *
+     * Constant subexpressions are folded while compiling, and anything that does
+     * not depend on the pixel is hoisted into frame code that runs once per frame.
+     * The pixel code then runs once per pixel over a shared register file.
+     */
+    class Program {
+    public:
+        static constexpr size_t MAX_REGISTERS = 256;
+        static constexpr size_t MAX_INSTRUCTIONS = 512;
+
+        Program();
+
+        /**
+         * Compile a program, replacing any previous one
+         * @param source Program text
+         * @param variables Named numbers the program may refer to
+         * @param error Filled in when compiling fails
+         * @return true on success; on failure the program renders black
+         */
+        bool compile(const char *source, const std::vector<Variable> &variables, Error &error);
+
+        /**
+         * Colors returned by palette(), spread evenly over 0-1. Call before compile()
+         * for constant palette lookups to see them. Defaults to the color wheel.
+         * @param colors At least one color
+         */
+        void setPalette(const std::vector<Strip::Color> &colors);
+
+        /**
+         * Run the frame code
+         * @param frame Frame counter
+         * @param length Number of pixels
+         */
+        void beginFrame(uint32_t frame, Strip::PixelIndex length);
+
+        /**
+         * Run the pixel code, after beginFrame()
+         * @param index Pixel index
+         * @return Color of the pixel
+         */
+        Strip::Color pixel(Strip::PixelIndex index);
+
+        /**
+         * Render a whole frame
+         * @param strip Strip to draw into
+         * @param frame Frame counter
+         */
+        void render(Strip::Strip &strip, uint32_t frame);
+
+        /**
+         * @return true if the output changes with f or t
+         */
+        bool isAnimated() const { return animated; }
+
+        /**
+         * @return true if every pixel gets the same color
+         */
+        bool isUniform() const { return pixel_code.empty(); }
+
+        size_t frameInstructions() const { return frame_code.size(); }
+
+        size_t pixelInstructions() const { return pixel_code.size(); }
+
+        size_t registerCount() const { return registers.size(); }
+
+    private:
+        friend class Compiler;
+
+        std::vector<Instruction> frame_code;
+        std::vector<Instruction> pixel_code;
+        std::vector<Fixed> registers;
+        std::array<Strip::Color, 256> palette;
+        uint8_t output = 0;
+        bool animated = false;
+        uint64_t x_step = 0; // i to x in Q32, so no pixel pays for a division
+
+        static void run(const std::vector<Instruction> &code, Fixed *r, const Strip::Color *palette);
+    };
+} // Support::Shader
+
+#endif //LEDZ_SUPPORT_SHADER_H
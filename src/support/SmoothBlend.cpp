@@ -2,7 +2,6 @@
 #include "../color.h"
 #include "../Timer.h"
 #include <algorithm>
-#include <cmath>
 
 #ifdef ARDUINO
 #include <Arduino.h>
@@ -10,106 +9,74 @@
 
 namespace Support {
     namespace {
-        /**
-         * Blend a single color component with power function
-         * @param start_component Starting component value
-         * @param end_component Target component value
-         * @param fade_progress Progress from start (1.0) to end (0.0)
-         * @param power Power for the blend curve (1.0 = linear)
-         * @return Blended component value
-         */
-        Strip::ColorComponent blend_component(
-            Strip::ColorComponent start_component,
-            Strip::ColorComponent end_component,
-            float fade_progress,
-            float power = 1.0f
-        ) {
-            float start_value = start_component * std::pow(fade_progress, power);
-            float end_value = end_component * std::pow(1.0f - fade_progress, power);
-            return static_cast<Strip::ColorComponent>(start_value + end_value);
-        }
-
-        /**
-         * Blend two colors linearly
-         * @param start_color Starting color
-         * @param end_color Target color
-         * @param fade_progress Progress from start (1.0) to end (0.0)
-         * @return Blended color
-         */
-        Strip::Color linear_blend(Strip::Color start_color, Strip::Color end_color, float fade_progress) {
-            Strip::ColorComponent r = blend_component(red(start_color), red(end_color), fade_progress);
-            Strip::ColorComponent g = blend_component(green(start_color), green(end_color), fade_progress);
-            Strip::ColorComponent b = blend_component(blue(start_color), blue(end_color), fade_progress);
-            return color(r, g, b);
+        unsigned long now() {
+#ifdef ARDUINO
+            return millis();
+#else
+            return ::millis();
+#endif
         }
     }
 
     SmoothBlend::SmoothBlend(Strip::Strip &strip, const std::vector<Strip::Color> &target_colors,
-                             unsigned long duration_ms)
-        : strip(strip), target_colors(target_colors), duration_ms(duration_ms) {
-        // Capture initial colors from the strip
-        initial_colors.reserve(strip.length());
-        for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
-            initial_colors.push_back(strip.getPixelColor(i));
-        }
+                             unsigned long duration_ms, Interpolation::Easing easing)
+        : strip(strip), duration_ms(duration_ms), easing(easing) {
+        prepare(target_colors);
 
         // Record start time
-#ifdef ARDUINO
-        start_time = millis();
-#else
-        start_time = ::millis();
-#endif
+        start_time = now();
     }
 
-    SmoothBlend::SmoothBlend(Strip::Strip &strip, Strip::Color target_color, unsigned long duration_ms)
-        : strip(strip), duration_ms(duration_ms) {
-        // Fill target_colors with the same color for all LEDs
-        target_colors.resize(strip.length(), target_color);
-
-        // Capture initial colors from the strip
-        initial_colors.reserve(strip.length());
-        for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
-            initial_colors.push_back(strip.getPixelColor(i));
-        }
+    SmoothBlend::SmoothBlend(Strip::Strip &strip, Strip::Color target_color, unsigned long duration_ms,
+                             Interpolation::Easing easing)
+        : strip(strip), duration_ms(duration_ms), easing(easing) {
+        // The same target color for all LEDs
+        prepare(std::vector<Strip::Color>(strip.length(), target_color));
 
         // Record start time
-#ifdef ARDUINO
-        start_time = millis();
-#else
-        start_time = ::millis();
-#endif
+        start_time = now();
     }
 
-    bool SmoothBlend::step() {
-        // Get current time
-#ifdef ARDUINO
-        unsigned long now = millis();
-#else
-        unsigned long now = ::millis();
-#endif
+    void SmoothBlend::prepare(const std::vector<Strip::Color> &target_colors) {
+        // Capture initial colors from the strip, with the way to each target
+        auto count = std::min<size_t>(std::max<Strip::PixelIndex>(0, strip.length()), target_colors.size());
+        deltas.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            Strip::Color from = strip.getPixelColor(static_cast<Strip::PixelIndex>(i));
+            Strip::Color to = target_colors[i];
+            deltas.push_back({red(from), green(from), blue(from),
+                              static_cast<int16_t>(red(to) - red(from)),
+                              static_cast<int16_t>(green(to) - green(from)),
+                              static_cast<int16_t>(blue(to) - blue(from))});
+        }
+    }
 
-        // Calculate fade progress (1.0 at start, 0.0 at end)
-        float elapsed = static_cast<float>(now - start_time);
-        float fade_progress = 1.0f - std::min(elapsed / static_cast<float>(duration_ms), 1.0f);
+    bool SmoothBlend::step() {
+        unsigned long elapsed = now() - start_time;
 
-        // Update each LED
-        for (Strip::PixelIndex i = 0; i < strip.length() && i < static_cast<Strip::PixelIndex>(target_colors.size()); i
-             ++) {
-            Strip::Color blended = linear_blend(initial_colors[i], target_colors[i], fade_progress);
-            strip.setPixelColor(i, blended);
+        // Calculate progress (0 at start, ONE at the end)
+        uint32_t progress = Interpolation::ONE;
+        if (elapsed < duration_ms) {
+            progress = static_cast<uint32_t>(static_cast<uint64_t>(elapsed) * Interpolation::ONE / duration_ms);
         }
-
-        strip.show();
+        render(progress);
 
         return !isComplete();
     }
 
+    void SmoothBlend::render(uint32_t progress) {
+        int32_t t = static_cast<int32_t>(Interpolation::ease(easing, progress));
+        for (size_t i = 0; i < deltas.size(); i++) {
+            const Delta &pixel = deltas[i];
+            // channel + delta * t, rounded down like the truncated float blend
+            auto r = static_cast<Strip::ColorComponent>(pixel.red + (pixel.red_delta * t >> 16));
+            auto g = static_cast<Strip::ColorComponent>(pixel.green + (pixel.green_delta * t >> 16));
+            auto b = static_cast<Strip::ColorComponent>(pixel.blue + (pixel.blue_delta * t >> 16));
+            strip.setPixelColor(static_cast<Strip::PixelIndex>(i), color(r, g, b));
+        }
+    }
+
     bool SmoothBlend::isComplete() const {
-#ifdef ARDUINO
-        unsigned long now = millis();
-#else
-        unsigned long now = ::millis();
-#endif
-        return (now - start_time) >= duration_ms;
+        return (now() - start_time) >= duration_ms;
     }
-} // namespace Support
\ No newline at end of file
+} // namespace Support
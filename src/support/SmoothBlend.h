@@ -3,11 +3,14 @@
 
 #include <vector>
 #include "../strip/Strip.h"
+#include "Interpolation.h"
 
 namespace Support {
     /**
      * SmoothBlend creates smooth color transitions over time.
      * It interpolates between initial colors and target colors over a 2-second period.
+     * Each pixel's start and channel deltas are worked out once, so a step is
+     * one eased Q16 progress and a multiply-add per channel.
      */
     class SmoothBlend {
     public:
@@ -16,36 +19,54 @@ namespace Support {
          * @param strip The LED strip to animate
          * @param target_colors Vector of target colors for each LED
          * @param duration_ms Duration of the blend in milliseconds (default: 2000ms)
+         * @param easing Curve of the progress over time (default: linear)
          */
         SmoothBlend(Strip::Strip &strip, const std::vector<Strip::Color> &target_colors,
-                    unsigned long duration_ms = 2000);
+                    unsigned long duration_ms = 2000, Interpolation::Easing easing = Interpolation::Easing::LINEAR);
 
         /**
          * Create a smooth blend to a single color for all LEDs
          * @param strip The LED strip to animate
          * @param target_color Single target color for all LEDs
          * @param duration_ms Duration of the blend in milliseconds (default: 2000ms)
+         * @param easing Curve of the progress over time (default: linear)
          */
-        SmoothBlend(Strip::Strip &strip, Strip::Color target_color, unsigned long duration_ms = 2000);
+        SmoothBlend(Strip::Strip &strip, Strip::Color target_color, unsigned long duration_ms = 2000,
+                    Interpolation::Easing easing = Interpolation::Easing::LINEAR);
 
         /**
          * Perform one step of the blend animation.
          * Call this repeatedly (e.g., in a loop) to animate the transition.
+         * The pixels are only set; showing them is up to the caller.
          * @return true if the blend is still in progress, false if complete
          */
         bool step();
 
+        /**
+         * Set the pixels to the blend at a given point in time
+         * @param progress Share of the duration passed in Q16, 0 to Interpolation::ONE
+         */
+        void render(uint32_t progress);
+
         /**
          * Check if the blend animation is complete
          */
         bool isComplete() const;
 
     private:
+        // start and distance to the target of one pixel's channels
+        struct Delta {
+            uint8_t red, green, blue;
+            int16_t red_delta, green_delta, blue_delta;
+        };
+
         Strip::Strip &strip;
-        std::vector<Strip::Color> initial_colors;
-        std::vector<Strip::Color> target_colors;
+        std::vector<Delta> deltas;
         unsigned long start_time;
         unsigned long duration_ms;
+        Interpolation::Easing easing;
+
+        void prepare(const std::vector<Strip::Color> &target_colors);
     };
 } // namespace Support
 
@@ -0,0 +1,136 @@
+#include "Tempo.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef ARDUINO
+#include <esp_timer.h>
+#else
+#include <chrono>
+#endif
+
+namespace Support::Tempo {
+    namespace {
+        constexpr uint64_t MICROS_PER_MINUTE = 60000000ULL;
+
+        uint32_t millibpmOf(float bpm) {
+            return static_cast<uint32_t>(std::lround(std::min(MAX_BPM, std::max(MIN_BPM, bpm)) * 1000.0f));
+        }
+
+        /**
+         * Exact position of a setting at a moment
+         * @param beat Receives whole beats
+         * @param fraction Receives the beat fraction in BEAT_UNITS
+         */
+        void advance(const Setting &setting, uint64_t now_us, uint64_t &beat, uint64_t &fraction) {
+            uint64_t elapsed = now_us > setting.anchor_us ? now_us - setting.anchor_us : 0;
+            // elapsed * millibpm would overflow after a few months, so whole
+            // minutes are counted separately from the rest
+            uint64_t minutes = elapsed / MICROS_PER_MINUTE;
+            uint64_t rest = elapsed % MICROS_PER_MINUTE;
+            uint64_t millibeats = minutes * setting.millibpm;
+            uint64_t units = (millibeats % 1000) * MICROS_PER_MINUTE + rest * setting.millibpm + setting.anchor_fraction;
+            beat = setting.anchor_beat + millibeats / 1000 + units / BEAT_UNITS;
+            fraction = units % BEAT_UNITS;
+        }
+    }
+
+    uint64_t now() {
+#ifdef ARDUINO
+        return static_cast<uint64_t>(esp_timer_get_time());
+#else
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    Clock::Clock(uint64_t start_us) {
+        setting.anchor_us = start_us;
+        published.write(setting);
+    }
+
+    void Clock::setBpm(float bpm, uint64_t now_us) {
+        publish(millibpmOf(bpm), setting.beats_per_bar, now_us, false);
+    }
+
+    void Clock::setBeatsPerBar(uint8_t beats, uint64_t now_us) {
+        publish(setting.millibpm, std::max<uint8_t>(1, beats), now_us, false);
+    }
+
+    size_t Clock::tap(uint64_t now_us) {
+        if (tap_count > 0 && (now_us <= taps[tap_count - 1] || now_us - taps[tap_count - 1] > TAP_TIMEOUT_US)) {
+            tap_count = 0;
+        }
+        if (tap_count == MAX_TAPS) {
+            std::copy(taps + 1, taps + MAX_TAPS, taps);
+            tap_count--;
+        }
+        taps[tap_count++] = now_us;
+
+        uint32_t millibpm = setting.millibpm;
+        if (tap_count >= 2) {
+            double interval = static_cast<double>(now_us - taps[0]) / static_cast<double>(tap_count - 1);
+            millibpm = millibpmOf(static_cast<float>(MICROS_PER_MINUTE / interval));
+        }
+        publish(millibpm, setting.beats_per_bar, now_us, true);
+        return tap_count;
+    }
+
+    float Clock::bpm() const {
+        return static_cast<float>(current().millibpm) / 1000.0f;
+    }
+
+    uint8_t Clock::beatsPerBar() const {
+        return current().beats_per_bar;
+    }
+
+    Position Clock::at(uint64_t now_us) const {
+        return at(current(), now_us);
+    }
+
+    Position Clock::at(const Setting &setting, uint64_t now_us) {
+        uint64_t beat;
+        uint64_t fraction;
+        advance(setting, now_us, beat, fraction);
+
+        Position position;
+        position.beat = beat;
+        position.phase = static_cast<float>(static_cast<double>(fraction) / static_cast<double>(BEAT_UNITS));
+        position.bar = beat / setting.beats_per_bar;
+        position.beat_in_bar = static_cast<uint8_t>(beat % setting.beats_per_bar);
+        return position;
+    }
+
+    Setting Clock::current() const {
+        Setting latest;
+        // the writer never waits, so a read is bound to succeed soon
+        while (!published.read(latest)) {
+        }
+        return latest;
+    }
+
+    void Clock::publish(uint32_t millibpm, uint8_t beats_per_bar, uint64_t now_us, bool downbeat) {
+        uint64_t beat;
+        uint64_t fraction;
+        advance(setting, now_us, beat, fraction);
+        if (downbeat) {
+            // snap to the nearest beat so the count never jumps back a whole beat
+            if (fraction >= BEAT_UNITS / 2) {
+                beat++;
+            }
+            fraction = 0;
+        }
+
+        setting.millibpm = millibpm;
+        setting.beats_per_bar = beats_per_bar;
+        setting.anchor_us = now_us;
+        setting.anchor_beat = beat;
+        setting.anchor_fraction = fraction;
+        published.write(setting);
+    }
+
+    Clock &clock() {
+        static Clock shared;
+        return shared;
+    }
+} // Support::Tempo
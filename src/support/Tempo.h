@@ -0,0 +1,126 @@
+#ifndef LEDZ_SUPPORT_TEMPO_H
+#define LEDZ_SUPPORT_TEMPO_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "SeqLock.h"
+
+namespace Support::Tempo {
+    static constexpr float MIN_BPM = 20.0f;
+    static constexpr float MAX_BPM = 300.0f;
+
+    /**
+     * @return Microseconds of the monotonic timer, which does not wrap
+     */
+    uint64_t now();
+
+    /**
+     * Where the clock stands at some moment
+     */
+    struct Position {
+        uint64_t beat; // beats since the clock started
+        float phase; // progress through the current beat, 0-1
+        uint64_t bar; // bars since the clock started
+        uint8_t beat_in_bar; // 0 on the downbeat
+
+        /**
+         * @return Beats since the clock started, including the current fraction
+         */
+        double beats() const { return static_cast<double>(beat) + phase; }
+    };
+
+    /**
+     * Units of a beat in the anchor fraction: microseconds per minute times
+     * millibeats per beat, so that microseconds times millibpm count in them
+     */
+    static constexpr uint64_t BEAT_UNITS = 60000000ULL * 1000ULL;
+
+    /**
+     * Tempo as published to the shows: at anchor_us the clock stood at
+     * anchor_beat plus anchor_fraction / BEAT_UNITS beats, and it counts
+     * millibpm / 1000 beats per minute from there.
+     */
+    struct Setting {
+        uint32_t millibpm = 120000;
+        uint8_t beats_per_bar = 4;
+        uint64_t anchor_us = 0;
+        uint64_t anchor_beat = 0;
+        uint64_t anchor_fraction = 0;
+    };
+
+    /**
+     * Beat clock shared by beat-synchronized shows.
+     *
+     * Positions are computed from the monotonic timer in integer arithmetic,
+     * not counted in frames, so the phase stays exact to the microsecond
+     * however long the clock runs and whatever the frame rate. Changing the
+     * tempo keeps the current position, so beats and bars carry on counting.
+     *
+     * Set by a single writer (the web server); shows read the published
+     * setting without locks.
+     */
+    class Clock {
+    public:
+        static constexpr size_t MAX_TAPS = 8;
+        static constexpr uint64_t TAP_TIMEOUT_US = 2000000; // a longer pause starts a new tap sequence
+
+        /**
+         * @param start_us Moment of beat 0
+         */
+        explicit Clock(uint64_t start_us = now());
+
+        /**
+         * Change the tempo, keeping the position at that moment
+         * @param bpm Beats per minute, clamped to MIN_BPM - MAX_BPM
+         * @param now_us Moment of the change
+         */
+        void setBpm(float bpm, uint64_t now_us = now());
+
+        /**
+         * @param beats Beats per bar, at least 1
+         * @param now_us Moment of the change
+         */
+        void setBeatsPerBar(uint8_t beats, uint64_t now_us = now());
+
+        /**
+         * Tap tempo: from the second tap on, the tempo follows the average
+         * interval of the recent taps, and every tap starts a beat
+         * @param now_us Moment of the tap
+         * @return Number of taps in the current sequence
+         */
+        size_t tap(uint64_t now_us = now());
+
+        float bpm() const;
+
+        uint8_t beatsPerBar() const;
+
+        /**
+         * @param now_us Moment to look at
+         * @return Position of the clock at that moment
+         */
+        Position at(uint64_t now_us = now()) const;
+
+        /**
+         * Position of a published setting, for readers on other cores
+         */
+        static Position at(const Setting &setting, uint64_t now_us);
+
+    private:
+        SeqLock<Setting> published;
+        Setting setting; // writer's copy
+        uint64_t taps[MAX_TAPS] = {};
+        size_t tap_count = 0;
+
+        Setting current() const;
+
+        void publish(uint32_t millibpm, uint8_t beats_per_bar, uint64_t now_us, bool downbeat);
+    };
+
+    /**
+     * The clock the web server sets and beat-synchronized shows read by default
+     */
+    Clock &clock();
+} // Support::Tempo
+
+#endif //LEDZ_SUPPORT_TEMPO_H
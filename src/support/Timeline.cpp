@@ -0,0 +1,62 @@
+#include "Timeline.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Support {
+    bool Timeline::addTrack(const char *parameter, const std::vector<Keyframe> &keyframes) {
+        if (entries.size() >= MAX_TRACKS || parameter == nullptr || parameter[0] == '\0' ||
+            strlen(parameter) > MAX_PARAMETER_LENGTH || keyframes.empty() || keyframes.size() > MAX_KEYFRAMES) {
+            return false;
+        }
+        for (size_t i = 1; i < keyframes.size(); i++) {
+            if (keyframes[i].time_ms <= keyframes[i - 1].time_ms) {
+                return false;
+            }
+        }
+
+        Track track;
+        strcpy(track.parameter, parameter);
+        track.keyframes = keyframes;
+        track.value = keyframes.front().value;
+        entries.push_back(std::move(track));
+        length = std::max(length, keyframes.back().time_ms);
+        return true;
+    }
+
+    void Timeline::evaluate(uint32_t time_ms) {
+        if (looping && length > 0) {
+            time_ms %= length;
+        }
+
+        for (Track &track: entries) {
+            const std::vector<Keyframe> &keys = track.keyframes;
+            // time went backwards, e.g. a loop started over
+            if (time_ms < keys[track.segment].time_ms) {
+                track.segment = 0;
+            }
+            while (track.segment + 1 < keys.size() && keys[track.segment + 1].time_ms <= time_ms) {
+                track.segment++;
+            }
+
+            const Keyframe &from = keys[track.segment];
+            if (time_ms <= from.time_ms || track.segment + 1 == keys.size()) {
+                track.value = from.value;
+                continue;
+            }
+            const Keyframe &to = keys[track.segment + 1];
+            uint32_t elapsed = time_ms - from.time_ms;
+            uint32_t span = to.time_ms - from.time_ms;
+            float t;
+            if (from.easing == Easing::LINEAR) {
+                // finer than Q16, the value may move over hours
+                t = static_cast<float>(elapsed) / static_cast<float>(span);
+            } else {
+                uint32_t eased = Interpolation::ease(from.easing,
+                                                     static_cast<uint32_t>((static_cast<uint64_t>(elapsed) << 16) / span));
+                t = static_cast<float>(eased) / Interpolation::ONE;
+            }
+            track.value = from.value + (to.value - from.value) * t;
+        }
+    }
+} // Support
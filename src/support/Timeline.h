@@ -0,0 +1,89 @@
+#ifndef LEDZ_SUPPORT_TIMELINE_H
+#define LEDZ_SUPPORT_TIMELINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Interpolation.h"
+
+namespace Support {
+    /**
+     * Keyframes of numeric show parameters over time.
+     *
+     * Each track animates one parameter. Between two keyframes the value
+     * follows the Interpolation easing curve of the earlier one; before the first keyframe
+     * and after the last the track holds the nearest value. A looping timeline
+     * starts over after its last keyframe.
+     *
+     * Tracks remember the segment they were last evaluated in, so evaluating
+     * at increasing times costs O(tracks) per call and never allocates.
+     */
+    class Timeline {
+    public:
+        static constexpr size_t MAX_TRACKS = 8;
+        static constexpr size_t MAX_KEYFRAMES = 32; // per track
+        static constexpr size_t MAX_PARAMETER_LENGTH = 23;
+
+        using Easing = Interpolation::Easing;
+
+        struct Keyframe {
+            uint32_t time_ms;
+            float value;
+            Easing easing = Easing::LINEAR; // towards the next keyframe
+        };
+
+        /**
+         * Add a track
+         * @param parameter Show parameter name, at most MAX_PARAMETER_LENGTH characters
+         * @param keyframes 1 to MAX_KEYFRAMES keyframes in increasing time order
+         * @return false if the timeline is full or the track is invalid
+         */
+        bool addTrack(const char *parameter, const std::vector<Keyframe> &keyframes);
+
+        void setLoop(bool loop) { looping = loop; }
+
+        bool isLooping() const { return looping; }
+
+        size_t tracks() const { return entries.size(); }
+
+        const char *parameter(size_t track) const { return entries[track].parameter; }
+
+        const std::vector<Keyframe> &keyframes(size_t track) const { return entries[track].keyframes; }
+
+        /**
+         * @return Time of the last keyframe of all tracks
+         */
+        uint32_t duration() const { return length; }
+
+        /**
+         * @return true once a timeline that does not loop has passed its last keyframe
+         */
+        bool isFinished(uint32_t time_ms) const { return !looping && time_ms > length; }
+
+        /**
+         * Compute the value of every track at a time
+         * @param time_ms Time since the timeline started
+         */
+        void evaluate(uint32_t time_ms);
+
+        /**
+         * @return Value of a track at the time of the last evaluate()
+         */
+        float value(size_t track) const { return entries[track].value; }
+
+    private:
+        struct Track {
+            char parameter[MAX_PARAMETER_LENGTH + 1];
+            std::vector<Keyframe> keyframes;
+            size_t segment = 0; // keyframe at or before the last evaluated time
+            float value;
+        };
+
+        std::vector<Track> entries;
+        uint32_t length = 0;
+        bool looping = false;
+    };
+} // Support
+
+#endif //LEDZ_SUPPORT_TIMELINE_H
@@ -0,0 +1,44 @@
+#include "Audio.h"
+#include "../Log.h"
+
+static const char* TAG = "audio";
+
+namespace Task {
+    Audio::Audio(Support::Audio::Source &source, Support::Audio::Channel &output)
+        : source(source), analyzer(source.sampleRate()), output(output) {
+    }
+
+    void Audio::startTask() {
+#ifdef ARDUINO
+        // Core 0 next to the network task: the LED task on core 1 only reads
+        // the published frames, it never waits for the analysis.
+        xTaskCreatePinnedToCore(
+            taskWrapper, // Task Function
+            "Audio", // Task Name
+            6000, // Stack Size
+            this, // Parameters
+            2, // Priority, above the network task so I2S DMA buffers never overflow
+            &taskHandle, // Task Handle
+            0 // Core Number
+        );
+#endif
+    }
+
+#ifdef ARDUINO
+    void Audio::taskWrapper(void *pvParameters) {
+        ESP_LOGI(TAG, "taskWrapper()");
+        auto *instance = static_cast<Audio *>(pvParameters);
+        instance->task();
+    }
+#endif
+
+    void Audio::task() {
+        // A live source blocks in read() until the next hop of samples is in
+        while (Support::Audio::pump(source, analyzer, output)) {
+        }
+        ESP_LOGW(TAG, "Audio source ran dry, stopping analysis");
+#ifdef ARDUINO
+        vTaskDelete(nullptr);
+#endif
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef LEDZ_TASK_AUDIO_H
+#define LEDZ_TASK_AUDIO_H
+
+#include "support/Audio.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+namespace Task {
+    /**
+     * Reads the sample source and publishes the analysis to the shows
+     */
+    class Audio {
+        Support::Audio::Source &source;
+        Support::Audio::Analyzer analyzer;
+        Support::Audio::Channel &output;
+#ifdef ARDUINO
+        TaskHandle_t taskHandle = nullptr;
+
+        static void taskWrapper(void *pvParameters);
+#endif
+        void task();
+
+    public:
+        Audio(Support::Audio::Source &source, Support::Audio::Channel &output = Support::Audio::channel());
+
+        void startTask();
+    };
+}
+
+#endif //LEDZ_TASK_AUDIO_H
@@ -0,0 +1,45 @@
+#include "Playlist.h"
+#include "../Log.h"
+
+static const char* TAG = "playlist";
+
+// How often to look for an entry to build; also the delay a skip waits at most
+static constexpr uint32_t POLL_INTERVAL_MS = 100;
+
+namespace Task {
+    Playlist::Playlist(ShowController &controller) : controller(controller) {
+    }
+
+    void Playlist::startTask() {
+#ifdef ARDUINO
+        // Core 0 with the network task: building a show takes as long as it
+        // takes there, the LED task on core 1 keeps rendering meanwhile.
+        xTaskCreatePinnedToCore(
+            taskWrapper, // Task Function
+            "Playlist", // Task Name
+            10000, // Stack Size, presets are loaded and shows parsed here
+            this, // Parameters
+            1, // Priority
+            &taskHandle, // Task Handle
+            0 // Core Number
+        );
+#endif
+    }
+
+#ifdef ARDUINO
+    void Playlist::taskWrapper(void *pvParameters) {
+        ESP_LOGI(TAG, "taskWrapper()");
+        auto *instance = static_cast<Playlist *>(pvParameters);
+        instance->task();
+    }
+#endif
+
+    void Playlist::task() {
+#ifdef ARDUINO
+        while (true) {
+            controller.preparePlaylist();
+            vTaskDelay(POLL_INTERVAL_MS / portTICK_PERIOD_MS);
+        }
+#endif
+    }
+}
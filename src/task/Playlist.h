@@ -0,0 +1,31 @@
+#ifndef LEDZ_TASK_PLAYLIST_H
+#define LEDZ_TASK_PLAYLIST_H
+
+#include "ShowController.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+namespace Task {
+    /**
+     * Builds the shows of upcoming playlist entries, so the LED task only
+     * swaps them in when their slot starts
+     */
+    class Playlist {
+        ShowController &controller;
+#ifdef ARDUINO
+        TaskHandle_t taskHandle = nullptr;
+
+        static void taskWrapper(void *pvParameters);
+#endif
+        void task();
+
+    public:
+        explicit Playlist(ShowController &controller);
+
+        void startTask();
+    };
+}
+
+#endif //LEDZ_TASK_PLAYLIST_H
@@ -0,0 +1,40 @@
+#ifndef LEDZ_BENCHMARK_H
+#define LEDZ_BENCHMARK_H
+
+#include <chrono>
+#include <cstdio>
+
+#include "unity.h"
+
+// Minimal timing helper for native benchmarks.
+// Results are reported, never asserted: CI runners are too noisy for timing thresholds.
+
+// Keeps the optimizer from discarding benchmarked work
+static volatile uint32_t benchmark_sink;
+
+/**
+ * Time a body over a number of iterations and report the mean
+ * @param label Printed with the result
+ * @param iterations Number of calls to body
+ * @param units_per_iteration Work units per call (e.g. pixels), reported as ns/unit
+ * @return Mean nanoseconds per iteration
+ */
+template<typename Body>
+double benchmark(const char *label, unsigned iterations, unsigned units_per_iteration, Body &&body) {
+    body(); // warm up caches and lazy allocations
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; i++) {
+        body();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    double per_iteration = elapsed / iterations;
+    char message[160];
+    snprintf(message, sizeof(message), "%s: %.1f us/iteration, %.2f ns/unit",
+             label, per_iteration / 1000.0, per_iteration / units_per_iteration);
+    TEST_MESSAGE(message);
+    return per_iteration;
+}
+
+#endif //LEDZ_BENCHMARK_H
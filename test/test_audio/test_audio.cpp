@@ -0,0 +1,309 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "show/BeatPulse.h"
+#include "show/Spectrum.h"
+#include "strip/Buffer.h"
+#include "support/Audio.h"
+
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <vector>
+
+using Support::Audio::Analyzer;
+using Support::Audio::BANDS;
+using Support::Audio::Channel;
+using Support::Audio::Frame;
+using Support::Audio::SyntheticSource;
+
+static const uint32_t RATE = 22050;
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// Run a source through the pipeline for a number of seconds
+static std::vector<Frame> analyze(SyntheticSource &source, float seconds) {
+    Analyzer analyzer(RATE);
+    Channel channel;
+    std::vector<Frame> frames;
+    auto hops = static_cast<size_t>(seconds * RATE / Analyzer::HOP);
+    for (size_t hop = 0; hop < hops; hop++) {
+        Support::Audio::pump(source, analyzer, channel);
+        Frame frame;
+        TEST_ASSERT_TRUE(channel.read(frame));
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+// Band containing a frequency
+static size_t bandOf(const Analyzer &analyzer, float frequency) {
+    auto bin = static_cast<uint16_t>(frequency * Analyzer::SIZE / RATE + 0.5f);
+    for (size_t b = 0; b < BANDS; b++) {
+        if (bin < analyzer.bandEdges()[b + 1]) {
+            return b;
+        }
+    }
+    return BANDS - 1;
+}
+
+void test_real_fft_matches_dft() {
+    const size_t size = 64;
+    std::vector<float> input(size);
+    for (size_t i = 0; i < size; i++) {
+        input[i] = std::sin(0.3f * i) + 0.5f * std::cos(1.7f * i * i) - 0.2f;
+    }
+    std::vector<float> power(size / 2 + 1);
+    Support::Audio::RealFFT fft(size);
+    fft.power(input.data(), power.data());
+
+    for (size_t k = 0; k <= size / 2; k++) {
+        std::complex<double> sum = 0;
+        for (size_t n = 0; n < size; n++) {
+            sum += static_cast<double>(input[n]) * std::polar(1.0, -2 * M_PI * k * n / size);
+        }
+        double expected = std::norm(sum);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3 * (1 + expected), expected, power[k]);
+    }
+}
+
+void test_bands_cover_the_spectrum() {
+    Analyzer analyzer(RATE);
+    const auto &edges = analyzer.bandEdges();
+    TEST_ASSERT_EQUAL(1, edges[0]);
+    TEST_ASSERT_EQUAL(Analyzer::SIZE / 2, edges[BANDS]);
+    for (size_t b = 0; b < BANDS; b++) {
+        TEST_ASSERT_TRUE(edges[b + 1] > edges[b]);
+    }
+}
+
+void test_tone_lights_its_band() {
+    Analyzer reference(RATE);
+    for (float frequency: {100.0f, 1000.0f, 5000.0f}) {
+        SyntheticSource source(RATE, {{frequency, 0.5f}});
+        Frame frame = analyze(source, 1.0f).back();
+        size_t loudest = 0;
+        for (size_t b = 1; b < BANDS; b++) {
+            if (frame.bands[b] > frame.bands[loudest]) {
+                loudest = b;
+            }
+        }
+        TEST_ASSERT_EQUAL(bandOf(reference, frequency), loudest);
+        TEST_ASSERT_FLOAT_WITHIN(0.05f, 1.0f, frame.bands[loudest]);
+        TEST_ASSERT_TRUE(frame.level > 0.8f);
+    }
+}
+
+void test_silence_is_dark() {
+    SyntheticSource source(RATE);
+    Frame frame = analyze(source, 1.0f).back();
+    for (float band: frame.bands) {
+        TEST_ASSERT_EQUAL_FLOAT(0.0f, band);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, frame.level);
+    TEST_ASSERT_EQUAL(0, frame.beats);
+}
+
+void test_kicks_are_counted_as_beats() {
+    // 120 BPM over a steady tone and some noise: 16 kicks in 8 seconds
+    SyntheticSource source(RATE, {{440.0f, 0.2f}}, 120.0f, 0.05f);
+    std::vector<Frame> frames = analyze(source, 8.0f);
+    TEST_ASSERT_INT_WITHIN(1, 16, frames.back().beats);
+
+    // each beat is reported right after its kick
+    size_t previous = 0;
+    for (size_t i = 1; i < frames.size(); i++) {
+        if (frames[i].beats != frames[i - 1].beats) {
+            if (previous != 0) {
+                float seconds = static_cast<float>((i - previous) * Analyzer::HOP) / RATE;
+                TEST_ASSERT_FLOAT_WITHIN(0.03f, 0.5f, seconds);
+            }
+            previous = i;
+        }
+    }
+}
+
+void test_steady_bass_is_not_a_beat() {
+    SyntheticSource source(RATE, {{60.0f, 0.6f}}, 0.0f, 0.05f);
+    std::vector<Frame> frames = analyze(source, 4.0f);
+    // the onset of the tone is the only jump in bass energy
+    TEST_ASSERT_TRUE(frames.back().beats <= 1);
+}
+
+void test_wav_source_reads_back_a_file() {
+    const char *path = "test_audio.wav";
+    const int16_t stereo[] = {1000, 3000, -2000, -4000, 32767, 32767};
+    std::FILE *file = std::fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(file);
+    auto put = [file](uint32_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            std::fputc((value >> (8 * i)) & 0xFF, file);
+        }
+    };
+    std::fwrite("RIFF", 1, 4, file);
+    put(36 + sizeof(stereo), 4);
+    std::fwrite("WAVEfmt ", 1, 8, file);
+    put(16, 4);
+    put(1, 2); // PCM
+    put(2, 2); // stereo
+    put(RATE, 4);
+    put(RATE * 4, 4);
+    put(4, 2);
+    put(16, 2);
+    std::fwrite("data", 1, 4, file);
+    put(sizeof(stereo), 4);
+    for (int16_t sample: stereo) {
+        put(static_cast<uint16_t>(sample), 2);
+    }
+    std::fclose(file);
+
+    Support::Audio::WavSource wav(path, true);
+    TEST_ASSERT_TRUE(wav.isValid());
+    TEST_ASSERT_EQUAL(RATE, wav.sampleRate());
+    int16_t samples[5];
+    TEST_ASSERT_EQUAL(5, wav.read(samples, 5));
+    const int16_t expected[] = {2000, -3000, 32767, 2000, -3000};
+    TEST_ASSERT_EQUAL_INT16_ARRAY(expected, samples, 5);
+
+    Support::Audio::WavSource once(path);
+    TEST_ASSERT_EQUAL(3, once.read(samples, 5));
+    TEST_ASSERT_EQUAL(0, once.read(samples, 5));
+
+    std::remove(path);
+    TEST_ASSERT_FALSE(Support::Audio::WavSource(path).isValid());
+}
+
+void test_seqlock_publishes_the_latest_value() {
+    Channel channel;
+    Frame frame;
+    TEST_ASSERT_FALSE(channel.read(frame));
+
+    Frame published;
+    published.beats = 3;
+    published.bands[5] = 0.5f;
+    channel.write(published);
+    published.beats = 4;
+    channel.write(published);
+    TEST_ASSERT_TRUE(channel.read(frame));
+    TEST_ASSERT_EQUAL(4, frame.beats);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, frame.bands[5]);
+    TEST_ASSERT_EQUAL(2, channel.writes());
+}
+
+void test_spectrum_draws_bars() {
+    Channel channel;
+    Frame frame;
+    frame.bands[0] = 1.0f;
+    frame.bands[BANDS - 1] = 0.5f;
+    channel.write(frame);
+
+    Show::Spectrum spectrum(0.85f, false, channel);
+    MockStrip strip(BANDS * 10);
+    spectrum.execute(strip, 0);
+    // the bass bar is full, the treble bar half way, the others dark
+    for (Strip::PixelIndex i = 0; i < 10; i++) {
+        TEST_ASSERT_TRUE(strip.getPixelColor(i) != 0);
+    }
+    TEST_ASSERT_EQUAL_HEX32(0, strip.getPixelColor(15));
+    Strip::PixelIndex treble = (BANDS - 1) * 10;
+    TEST_ASSERT_TRUE(strip.getPixelColor(treble + 4) != 0);
+    TEST_ASSERT_EQUAL_HEX32(0, strip.getPixelColor(treble + 5));
+
+    // bars fall back slowly once the sound stops
+    channel.write(Frame());
+    spectrum.execute(strip, 1);
+    TEST_ASSERT_TRUE(strip.getPixelColor(7) != 0);
+    TEST_ASSERT_EQUAL_HEX32(0, strip.getPixelColor(9));
+}
+
+void test_beat_pulse_flashes_on_new_beats() {
+    Channel channel;
+    Frame frame;
+    frame.beats = 5;
+    channel.write(frame);
+
+    Show::BeatPulse pulse(0.5f, 0.0f, 40, channel);
+    MockStrip strip(10);
+    pulse.execute(strip, 0);
+    // beats from before the show started are not replayed
+    TEST_ASSERT_EQUAL_HEX32(0, strip.getPixelColor(5));
+
+    frame.beats = 6;
+    frame.beat_strength = 1.0f;
+    channel.write(frame);
+    pulse.execute(strip, 1);
+    Strip::Color flash = strip.getPixelColor(5);
+    TEST_ASSERT_TRUE(flash != 0);
+    TEST_ASSERT_EQUAL_HEX32(flash, strip.getPixelColor(0));
+
+    pulse.execute(strip, 2);
+    TEST_ASSERT_TRUE(strip.getPixelColor(5) < flash);
+}
+
+void test_benchmark_audio() {
+    Support::Audio::RealFFT fft(Analyzer::SIZE);
+    std::vector<float> input(Analyzer::SIZE), power(Analyzer::SIZE / 2 + 1);
+    for (size_t i = 0; i < input.size(); i++) {
+        input[i] = std::sin(0.1f * i);
+    }
+    benchmark("Real FFT 512", 20000, 1, [&] {
+        fft.power(input.data(), power.data());
+        benchmark_sink = static_cast<uint32_t>(power[10]);
+    });
+
+    SyntheticSource source(RATE, {{440.0f, 0.3f}, {2000.0f, 0.1f}}, 120.0f, 0.05f);
+    std::vector<int16_t> samples(RATE);
+    source.read(samples.data(), samples.size());
+    Analyzer analyzer(RATE);
+    size_t offset = 0;
+    benchmark("Analyzer hop (window, FFT, bands, beat)", 20000, 1, [&] {
+        offset = (offset + Analyzer::HOP) % (samples.size() - Analyzer::HOP);
+        benchmark_sink = analyzer.push(samples.data() + offset, Analyzer::HOP);
+    });
+
+    Channel channel;
+    Frame frame;
+    benchmark("SeqLock write + read", 100000, 1, [&] {
+        channel.write(analyzer.frame());
+        benchmark_sink = channel.read(frame);
+    });
+
+    channel.write(analyzer.frame());
+    for (Strip::PixelIndex length: {300, 1000}) {
+        char label[64];
+        Strip::Buffer strip(length);
+        Show::Iteration iteration = 0;
+        Show::Spectrum spectrum(0.85f, true, channel);
+        snprintf(label, sizeof(label), "Spectrum %d px", length);
+        benchmark(label, 2000, length, [&] { spectrum.execute(strip, iteration++); });
+
+        Show::BeatPulse pulse(0.9f, 3.0f, 40, channel);
+        snprintf(label, sizeof(label), "BeatPulse %d px", length);
+        benchmark(label, 2000, length, [&] { pulse.execute(strip, iteration++); });
+    }
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_real_fft_matches_dft);
+    RUN_TEST(test_bands_cover_the_spectrum);
+    RUN_TEST(test_tone_lights_its_band);
+    RUN_TEST(test_silence_is_dark);
+    RUN_TEST(test_kicks_are_counted_as_beats);
+    RUN_TEST(test_steady_bass_is_not_a_beat);
+    RUN_TEST(test_wav_source_reads_back_a_file);
+    RUN_TEST(test_seqlock_publishes_the_latest_value);
+    RUN_TEST(test_spectrum_draws_bars);
+    RUN_TEST(test_beat_pulse_flashes_on_new_beats);
+
+    RUN_TEST(test_benchmark_audio);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
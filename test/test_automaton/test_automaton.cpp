@@ -0,0 +1,281 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "show/Automaton.h"
+#include "strip/Buffer.h"
+#include "support/Automaton.h"
+#include "support/Random.h"
+
+#include <cstdio>
+#include <vector>
+
+using Support::Automaton::Elementary;
+using Support::Automaton::Life;
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// --- scalar references ------------------------------------------------------
+
+static std::vector<bool> referenceElementary(const std::vector<bool> &cells, uint8_t rule) {
+    size_t n = cells.size();
+    std::vector<bool> next(n);
+    for (size_t i = 0; i < n; i++) {
+        int neighbourhood = cells[(i + n - 1) % n] << 2 | cells[i] << 1 | cells[(i + 1) % n];
+        next[i] = (rule >> neighbourhood) & 1;
+    }
+    return next;
+}
+
+static std::vector<bool> referenceLife(const std::vector<bool> &cells, size_t width, size_t height) {
+    std::vector<bool> next(cells.size());
+    for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width; x++) {
+            int count = 0;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    if (dx != 0 || dy != 0) {
+                        size_t nx = (x + width + dx) % width;
+                        size_t ny = (y + height + dy) % height;
+                        count += cells[ny * width + nx];
+                    }
+                }
+            }
+            bool alive = cells[y * width + x];
+            next[y * width + x] = count == 3 || (alive && count == 2);
+        }
+    }
+    return next;
+}
+
+static std::vector<bool> randomCells(Support::Random &gen, size_t count) {
+    std::vector<bool> cells(count);
+    for (size_t i = 0; i < count; i++) {
+        cells[i] = gen() % 3 == 0;
+    }
+    return cells;
+}
+
+// --- Elementary -------------------------------------------------------------
+
+void test_elementary_matches_reference() {
+    Support::Random gen(7);
+    const uint8_t rules[] = {0, 30, 45, 90, 110, 150, 184, 255, 73, 201};
+    const size_t sizes[] = {1, 2, 5, 31, 32, 33, 63, 64, 65, 100, 1000};
+    for (uint8_t rule: rules) {
+        for (size_t size: sizes) {
+            std::vector<bool> expected = randomCells(gen, size);
+            Elementary automaton(rule);
+            automaton.resize(size);
+            for (size_t i = 0; i < size; i++) {
+                automaton.set(i, expected[i]);
+            }
+            for (int generation = 0; generation < 40; generation++) {
+                automaton.step();
+                expected = referenceElementary(expected, rule);
+                for (size_t i = 0; i < size; i++) {
+                    char message[48];
+                    snprintf(message, sizeof(message), "rule %u, %u cells, cell %u", rule,
+                             static_cast<unsigned>(size), static_cast<unsigned>(i));
+                    TEST_ASSERT_EQUAL_MESSAGE(expected[i], automaton.get(i), message);
+                }
+            }
+        }
+    }
+}
+
+void test_unused_bits_stay_clear() {
+    Elementary automaton(255);
+    automaton.resize(40);
+    automaton.step();
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFF, automaton.words()[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x000000FF, automaton.words()[1]);
+    // and a full ring no longer changes
+    TEST_ASSERT_FALSE(automaton.step());
+}
+
+void test_rule_90_draws_sierpinski() {
+    Elementary automaton(90);
+    automaton.resize(64);
+    automaton.set(32, true);
+    for (int generation = 0; generation < 4; generation++) {
+        automaton.step();
+    }
+    // generation 4 of Pascal's triangle mod 2: 1 0 0 0 0 0 0 0 1
+    for (size_t i = 0; i < 64; i++) {
+        TEST_ASSERT_EQUAL_MESSAGE(i == 28 || i == 36, automaton.get(i), "cell");
+    }
+}
+
+// --- Life -------------------------------------------------------------------
+
+void test_life_matches_reference() {
+    Support::Random gen(11);
+    const size_t shapes[][2] = {{3, 3}, {5, 5}, {32, 3}, {33, 17}, {70, 40}, {1, 8}, {100, 1}};
+    for (const auto &shape: shapes) {
+        size_t width = shape[0], height = shape[1];
+        std::vector<bool> expected = randomCells(gen, width * height);
+        Life life;
+        life.resize(width, height);
+        for (size_t y = 0; y < height; y++) {
+            for (size_t x = 0; x < width; x++) {
+                life.set(x, y, expected[y * width + x]);
+            }
+        }
+        for (int generation = 0; generation < 30; generation++) {
+            life.step();
+            expected = referenceLife(expected, width, height);
+            for (size_t y = 0; y < height; y++) {
+                for (size_t x = 0; x < width; x++) {
+                    char message[48];
+                    snprintf(message, sizeof(message), "%ux%u, cell %u,%u", static_cast<unsigned>(width),
+                             static_cast<unsigned>(height), static_cast<unsigned>(x), static_cast<unsigned>(y));
+                    TEST_ASSERT_EQUAL_MESSAGE(expected[y * width + x], life.get(x, y), message);
+                }
+            }
+        }
+    }
+}
+
+void test_glider_wraps_around_the_torus() {
+    Life life;
+    life.resize(40, 8);
+    // glider moving right and down
+    const int cells[][2] = {{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+    for (const auto &cell: cells) {
+        life.set(cell[0], cell[1], true);
+    }
+    // every 4 generations it moves one cell diagonally: 40 cells is one turn
+    // across and five turns down, back where it started
+    for (int generation = 0; generation < 4 * 40; generation++) {
+        TEST_ASSERT_TRUE(life.step());
+    }
+    for (const auto &cell: cells) {
+        TEST_ASSERT_TRUE(life.get(cell[0], cell[1]));
+    }
+}
+
+// --- show -------------------------------------------------------------------
+
+void test_show_draws_generations_with_trails() {
+    // rule 90 from a single cell, one generation per frame, two generations of trail
+    Show::Automaton automaton(90, 0, 0, {0xFF0000, 0x0000FF}, 1, 2);
+    MockStrip strip(21);
+    automaton.execute(strip, 0);
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, strip.getPixelColor(10));
+    TEST_ASSERT_EQUAL_HEX32(0x000000, strip.getPixelColor(9));
+
+    automaton.execute(strip, 1);
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, strip.getPixelColor(9));
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, strip.getPixelColor(11));
+    Strip::Color faded = strip.getPixelColor(10);
+    // half way through the palette and two thirds of the brightness
+    TEST_ASSERT_TRUE(faded != 0 && red(faded) > 0 && blue(faded) > 0 && red(faded) < 0x80);
+
+    automaton.execute(strip, 2);
+    automaton.execute(strip, 3);
+    // dead for three generations: past the end of the trail
+    TEST_ASSERT_EQUAL_HEX32(0x000000, strip.getPixelColor(10));
+}
+
+void test_show_reseeds_a_dead_pattern() {
+    // rule 0 kills everything in one generation
+    Show::Automaton automaton(0, 0, 1, {}, 1, 0);
+    MockStrip strip(64);
+    for (Show::Iteration iteration = 0; iteration < 10; iteration++) {
+        automaton.execute(strip, iteration);
+    }
+    // every other generation is a fresh random pattern
+    automaton.execute(strip, 10);
+    automaton.execute(strip, 11);
+    unsigned int lit = 0;
+    for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+        lit += strip.getPixelColor(i) != 0;
+    }
+    TEST_ASSERT_TRUE(lit > 0);
+}
+
+void test_show_plays_life_on_a_matrix() {
+    Show::Automaton automaton(30, 10, 5, {0x00FF00}, 1, 0);
+    MockStrip strip(100);
+    automaton.execute(strip, 0);
+    unsigned int lit = 0;
+    for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+        Strip::Color pixel = strip.getPixelColor(i);
+        TEST_ASSERT_TRUE(pixel == 0 || pixel == 0x00FF00);
+        lit += pixel != 0;
+    }
+    // a random soup of about 30%
+    TEST_ASSERT_TRUE(lit > 10 && lit < 60);
+}
+
+void test_benchmark_automaton() {
+    Support::Random gen(3);
+    for (size_t cells: {300, 4000}) {
+        char label[64];
+        std::vector<bool> reference = randomCells(gen, cells);
+        Elementary automaton(110);
+        automaton.resize(cells);
+        for (size_t i = 0; i < cells; i++) {
+            automaton.set(i, reference[i]);
+        }
+        snprintf(label, sizeof(label), "Rule 110 %u cells", static_cast<unsigned>(cells));
+        benchmark(label, 2000, cells, [&] { benchmark_sink = automaton.step(); });
+
+        snprintf(label, sizeof(label), "Rule 110 scalar reference %u cells", static_cast<unsigned>(cells));
+        benchmark(label, 200, cells, [&] {
+            reference = referenceElementary(reference, 110);
+            benchmark_sink = reference[0];
+        });
+    }
+
+    for (size_t side: {16, 64}) {
+        char label[64];
+        Life life;
+        life.resize(side, side);
+        std::vector<bool> soup = randomCells(gen, side * side);
+        for (size_t i = 0; i < soup.size(); i++) {
+            life.set(i % side, i / side, soup[i]);
+        }
+        snprintf(label, sizeof(label), "Life %ux%u", static_cast<unsigned>(side), static_cast<unsigned>(side));
+        benchmark(label, 1000, side * side, [&] { benchmark_sink = life.step(); });
+
+        snprintf(label, sizeof(label), "Life scalar reference %ux%u", static_cast<unsigned>(side),
+                 static_cast<unsigned>(side));
+        benchmark(label, 100, side * side, [&] {
+            soup = referenceLife(soup, side, side);
+            benchmark_sink = soup[0];
+        });
+    }
+
+    for (Strip::PixelIndex length: {300, 4000}) {
+        char label[64];
+        Strip::Buffer strip(length);
+        Show::Automaton automaton(30, 0, 1, {}, 1);
+        Show::Iteration iteration = 0;
+        snprintf(label, sizeof(label), "Automaton show %d px", length);
+        benchmark(label, 2000, length, [&] { automaton.execute(strip, iteration++); });
+    }
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_elementary_matches_reference);
+    RUN_TEST(test_unused_bits_stay_clear);
+    RUN_TEST(test_rule_90_draws_sierpinski);
+    RUN_TEST(test_life_matches_reference);
+    RUN_TEST(test_glider_wraps_around_the_torus);
+    RUN_TEST(test_show_draws_generations_with_trails);
+    RUN_TEST(test_show_reseeds_a_dead_pattern);
+    RUN_TEST(test_show_plays_life_on_a_matrix);
+
+    RUN_TEST(test_benchmark_automaton);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
@@ -0,0 +1,159 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "color.h"
+#include "show/Chaos.h"
+
+#include <cmath>
+#include <vector>
+
+using Show::Chaos;
+
+// Pixels of the strip the density histogram has any hits on
+static int litPixels(const Chaos &chaos, Strip::PixelIndex length) {
+    int lit = 0;
+    for (Strip::PixelIndex i = 0; i < length; i++) {
+        lit += chaos.density(i) > 0;
+    }
+    return lit;
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_points_mode_is_unchanged() {
+    // the old engine: the first 60 values of the map, painted over a cleared strip
+    Chaos chaos(3.3f, 4.0f, 0.01f);
+    MockStrip strip(100);
+    MockStrip expected(100);
+    float r = 3.3f;
+    for (int frame = 0; frame < 50; frame++) {
+        chaos.execute(strip, frame);
+        expected.fill(0x000000);
+        float x = 0.5f;
+        for (int i = 0; i < 60; i++) {
+            x = r * x * (1 - x);
+            expected.setPixelColor(static_cast<int16_t>(x * 99.0f), wheel((i * 4) % 255));
+        }
+        r += 0.01f;
+        for (Strip::PixelIndex i = 0; i < 100; i++) {
+            TEST_ASSERT_EQUAL_HEX32(expected.getPixelColor(i), strip.getPixelColor(i));
+        }
+    }
+}
+
+void test_density_finds_the_attractor() {
+    MockStrip strip(200);
+
+    // a single fixed point at 1 - 1/r
+    Chaos steady(2.95f, 4.0f, 0.0f, Chaos::Mode::DENSITY, 5000);
+    steady.execute(strip, 0);
+    auto pixel = static_cast<Strip::PixelIndex>((1.0f - 1.0f / 2.95f) * 200);
+    TEST_ASSERT_EQUAL(1, litPixels(steady, 200));
+    TEST_ASSERT_EQUAL_UINT32(5000 * 256, steady.density(pixel));
+
+    // period 2, then period 4
+    Chaos two(3.2f, 4.0f, 0.0f, Chaos::Mode::DENSITY, 5000);
+    two.execute(strip, 0);
+    TEST_ASSERT_EQUAL(2, litPixels(two, 200));
+    Chaos four(3.5f, 4.0f, 0.0f, Chaos::Mode::DENSITY, 5000);
+    four.execute(strip, 0);
+    TEST_ASSERT_EQUAL(4, litPixels(four, 200));
+
+    // chaos spreads over most of the strip
+    Chaos chaotic(3.99f, 4.0f, 0.0f, Chaos::Mode::DENSITY, 5000);
+    chaotic.execute(strip, 0);
+    TEST_ASSERT_GREATER_THAN(180, litPixels(chaotic, 200));
+}
+
+void test_density_fades_across_frames() {
+    MockStrip strip(50);
+    Chaos chaos(2.95f, 4.0f, 0.0f, Chaos::Mode::DENSITY, 100, 0.5f);
+    auto pixel = static_cast<Strip::PixelIndex>((1.0f - 1.0f / 2.95f) * 50);
+    chaos.execute(strip, 0);
+    TEST_ASSERT_EQUAL_UINT32(100 * 256, chaos.density(pixel));
+    chaos.execute(strip, 1);
+    TEST_ASSERT_EQUAL_UINT32(150 * 256, chaos.density(pixel));
+    chaos.execute(strip, 2);
+    TEST_ASSERT_EQUAL_UINT32(175 * 256, chaos.density(pixel));
+
+    // a new length starts an empty histogram
+    MockStrip longer(80);
+    chaos.execute(longer, 3);
+    TEST_ASSERT_EQUAL(1, litPixels(chaos, 80));
+    TEST_ASSERT_EQUAL_UINT32(100 * 256, chaos.density(static_cast<Strip::PixelIndex>((1.0f - 1.0f / 2.95f) * 80)));
+}
+
+void test_log_density_colors() {
+    Chaos chaos(2.95f, 4.0f, 0.0002f, Chaos::Mode::DENSITY, 10000, 0.8f, {0xFF0000, 0x00FF00});
+    TEST_ASSERT_EQUAL_HEX32(0x000000, chaos.colorOf(0, 1000));
+    TEST_ASSERT_EQUAL_HEX32(0x00FF00, chaos.colorOf(1000, 1000));
+    // a thousandth of the top density is still well lit
+    Strip::Color rare = chaos.colorOf(256, 256000);
+    TEST_ASSERT_GREATER_THAN(60, red(rare) + green(rare));
+    // and brightness rises with density
+    Strip::Color previous = chaos.colorOf(1, 256000);
+    for (uint32_t density = 2; density <= 256000; density *= 2) {
+        Strip::Color current = chaos.colorOf(density, 256000);
+        TEST_ASSERT_TRUE(red(current) + green(current) >= red(previous) + green(previous) - 1);
+        previous = current;
+    }
+
+    TEST_ASSERT_TRUE(Chaos::modeFromName("density") == Chaos::Mode::DENSITY);
+    TEST_ASSERT_TRUE(Chaos::modeFromName("points") == Chaos::Mode::POINTS);
+    TEST_ASSERT_TRUE(Chaos::modeFromName("fog") == Chaos::Mode::POINTS);
+    TEST_ASSERT_TRUE(Chaos::modeFromName(nullptr) == Chaos::Mode::POINTS);
+}
+
+void test_benchmark_chaos() {
+    const Strip::PixelIndex length = 300;
+    const unsigned int count = 10000;
+    MockStrip strip(length);
+
+    // the same work in floats, the way points mode iterates
+    std::vector<uint32_t> histogram(length);
+    float x = 0.5f;
+    benchmark("float map, 10000 iterations", 200, count, [&] {
+        const float r = 3.9f;
+        for (unsigned int i = 0; i < count; i++) {
+            x = r * x * (1 - x);
+            histogram[static_cast<int>(x * length)] += 256;
+        }
+        benchmark_sink = histogram[0];
+    });
+
+    Chaos chaos(3.9f, 4.0f, 0.0f, Chaos::Mode::DENSITY, count);
+    chaos.execute(strip, 0);
+    benchmark("fixed-point map, 10000 iterations", 200, count, [&] {
+        chaos.accumulate(count);
+        benchmark_sink = chaos.density(0);
+    });
+
+    Chaos points(3.9f, 4.0f, 0.0f);
+    benchmark("points frame, 300 LEDs", 200, 1, [&] {
+        points.execute(strip, 0);
+        benchmark_sink = strip.getPixelColor(0);
+    });
+    Chaos density(3.9f, 4.0f, 0.0f, Chaos::Mode::DENSITY, count);
+    benchmark("density frame, 10000 iterations, 300 LEDs", 200, 1, [&] {
+        density.execute(strip, 0);
+        benchmark_sink = strip.getPixelColor(0);
+    });
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_points_mode_is_unchanged);
+    RUN_TEST(test_density_finds_the_attractor);
+    RUN_TEST(test_density_fades_across_frames);
+    RUN_TEST(test_log_density_colors);
+    RUN_TEST(test_benchmark_chaos);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
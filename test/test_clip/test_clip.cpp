@@ -0,0 +1,328 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "show/Clip.h"
+#include "support/Clip.h"
+#include "support/Delta.h"
+#include "support/Random.h"
+
+#include <cstdio>
+#include <vector>
+
+using Support::Clip::Decoder;
+using Support::Clip::Encoder;
+using Support::Clip::Header;
+
+static const char *PATH = "test_clip.ledc";
+
+void setUp() {
+}
+
+void tearDown() {
+    std::remove(PATH);
+}
+
+typedef std::vector<Strip::Color> Frame;
+
+/**
+ * A scrolling 64 color gradient with a bouncing dot and a few sparkles, a
+ * mix of what the ops are good at (SHIFT, RUN) and what they are not
+ */
+static std::vector<Frame> animation(Strip::PixelIndex length, size_t frames) {
+    Support::Random gen(7);
+    std::vector<Frame> result;
+    for (size_t t = 0; t < frames; t++) {
+        Frame frame(length);
+        for (Strip::PixelIndex i = 0; i < length; i++) {
+            unsigned step = (i + t) % 64;
+            frame[i] = (step * 4) << 16 | (255 - step * 4);
+        }
+        auto bounce = static_cast<Strip::PixelIndex>(t % (2 * length));
+        frame[bounce < length ? bounce : 2 * length - 1 - bounce] = 0xFFFFFF;
+        for (int k = 0; k < 3; k++) {
+            frame[gen() % length] = 0x00FF00 + (gen() % 8);
+        }
+        result.push_back(frame);
+    }
+    return result;
+}
+
+static std::vector<uint8_t> encode(const std::vector<Frame> &frames, uint8_t fps, uint16_t keyframe_interval) {
+    Encoder encoder(static_cast<Strip::PixelIndex>(frames[0].size()), fps, keyframe_interval);
+    for (const Frame &frame: frames) {
+        TEST_ASSERT_TRUE(encoder.append(frame.data()));
+    }
+    return encoder.finish();
+}
+
+static void save(const std::vector<uint8_t> &bytes) {
+    std::FILE *file = std::fopen(PATH, "wb");
+    TEST_ASSERT_NOT_NULL(file);
+    std::fwrite(bytes.data(), 1, bytes.size(), file);
+    std::fclose(file);
+}
+
+static void assert_frame(const Frame &expected, const Decoder &decoder, size_t index) {
+    char message[48];
+    snprintf(message, sizeof(message), "frame %u", static_cast<unsigned>(index));
+    TEST_ASSERT_EQUAL_HEX32_ARRAY_MESSAGE(expected.data(), decoder.frame(), expected.size(), message);
+}
+
+// --- format -------------------------------------------------------------------
+
+void test_round_trip_and_loop() {
+    std::vector<Frame> frames = animation(300, 250);
+    save(encode(frames, 50, 60));
+
+    Header header;
+    TEST_ASSERT_TRUE(Support::Clip::readHeader(PATH, header));
+    TEST_ASSERT_EQUAL(50, header.fps);
+    TEST_ASSERT_EQUAL(300, header.pixels);
+    TEST_ASSERT_EQUAL(250, header.frames);
+    TEST_ASSERT_EQUAL(60, header.keyframe_interval);
+
+    Decoder decoder(PATH);
+    TEST_ASSERT_TRUE(decoder.isValid());
+    for (size_t pass = 0; pass < 2; pass++) {
+        for (size_t i = 0; i < frames.size(); i++) {
+            TEST_ASSERT_TRUE(decoder.next());
+            assert_frame(frames[i], decoder, i);
+        }
+    }
+}
+
+void test_compresses_well_below_raw() {
+    std::vector<Frame> frames = animation(300, 250);
+    std::vector<uint8_t> bytes = encode(frames, 50, 100);
+    size_t raw = frames.size() * frames[0].size() * 3;
+    char message[80];
+    snprintf(message, sizeof(message), "%u frames: %u bytes, %u raw RGB",
+             static_cast<unsigned>(frames.size()), static_cast<unsigned>(bytes.size()), static_cast<unsigned>(raw));
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(bytes.size() * 10 < raw);
+}
+
+void test_stops_at_the_end_without_loop() {
+    std::vector<Frame> frames = animation(20, 5);
+    save(encode(frames, 10, 100));
+
+    Decoder decoder(PATH, false);
+    for (size_t i = 0; i < frames.size(); i++) {
+        TEST_ASSERT_TRUE(decoder.next());
+    }
+    TEST_ASSERT_FALSE(decoder.next());
+    TEST_ASSERT_TRUE(decoder.isValid());
+    assert_frame(frames.back(), decoder, frames.size() - 1);
+}
+
+void test_seek_matches_sequential_decoding() {
+    std::vector<Frame> frames = animation(64, 200);
+    save(encode(frames, 25, 30));
+
+    Decoder decoder(PATH);
+    for (uint32_t target: {137u, 150u, 10u, 0u, 199u, 60u, 61u}) {
+        TEST_ASSERT_TRUE(decoder.seek(target));
+        TEST_ASSERT_EQUAL(target, decoder.position());
+        TEST_ASSERT_TRUE(decoder.next());
+        assert_frame(frames[target], decoder, target);
+    }
+    TEST_ASSERT_FALSE(decoder.seek(200));
+}
+
+void test_palette_overflow_rejects_the_frame_only() {
+    Encoder encoder(300, 30);
+    Frame gray(300, 0x101010);
+    TEST_ASSERT_TRUE(encoder.append(gray.data()));
+
+    Frame colorful(300);
+    for (size_t i = 0; i < colorful.size(); i++) {
+        colorful[i] = static_cast<Strip::Color>(i * 3 + 1);
+    }
+    TEST_ASSERT_FALSE(encoder.append(colorful.data()));
+    TEST_ASSERT_EQUAL(1, encoder.frames());
+
+    // the colors of the rejected frame are not kept
+    Frame few(colorful.begin(), colorful.begin() + 255);
+    few.resize(300, 0x101010);
+    TEST_ASSERT_TRUE(encoder.append(few.data()));
+
+    save(encoder.finish());
+    Decoder decoder(PATH);
+    TEST_ASSERT_TRUE(decoder.next());
+    TEST_ASSERT_TRUE(decoder.next());
+    assert_frame(few, decoder, 1);
+}
+
+void test_rejects_missing_and_malformed_files() {
+    TEST_ASSERT_FALSE(Decoder("no_such_clip.ledc").isValid());
+
+    std::vector<uint8_t> bytes = encode(animation(30, 10), 30, 100);
+    std::vector<uint8_t> bad = bytes;
+    bad[0] = 'X';
+    save(bad);
+    TEST_ASSERT_FALSE(Decoder(PATH).isValid());
+
+    bad = bytes;
+    bad[5] = 101; // fps
+    save(bad);
+    TEST_ASSERT_FALSE(Decoder(PATH).isValid());
+
+    // too short for the frames the header announces
+    bad.assign(bytes.begin(), bytes.begin() + Support::Clip::HEADER_SIZE + 8);
+    save(bad);
+    Header header;
+    TEST_ASSERT_FALSE(Support::Clip::readHeader(PATH, header));
+}
+
+void test_corrupt_frame_data_invalidates_the_decoder() {
+    std::vector<Frame> frames = animation(30, 10);
+    std::vector<uint8_t> bytes = encode(frames, 30, 100);
+    // truncate the last frame
+    bytes.resize(bytes.size() - 1);
+    save(bytes);
+
+    Decoder decoder(PATH);
+    for (size_t i = 0; i + 1 < frames.size(); i++) {
+        TEST_ASSERT_TRUE(decoder.next());
+    }
+    TEST_ASSERT_FALSE(decoder.next());
+    TEST_ASSERT_FALSE(decoder.isValid());
+}
+
+void test_delta_decode_checks_bounds() {
+    const Strip::Color palette[] = {0x111111, 0x222222};
+    Frame previous = {1, 2, 3, 4};
+    Frame current(4);
+
+    const uint8_t valid[] = {Support::Delta::RUN | 1, 1, Support::Delta::SHIFT | 1, 0xFE};
+    TEST_ASSERT_TRUE(Support::Delta::decode(valid, valid + sizeof(valid), palette, 2,
+                                            previous.data(), current.data(), 4));
+    const Frame expected = {0x222222, 0x222222, 1, 2};
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(expected.data(), current.data(), 4);
+
+    const uint8_t too_long[] = {Support::Delta::SKIP | 4};
+    const uint8_t too_short[] = {Support::Delta::SKIP | 2};
+    const uint8_t bad_color[] = {Support::Delta::RUN | 3, 2};
+    const uint8_t bad_shift[] = {Support::Delta::SKIP | 1, Support::Delta::SHIFT | 1, 1};
+    const uint8_t cut_off[] = {Support::Delta::LITERAL | 3, 0, 1};
+    TEST_ASSERT_FALSE(Support::Delta::decode(too_long, too_long + 1, palette, 2, previous.data(), current.data(), 4));
+    TEST_ASSERT_FALSE(Support::Delta::decode(too_short, too_short + 1, palette, 2, previous.data(), current.data(), 4));
+    TEST_ASSERT_FALSE(Support::Delta::decode(bad_color, bad_color + 2, palette, 2, previous.data(), current.data(), 4));
+    TEST_ASSERT_FALSE(Support::Delta::decode(bad_shift, bad_shift + 3, palette, 2, previous.data(), current.data(), 4));
+    TEST_ASSERT_FALSE(Support::Delta::decode(cut_off, cut_off + 3, palette, 2, previous.data(), current.data(), 4));
+}
+
+void test_names() {
+    TEST_ASSERT_TRUE(Support::Clip::isValidName("sunset_2-b"));
+    TEST_ASSERT_FALSE(Support::Clip::isValidName(""));
+    TEST_ASSERT_FALSE(Support::Clip::isValidName("../config"));
+    TEST_ASSERT_FALSE(Support::Clip::isValidName("a name"));
+    TEST_ASSERT_FALSE(Support::Clip::isValidName(std::string(Support::Clip::MAX_NAME_LENGTH + 1, 'a')));
+    TEST_ASSERT_EQUAL_STRING("sunset.ledc", Support::Clip::path("sunset").c_str());
+}
+
+// --- show ---------------------------------------------------------------------
+
+void test_show_plays_at_the_clip_frame_rate() {
+    std::vector<Frame> frames = animation(10, 8);
+    save(encode(frames, 25, 100));
+
+    Show::Clip show(PATH);
+    MockStrip strip(12);
+    // started late: clip time counts from the first frame shown
+    for (Show::Iteration iteration = 1000; iteration < 1040; iteration++) {
+        show.execute(strip, iteration);
+        size_t index = (iteration - 1000) / 4 % frames.size();
+        for (Strip::PixelIndex i = 0; i < 10; i++) {
+            TEST_ASSERT_EQUAL_HEX32(frames[index][i], strip.getPixelColor(i));
+        }
+        // beyond the clip
+        TEST_ASSERT_EQUAL_HEX32(0, strip.getPixelColor(10));
+        TEST_ASSERT_EQUAL_HEX32(0, strip.getPixelColor(11));
+    }
+    TEST_ASSERT_FALSE(show.isComplete());
+}
+
+void test_show_holds_the_last_frame_without_loop() {
+    std::vector<Frame> frames = animation(10, 8);
+    save(encode(frames, 100, 100));
+
+    Show::Clip show(PATH, false);
+    MockStrip strip(10);
+    for (Show::Iteration iteration = 0; iteration < 8; iteration++) {
+        show.execute(strip, iteration);
+        TEST_ASSERT_FALSE(show.isComplete());
+    }
+    // a stall skips ahead to the end
+    show.execute(strip, 5000);
+    TEST_ASSERT_TRUE(show.isComplete());
+    for (Strip::PixelIndex i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_HEX32(frames.back()[i], strip.getPixelColor(i));
+    }
+}
+
+void test_show_catches_up_after_a_stall() {
+    std::vector<Frame> frames = animation(16, 300);
+    save(encode(frames, 100, 20));
+
+    Show::Clip show(PATH);
+    MockStrip strip(16);
+    show.execute(strip, 0);
+    show.execute(strip, 777);
+    for (Strip::PixelIndex i = 0; i < 16; i++) {
+        TEST_ASSERT_EQUAL_HEX32(frames[777 % 300][i], strip.getPixelColor(i));
+    }
+}
+
+void test_show_without_clip_is_dark() {
+    Show::Clip show("no_such_clip.ledc");
+    MockStrip strip(4);
+    strip.fill(0xFFFFFF);
+    show.execute(strip, 0);
+    TEST_ASSERT_FALSE(show.isValid());
+    TEST_ASSERT_TRUE(show.isComplete());
+    TEST_ASSERT_EQUAL_HEX32(0, strip.getPixelColor(3));
+}
+
+// --- benchmark ----------------------------------------------------------------
+
+void test_benchmark_decode() {
+    // 10 s at 300 LEDs x 100 fps: each frame has a 10 ms budget
+    std::vector<Frame> frames = animation(300, 1000);
+    save(encode(frames, 100, 100));
+
+    Decoder decoder(PATH);
+    benchmark("Clip decode 300 px from file", 5000, 300, [&] {
+        decoder.next();
+        benchmark_sink = decoder.frame()[0];
+    });
+
+    Show::Clip show(PATH);
+    MockStrip strip(300);
+    Show::Iteration iteration = 0;
+    benchmark("Clip show 300 px at 100 fps", 5000, 300, [&] { show.execute(strip, iteration++); });
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip_and_loop);
+    RUN_TEST(test_compresses_well_below_raw);
+    RUN_TEST(test_stops_at_the_end_without_loop);
+    RUN_TEST(test_seek_matches_sequential_decoding);
+    RUN_TEST(test_palette_overflow_rejects_the_frame_only);
+    RUN_TEST(test_rejects_missing_and_malformed_files);
+    RUN_TEST(test_corrupt_frame_data_invalidates_the_decoder);
+    RUN_TEST(test_delta_decode_checks_bounds);
+    RUN_TEST(test_names);
+    RUN_TEST(test_show_plays_at_the_clip_frame_rate);
+    RUN_TEST(test_show_holds_the_last_frame_without_loop);
+    RUN_TEST(test_show_catches_up_after_a_stall);
+    RUN_TEST(test_show_without_clip_is_dark);
+
+    RUN_TEST(test_benchmark_decode);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
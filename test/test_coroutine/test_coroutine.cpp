@@ -0,0 +1,221 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "show/Starlight.h"
+#include "show/Stroboscope.h"
+#include "support/Coroutine.h"
+
+#include <vector>
+
+using Support::Coroutine;
+
+// Fade in over 100, hold 50, fade out over 100, then finish
+struct Pulse {
+    Coroutine co;
+    int32_t level = -1;
+    int steps = 0;
+
+    void run(uint32_t now) {
+        CO_BEGIN(co, now);
+        CO_FADE(co, now, 100, level, 0, 1000);
+        steps++;
+        CO_WAIT(co, now, 50);
+        steps++;
+        CO_FADE(co, now, 100, level, 1000, 0);
+        steps++;
+        CO_END(co);
+    }
+};
+
+// Endless loop of a 30 long step and a 20 long step
+struct Blink {
+    Coroutine co;
+    bool on = false;
+    std::vector<uint32_t> switches;
+
+    void run(uint32_t now) {
+        CO_BEGIN(co, now);
+        for (;;) {
+            on = true;
+            switches.push_back(co.mark);
+            CO_WAIT(co, now, 30);
+            on = false;
+            switches.push_back(co.mark);
+            CO_WAIT(co, now, 20);
+        }
+        CO_END(co);
+    }
+};
+
+// Waits for a condition, then yields once
+struct Gate {
+    Coroutine co;
+    bool open = false;
+    int passed = 0;
+
+    void run(uint32_t now) {
+        CO_BEGIN(co, now);
+        CO_WAIT_UNTIL(co, now, open);
+        passed++;
+        CO_YIELD(co, now);
+        passed++;
+        CO_END(co);
+    }
+};
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_script_runs_step_by_step() {
+    Pulse pulse;
+    pulse.run(1000);
+    TEST_ASSERT_EQUAL(0, pulse.level);
+    pulse.run(1050);
+    TEST_ASSERT_EQUAL(500, pulse.level);
+    TEST_ASSERT_EQUAL(0, pulse.steps);
+
+    pulse.run(1100); // fade done, now holding
+    TEST_ASSERT_EQUAL(1000, pulse.level);
+    TEST_ASSERT_EQUAL(1, pulse.steps);
+    pulse.run(1149);
+    TEST_ASSERT_EQUAL(1, pulse.steps);
+
+    pulse.run(1175); // 25 into the fade out
+    TEST_ASSERT_EQUAL(2, pulse.steps);
+    TEST_ASSERT_EQUAL(750, pulse.level);
+    TEST_ASSERT_FALSE(pulse.co.isFinished());
+
+    pulse.run(1250);
+    TEST_ASSERT_EQUAL(0, pulse.level);
+    TEST_ASSERT_EQUAL(3, pulse.steps);
+    TEST_ASSERT_TRUE(pulse.co.isFinished());
+
+    // finished scripts do nothing until restarted
+    pulse.run(2000);
+    TEST_ASSERT_EQUAL(3, pulse.steps);
+    pulse.co.restart();
+    pulse.run(3000);
+    TEST_ASSERT_EQUAL(0, pulse.level);
+    TEST_ASSERT_FALSE(pulse.co.isFinished());
+}
+
+void test_late_frames_skip_whole_steps() {
+    Pulse pulse;
+    pulse.run(0);
+    pulse.run(500); // every step was due by now
+    TEST_ASSERT_EQUAL(0, pulse.level);
+    TEST_ASSERT_EQUAL(3, pulse.steps);
+    TEST_ASSERT_TRUE(pulse.co.isFinished());
+}
+
+void test_steps_keep_their_deadlines() {
+    Blink blink;
+    // frames every 7, which never land on a step boundary
+    for (uint32_t now = 3; now < 100000; now += 7) {
+        blink.run(now);
+    }
+    // every step started exactly when the previous was due
+    for (size_t i = 1; i < blink.switches.size(); i++) {
+        TEST_ASSERT_EQUAL(i % 2 ? 30 : 20, blink.switches[i] - blink.switches[i - 1]);
+    }
+    TEST_ASSERT_TRUE(blink.switches.size() > 3000);
+}
+
+void test_wait_until_and_yield() {
+    Gate gate;
+    gate.run(0);
+    gate.run(1);
+    TEST_ASSERT_EQUAL(0, gate.passed);
+    gate.open = true;
+    gate.run(2);
+    TEST_ASSERT_EQUAL(1, gate.passed);
+    TEST_ASSERT_FALSE(gate.co.isFinished());
+    gate.run(3);
+    TEST_ASSERT_EQUAL(2, gate.passed);
+    TEST_ASSERT_TRUE(gate.co.isFinished());
+}
+
+void test_lerp_is_exact_at_the_ends() {
+    TEST_ASSERT_EQUAL(0, Coroutine::lerp(0, 256, 0, 1000));
+    TEST_ASSERT_EQUAL(256, Coroutine::lerp(0, 256, 1000, 1000));
+    TEST_ASSERT_EQUAL(256, Coroutine::lerp(256, 0, 0, 1000));
+    TEST_ASSERT_EQUAL(0, Coroutine::lerp(256, 0, 5000, 1000));
+    TEST_ASSERT_EQUAL(-50, Coroutine::lerp(-100, 100, 250, 1000));
+    TEST_ASSERT_EQUAL(7, Coroutine::lerp(3, 7, 0, 0));
+}
+
+void test_stroboscope_rhythm() {
+    Show::Stroboscope strobe(255, 0, 0, 2, 3);
+    MockStrip strip(2);
+    const bool expected[] = {true, true, false, false, false, true, true, false, false, false, true};
+    for (Show::Iteration i = 0; i < sizeof(expected); i++) {
+        strobe.execute(strip, i);
+        TEST_ASSERT_EQUAL_MESSAGE(expected[i], strip.getPixelColor(0) != 0, "frame");
+    }
+
+    // no off cycles: always on
+    Show::Stroboscope steady(255, 0, 0, 1, 0);
+    for (Show::Iteration i = 0; i < 5; i++) {
+        steady.execute(strip, i);
+        TEST_ASSERT_EQUAL_HEX32(0xFF0000, strip.getPixelColor(1));
+    }
+
+    // nothing to wait for at all: dark instead of a busy loop
+    Show::Stroboscope never(255, 0, 0, 0, 0);
+    never.execute(strip, 0);
+    TEST_ASSERT_EQUAL_HEX32(0, strip.getPixelColor(0));
+}
+
+void test_star_fades_in_holds_and_fades_out() {
+    // a star on the only LED every frame it is free; 10 ms per frame natively
+    Show::Starlight starlight(1.0f, 200, 100, 200, 100, 0);
+    MockStrip strip(1);
+    std::vector<uint8_t> red;
+    for (Show::Iteration i = 0; i < 45; i++) {
+        starlight.execute(strip, i);
+        red.push_back(strip.getPixelColor(0) >> 16);
+    }
+    TEST_ASSERT_EQUAL(0, red[0]);
+    TEST_ASSERT_EQUAL(100, red[5]); // half way in
+    TEST_ASSERT_EQUAL(200, red[10]);
+    TEST_ASSERT_EQUAL(200, red[29]);
+    TEST_ASSERT_EQUAL(100, red[35]); // half way out
+    TEST_ASSERT_EQUAL(0, red[40]); // and straight into the next star
+    TEST_ASSERT_EQUAL(39, red[42]); // 20 ms into its fade in
+}
+
+void test_benchmark_resume() {
+    std::vector<Blink> blinks(1000);
+    for (Blink &blink: blinks) {
+        blink.switches.reserve(1);
+    }
+    uint32_t now = 0;
+    benchmark("Coroutine resume", 2000, blinks.size(), [&] {
+        now += 10;
+        for (Blink &blink: blinks) {
+            blink.run(now);
+            blink.switches.clear();
+        }
+        benchmark_sink = blinks[0].on;
+    });
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_script_runs_step_by_step);
+    RUN_TEST(test_late_frames_skip_whole_steps);
+    RUN_TEST(test_steps_keep_their_deadlines);
+    RUN_TEST(test_wait_until_and_yield);
+    RUN_TEST(test_lerp_is_exact_at_the_ends);
+    RUN_TEST(test_stroboscope_rhythm);
+    RUN_TEST(test_star_fades_in_holds_and_fades_out);
+    RUN_TEST(test_benchmark_resume);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
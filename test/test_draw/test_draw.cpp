@@ -0,0 +1,189 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "show/ColorRun.h"
+#include "show/Jump.h"
+#include "strip/Buffer.h"
+#include "support/Blend.h"
+#include "support/Draw.h"
+
+namespace Draw = Support::Draw;
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+static uint32_t channelSum(const Strip::Strip &strip, int shift) {
+    uint32_t sum = 0;
+    for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+        sum += strip.getPixelColor(i) >> shift & 0xFF;
+    }
+    return sum;
+}
+
+void test_dot_on_pixel_center_lights_one_pixel() {
+    MockStrip strip(5);
+    Draw::dot(strip, 2 * Draw::ONE_PIXEL, 0xFF8040);
+    TEST_ASSERT_EQUAL_HEX32(0x000000, strip.getPixelColor(1));
+    TEST_ASSERT_EQUAL_HEX32(0xFF8040, strip.getPixelColor(2));
+    TEST_ASSERT_EQUAL_HEX32(0x000000, strip.getPixelColor(3));
+}
+
+void test_dot_between_pixels_splits() {
+    MockStrip strip(5);
+    Draw::dot(strip, 2 * Draw::ONE_PIXEL + 128, 0xFF0000, Draw::ONE_PIXEL, Draw::Op::ADD);
+    TEST_ASSERT_EQUAL_HEX32(0x7F0000, strip.getPixelColor(2));
+    TEST_ASSERT_EQUAL_HEX32(0x7F0000, strip.getPixelColor(3));
+
+    MockStrip quarter(5);
+    Draw::dot(quarter, 2 * Draw::ONE_PIXEL + 64, 0x0000FF, Draw::ONE_PIXEL, Draw::Op::ADD);
+    TEST_ASSERT_EQUAL_HEX32(0x0000BF, quarter.getPixelColor(2));
+    TEST_ASSERT_EQUAL_HEX32(0x00003F, quarter.getPixelColor(3));
+}
+
+void test_dot_conserves_energy() {
+    // the brightness summed over the strip is independent of the sub-pixel offset
+    for (Draw::Position width: {Draw::ONE_PIXEL, 3 * Draw::ONE_PIXEL / 2, 3 * Draw::ONE_PIXEL}) {
+        for (Draw::Position offset = 0; offset < Draw::ONE_PIXEL; offset += 7) {
+            MockStrip strip(20);
+            Draw::dot(strip, 10 * Draw::ONE_PIXEL + offset, 0xC8C8C8, width, Draw::Op::ADD);
+            uint32_t expected = 200 * width / Draw::ONE_PIXEL;
+            uint32_t pixels_touched = width / Draw::ONE_PIXEL + 2;
+            uint32_t sum = channelSum(strip, 8);
+            TEST_ASSERT_UINT32_WITHIN(pixels_touched, expected, sum);
+        }
+    }
+}
+
+void test_dot_moves_smoothly() {
+    // moving by 1/256 pixel never changes the total by more than rounding
+    uint32_t previous_center = 0;
+    for (Draw::Position position = 5 * Draw::ONE_PIXEL; position <= 6 * Draw::ONE_PIXEL; position += 16) {
+        MockStrip strip(10);
+        Draw::dot(strip, position, 0x00FF00, Draw::ONE_PIXEL, Draw::Op::ADD);
+        uint32_t right = strip.getPixelColor(6) >> 8 & 0xFF;
+        TEST_ASSERT_TRUE(right >= previous_center);
+        previous_center = right;
+    }
+    TEST_ASSERT_EQUAL(255, previous_center);
+}
+
+void test_span_fractional_ends() {
+    MockStrip strip(6);
+    // from 1.25 to 3.75 in pixel centers: pixel 1 covered 3/4 ... pixel 4 covered 1/4
+    Draw::span(strip, Draw::ONE_PIXEL + 64 - 128, 4 * Draw::ONE_PIXEL - 64 + 128 - 256, 0xFFFFFF, Draw::Op::ADD);
+    TEST_ASSERT_EQUAL_HEX32(0x000000, strip.getPixelColor(0));
+    TEST_ASSERT_EQUAL_HEX32(0xBFBFBF, strip.getPixelColor(1));
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, strip.getPixelColor(2));
+    TEST_ASSERT_EQUAL_HEX32(0xBFBFBF, strip.getPixelColor(3));
+    TEST_ASSERT_EQUAL_HEX32(0x000000, strip.getPixelColor(4));
+}
+
+void test_span_clips_to_strip() {
+    MockStrip strip(4);
+    Draw::span(strip, -10 * Draw::ONE_PIXEL, 10 * Draw::ONE_PIXEL, 0x123456);
+    for (Strip::PixelIndex i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_HEX32(0x123456, strip.getPixelColor(i));
+    }
+    Draw::dot(strip, -5 * Draw::ONE_PIXEL, 0xFFFFFF);
+    Draw::dot(strip, 50 * Draw::ONE_PIXEL, 0xFFFFFF);
+    TEST_ASSERT_EQUAL_HEX32(0x123456, strip.getPixelColor(0));
+    TEST_ASSERT_EQUAL_HEX32(0x123456, strip.getPixelColor(3));
+}
+
+void test_over_blends_with_background() {
+    MockStrip strip(3);
+    strip.fill(0x0000FF);
+    Draw::dot(strip, Draw::ONE_PIXEL + 128, 0xFF0000);
+    TEST_ASSERT_EQUAL_HEX32(Support::Blend::mix(0x0000FF, 0xFF0000, 128), strip.getPixelColor(1));
+    TEST_ASSERT_EQUAL_HEX32(Support::Blend::mix(0x0000FF, 0xFF0000, 128), strip.getPixelColor(2));
+}
+
+void test_add_saturates() {
+    MockStrip strip(3);
+    strip.fill(0xF0F0F0);
+    Draw::dot(strip, Draw::ONE_PIXEL, 0x202020, Draw::ONE_PIXEL, Draw::Op::ADD);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, strip.getPixelColor(1));
+    TEST_ASSERT_EQUAL_HEX32(0xF0F0F0, strip.getPixelColor(0));
+}
+
+void test_gradient_runs_between_colors() {
+    MockStrip strip(5);
+    Draw::gradient(strip, -128, 5 * Draw::ONE_PIXEL - 128, 0x000000, 0xFF0000);
+    for (Strip::PixelIndex i = 1; i < 5; i++) {
+        TEST_ASSERT_TRUE(strip.getPixelColor(i) > strip.getPixelColor(i - 1));
+    }
+    TEST_ASSERT_UINT32_WITHIN(0x020000, 0x190000, strip.getPixelColor(0));
+    TEST_ASSERT_UINT32_WITHIN(0x020000, 0xE50000, strip.getPixelColor(4));
+}
+
+void test_ported_shows_light_the_strip() {
+    MockStrip strip(60);
+    Show::Jump jump;
+    for (Show::Iteration iteration = 0; iteration < 20; iteration++) {
+        jump.execute(strip, iteration);
+    }
+    TEST_ASSERT_TRUE(channelSum(strip, 16) + channelSum(strip, 8) + channelSum(strip, 0) > 0);
+
+    Show::ColorRun run;
+
+    MockStrip run_strip(60);
+    for (Show::Iteration iteration = 0; iteration < 8; iteration++) {
+        run.execute(run_strip, iteration);
+    }
+    // the first dot runs at half speed and is 3.5 pixels out after 7 frames
+    TEST_ASSERT_TRUE((run_strip.getPixelColor(3) >> 16) > 0);
+    TEST_ASSERT_TRUE((run_strip.getPixelColor(4) >> 16) > 0);
+}
+
+void test_benchmark_draw() {
+    for (Strip::PixelIndex length: {300, 1000}) {
+        Strip::Buffer strip(length);
+        char label[48];
+        Draw::Position position = 0;
+
+        snprintf(label, sizeof(label), "dot %d px", length);
+        benchmark(label, 20000, 1, [&] {
+            position = (position + 37) % (length * Draw::ONE_PIXEL);
+            Draw::dot(strip, position, 0xFF8000, Draw::ONE_PIXEL, Draw::Op::ADD);
+            benchmark_sink = strip.getPixelColor(length / 2);
+        });
+
+        snprintf(label, sizeof(label), "span %d px", length);
+        benchmark(label, 2000, length, [&] {
+            Draw::span(strip, 100, length * Draw::ONE_PIXEL - 100, 0x204080);
+            benchmark_sink = strip.getPixelColor(length / 2);
+        });
+
+        snprintf(label, sizeof(label), "gradient %d px", length);
+        benchmark(label, 2000, length, [&] {
+            Draw::gradient(strip, 100, length * Draw::ONE_PIXEL - 100, 0xFF0000, 0x0000FF);
+            benchmark_sink = strip.getPixelColor(length / 2);
+        });
+    }
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_dot_on_pixel_center_lights_one_pixel);
+    RUN_TEST(test_dot_between_pixels_splits);
+    RUN_TEST(test_dot_conserves_energy);
+    RUN_TEST(test_dot_moves_smoothly);
+    RUN_TEST(test_span_fractional_ends);
+    RUN_TEST(test_span_clips_to_strip);
+    RUN_TEST(test_over_blends_with_background);
+    RUN_TEST(test_add_saturates);
+    RUN_TEST(test_gradient_runs_between_colors);
+    RUN_TEST(test_ported_shows_light_the_strip);
+
+    RUN_TEST(test_benchmark_draw);
+
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
@@ -0,0 +1,255 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "color.h"
+#include "show/Fire.h"
+#include "support/color.h"
+#include "support/Random.h"
+
+#include <algorithm>
+#include <vector>
+
+using Show::Fire;
+using Show::FireState;
+
+// The float engine Fire had before: kernel weights summed and divided per
+// pixel, colors computed with black_body_color. Kept to compare against.
+class ReferenceFire {
+public:
+    ReferenceFire(Strip::PixelIndex length, std::vector<float> weights)
+        : temperature(length, 0.0f), prev_temperature(length, 0.0f), weights(std::move(weights)) {
+    }
+
+    void spread(const uint32_t *noise, float spread_rate) {
+        prev_temperature = temperature;
+        for (Strip::PixelIndex i = 0; i < static_cast<Strip::PixelIndex>(temperature.size()); i++) {
+            float weighted_previous = 0.0f;
+            float available_energy = 0.0f;
+            float local_total_weight = 0.0f;
+            for (size_t w = 0; w < weights.size(); ++w) {
+                if (i - 1 - static_cast<int>(w) >= 0) {
+                    local_total_weight += weights[w];
+                }
+            }
+            if (local_total_weight > 0) {
+                for (size_t w = 0; w < weights.size(); ++w) {
+                    int prev = i - 1 - static_cast<int>(w);
+                    if (prev >= 0) {
+                        weighted_previous += prev_temperature[prev] * weights[w] / local_total_weight;
+                        available_energy += prev_temperature[prev];
+                    }
+                }
+            }
+            float random = static_cast<float>(noise[i] >> 16) / 65536.0f;
+            float amount = std::min(available_energy, std::min(0.25f, weighted_previous) * spread_rate * random);
+            if (amount > 0) {
+                temperature[i] += amount;
+                for (size_t w = 0; w < weights.size(); ++w) {
+                    int prev = i - 1 - static_cast<int>(w);
+                    if (prev >= 0) {
+                        temperature[prev] -= amount * weights[w] / local_total_weight;
+                    }
+                }
+            }
+        }
+    }
+
+    void draw(Strip::Strip &strip, Strip::PixelIndex offset) const {
+        for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+            strip.setPixelColor(i, Support::Color::black_body_color(temperature[i + offset]));
+        }
+    }
+
+    std::vector<float> temperature;
+
+private:
+    std::vector<float> prev_temperature;
+    std::vector<float> weights;
+};
+
+// Random heat in 0 - 2 on every pixel of both engines
+static void heatUp(FireState &state, ReferenceFire *reference, Support::Random &gen) {
+    for (Strip::PixelIndex i = 0; i < state.length(); i++) {
+        state.set_temperature(i, 2.0f * gen.nextFloat());
+        if (reference != nullptr) {
+            reference->temperature[i] = state.get_temperature(i);
+        }
+    }
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_spread_conserves_heat_exactly() {
+    const std::vector<std::vector<float>> kernels = {{1.0f}, {2.0f, 1.0f}, {0.5f, 0.3f, 0.2f}, {3.0f, 0.0f, 1.0f}};
+    Support::Random gen(1);
+    std::vector<uint32_t> noise(120);
+    for (const std::vector<float> &weights: kernels) {
+        FireState state(120, weights);
+        heatUp(state, nullptr, gen);
+        int64_t total = state.total();
+        for (int frame = 0; frame < 500; frame++) {
+            gen.fill(noise.data(), noise.size());
+            state.spread(noise.data(), 10.0f);
+            TEST_ASSERT_EQUAL_INT64(total, state.total());
+        }
+    }
+}
+
+void test_spread_matches_the_float_engine() {
+    const std::vector<std::vector<float>> kernels = {{1.0f}, {2.0f, 1.0f}, {0.5f, 0.3f, 0.2f}};
+    Support::Random gen(2);
+    std::vector<uint32_t> noise(60);
+    for (const std::vector<float> &weights: kernels) {
+        FireState state(60, weights);
+        ReferenceFire reference(60, weights);
+        heatUp(state, &reference, gen);
+        gen.fill(noise.data(), noise.size());
+        state.spread(noise.data(), 2.0f);
+        reference.spread(noise.data(), 2.0f);
+        for (Strip::PixelIndex i = 0; i < 60; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-3f, reference.temperature[i], state.get_temperature(i));
+        }
+    }
+}
+
+void test_bottom_pixels_use_the_weights_they_have() {
+    // pixel 1 has a single pixel below: it takes the whole kernel share
+    // although the first weight is only half of all weights
+    FireState state(2, {1.0f, 1.0f});
+    std::vector<uint32_t> full(4, UINT32_MAX);
+    state.set_temperature(0, 0.2f);
+    state.spread(full.data(), 1.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, state.get_temperature(0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.2f, state.get_temperature(1));
+
+    // all zero weights: nothing moves
+    FireState still(4, {0.0f, 0.0f});
+    still.set_temperature(0, 1.0f);
+    still.spread(full.data(), 1.0f);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, still.get_temperature(0));
+}
+
+void test_sparks_rise_from_every_source() {
+    FireState state(30);
+    std::vector<uint32_t> noise(9, 0);
+    noise[4] = UINT32_MAX; // the second pixel of the second source stays dark
+    state.ignite(noise.data(), 0.5f, 3, 0.5f, {0, 10, 28});
+    for (Strip::PixelIndex i = 0; i < 30; i++) {
+        bool lit = i < 3 || i == 10 || i == 12 || i >= 28;
+        TEST_ASSERT_EQUAL_FLOAT_MESSAGE(lit ? 0.5f : 0.0f, state.get_temperature(i), "pixel");
+    }
+
+    // no chance, no sparks
+    FireState cold(30);
+    cold.ignite(noise.data(), 0.0f, 3, 0.5f, {0});
+    TEST_ASSERT_EQUAL_INT64(0, cold.total());
+}
+
+void test_large_sparks_saturate() {
+    FireState state(10);
+    std::vector<uint32_t> noise(10, 0);
+    for (int frame = 0; frame < 1000; frame++) {
+        state.ignite(noise.data(), 1.0f, 10, 1.0e6f, {0});
+        state.spread(noise.data(), 100.0f);
+    }
+    for (Strip::PixelIndex i = 0; i < 10; i++) {
+        TEST_ASSERT_TRUE(state.heat(i) > 0 && state.heat(i) <= FireState::MAX_HEAT);
+    }
+
+    // no cooling, a spark on every pixel every frame
+    Fire fire(0.0f, 100.0f, 1.0e9f, 1.0e9f, {1.0f}, 0, 20, Fire::Fuel::WOOD, {0}, 3);
+    MockStrip strip(20);
+    for (Show::Iteration i = 0; i < 1000; i++) {
+        fire.execute(strip, i);
+    }
+    TEST_ASSERT_EQUAL_HEX32(Support::Color::black_body_color(1.0f), strip.getPixelColor(10));
+}
+
+void test_palettes() {
+    Fire wood;
+    TEST_ASSERT_EQUAL_HEX32(0x000000, wood.colorOf(0));
+    TEST_ASSERT_EQUAL_HEX32(0x000000, wood.colorOf(-FireState::ONE));
+    TEST_ASSERT_EQUAL_HEX32(Support::Color::black_body_color(1.0f), wood.colorOf(FireState::ONE));
+    TEST_ASSERT_EQUAL_HEX32(Support::Color::black_body_color(1.0f), wood.colorOf(5 * FireState::ONE));
+    TEST_ASSERT_EQUAL_HEX32(Support::Color::black_body_color(0.2f), wood.colorOf(FireState::ONE / 5));
+
+    TEST_ASSERT_TRUE(Fire::fuelFromName("gas") == Fire::Fuel::GAS);
+    TEST_ASSERT_TRUE(Fire::fuelFromName("chemical") == Fire::Fuel::CHEMICAL);
+    TEST_ASSERT_TRUE(Fire::fuelFromName("coal") == Fire::Fuel::WOOD);
+    TEST_ASSERT_TRUE(Fire::fuelFromName(nullptr) == Fire::Fuel::WOOD);
+
+    Fire gas(0.1f, 10.0f, 0.5f, 0.5f, {1.0f}, 5, 5, Fire::Fuel::GAS);
+    Fire chemical(0.1f, 10.0f, 0.5f, 0.5f, {1.0f}, 5, 5, Fire::Fuel::CHEMICAL);
+    Strip::Color flame = gas.colorOf(FireState::ONE / 2);
+    TEST_ASSERT_TRUE(blue(flame) > red(flame) && blue(flame) > green(flame));
+    flame = chemical.colorOf(FireState::ONE / 2);
+    TEST_ASSERT_TRUE(green(flame) > red(flame) && green(flame) > blue(flame));
+    TEST_ASSERT_EQUAL_HEX32(0x000000, gas.colorOf(0));
+}
+
+void test_fire_burns_above_every_source() {
+    Fire fire(0.05f, 10.0f, 0.5f, 0.5f, {1.0f}, 0, 5, Fire::Fuel::WOOD, {0, 50}, 3);
+    MockStrip strip(60);
+    for (Show::Iteration i = 0; i < 100; i++) {
+        fire.execute(strip, i);
+    }
+    TEST_ASSERT_TRUE(strip.getPixelColor(2) != 0);
+    TEST_ASSERT_TRUE(strip.getPixelColor(52) != 0);
+}
+
+static void benchmarkFrames(Strip::PixelIndex length) {
+    const Strip::PixelIndex offset = 5;
+    char label[64];
+    MockStrip strip(length);
+
+    ReferenceFire reference(length + offset, {2.0f, 1.0f});
+    Support::Random gen(1);
+    std::vector<uint32_t> noise(length + offset);
+    snprintf(label, sizeof(label), "float Fire, %d LEDs", length);
+    benchmark(label, 500, length, [&] {
+        gen.fill(noise.data(), noise.size());
+        for (float &heat: reference.temperature) {
+            heat = std::max(0.0f, heat - 0.05f);
+        }
+        reference.spread(noise.data(), 10.0f);
+        for (Strip::PixelIndex i = 0; i < 5; i++) {
+            reference.temperature[i] += 0.5f * (noise[i] & 1);
+        }
+        reference.draw(strip, offset);
+        benchmark_sink = strip.getPixelColor(0);
+    });
+
+    Fire fire(0.1f, 10.0f, 0.5f, 0.5f, {2.0f, 1.0f}, offset, 5, Fire::Fuel::WOOD, {0}, 1);
+    Show::Iteration iteration = 0;
+    snprintf(label, sizeof(label), "fixed-point Fire, %d LEDs", length);
+    benchmark(label, 500, length, [&] {
+        fire.execute(strip, iteration++);
+        benchmark_sink = strip.getPixelColor(0);
+    });
+}
+
+void test_benchmark_fire() {
+    benchmarkFrames(300);
+    benchmarkFrames(1000);
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_spread_conserves_heat_exactly);
+    RUN_TEST(test_spread_matches_the_float_engine);
+    RUN_TEST(test_bottom_pixels_use_the_weights_they_have);
+    RUN_TEST(test_sparks_rise_from_every_source);
+    RUN_TEST(test_large_sparks_saturate);
+    RUN_TEST(test_palettes);
+    RUN_TEST(test_fire_burns_above_every_source);
+    RUN_TEST(test_benchmark_fire);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
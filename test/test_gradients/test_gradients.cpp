@@ -0,0 +1,138 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "support/Gradients.h"
+#include "color.h"
+
+#include <string>
+#include <vector>
+
+using namespace Support;
+
+void setUp() {}
+
+void tearDown() {
+    Gradients::clear();
+}
+
+void test_built_in_gradients_are_found_by_name() {
+    std::vector<Gradients::Gradient> builtIn = Gradients::builtIn();
+    TEST_ASSERT_TRUE(builtIn.size() >= 5);
+    for (const Gradients::Gradient &gradient: builtIn) {
+        TEST_ASSERT_TRUE(Gradients::isBuiltIn(gradient.name));
+        TEST_ASSERT_TRUE(Gradients::isValidName(gradient.name));
+        TEST_ASSERT_TRUE(gradient.colors.size() >= 2 && gradient.colors.size() <= Gradients::MAX_COLORS);
+        TEST_ASSERT_TRUE(Gradients::find(gradient.name) == gradient.colors);
+    }
+    TEST_ASSERT_TRUE(Gradients::find("no-such-palette").empty());
+}
+
+void test_bake_spreads_the_colors_evenly() {
+    Palette::Table table = Gradients::bake({0x000000, 0xFF0000, 0xFFFFFF});
+    TEST_ASSERT_EQUAL_HEX32(0x000000, table[0]);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, table[255]);
+    // the middle color halfway: red rises up to it, then the others follow
+    for (size_t i = 1; i < 128; i++) {
+        TEST_ASSERT_TRUE(red(table[i]) >= red(table[i - 1]));
+        TEST_ASSERT_EQUAL_HEX32(0, table[i] & 0x00FFFF);
+    }
+    for (size_t i = 128; i < 256; i++) {
+        TEST_ASSERT_EQUAL_HEX32(0xFF, red(table[i]));
+        TEST_ASSERT_TRUE(green(table[i]) >= green(table[i - 1]));
+    }
+
+    table = Gradients::bake({0x123456});
+    for (Strip::Color entry: table) {
+        TEST_ASSERT_EQUAL_HEX32(0x123456, entry);
+    }
+}
+
+void test_bake_cyclic_blends_back_into_the_first_color() {
+    Palette::Table table = Gradients::bakeCyclic({0xFF0000, 0x0000FF});
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, table[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, table[128]);
+    // nearly back at red, one step before the turn is complete
+    TEST_ASSERT_TRUE(red(table[255]) > 0xF0 && blue(table[255]) < 0x10);
+
+    // on the 255 step wheel, entry 255 is where the turn starts again
+    table = Gradients::bakeCyclic({0xFF0000, 0x0000FF}, 255.0f);
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, table[0]);
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, table[255]);
+
+    table = Gradients::bakeCyclic({});
+    TEST_ASSERT_EQUAL_HEX32(0x000000, table[100]);
+}
+
+void test_custom_gradients_are_stored_replaced_and_removed() {
+    TEST_ASSERT_TRUE(Gradients::store("dusk", {0x100020, 0xC03050}));
+    TEST_ASSERT_TRUE(Gradients::store("mint", {0x00FF80}));
+    TEST_ASSERT_FALSE(Gradients::isBuiltIn("dusk"));
+    TEST_ASSERT_EQUAL_HEX32(0xC03050, Gradients::find("dusk").back());
+
+    TEST_ASSERT_TRUE(Gradients::store("dusk", {0x000000, 0x202020, 0x404040}));
+    std::vector<Gradients::Gradient> custom = Gradients::custom();
+    TEST_ASSERT_EQUAL(2, custom.size());
+    TEST_ASSERT_EQUAL_STRING("dusk", custom[0].name.c_str());
+    TEST_ASSERT_EQUAL(3, custom[0].colors.size());
+    TEST_ASSERT_EQUAL_STRING("mint", custom[1].name.c_str());
+
+    TEST_ASSERT_TRUE(Gradients::remove("dusk"));
+    TEST_ASSERT_FALSE(Gradients::remove("dusk"));
+    TEST_ASSERT_TRUE(Gradients::find("dusk").empty());
+    TEST_ASSERT_EQUAL(1, Gradients::custom().size());
+}
+
+void test_invalid_gradients_are_refused() {
+    TEST_ASSERT_FALSE(Gradients::store("", {0xFFFFFF}));
+    TEST_ASSERT_FALSE(Gradients::store("two words", {0xFFFFFF}));
+    TEST_ASSERT_FALSE(Gradients::store("a-name-that-is-too-long", {0xFFFFFF}));
+    TEST_ASSERT_FALSE(Gradients::store("lava", {0xFFFFFF}));
+    TEST_ASSERT_FALSE(Gradients::store("empty", {}));
+    TEST_ASSERT_FALSE(Gradients::store("crowded", std::vector<Strip::Color>(Gradients::MAX_COLORS + 1, 0xFFFFFF)));
+    TEST_ASSERT_EQUAL_HEX32(0x000000, Gradients::find("lava").front());
+
+    for (size_t i = 0; i < Gradients::MAX_CUSTOM; i++) {
+        TEST_ASSERT_TRUE(Gradients::store("custom" + std::to_string(i), {0xFFFFFF}));
+    }
+    TEST_ASSERT_FALSE(Gradients::store("one-more", {0xFFFFFF}));
+    // replacing one is still possible when all are taken
+    TEST_ASSERT_TRUE(Gradients::store("custom0", {0x000000}));
+}
+
+void test_benchmark_palette_lookup() {
+    const int pixels = 300;
+    Palette palette;
+    std::vector<Strip::Color> colors = Gradients::find("sunset");
+    for (size_t i = 0; i < colors.size(); i++) {
+        palette.addPoint(static_cast<float>(i) / (colors.size() - 1), colors[i]);
+    }
+    Palette::Table table = Gradients::bake(colors);
+
+    benchmark("get_color per pixel, 300 LEDs", 2000, pixels, [&] {
+        for (int i = 0; i < pixels; i++) {
+            benchmark_sink = palette.get_color(static_cast<float>(i & 0xFF) / 255.0f);
+        }
+    });
+    benchmark("baked table per pixel, 300 LEDs", 2000, pixels, [&] {
+        for (int i = 0; i < pixels; i++) {
+            benchmark_sink = table[i & 0xFF];
+        }
+    });
+    benchmark("bake, 5 colors", 200, 1, [&] {
+        benchmark_sink = Gradients::bake(colors)[100];
+    });
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_built_in_gradients_are_found_by_name);
+    RUN_TEST(test_bake_spreads_the_colors_evenly);
+    RUN_TEST(test_bake_cyclic_blends_back_into_the_first_color);
+    RUN_TEST(test_custom_gradients_are_stored_replaced_and_removed);
+    RUN_TEST(test_invalid_gradients_are_refused);
+    RUN_TEST(test_benchmark_palette_lookup);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
@@ -0,0 +1,181 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "color.h"
+#include "support/Interpolation.h"
+#include "support/Palette.h"
+#include "support/SmoothBlend.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Support::Interpolation;
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_lerp_rounds_down() {
+    TEST_ASSERT_EQUAL(0, lerp16(0, 255, 0));
+    TEST_ASSERT_EQUAL(255, lerp16(0, 255, ONE));
+    TEST_ASSERT_EQUAL(127, lerp16(0, 255, ONE / 2));
+    TEST_ASSERT_EQUAL(127, lerp16(255, 0, ONE / 2));
+    TEST_ASSERT_EQUAL(-50, lerp16(-100, 0, ONE / 2));
+    TEST_ASSERT_EQUAL(1000000, lerp16(0, 2000000, ONE / 2));
+
+    TEST_ASSERT_EQUAL_HEX32(0x123456, lerpColor(0x123456, 0xFEDCBA, 0));
+    TEST_ASSERT_EQUAL_HEX32(0xFEDCBA, lerpColor(0x123456, 0xFEDCBA, ONE));
+    TEST_ASSERT_EQUAL_HEX32(0x7F007F, lerpColor(0xFF0000, 0x0000FF, ONE / 2));
+
+    TEST_ASSERT_EQUAL_UINT32(0, toQ16(-1.0f));
+    TEST_ASSERT_EQUAL_UINT32(0, toQ16(NAN));
+    TEST_ASSERT_EQUAL_UINT32(ONE / 4, toQ16(0.25f));
+    TEST_ASSERT_EQUAL_UINT32(ONE, toQ16(3.0f));
+}
+
+void test_easing_curves() {
+    auto quad = [](double t) { return t < 0.5 ? 2 * t * t : 1 - 2 * (1 - t) * (1 - t); };
+    auto cubic = [](double t) { return t < 0.5 ? 4 * t * t * t : 1 - 4 * (1 - t) * (1 - t) * (1 - t); };
+    auto sine = [](double t) { return (1 - std::cos(M_PI * t)) / 2; };
+    struct {
+        Easing easing;
+        double (*curve)(double);
+    } curves[] = {{Easing::LINEAR, [](double t) { return t; }}, {Easing::EASE_IN, [](double t) { return t * t; }},
+                  {Easing::EASE_OUT, [](double t) { return 1 - (1 - t) * (1 - t); }}, {Easing::QUAD, quad},
+                  {Easing::CUBIC, cubic}, {Easing::SINE, sine}};
+
+    for (const auto &c: curves) {
+        TEST_ASSERT_EQUAL_UINT32(0, ease(c.easing, 0));
+        TEST_ASSERT_EQUAL_UINT32(ONE, ease(c.easing, ONE));
+        TEST_ASSERT_EQUAL_UINT32(ONE, ease(c.easing, 2 * ONE));
+        uint32_t previous = 0;
+        for (uint32_t t = 0; t <= ONE; t += 97) {
+            uint32_t value = ease(c.easing, t);
+            auto expected = static_cast<int32_t>(c.curve(t / 65536.0) * ONE);
+            // sampled every 1/256, with straight lines in between
+            TEST_ASSERT_INT_WITHIN(4, expected, static_cast<int32_t>(value));
+            TEST_ASSERT_TRUE(value >= previous);
+            previous = value;
+        }
+        TEST_ASSERT_TRUE(easingFromName(easingName(c.easing)) == c.easing);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, ease(Easing::STEP, ONE - 1));
+    TEST_ASSERT_EQUAL_UINT32(ONE, ease(Easing::STEP, ONE));
+    TEST_ASSERT_TRUE(easingFromName("step") == Easing::STEP);
+    TEST_ASSERT_TRUE(easingFromName("ease-in-out") == Easing::SINE);
+    TEST_ASSERT_TRUE(easingFromName("bounce") == Easing::LINEAR);
+    TEST_ASSERT_TRUE(easingFromName(nullptr) == Easing::LINEAR);
+}
+
+void test_power_curve() {
+    for (float power: {1.0f, 2.0f, 3.5f}) {
+        PowerCurve curve(power);
+        TEST_ASSERT_EQUAL_UINT32(0, curve(0));
+        TEST_ASSERT_EQUAL_UINT32(ONE, curve(ONE));
+        for (uint32_t t = 0; t <= ONE; t += 101) {
+            auto expected = static_cast<int32_t>(std::pow(t / 65536.0, power) * ONE);
+            TEST_ASSERT_INT_WITHIN(8, expected, static_cast<int32_t>(curve(t)));
+        }
+    }
+    // 0 to a negative power would be infinite
+    PowerCurve inverse(-1.0f);
+    TEST_ASSERT_EQUAL_UINT32(ONE, inverse(0));
+}
+
+// get_color as it was before the binary search and the sampled power curve
+static Strip::Color scanColor(const std::vector<Support::ColorPoint> &points, float position) {
+    if (position <= points.front().position) {
+        return points.front().color;
+    }
+    if (position >= points.back().position) {
+        return points.back().color;
+    }
+    for (size_t i = 0; i < points.size() - 1; ++i) {
+        if (position >= points[i].position && position < points[i + 1].position) {
+            const auto &p1 = points[i];
+            const auto &p2 = points[i + 1];
+            float progress = (position - p1.position) / (p2.position - p1.position);
+            if (p1.interpolation == Support::InterpolationType::Power) {
+                progress = std::pow(progress, p1.power);
+            }
+            auto channel = [progress](Strip::ColorComponent a, Strip::ColorComponent b) {
+                return static_cast<Strip::ColorComponent>(a * (1.0f - progress) + b * progress);
+            };
+            return color(channel(red(p1.color), red(p2.color)), channel(green(p1.color), green(p2.color)),
+                         channel(blue(p1.color), blue(p2.color)));
+        }
+    }
+    return points.back().color;
+}
+
+// SmoothBlend::step as it was before the precomputed deltas: two std::pow
+// per channel
+static void powBlend(MockStrip &strip, const std::vector<Strip::Color> &from, const std::vector<Strip::Color> &to,
+                     float fade_progress) {
+    auto channel = [fade_progress](Strip::ColorComponent start, Strip::ColorComponent end) {
+        float start_value = start * std::pow(fade_progress, 1.0f);
+        float end_value = end * std::pow(1.0f - fade_progress, 1.0f);
+        return static_cast<Strip::ColorComponent>(start_value + end_value);
+    };
+    for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+        strip.setPixelColor(i, color(channel(red(from[i]), red(to[i])), channel(green(from[i]), green(to[i])),
+                                     channel(blue(from[i]), blue(to[i]))));
+    }
+}
+
+void test_benchmark_interpolation() {
+    std::vector<Support::ColorPoint> points;
+    for (int i = 0; i <= 16; i++) {
+        points.emplace_back(i / 16.0f, wheel(i * 15), Support::InterpolationType::Power, 2.2f);
+    }
+    Support::Palette palette(points);
+    const int lookups = 1000;
+    benchmark("palette, scan and pow, 17 points", 200, lookups, [&] {
+        for (int i = 0; i < lookups; i++) {
+            benchmark_sink = scanColor(points, i / static_cast<float>(lookups));
+        }
+    });
+    benchmark("palette, binary search and curve, 17 points", 200, lookups, [&] {
+        for (int i = 0; i < lookups; i++) {
+            benchmark_sink = palette.get_color(i / static_cast<float>(lookups));
+        }
+    });
+
+    const Strip::PixelIndex length = 300;
+    MockStrip strip(length);
+    std::vector<Strip::Color> from(length);
+    std::vector<Strip::Color> to(length);
+    for (Strip::PixelIndex i = 0; i < length; i++) {
+        from[i] = wheel(i % 255);
+        to[i] = wheel((i * 7) % 255);
+        strip.setPixelColor(i, from[i]);
+    }
+    float fade = 1.0f;
+    benchmark("blend step, pow per channel, 300 LEDs", 500, length, [&] {
+        powBlend(strip, from, to, fade);
+        fade = fade > 0.01f ? fade - 0.01f : 1.0f;
+        benchmark_sink = strip.getPixelColor(0);
+    });
+    Support::SmoothBlend blend(strip, to);
+    uint32_t progress = 0;
+    benchmark("blend step, Q16 deltas, 300 LEDs", 500, length, [&] {
+        blend.render(progress);
+        progress = (progress + 655) % ONE;
+        benchmark_sink = strip.getPixelColor(0);
+    });
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_lerp_rounds_down);
+    RUN_TEST(test_easing_curves);
+    RUN_TEST(test_power_curve);
+    RUN_TEST(test_benchmark_interpolation);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
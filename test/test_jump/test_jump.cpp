@@ -1,5 +1,6 @@
 #include "unity.h"
 #include "show/Jump.h"
+#include "../MockStrip.h"
 
 Show::Jump::Ball ball(1.0f, 0xff0000);
 
@@ -31,12 +32,33 @@ void test_jump_end_of_peak() {
     TEST_ASSERT_EQUAL_INT(99, position);
 }
 
+void test_jump_subpixel_position_matches_pixel() {
+    Show::Jump::Ball subpixel_ball(0.5f, 0x00ff00);
+    for (Show::Iteration iteration = 0; iteration < 60; iteration++) {
+        auto pixel = subpixel_ball.get_position(iteration, 100);
+        auto position = subpixel_ball.get_subpixel_position(iteration, 100);
+        TEST_ASSERT_INT_WITHIN(256, pixel * 256 + 128, position);
+    }
+}
+
+void test_jump_keeps_every_ball_after_bounces() {
+    Show::Jump jump;
+    MockStrip strip(100);
+    // long enough for every ball to bounce many times
+    for (Show::Iteration iteration = 0; iteration < 2000; iteration++) {
+        jump.execute(strip, iteration);
+        TEST_ASSERT_EQUAL_UINT(5, jump.ballsInFlight());
+    }
+}
+
 int runUnityTests() {
     UNITY_BEGIN();
     RUN_TEST(test_jump_basic_position);
     RUN_TEST(test_jump_start_of_peak);
     RUN_TEST(test_jump_mid_of_peak);
     RUN_TEST(test_jump_end_of_peak);
+    RUN_TEST(test_jump_subpixel_position_matches_pixel);
+    RUN_TEST(test_jump_keeps_every_ball_after_bounces);
     return UNITY_END();
 }
 
@@ -0,0 +1,187 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "ShowFactory.h"
+#include "show/Layers.h"
+#include "support/Blend.h"
+
+#include <vector>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+using Support::Blend::Mode;
+
+// Draws its color on the first frame only, relying on the strip to keep it
+class OnceShow : public Show::Show {
+    Strip::Color fill_color;
+    bool drawn = false;
+
+public:
+    explicit OnceShow(Strip::Color fill_color) : fill_color(fill_color) {
+    }
+
+    void execute(Strip::Strip &strip, ::Show::Iteration iteration) override {
+        if (!drawn) {
+            strip.fill(fill_color);
+            drawn = true;
+        }
+    }
+
+    bool isComplete() const override { return drawn; }
+};
+
+Strip::Color composite_one(Mode mode, Strip::Color base, Strip::Color layer, uint8_t opacity = 255) {
+    Support::Blend::composite(mode, &layer, &base, 1, opacity);
+    return base;
+}
+
+void test_normal_mode() {
+    TEST_ASSERT_EQUAL_HEX32(0x00FF00, composite_one(Mode::NORMAL, 0xFF0000, 0x00FF00));
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, composite_one(Mode::NORMAL, 0xFF0000, 0x00FF00, 0));
+    TEST_ASSERT_EQUAL_HEX32(Support::Blend::mix(0xFF0000, 0x00FF00, 128),
+                            composite_one(Mode::NORMAL, 0xFF0000, 0x00FF00, 128));
+}
+
+void test_add_mode_saturates_per_channel() {
+    TEST_ASSERT_EQUAL_HEX32(0xFF3050, composite_one(Mode::ADD, 0xF01020, 0x202030));
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, composite_one(Mode::ADD, 0xFFFFFF, 0xFFFFFF));
+    TEST_ASSERT_EQUAL_HEX32(0x01FF01, composite_one(Mode::ADD, 0x00FF00, 0x0101FF) & 0x01FF01);
+    // half opacity adds half the layer
+    TEST_ASSERT_EQUAL_HEX32(0x108010, composite_one(Mode::ADD, 0x100010, 0x00FF00, 128));
+}
+
+void test_multiply_mode() {
+    TEST_ASSERT_EQUAL_HEX32(0x000000, composite_one(Mode::MULTIPLY, 0xFFFFFF, 0x000000));
+    TEST_ASSERT_EQUAL_HEX32(0x804020, composite_one(Mode::MULTIPLY, 0x804020, 0xFFFFFF));
+    TEST_ASSERT_EQUAL_HEX32(0x400000, composite_one(Mode::MULTIPLY, 0x800000, 0x800000));
+}
+
+void test_screen_mode() {
+    TEST_ASSERT_EQUAL_HEX32(0x804020, composite_one(Mode::SCREEN, 0x804020, 0x000000));
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, composite_one(Mode::SCREEN, 0x804020, 0xFFFFFF));
+    TEST_ASSERT_EQUAL_HEX32(0xBF0000, composite_one(Mode::SCREEN, 0x800000, 0x800000));
+}
+
+void test_max_mode() {
+    TEST_ASSERT_EQUAL_HEX32(0x80FF40, composite_one(Mode::MAX, 0x10FF40, 0x802010));
+}
+
+void test_mode_names_round_trip() {
+    for (Mode mode: {Mode::NORMAL, Mode::ADD, Mode::MULTIPLY, Mode::SCREEN, Mode::MAX}) {
+        TEST_ASSERT_TRUE(mode == Support::Blend::modeFromName(Support::Blend::modeName(mode)));
+    }
+    TEST_ASSERT_TRUE(Mode::NORMAL == Support::Blend::modeFromName("bogus"));
+}
+
+void test_layers_keep_their_own_frame() {
+    Show::Layers layers;
+    TEST_ASSERT_TRUE(layers.addLayer(std::make_unique<OnceShow>(0x100000), "base", Mode::NORMAL, 255));
+    TEST_ASSERT_TRUE(layers.addLayer(std::make_unique<OnceShow>(0x000010), "top", Mode::ADD, 255));
+    MockStrip strip(8);
+
+    for (Show::Iteration iteration = 0; iteration < 3; iteration++) {
+        layers.execute(strip, iteration);
+        TEST_ASSERT_EQUAL_HEX32(0x100010, strip.getPixelColor(7));
+    }
+    TEST_ASSERT_TRUE(layers.isComplete());
+}
+
+void test_layers_capacity() {
+    Show::Layers layers;
+    for (size_t i = 0; i < Show::Layers::MAX_LAYERS; i++) {
+        TEST_ASSERT_TRUE(layers.addLayer(std::make_unique<OnceShow>(0), "layer", Mode::NORMAL, 255));
+    }
+    TEST_ASSERT_FALSE(layers.addLayer(std::make_unique<OnceShow>(0), "layer", Mode::NORMAL, 255));
+}
+
+void test_layer_timings_reported() {
+    Show::Layers layers;
+    layers.addLayer(std::make_unique<OnceShow>(0x101010), "Solid", Mode::NORMAL, 255);
+    layers.addLayer(std::make_unique<OnceShow>(0x101010), "Starlight", Mode::ADD, 255);
+    MockStrip strip(10);
+    layers.execute(strip, 0);
+
+    Show::LayerTiming timings[Show::Layers::MAX_LAYERS];
+    TEST_ASSERT_EQUAL(2, layers.layerTimings(timings, Show::Layers::MAX_LAYERS));
+    TEST_ASSERT_EQUAL_STRING("Solid", timings[0].name);
+    TEST_ASSERT_EQUAL_STRING("Starlight", timings[1].name);
+    TEST_ASSERT_EQUAL(1, layers.layerTimings(timings, 1));
+}
+
+void test_factory_builds_layer_stack() {
+    ShowFactory factory;
+    TEST_ASSERT_TRUE(factory.hasShow("Layers"));
+
+    auto show = factory.createShow("Layers",
+        R"({"layers":[{"show":"Rainbow","params":{"pixel_step":0},"opacity":128},)"
+        R"({"show":"Layers"},{"show":"Nope"},{"show":"Stroboscope","blend":"add"}]})");
+    TEST_ASSERT_NOT_NULL(show.get());
+
+    Show::LayerTiming timings[Show::Layers::MAX_LAYERS];
+    TEST_ASSERT_EQUAL(2, show->layerTimings(timings, Show::Layers::MAX_LAYERS));
+    TEST_ASSERT_EQUAL_STRING("Rainbow", timings[0].name);
+    TEST_ASSERT_EQUAL_STRING("Stroboscope", timings[1].name);
+
+    // Rainbow at half opacity plus a white flash saturates to white
+    MockStrip strip(5);
+    show->execute(strip, 0);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, strip.getPixelColor(2));
+    show->execute(strip, 1);
+    TEST_ASSERT_EQUAL_HEX32(Support::Blend::mix(0, wheel(1), 128), strip.getPixelColor(2));
+}
+
+void test_factory_empty_stack_is_black() {
+    ShowFactory factory;
+    auto show = factory.createShow("Layers", "{}");
+    MockStrip strip(5);
+    strip.fill(0xFFFFFF);
+    show->execute(strip, 0);
+    TEST_ASSERT_EQUAL_HEX32(0x000000, strip.getPixelColor(4));
+}
+
+void test_benchmark_blend_modes() {
+    for (size_t length: {300, 1000}) {
+        std::vector<Strip::Color> layer(length), base(length);
+        for (size_t i = 0; i < length; i++) {
+            layer[i] = wheel(i % 255);
+            base[i] = wheel((i * 7) % 255);
+        }
+        for (Mode mode: {Mode::NORMAL, Mode::ADD, Mode::MULTIPLY, Mode::SCREEN, Mode::MAX}) {
+            char label[48];
+            snprintf(label, sizeof(label), "%s %zu px", Support::Blend::modeName(mode), length);
+            benchmark(label, 2000, length, [&] {
+                Support::Blend::composite(mode, layer.data(), base.data(), length, 200);
+                benchmark_sink = base[length / 2];
+            });
+        }
+    }
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_normal_mode);
+    RUN_TEST(test_add_mode_saturates_per_channel);
+    RUN_TEST(test_multiply_mode);
+    RUN_TEST(test_screen_mode);
+    RUN_TEST(test_max_mode);
+    RUN_TEST(test_mode_names_round_trip);
+
+    RUN_TEST(test_layers_keep_their_own_frame);
+    RUN_TEST(test_layers_capacity);
+    RUN_TEST(test_layer_timings_reported);
+    RUN_TEST(test_factory_builds_layer_stack);
+    RUN_TEST(test_factory_empty_stack_is_black);
+
+    RUN_TEST(test_benchmark_blend_modes);
+
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
@@ -0,0 +1,219 @@
+#include "unity.h"
+#include "../MockStrip.h"
+#include "show/Baked.h"
+#include "show/MorseCode.h"
+#include "show/Rainbow.h"
+#include "show/Stroboscope.h"
+#include "show/TheaterChase.h"
+#include "support/FrameLoop.h"
+
+#include <functional>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+static constexpr size_t BUDGET = 24 * 1024;
+
+/**
+ * Run a live and a baked instance of the same show side by side for a number
+ * of frames and require identical output on every pixel of every frame.
+ */
+void assert_baked_matches_live(const std::function<std::unique_ptr<Show::Show>()> &create,
+                               Strip::PixelIndex length, Show::Iteration frames) {
+    auto live = create();
+    Show::Iteration period = live->period();
+    TEST_ASSERT_TRUE(period > 0);
+    Show::Baked baked(create(), period, BUDGET);
+
+    MockStrip live_strip(length);
+    MockStrip baked_strip(length);
+
+    for (Show::Iteration iteration = 0; iteration < frames; iteration++) {
+        live->execute(live_strip, iteration);
+        baked.execute(baked_strip, iteration);
+        for (Strip::PixelIndex i = 0; i < length; i++) {
+            if (live_strip.getPixelColor(i) != baked_strip.getPixelColor(i)) {
+                char message[64];
+                snprintf(message, sizeof(message), "frame %u pixel %d", (unsigned) iteration, i);
+                TEST_FAIL_MESSAGE(message);
+            }
+        }
+    }
+    TEST_ASSERT_TRUE(baked.isBaked());
+}
+
+void test_rainbow_period() {
+    TEST_ASSERT_EQUAL(255, Show::Rainbow().period());
+    TEST_ASSERT_EQUAL(510, Show::Rainbow(0.5f, 1.0f).period());
+    // 0.3 rounds to 77/256, which has no factor in common with a turn of 255 * 256
+    TEST_ASSERT_EQUAL(255 * 256, Show::Rainbow(0.3f, 1.0f).period());
+    TEST_ASSERT_EQUAL(255, Show::Rainbow(1.001f, 0.3f).period());
+    TEST_ASSERT_EQUAL(0, Show::Rainbow(0.0f, 1.0f).period());
+}
+
+void test_theater_chase_period() {
+    TEST_ASSERT_EQUAL(21, Show::TheaterChase().period());
+    TEST_ASSERT_EQUAL(70, Show::TheaterChase(10).period());
+}
+
+void test_stroboscope_period() {
+    TEST_ASSERT_EQUAL(11, Show::Stroboscope().period());
+    TEST_ASSERT_EQUAL(5, Show::Stroboscope(255, 0, 0, 2, 3).period());
+}
+
+void test_morse_code_period() {
+    // half an LED per frame wraps after two frames per pattern LED
+    Show::MorseCode morse("E", 0.5f, 1, 3, 2, 3, 5);
+    TEST_ASSERT_EQUAL(2, morse.period());
+    TEST_ASSERT_EQUAL(0, Show::MorseCode("HELLO WORLD!", 0.3f).period());
+}
+
+void test_baked_rainbow_matches_live() {
+    assert_baked_matches_live([] { return std::make_unique<Show::Rainbow>(); }, 300, 3 * 255 + 17);
+}
+
+void test_baked_rainbow_half_step_matches_live() {
+    assert_baked_matches_live([] { return std::make_unique<Show::Rainbow>(0.5f, 1.0f); }, 150, 2 * 510 + 3);
+}
+
+void test_baked_rainbow_rounded_step_matches_live() {
+    assert_baked_matches_live([] { return std::make_unique<Show::Rainbow>(1.001f, 0.3f); }, 150, 2 * 255 + 3);
+}
+
+void test_baked_theater_chase_matches_live() {
+    assert_baked_matches_live([] { return std::make_unique<Show::TheaterChase>(); }, 300, 100);
+}
+
+void test_baked_morse_code_matches_live() {
+    // whole-LED steps keep every frame a shift of the last, which the loop stores compactly
+    auto create = [] { return std::make_unique<Show::MorseCode>("HELLO WORLD!", 1.0f); };
+    Show::Iteration period = create()->period();
+    TEST_ASSERT_TRUE(period > 0);
+    assert_baked_matches_live(create, 144, 2 * period + 5);
+}
+
+void test_baked_stroboscope_matches_live() {
+    assert_baked_matches_live([] { return std::make_unique<Show::Stroboscope>(255, 0, 128, 2, 5); }, 60, 50);
+}
+
+void test_baked_loop_is_compact() {
+    Show::Baked baked(std::make_unique<Show::Rainbow>(), 255, BUDGET);
+    MockStrip strip(300);
+    for (Show::Iteration iteration = 0; iteration < 255; iteration++) {
+        baked.execute(strip, iteration);
+    }
+
+    TEST_ASSERT_TRUE(baked.isBaked());
+    // A scrolling rainbow reduces to a shifted copy plus one new pixel per frame
+    TEST_ASSERT_LESS_THAN(8 * 1024, baked.bakedSize());
+}
+
+void test_over_budget_runs_live() {
+    auto live = std::make_unique<Show::Rainbow>();
+    Show::Baked baked(std::make_unique<Show::Rainbow>(), 255, 512);
+    MockStrip live_strip(300);
+    MockStrip baked_strip(300);
+
+    for (Show::Iteration iteration = 0; iteration < 600; iteration++) {
+        live->execute(live_strip, iteration);
+        baked.execute(baked_strip, iteration);
+        TEST_ASSERT_EQUAL_HEX32(live_strip.getPixelColor(iteration % 300), baked_strip.getPixelColor(iteration % 300));
+    }
+
+    TEST_ASSERT_FALSE(baked.isBaked());
+    TEST_ASSERT_EQUAL(0, baked.bakedSize());
+}
+
+void test_length_change_rebakes() {
+    Show::Baked baked(std::make_unique<Show::Stroboscope>(), 11, BUDGET);
+    MockStrip small(10);
+    for (Show::Iteration iteration = 0; iteration < 11; iteration++) {
+        baked.execute(small, iteration);
+    }
+    TEST_ASSERT_TRUE(baked.isBaked());
+
+    MockStrip large(20);
+    baked.execute(large, 11);
+    TEST_ASSERT_FALSE(baked.isBaked());
+    // first frame of the cycle again: flash on the whole new length
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, large.getPixelColor(19));
+
+    for (Show::Iteration iteration = 12; iteration < 22; iteration++) {
+        baked.execute(large, iteration);
+    }
+    TEST_ASSERT_TRUE(baked.isBaked());
+}
+
+void test_frame_loop_round_trip() {
+    const Strip::PixelIndex length = 100;
+    Support::FrameLoop loop(length, BUDGET);
+    std::vector<std::vector<Strip::Color>> frames;
+
+    // static, shifted, run-length and noisy content in one sequence
+    for (int f = 0; f < 12; f++) {
+        std::vector<Strip::Color> frame(length);
+        for (Strip::PixelIndex i = 0; i < length; i++) {
+            if (i < 30) {
+                frame[i] = 0x102030;
+            } else if (i < 60) {
+                frame[i] = wheel(static_cast<uint8_t>((i + f * 3) * 5));
+            } else if (i < 80) {
+                frame[i] = f % 2 ? 0xFF0000 : 0x0000FF;
+            } else {
+                frame[i] = wheel(static_cast<uint8_t>((i * 37 + f * 101) % 255));
+            }
+        }
+        TEST_ASSERT_TRUE(loop.append(frame.data()));
+        frames.push_back(frame);
+    }
+    loop.finish();
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (const auto &expected: frames) {
+            const Strip::Color *decoded = loop.next();
+            TEST_ASSERT_EQUAL_HEX32_ARRAY(expected.data(), decoded, length);
+        }
+    }
+}
+
+void test_frame_loop_palette_limit() {
+    Support::FrameLoop loop(300, 64 * 1024);
+    std::vector<Strip::Color> frame(300);
+    for (Strip::PixelIndex i = 0; i < 300; i++) {
+        frame[i] = i * 0x010101;
+    }
+
+    TEST_ASSERT_FALSE(loop.append(frame.data()));
+    TEST_ASSERT_EQUAL(0, loop.frames());
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_rainbow_period);
+    RUN_TEST(test_theater_chase_period);
+    RUN_TEST(test_stroboscope_period);
+    RUN_TEST(test_morse_code_period);
+
+    RUN_TEST(test_baked_rainbow_matches_live);
+    RUN_TEST(test_baked_rainbow_half_step_matches_live);
+    RUN_TEST(test_baked_rainbow_rounded_step_matches_live);
+    RUN_TEST(test_baked_theater_chase_matches_live);
+    RUN_TEST(test_baked_morse_code_matches_live);
+    RUN_TEST(test_baked_stroboscope_matches_live);
+    RUN_TEST(test_baked_loop_is_compact);
+    RUN_TEST(test_over_budget_runs_live);
+    RUN_TEST(test_length_change_rebakes);
+
+    RUN_TEST(test_frame_loop_round_trip);
+    RUN_TEST(test_frame_loop_palette_limit);
+
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
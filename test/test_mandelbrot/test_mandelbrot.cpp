@@ -0,0 +1,233 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "color.h"
+#include "show/Mandelbrot.h"
+
+#include <cmath>
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+using Show::Mandelbrot;
+
+// The engine Mandelbrot had before: plain float iteration through a
+// tuple-returning step, escape at |z|^2 > 10, colored by whole iterations
+class ReferenceMandelbrot {
+public:
+    explicit ReferenceMandelbrot(unsigned int max_iterations) : max_iterations(max_iterations) {
+    }
+
+    static std::tuple<float, float> func(float zre, float zim, float cre, float cim) {
+        return std::make_tuple<float, float>(zre * zre - zim * zim + cre, 2 * zre * zim + cim);
+    }
+
+    // @return iterations run; max_iterations for points taken as inside
+    unsigned int iterate(float cre, float cim) const {
+        float zre = 0.0, zim = 0.0;
+        for (unsigned int k = 0; k < max_iterations; k++) {
+            auto [zre1, zim1] = func(zre, zim, cre, cim);
+            zre = zre1;
+            zim = zim1;
+            if (zre * zre + zim * zim > 10) {
+                return k + 1;
+            }
+        }
+        return max_iterations;
+    }
+
+    Strip::Color color(float cre, float cim) const {
+        unsigned int iterations = iterate(cre, cim);
+        return iterations < max_iterations ? wheel(((iterations - 1) * 10) % 255) : 0x000000;
+    }
+
+private:
+    unsigned int max_iterations;
+};
+
+// Points of a grid over the whole set
+static std::vector<std::pair<float, float>> grid(int columns, int rows) {
+    std::vector<std::pair<float, float>> points;
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < columns; x++) {
+            points.emplace_back(-2.2f + 2.8f * x / columns, -1.3f + 2.6f * y / rows);
+        }
+    }
+    return points;
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_bulb_rejection_is_exact() {
+    ReferenceMandelbrot reference(5000);
+    int rejected = 0;
+    for (auto [cre, cim]: grid(200, 200)) {
+        if (Mandelbrot::inMainBulbs(cre, cim)) {
+            rejected++;
+            TEST_ASSERT_EQUAL_MESSAGE(5000, reference.iterate(cre, cim), "rejected point escapes");
+        }
+    }
+    // the cardioid and the bulb hold most of the set's area
+    TEST_ASSERT_GREATER_THAN(4000, rejected);
+
+    TEST_ASSERT_TRUE(Mandelbrot::inMainBulbs(0.0f, 0.0f));
+    TEST_ASSERT_TRUE(Mandelbrot::inMainBulbs(-1.0f, 0.2f));
+    TEST_ASSERT_FALSE(Mandelbrot::inMainBulbs(0.3f, 0.0f));
+    TEST_ASSERT_FALSE(Mandelbrot::inMainBulbs(-0.122f, 0.745f)); // period-3 bulb
+}
+
+void test_kernels_agree_with_plain_iteration() {
+    Mandelbrot show(-1.05f, -0.3616f, -0.3156f, 5, 200);
+    Mandelbrot fixed(-1.05f, -0.3616f, -0.3156f, 5, 200, 10, true);
+    ReferenceMandelbrot reference(200);
+    int points = 0;
+    int disagree = 0;
+    for (auto [cre, cim]: grid(120, 120)) {
+        bool inside = reference.iterate(cre, cim) == 200;
+        Mandelbrot::Escape floats = show.escape(cre, cim);
+        Mandelbrot::Escape integers = fixed.escapeFixed(cre, cim);
+        points++;
+        // only points right at the border may land on the other side
+        disagree += floats.inside != inside;
+        disagree += integers.inside != inside;
+        // orbits that take long to escape pass near the border, where float
+        // and fixed-point rounding drift apart
+        if (!floats.inside && !integers.inside && floats.iterations < 30) {
+            TEST_ASSERT_FLOAT_WITHIN(0.05f, floats.smooth, integers.smooth);
+        }
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(points / 500, disagree);
+}
+
+void test_cycles_end_early() {
+    // the center of the period-3 bulb: attracted to a 3-cycle, not covered by the bulb test
+    Mandelbrot show(0, 0, 0, 5, 100000);
+    Mandelbrot::Escape floats = show.escape(-0.1226f, 0.7449f);
+    TEST_ASSERT_TRUE(floats.inside);
+    TEST_ASSERT_LESS_THAN(1000, floats.iterations);
+    Mandelbrot::Escape integers = show.escapeFixed(-0.1226f, 0.7449f);
+    TEST_ASSERT_TRUE(integers.inside);
+    TEST_ASSERT_LESS_THAN(1000, integers.iterations);
+
+    TEST_ASSERT_EQUAL(0, show.escape(-0.1f, 0.1f).iterations); // cardioid
+}
+
+void test_escape_time_is_continuous() {
+    // along the real axis past the cusp the escape time falls smoothly
+    Mandelbrot show(0, 0, 0, 5, 1000);
+    Mandelbrot::Escape previous = show.escape(0.3f, 0.0f);
+    int steps = 0;
+    for (float cre = 0.301f; cre < 2.0f; cre += 0.001f) {
+        Mandelbrot::Escape result = show.escape(cre, 0.0f);
+        TEST_ASSERT_FALSE(result.inside);
+        TEST_ASSERT_TRUE(result.smooth <= previous.smooth + 1e-3f);
+        // whole iteration steps would jump by 1
+        TEST_ASSERT_TRUE_MESSAGE(previous.smooth - result.smooth < 0.2f, "escape time jumps");
+        steps += result.iterations != previous.iterations;
+        previous = result;
+    }
+    TEST_ASSERT_GREATER_THAN(10, steps);
+}
+
+void test_palette_blends_between_colors() {
+    Mandelbrot wheel_colors(0, 0, 0, 5, 50, 1);
+    TEST_ASSERT_EQUAL_HEX32(WHEEL_TABLE[3], wheel_colors.colorOf(3.0f));
+    Strip::Color half = wheel_colors.colorOf(3.5f);
+    TEST_ASSERT_TRUE(half != WHEEL_TABLE[3] && half != WHEEL_TABLE[4]);
+
+    // two colors: the palette runs red, blue, back to red over 256 steps
+    Mandelbrot custom(0, 0, 0, 5, 50, 64, false, {0xFF0000, 0x0000FF});
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, custom.colorOf(0.0f));
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, custom.colorOf(2.0f));
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, custom.colorOf(4.0f));
+}
+
+void test_show_draws_slices() {
+    Mandelbrot show(-1.05f, -0.3616f, -0.3156f);
+    MockStrip strip(60);
+    int lit = 0;
+    for (Show::Iteration i = 0; i < 300; i++) {
+        show.execute(strip, i);
+        for (Strip::PixelIndex p = 0; p < 60; p++) {
+            lit += strip.getPixelColor(p) != 0;
+        }
+    }
+    TEST_ASSERT_GREATER_THAN(0, lit);
+    TEST_ASSERT_LESS_THAN(300 * 60, lit);
+}
+
+struct View {
+    const char *name;
+    float c_re_min, c_im_min, c_im_max;
+};
+
+// Frames of a scan over a 300 LED strip, timed in the work the plain engine
+// does: pixels times the iterations it runs for them
+static void benchmarkEngine(const View &view, unsigned int max_iterations, const char *engine) {
+    const Strip::PixelIndex length = 300;
+    const unsigned int frames = 100;
+    const bool reference = strcmp(engine, "plain float") == 0;
+    ReferenceMandelbrot plain(max_iterations);
+    Mandelbrot show(view.c_re_min, view.c_im_min, view.c_im_max, 5, max_iterations, 10,
+                    strcmp(engine, "fixed point") == 0);
+    MockStrip strip(length);
+    float delta = std::fabs(view.c_im_max - view.c_im_min) / length;
+
+    uint64_t work = 0;
+    for (unsigned int frame = 0; frame < frames; frame++) {
+        float cre = view.c_re_min + delta / 5 * frame;
+        for (Strip::PixelIndex i = 0; i < length; i++) {
+            work += plain.iterate(cre, view.c_im_min + delta * i);
+        }
+    }
+
+    char label[100];
+    snprintf(label, sizeof(label), "%s, %s, %u iterations", engine, view.name, max_iterations);
+    double ns = benchmark(label, 3, frames * length, [&] {
+        for (unsigned int frame = 0; frame < frames; frame++) {
+            if (reference) {
+                float cre = view.c_re_min + delta / 5 * frame;
+                for (Strip::PixelIndex i = 0; i < length; i++) {
+                    strip.setPixelColor(i, plain.color(cre, view.c_im_min + delta * i));
+                }
+            } else {
+                show.execute(strip, frame);
+            }
+        }
+        benchmark_sink = strip.getPixelColor(0);
+    });
+    char message[160];
+    snprintf(message, sizeof(message), "%s: %.0f Mpixel-iterations/s", label, work / (ns / 1000.0));
+    TEST_MESSAGE(message);
+}
+
+void test_benchmark_mandelbrot() {
+    const View views[] = {{"default spiral", -1.05f, -0.3616f, -0.3156f}, {"classic view", -0.5f, 0.0f, -0.5f}};
+    for (const View &view: views) {
+        for (unsigned int max_iterations: {50u, 500u}) {
+            for (const char *engine: {"plain float", "float", "fixed point"}) {
+                benchmarkEngine(view, max_iterations, engine);
+            }
+        }
+    }
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_bulb_rejection_is_exact);
+    RUN_TEST(test_kernels_agree_with_plain_iteration);
+    RUN_TEST(test_cycles_end_early);
+    RUN_TEST(test_escape_time_is_continuous);
+    RUN_TEST(test_palette_blends_between_colors);
+    RUN_TEST(test_show_draws_slices);
+    RUN_TEST(test_benchmark_mandelbrot);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
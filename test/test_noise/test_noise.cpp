@@ -0,0 +1,177 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "show/Noise.h"
+#include "strip/Buffer.h"
+#include "support/Noise.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using Support::Noise::Fixed;
+using Support::Noise::Line;
+using Support::Noise::ONE;
+using Support::Noise::fractal;
+using Support::Noise::noise;
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_noise_is_zero_on_lattice_points() {
+    for (int32_t i = -3; i <= 3; i++) {
+        TEST_ASSERT_EQUAL_INT32(0, noise(i * ONE));
+        TEST_ASSERT_EQUAL_INT32(0, noise(i * ONE, 7 * ONE));
+        TEST_ASSERT_EQUAL_INT32(0, noise(i * ONE, 2 * ONE, -5 * ONE));
+    }
+}
+
+void test_noise_is_deterministic() {
+    // pinned outputs: changing the tables or the arithmetic changes every show using them
+    TEST_ASSERT_EQUAL_INT32(32280, noise(ONE / 3));
+    TEST_ASSERT_EQUAL_INT32(25072, noise(ONE / 3, 5 * ONE / 4));
+    TEST_ASSERT_EQUAL_INT32(24320, noise(ONE / 3, 5 * ONE / 4, -ONE / 7));
+    TEST_ASSERT_EQUAL_INT32(1809, fractal(4, 10 * ONE + 123, 2 * ONE + 4567, 99));
+}
+
+void test_noise_is_bounded_and_continuous() {
+    Fixed previous1 = noise(0);
+    Fixed previous3 = noise(0, ONE / 3, ONE / 5);
+    for (Fixed x = ONE / 64; x < 40 * ONE; x += ONE / 64) {
+        Fixed value1 = noise(x);
+        Fixed value3 = noise(x, ONE / 3, ONE / 5);
+        TEST_ASSERT_TRUE(std::abs(value1) <= ONE);
+        TEST_ASSERT_TRUE(std::abs(value3) <= ONE + ONE / 8);
+        // the steepest slope is about 2 per unit
+        TEST_ASSERT_INT_WITHIN(ONE / 24, previous1, value1);
+        TEST_ASSERT_INT_WITHIN(ONE / 24, previous3, value3);
+        previous1 = value1;
+        previous3 = value3;
+    }
+}
+
+void test_noise_repeats_every_256_units() {
+    for (Fixed x = 0; x < 4 * ONE; x += ONE / 10) {
+        TEST_ASSERT_EQUAL_INT32(noise(x, ONE / 2), noise(x + 256 * ONE, ONE / 2 - 256 * ONE));
+    }
+    // so coordinates may wrap around like unsigned numbers
+    Fixed near_end = static_cast<Fixed>(0x7FFFF000);
+    TEST_ASSERT_EQUAL_INT32(noise(near_end + ONE, ONE / 2),
+                            noise(static_cast<Fixed>(static_cast<uint32_t>(near_end) + ONE), ONE / 2));
+}
+
+void test_line_matches_fractal() {
+    for (uint8_t octaves = 1; octaves <= Support::Noise::MAX_OCTAVES; octaves++) {
+        Line line;
+        Fixed x0 = -3 * ONE + 777;
+        Fixed dx = ONE / 13;
+        Fixed y = 40 * ONE + 12345;
+        Fixed z = ONE / 3;
+        line.begin(octaves, x0, dx, y, z);
+        for (int k = 0; k < 300; k++) {
+            TEST_ASSERT_EQUAL_INT32(fractal(octaves, x0 + k * dx, y, z), line.next());
+        }
+    }
+}
+
+void test_octaves_add_detail() {
+    // more octaves make neighbouring samples less alike
+    auto roughness = [](uint8_t octaves) {
+        Line line;
+        line.begin(octaves, 0, ONE / 16, ONE / 3);
+        int64_t total = 0;
+        Fixed previous = line.next();
+        for (int k = 0; k < 1000; k++) {
+            Fixed value = line.next();
+            total += std::abs(value - previous);
+            previous = value;
+        }
+        return total;
+    };
+    TEST_ASSERT_TRUE(roughness(4) > roughness(1));
+}
+
+void test_noise_show_uses_the_palette() {
+    MockStrip strip(50);
+    Show::Noise single({0x00FF00});
+    single.execute(strip, 0);
+    for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+        TEST_ASSERT_EQUAL_HEX32(0x00FF00, strip.getPixelColor(i));
+    }
+
+    // black to white: the noise itself shows as gray levels that move over time
+    Show::Noise gray({0x000000, 0xFFFFFF}, 10.0f, 1.0f, 2, 42);
+    Show::Noise same({0x000000, 0xFFFFFF}, 10.0f, 1.0f, 2, 42);
+    MockStrip other(50);
+    gray.execute(strip, 100);
+    same.execute(other, 100);
+    bool varies = false;
+    for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+        TEST_ASSERT_EQUAL_HEX32(strip.getPixelColor(i), other.getPixelColor(i));
+        varies |= strip.getPixelColor(i) != strip.getPixelColor(0);
+    }
+    TEST_ASSERT_TRUE(varies);
+
+    gray.execute(other, 150);
+    bool moved = false;
+    for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+        moved |= strip.getPixelColor(i) != other.getPixelColor(i);
+    }
+    TEST_ASSERT_TRUE(moved);
+}
+
+void test_benchmark_noise() {
+    for (Strip::PixelIndex length: {300, 1000}) {
+        for (uint8_t octaves: {1, 3, 6}) {
+            char label[64];
+            Fixed y = 0;
+
+            Line line;
+            snprintf(label, sizeof(label), "Line %u octaves %d px", octaves, length);
+            benchmark(label, 1000, length, [&] {
+                line.begin(octaves, 0, ONE / 20, y += ONE / 100);
+                Fixed sum = 0;
+                for (Strip::PixelIndex i = 0; i < length; i++) {
+                    sum += line.next();
+                }
+                benchmark_sink = sum;
+            });
+
+            snprintf(label, sizeof(label), "fractal() %u octaves %d px", octaves, length);
+            benchmark(label, 1000, length, [&] {
+                y += ONE / 100;
+                Fixed sum = 0;
+                for (Strip::PixelIndex i = 0; i < length; i++) {
+                    sum += fractal(octaves, i * (ONE / 20), y);
+                }
+                benchmark_sink = sum;
+            });
+
+            Strip::Buffer strip(length);
+            Show::Noise show({}, 20.0f, 0.3f, octaves, 1);
+            Show::Iteration iteration = 0;
+            snprintf(label, sizeof(label), "Noise show %u octaves %d px", octaves, length);
+            benchmark(label, 1000, length, [&] { show.execute(strip, iteration++); });
+        }
+    }
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_noise_is_zero_on_lattice_points);
+    RUN_TEST(test_noise_is_deterministic);
+    RUN_TEST(test_noise_is_bounded_and_continuous);
+    RUN_TEST(test_noise_repeats_every_256_units);
+    RUN_TEST(test_line_matches_fractal);
+    RUN_TEST(test_octaves_add_detail);
+    RUN_TEST(test_noise_show_uses_the_palette);
+
+    RUN_TEST(test_benchmark_noise);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
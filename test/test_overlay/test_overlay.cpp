@@ -0,0 +1,171 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "show/Overlay.h"
+#include "strip/Buffer.h"
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+using Show::Overlay;
+
+void test_type_names_round_trip() {
+    for (Overlay::Type type: {Overlay::Type::FLASH, Overlay::Type::PULSE, Overlay::Type::PROGRESS}) {
+        TEST_ASSERT_TRUE(type == Overlay::typeFromName(Overlay::typeName(type)));
+    }
+    TEST_ASSERT_TRUE(Overlay::Type::NONE == Overlay::typeFromName("sparkle"));
+    TEST_ASSERT_TRUE(Overlay::Type::NONE == Overlay::typeFromName(nullptr));
+}
+
+void test_idle_overlay_leaves_strip_alone() {
+    Overlay overlay;
+    MockStrip strip(4);
+    strip.fill(0x123456);
+    overlay.restore(strip);
+    overlay.apply(strip);
+    TEST_ASSERT_FALSE(overlay.isActive());
+    TEST_ASSERT_EQUAL_HEX32(0x123456, strip.getPixelColor(2));
+}
+
+void test_flash_fades_out() {
+    Overlay overlay;
+    MockStrip strip(4);
+    overlay.start(strip.length(), Overlay::Type::FLASH, 0xFFFFFF, 4);
+
+    Strip::Color levels[4];
+    for (auto &level: levels) {
+        overlay.restore(strip);
+        strip.fill(0x000000);
+        overlay.apply(strip);
+        level = strip.getPixelColor(0);
+    }
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, levels[0]);
+    TEST_ASSERT_TRUE(levels[1] < levels[0]);
+    TEST_ASSERT_TRUE(levels[2] < levels[1]);
+    TEST_ASSERT_TRUE(levels[3] < levels[2]);
+    TEST_ASSERT_FALSE(overlay.isActive());
+}
+
+void test_show_frame_survives_overlay() {
+    // a show that draws once and relies on the strip keeping its pixels
+    Overlay overlay;
+    MockStrip strip(6);
+    strip.fill(0x00FF00);
+    overlay.start(strip.length(), Overlay::Type::PULSE, 0xFF0000, 5);
+
+    while (overlay.isActive()) {
+        overlay.restore(strip);
+        TEST_ASSERT_EQUAL_HEX32(0x00FF00, strip.getPixelColor(3));
+        overlay.apply(strip);
+    }
+    overlay.restore(strip);
+    for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+        TEST_ASSERT_EQUAL_HEX32(0x00FF00, strip.getPixelColor(i));
+    }
+}
+
+void test_pulse_peaks_twice() {
+    Overlay overlay;
+    MockStrip strip(1);
+    overlay.start(strip.length(), Overlay::Type::PULSE, 0x0000FF, 8);
+
+    uint8_t levels[8];
+    for (auto &level: levels) {
+        overlay.restore(strip);
+        strip.fill(0);
+        overlay.apply(strip);
+        level = strip.getPixelColor(0) & 0xFF;
+    }
+    TEST_ASSERT_EQUAL(0, levels[0]);
+    TEST_ASSERT_TRUE(levels[2] > levels[1]);
+    TEST_ASSERT_TRUE(levels[4] < levels[2]);
+    TEST_ASSERT_TRUE(levels[6] > levels[5]);
+}
+
+void test_progress_fills_fraction() {
+    Overlay overlay;
+    MockStrip strip(10);
+    overlay.start(strip.length(), Overlay::Type::PROGRESS, 0xFFFFFF, 8, 128);
+    strip.fill(0x000000);
+    overlay.apply(strip);
+
+    for (Strip::PixelIndex i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, strip.getPixelColor(i));
+    }
+    for (Strip::PixelIndex i = 6; i < 10; i++) {
+        TEST_ASSERT_EQUAL_HEX32(0x000000, strip.getPixelColor(i));
+    }
+}
+
+void test_restart_replaces_running_overlay() {
+    Overlay overlay;
+    MockStrip strip(3);
+    overlay.start(strip.length(), Overlay::Type::FLASH, 0xFF0000, 10);
+    overlay.apply(strip);
+    overlay.restore(strip);
+    overlay.start(strip.length(), Overlay::Type::FLASH, 0x0000FF, 2);
+    overlay.apply(strip);
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, strip.getPixelColor(1));
+}
+
+void test_cancel_still_restores() {
+    Overlay overlay;
+    MockStrip strip(3);
+    strip.fill(0x101010);
+    overlay.start(strip.length(), Overlay::Type::FLASH, 0xFFFFFF, 10);
+    overlay.apply(strip);
+    overlay.cancel();
+    TEST_ASSERT_FALSE(overlay.isActive());
+    overlay.restore(strip);
+    TEST_ASSERT_EQUAL_HEX32(0x101010, strip.getPixelColor(0));
+}
+
+void test_length_change_stops_overlay() {
+    Overlay overlay;
+    MockStrip small(3);
+    MockStrip large(5);
+    overlay.start(small.length(), Overlay::Type::FLASH, 0xFFFFFF, 10);
+    large.fill(0x202020);
+    overlay.apply(large);
+    TEST_ASSERT_FALSE(overlay.isActive());
+    TEST_ASSERT_EQUAL_HEX32(0x202020, large.getPixelColor(4));
+}
+
+void test_benchmark_overlay() {
+    for (Strip::PixelIndex length: {300, 1000}) {
+        Strip::Buffer strip(length);
+        Overlay overlay;
+        overlay.start(length, Overlay::Type::PROGRESS, 0xFFFFFF, 1u << 30, 100);
+        char label[48];
+        snprintf(label, sizeof(label), "progress overlay %d px", length);
+        benchmark(label, 2000, length, [&] {
+            overlay.restore(strip);
+            overlay.apply(strip);
+            benchmark_sink = strip.getPixelColor(length / 2);
+        });
+    }
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_type_names_round_trip);
+    RUN_TEST(test_idle_overlay_leaves_strip_alone);
+    RUN_TEST(test_flash_fades_out);
+    RUN_TEST(test_show_frame_survives_overlay);
+    RUN_TEST(test_pulse_peaks_twice);
+    RUN_TEST(test_progress_fills_fraction);
+    RUN_TEST(test_restart_replaces_running_overlay);
+    RUN_TEST(test_cancel_still_restores);
+    RUN_TEST(test_length_change_stops_overlay);
+    RUN_TEST(test_benchmark_overlay);
+
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
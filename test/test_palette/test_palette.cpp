@@ -2,6 +2,9 @@
 #include "support/Palette.h"
 #include "color.h"
 
+#include <cmath>
+#include <vector>
+
 void setUp() {}
 void tearDown() {}
 
@@ -74,6 +77,78 @@ void test_palette_power_interpolation() {
     TEST_ASSERT_EQUAL_UINT32(0x3F3F3F, palette.get_color(0.5f));
 }
 
+// get_color as it was computed before: a linear scan, std::pow for Power
+// points and a truncated float blend
+static Strip::Color floatColor(const std::vector<Support::ColorPoint> &points, float position) {
+    if (position <= points.front().position) {
+        return points.front().color;
+    }
+    if (position >= points.back().position) {
+        return points.back().color;
+    }
+    for (size_t i = 0; i < points.size() - 1; ++i) {
+        if (position >= points[i].position && position < points[i + 1].position) {
+            const auto &p1 = points[i];
+            const auto &p2 = points[i + 1];
+            if (p1.interpolation == Support::InterpolationType::Step) {
+                return p1.color;
+            }
+            float progress = (position - p1.position) / (p2.position - p1.position);
+            if (p1.interpolation == Support::InterpolationType::Power) {
+                progress = std::pow(progress, p1.power);
+            }
+            auto channel = [progress](Strip::ColorComponent a, Strip::ColorComponent b) {
+                return static_cast<Strip::ColorComponent>(a * (1.0f - progress) + b * progress);
+            };
+            return color(channel(red(p1.color), red(p2.color)), channel(green(p1.color), green(p2.color)),
+                         channel(blue(p1.color), blue(p2.color)));
+        }
+    }
+    return points.back().color;
+}
+
+void test_palette_matches_float_colors() {
+    std::vector<Support::ColorPoint> points = {
+        {0.0f, 0x000000},
+        {0.1f, 0xFF2000, Support::InterpolationType::Power, 2.0f},
+        {0.3f, 0x20FF40},
+        {0.45f, 0x0000FF, Support::InterpolationType::Step},
+        {0.6f, 0xFFFFFF, Support::InterpolationType::Power, 3.0f},
+        {0.8f, 0x804020},
+        {1.0f, 0x10F0E0},
+    };
+    Support::Palette palette(points);
+    int differences = 0;
+    for (int i = -10; i <= 1010; i++) {
+        float position = i / 1000.0f;
+        Strip::Color expected = floatColor(points, position);
+        Strip::Color actual = palette.get_color(position);
+        TEST_ASSERT_INT_WITHIN(1, red(expected), red(actual));
+        TEST_ASSERT_INT_WITHIN(1, green(expected), green(actual));
+        TEST_ASSERT_INT_WITHIN(1, blue(expected), blue(actual));
+        differences += expected != actual;
+    }
+    // off by one only where the float result lands right on an integer
+    TEST_ASSERT_LESS_THAN(50, differences);
+}
+
+void test_palette_bake_samples_every_entry() {
+    Support::Palette palette;
+    palette.addPoint(0.0f, 0x000000);
+    palette.addPoint(0.5f, 0xFF0000, Support::InterpolationType::Power, 2.0f);
+    palette.addPoint(1.0f, 0x00FF00);
+
+    Support::Palette::Table table = palette.bake();
+    for (size_t i = 0; i < table.size(); i++) {
+        TEST_ASSERT_EQUAL_HEX32(palette.get_color(i / 255.0f), table[i]);
+    }
+    TEST_ASSERT_EQUAL_HEX32(0x00FF00, table[255]);
+
+    // a palette that wraps around stops short of the end
+    table = palette.bake(256.0f);
+    TEST_ASSERT_EQUAL_HEX32(palette.get_color(255 / 256.0f), table[255]);
+}
+
 int main() {
     UNITY_BEGIN();
     RUN_TEST(test_palette_empty);
@@ -83,5 +158,7 @@ int main() {
     RUN_TEST(test_palette_multiple_points);
     RUN_TEST(test_palette_unsorted_points);
     RUN_TEST(test_palette_power_interpolation);
+    RUN_TEST(test_palette_matches_float_colors);
+    RUN_TEST(test_palette_bake_samples_every_entry);
     return UNITY_END();
 }
@@ -0,0 +1,202 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "show/ColorRun.h"
+#include "show/Jump.h"
+#include "show/Starlight.h"
+#include "strip/Buffer.h"
+#include "support/Particles.h"
+
+using Support::Particles;
+namespace Draw = Support::Draw;
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+static unsigned int litPixels(const Strip::Strip &strip) {
+    unsigned int lit = 0;
+    for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+        if (strip.getPixelColor(i) != 0) {
+            lit++;
+        }
+    }
+    return lit;
+}
+
+void test_spawn_stops_at_capacity() {
+    Particles particles(3);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(particles.spawn(0, 0, 0, 0xFFFFFF, 10, 0));
+    }
+    TEST_ASSERT_FALSE(particles.spawn(0, 0, 0, 0xFFFFFF, 10, 0));
+    TEST_ASSERT_EQUAL(3, particles.size());
+    TEST_ASSERT_EQUAL(3, particles.capacity());
+
+    particles.clear();
+    TEST_ASSERT_EQUAL(0, particles.size());
+    TEST_ASSERT_EQUAL(3, particles.capacity());
+}
+
+void test_motion_is_closed_form() {
+    Particles particles(1);
+    // half a pixel per frame, slowing by 1/64 pixel per frame squared
+    particles.spawn(Draw::ONE_PIXEL, Particles::ONE_PIXEL_PER_FRAME / 2, -Particles::ONE_PIXEL_PER_FRAME / 64,
+                    0xFFFFFF, 1000, 100);
+    TEST_ASSERT_EQUAL_INT32(Draw::ONE_PIXEL, particles.position(0, 100));
+    // 1 + 0.5 * 16 - 256 / 128 = 7 pixels
+    TEST_ASSERT_EQUAL_INT32(7 * Draw::ONE_PIXEL, particles.position(0, 116));
+    // back at 1 pixel after 64 frames
+    TEST_ASSERT_EQUAL_INT32(Draw::ONE_PIXEL, particles.position(0, 164));
+}
+
+void test_particles_expire_by_lifetime() {
+    Particles particles(2);
+    MockStrip strip(10);
+    particles.spawn(2 * Draw::ONE_PIXEL, 0, 0, 0xFF0000, 5, 0);
+    particles.spawn(4 * Draw::ONE_PIXEL, 0, 0, 0x00FF00, 10, 0);
+
+    particles.step(strip, 4, Particles::Edge::EXPIRE);
+    TEST_ASSERT_EQUAL(2, particles.size());
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, strip.getPixelColor(2));
+
+    strip.fill(0);
+    particles.step(strip, 5, Particles::Edge::EXPIRE);
+    TEST_ASSERT_EQUAL(1, particles.size());
+    TEST_ASSERT_EQUAL_HEX32(0x000000, strip.getPixelColor(2));
+    // the survivor moved into the freed slot and is still drawn
+    TEST_ASSERT_EQUAL_HEX32(0x00FF00, strip.getPixelColor(4));
+}
+
+void test_edges_expire_or_clamp() {
+    MockStrip strip(10);
+    Particles expiring(1);
+    expiring.spawn(9 * Draw::ONE_PIXEL, Particles::ONE_PIXEL_PER_FRAME / 2, 0, 0xFF0000, 100, 0);
+    expiring.step(strip, 1, Particles::Edge::EXPIRE);
+    TEST_ASSERT_EQUAL(1, expiring.size());
+    // half off the end is still partly drawn
+    TEST_ASSERT_TRUE(strip.getPixelColor(9) != 0);
+    expiring.step(strip, 2, Particles::Edge::EXPIRE);
+    TEST_ASSERT_EQUAL(0, expiring.size());
+
+    strip.fill(0);
+    Particles clamped(1);
+    clamped.spawn(9 * Draw::ONE_PIXEL, Particles::ONE_PIXEL_PER_FRAME, 0, 0xFF0000, 100, 0);
+    clamped.step(strip, 50, Particles::Edge::CLAMP);
+    TEST_ASSERT_EQUAL(1, clamped.size());
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, strip.getPixelColor(9));
+}
+
+void test_shade_sees_age_and_lifetime() {
+    Particles particles(1);
+    MockStrip strip(3);
+    particles.spawn(Draw::ONE_PIXEL, 0, 0, 0xFF0000, 8, 10);
+    particles.step(strip, 12, Particles::Edge::EXPIRE, [](Strip::Color color, uint32_t age, uint32_t lifetime) {
+        return Draw::scale(color, Draw::ONE_PIXEL * age / lifetime);
+    });
+    TEST_ASSERT_EQUAL_HEX32(0x3F0000, strip.getPixelColor(1));
+}
+
+void test_time_wraps_around() {
+    Particles particles(1);
+    MockStrip strip(10);
+    particles.spawn(0, Particles::ONE_PIXEL_PER_FRAME, 0, 0xFFFFFF, 10, 0xFFFFFFFE);
+    particles.step(strip, 3, Particles::Edge::EXPIRE);
+    TEST_ASSERT_EQUAL(1, particles.size());
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, strip.getPixelColor(5));
+}
+
+void test_starlight_memory_is_constant() {
+    Show::Starlight starlight(1.0f, 200, 100);
+    MockStrip strip(50);
+    unsigned int max_lit = 0;
+    for (Show::Iteration iteration = 0; iteration < 2000; iteration++) {
+        starlight.execute(strip, iteration);
+        max_lit = std::max(max_lit, litPixels(strip));
+    }
+    // a star is spawned every frame and lives 40 frames
+    TEST_ASSERT_TRUE(max_lit > 10);
+    TEST_ASSERT_TRUE(max_lit <= 50);
+}
+
+void test_color_run_dots_expire() {
+    Show::ColorRun run;
+    MockStrip strip(100);
+    for (Show::Iteration iteration = 0; iteration < 5000; iteration++) {
+        run.execute(strip, iteration);
+        TEST_ASSERT_TRUE(run.active() <= 50);
+    }
+}
+
+void test_jump_balls_land_on_the_floor() {
+    Show::Jump jump;
+    Show::Jump::Ball reference(1.0f, 0xff0000);
+    MockStrip strip(100);
+    unsigned int period_length = reference.get_period_length(100);
+
+    for (Show::Iteration iteration = 0; iteration <= period_length; iteration++) {
+        jump.execute(strip, iteration);
+    }
+    // the highest ball is back on the first pixel after one period
+    TEST_ASSERT_TRUE(strip.getPixelColor(0) != 0);
+
+    // and near the top half way through
+    strip.fill(0);
+    jump.execute(strip, period_length + period_length / 2);
+    TEST_ASSERT_TRUE(strip.getPixelColor(99) != 0 || strip.getPixelColor(98) != 0);
+}
+
+void test_benchmark_particles() {
+    for (Strip::PixelIndex length: {300, 4000}) {
+        Strip::Buffer strip(length);
+        char label[64];
+        uint32_t now = 0;
+
+        Particles particles(2000);
+        snprintf(label, sizeof(label), "2000 particles %d px", length);
+        benchmark(label, 500, 2000, [&] {
+            now++;
+            while (particles.spawn(0, (now % 50 + 10) * Particles::ONE_PIXEL_PER_FRAME / 100, 0, 0xFF8000,
+                                   100000, now)) {
+            }
+            strip.fill(0);
+            particles.step(strip, now, Particles::Edge::EXPIRE, Draw::Op::ADD);
+            benchmark_sink = particles.size();
+        });
+
+        Show::Iteration iteration = 0;
+        Show::Starlight starlight(0.5f, 2000, 500);
+        snprintf(label, sizeof(label), "Starlight %d px", length);
+        benchmark(label, 2000, length, [&] { starlight.execute(strip, iteration++); });
+
+        Show::ColorRun run;
+        snprintf(label, sizeof(label), "ColorRun %d px", length);
+        benchmark(label, 2000, length, [&] { run.execute(strip, iteration++); });
+
+        Show::Jump jump;
+        snprintf(label, sizeof(label), "Jump %d px", length);
+        benchmark(label, 2000, length, [&] { jump.execute(strip, iteration++); });
+    }
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_spawn_stops_at_capacity);
+    RUN_TEST(test_motion_is_closed_form);
+    RUN_TEST(test_particles_expire_by_lifetime);
+    RUN_TEST(test_edges_expire_or_clamp);
+    RUN_TEST(test_shade_sees_age_and_lifetime);
+    RUN_TEST(test_time_wraps_around);
+    RUN_TEST(test_starlight_memory_is_constant);
+    RUN_TEST(test_color_run_dots_expire);
+    RUN_TEST(test_jump_balls_land_on_the_floor);
+
+    RUN_TEST(test_benchmark_particles);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
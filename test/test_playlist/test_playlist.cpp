@@ -0,0 +1,188 @@
+#include "unity.h"
+#include "support/Playlist.h"
+
+#include <algorithm>
+#include <vector>
+
+using Support::Playlist;
+
+static std::vector<Playlist::Entry> entries(size_t count, uint32_t duration_ms = 1000) {
+    std::vector<Playlist::Entry> list;
+    for (size_t i = 0; i < count; i++) {
+        list.push_back({static_cast<uint8_t>(i), duration_ms});
+    }
+    return list;
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_first_entry_is_due_immediately() {
+    Playlist playlist(1);
+    playlist.start(entries(3), false, 500);
+
+    TEST_ASSERT_TRUE(playlist.isActive());
+    TEST_ASSERT_TRUE(playlist.isDue(500));
+    TEST_ASSERT_EQUAL(3, playlist.position());
+    TEST_ASSERT_EQUAL(0, playlist.upcoming().preset);
+
+    playlist.next(500);
+    TEST_ASSERT_EQUAL(0, playlist.position());
+    TEST_ASSERT_EQUAL(0, playlist.current().preset);
+    TEST_ASSERT_FALSE(playlist.isDue(500));
+}
+
+void test_entries_play_their_duration() {
+    Playlist playlist(1);
+    std::vector<Playlist::Entry> list = {{4, 1000}, {2, 3000}};
+    playlist.start(list, false, 0);
+    playlist.next(0);
+
+    TEST_ASSERT_EQUAL(1000, playlist.remaining(0));
+    TEST_ASSERT_EQUAL(400, playlist.remaining(600));
+    TEST_ASSERT_FALSE(playlist.isDue(999));
+    TEST_ASSERT_TRUE(playlist.isDue(1000));
+
+    playlist.next(1010);
+    TEST_ASSERT_EQUAL(2, playlist.current().preset);
+    TEST_ASSERT_EQUAL(3000, playlist.remaining(1010));
+    TEST_ASSERT_TRUE(playlist.isDue(4010));
+}
+
+void test_in_order_playback_wraps() {
+    Playlist playlist(1);
+    playlist.start(entries(3), false, 0);
+
+    std::vector<uint8_t> played;
+    for (int i = 0; i < 7; i++) {
+        uint8_t expected = playlist.upcoming().preset;
+        playlist.next(i * 1000);
+        TEST_ASSERT_EQUAL(expected, playlist.current().preset);
+        played.push_back(playlist.current().preset);
+    }
+    std::vector<uint8_t> expected = {0, 1, 2, 0, 1, 2, 0};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.data(), played.data(), expected.size());
+}
+
+void test_previous_wraps_within_pass() {
+    Playlist playlist(1);
+    playlist.start(entries(3), false, 0);
+    playlist.next(0);
+
+    TEST_ASSERT_EQUAL(2, playlist.preceding().preset);
+    playlist.previous(100);
+    TEST_ASSERT_EQUAL(2, playlist.current().preset);
+    TEST_ASSERT_EQUAL(2, playlist.position());
+    TEST_ASSERT_EQUAL(1000, playlist.remaining(100));
+
+    playlist.previous(200);
+    TEST_ASSERT_EQUAL(1, playlist.current().preset);
+}
+
+void test_shuffle_plays_every_entry_once_per_pass() {
+    Playlist playlist(42);
+    playlist.start(entries(8), true, 0);
+
+    for (int pass = 0; pass < 20; pass++) {
+        std::vector<uint8_t> played;
+        for (int i = 0; i < 8; i++) {
+            playlist.next(0);
+            played.push_back(playlist.current().preset);
+        }
+        std::sort(played.begin(), played.end());
+        for (uint8_t i = 0; i < 8; i++) {
+            TEST_ASSERT_EQUAL(i, played[i]);
+        }
+    }
+}
+
+void test_shuffle_never_repeats_across_passes() {
+    Playlist playlist(7);
+    playlist.start(entries(3), true, 0);
+    playlist.next(0);
+
+    bool reordered = false;
+    std::vector<uint8_t> first_pass;
+    for (int i = 0; i < 300; i++) {
+        uint8_t before = playlist.current().preset;
+        uint8_t upcoming = playlist.upcoming().preset;
+        playlist.next(0);
+        TEST_ASSERT_EQUAL(upcoming, playlist.current().preset);
+        TEST_ASSERT_NOT_EQUAL(before, playlist.current().preset);
+        if (i < 3) {
+            first_pass.push_back(before);
+        } else if (playlist.position() == 0 && playlist.current().preset != first_pass[0]) {
+            reordered = true;
+        }
+    }
+    TEST_ASSERT_TRUE(reordered);
+}
+
+void test_single_entry_shuffle() {
+    Playlist playlist(3);
+    playlist.start(entries(1), true, 0);
+    for (int i = 0; i < 3; i++) {
+        playlist.next(i * 1000);
+        TEST_ASSERT_EQUAL(0, playlist.current().preset);
+        TEST_ASSERT_EQUAL(0, playlist.upcoming().preset);
+    }
+}
+
+void test_remaining_survives_clock_wrap() {
+    Playlist playlist(1);
+    playlist.start(entries(2, 1000), false, 0);
+    playlist.next(UINT32_MAX - 499);
+
+    TEST_ASSERT_EQUAL(500, playlist.remaining(0));
+    TEST_ASSERT_FALSE(playlist.isDue(499));
+    TEST_ASSERT_TRUE(playlist.isDue(500));
+}
+
+void test_stop_and_empty_start() {
+    Playlist playlist(1);
+    playlist.start(entries(2), false, 0);
+    playlist.next(0);
+    playlist.stop();
+
+    TEST_ASSERT_FALSE(playlist.isActive());
+    TEST_ASSERT_FALSE(playlist.isDue(5000));
+    playlist.next(0); // ignored
+
+    playlist.start({}, true, 0);
+    TEST_ASSERT_FALSE(playlist.isActive());
+    TEST_ASSERT_EQUAL(0, playlist.position());
+}
+
+void test_restart_begins_from_the_top() {
+    Playlist playlist(1);
+    playlist.start(entries(3), false, 0);
+    playlist.next(0);
+    playlist.next(1000);
+    TEST_ASSERT_EQUAL(1, playlist.current().preset);
+
+    playlist.start(entries(3), false, 2000);
+    TEST_ASSERT_TRUE(playlist.isDue(2000));
+    TEST_ASSERT_EQUAL(0, playlist.upcoming().preset);
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_entry_is_due_immediately);
+    RUN_TEST(test_entries_play_their_duration);
+    RUN_TEST(test_in_order_playback_wraps);
+    RUN_TEST(test_previous_wraps_within_pass);
+    RUN_TEST(test_shuffle_plays_every_entry_once_per_pass);
+    RUN_TEST(test_shuffle_never_repeats_across_passes);
+    RUN_TEST(test_single_entry_shuffle);
+    RUN_TEST(test_remaining_survives_clock_wrap);
+    RUN_TEST(test_stop_and_empty_start);
+    RUN_TEST(test_restart_begins_from_the_top);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
@@ -0,0 +1,224 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "ShowFactory.h"
+#include "show/PostProcessed.h"
+#include "support/PostProcess.h"
+
+#include <vector>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+namespace Post = Support::PostProcess;
+
+// Lights a single pixel that moves by one every frame
+class DotShow : public Show::Show {
+    Strip::Color dot_color;
+
+public:
+    explicit DotShow(Strip::Color dot_color) : dot_color(dot_color) {
+    }
+
+    void execute(Strip::Strip &strip, ::Show::Iteration iteration) override {
+        strip.fill(0x000000);
+        strip.setPixelColor(iteration % strip.length(), dot_color);
+    }
+};
+
+// Draws once and then relies on the strip keeping its pixels
+class StaticShow : public Show::Show {
+    bool drawn = false;
+
+public:
+    void execute(Strip::Strip &strip, ::Show::Iteration iteration) override {
+        if (!drawn) {
+            strip.fill(0x804020);
+            drawn = true;
+        }
+    }
+
+    bool isComplete() const override { return drawn; }
+};
+
+void test_scale_per_channel() {
+    TEST_ASSERT_EQUAL_HEX32(0x7F7F7F, Post::scale(0xFFFFFF, 128));
+    TEST_ASSERT_EQUAL_HEX32(0x000000, Post::scale(0xFFFFFF, 0));
+    TEST_ASSERT_EQUAL_HEX32(0x400000, Post::scale(0x800000, 128));
+    TEST_ASSERT_EQUAL_HEX32(0x000001, Post::scale(0x000002, 128));
+}
+
+void test_fade_reaches_black() {
+    Strip::Color pixels[3] = {0xFFFFFF, 0x010203, 0x000000};
+    for (int i = 0; i < 64; i++) {
+        Post::fade(pixels, 3, 200);
+    }
+    TEST_ASSERT_EQUAL_HEX32(0, pixels[0]);
+    TEST_ASSERT_EQUAL_HEX32(0, pixels[1]);
+}
+
+void test_trail_keeps_brighter_channel() {
+    Strip::Color frame[2] = {0x00FF00, 0x000000};
+    Strip::Color history[2] = {0xFF0000, 0x800080};
+    Post::trail(frame, history, 2, 128);
+    TEST_ASSERT_EQUAL_HEX32(0x7FFF00, history[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x400040, history[1]);
+}
+
+void test_decay_moves_towards_frame() {
+    Strip::Color frame[1] = {0xFFFFFF};
+    Strip::Color history[1] = {0x000000};
+    Post::decay(frame, history, 1, 128);
+    TEST_ASSERT_EQUAL_HEX32(0x808080, history[0]);
+    for (int i = 0; i < 32; i++) {
+        Post::decay(frame, history, 1, 128);
+    }
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, history[0]);
+}
+
+void test_gaussian_blur_spreads_single_pixel() {
+    Strip::Color pixels[5] = {0, 0, 0xFCFCFC, 0, 0};
+    Post::blur(pixels, 5, Post::Kernel::GAUSSIAN);
+    TEST_ASSERT_EQUAL_HEX32(0x000000, pixels[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x3F3F3F, pixels[1]);
+    TEST_ASSERT_EQUAL_HEX32(0x7E7E7E, pixels[2]);
+    TEST_ASSERT_EQUAL_HEX32(0x3F3F3F, pixels[3]);
+    TEST_ASSERT_EQUAL_HEX32(0x000000, pixels[4]);
+}
+
+void test_box_blur_spreads_single_pixel() {
+    Strip::Color pixels[4] = {0, 0x0000FF, 0, 0};
+    Post::blur(pixels, 4, Post::Kernel::BOX);
+    TEST_ASSERT_EQUAL_HEX32(0x000055, pixels[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x000055, pixels[1]);
+    TEST_ASSERT_EQUAL_HEX32(0x000055, pixels[2]);
+    TEST_ASSERT_EQUAL_HEX32(0x000000, pixels[3]);
+}
+
+void test_blur_keeps_flat_color() {
+    std::vector<Strip::Color> pixels(10, 0xFF8001);
+    Post::blur(pixels.data(), pixels.size(), Post::Kernel::GAUSSIAN);
+    for (auto pixel: pixels) {
+        TEST_ASSERT_EQUAL_HEX32(0xFF8001, pixel);
+    }
+}
+
+void test_blur_lanes_do_not_bleed() {
+    Strip::Color pixels[3] = {0xFF00FF, 0xFF00FF, 0xFF00FF};
+    Post::blur(pixels, 3, Post::Kernel::BOX);
+    TEST_ASSERT_EQUAL_HEX32(0, pixels[1] & 0x00FF00);
+}
+
+void test_trail_leaves_fading_tail() {
+    Show::PostProcessed::Settings settings;
+    settings.trail = 128;
+    Show::PostProcessed show(std::make_unique<DotShow>(0xFF0000), settings);
+    MockStrip strip(10);
+
+    for (Show::Iteration iteration = 0; iteration < 4; iteration++) {
+        show.execute(strip, iteration);
+    }
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, strip.getPixelColor(3));
+    TEST_ASSERT_EQUAL_HEX32(0x7F0000, strip.getPixelColor(2));
+    TEST_ASSERT_EQUAL_HEX32(0x3F0000, strip.getPixelColor(1));
+    TEST_ASSERT_EQUAL_HEX32(0x000000, strip.getPixelColor(5));
+}
+
+void test_static_show_settles() {
+    Show::PostProcessed::Settings settings;
+    settings.decay = 128;
+    Show::PostProcessed show(std::make_unique<StaticShow>(), settings);
+    MockStrip strip(4);
+
+    show.execute(strip, 0);
+    TEST_ASSERT_FALSE(show.isComplete());
+    for (Show::Iteration iteration = 1; iteration < 40 && !show.isComplete(); iteration++) {
+        show.execute(strip, iteration);
+    }
+    TEST_ASSERT_TRUE(show.isComplete());
+    TEST_ASSERT_EQUAL_HEX32(0x804020, strip.getPixelColor(2));
+}
+
+void test_factory_wraps_post_params() {
+    ShowFactory factory;
+    auto show = factory.createShow("Solid", R"({"colors":[[0,0,255]],"post":{"trail":0.5}})");
+    TEST_ASSERT_NOT_NULL(dynamic_cast<Show::PostProcessed *>(show.get()));
+
+    show = factory.createShow("Solid", R"({"colors":[[0,0,255]],"post":{}})");
+    TEST_ASSERT_NULL(dynamic_cast<Show::PostProcessed *>(show.get()));
+
+    show = factory.createShow("Solid", R"({"colors":[[0,0,255]]})");
+    TEST_ASSERT_NULL(dynamic_cast<Show::PostProcessed *>(show.get()));
+}
+
+void test_benchmark_kernels() {
+    for (size_t length: {300, 1000}) {
+        std::vector<Strip::Color> frame(length), history(length);
+        for (size_t i = 0; i < length; i++) {
+            frame[i] = wheel(i % 255);
+            history[i] = wheel((i * 3) % 255);
+        }
+        char label[48];
+
+        snprintf(label, sizeof(label), "fade %zu px", length);
+        benchmark(label, 2000, length, [&] {
+            Post::fade(history.data(), length, 250);
+            benchmark_sink = history[length / 2];
+        });
+        snprintf(label, sizeof(label), "trail %zu px", length);
+        benchmark(label, 2000, length, [&] {
+            Post::trail(frame.data(), history.data(), length, 200);
+            benchmark_sink = history[length / 2];
+        });
+        // alternate targets so decay never settles and skips pixels
+        std::vector<Strip::Color> inverted(length);
+        for (size_t i = 0; i < length; i++) {
+            inverted[i] = frame[i] ^ 0xFFFFFF;
+        }
+        bool flip = false;
+        snprintf(label, sizeof(label), "decay %zu px", length);
+        benchmark(label, 2000, length, [&] {
+            flip = !flip;
+            Post::decay(flip ? frame.data() : inverted.data(), history.data(), length, 200);
+            benchmark_sink = history[length / 2];
+        });
+        snprintf(label, sizeof(label), "gaussian blur %zu px", length);
+        benchmark(label, 2000, length, [&] {
+            Post::blur(history.data(), length, Post::Kernel::GAUSSIAN);
+            benchmark_sink = history[length / 2];
+        });
+        snprintf(label, sizeof(label), "box blur %zu px", length);
+        benchmark(label, 2000, length, [&] {
+            Post::blur(history.data(), length, Post::Kernel::BOX);
+            benchmark_sink = history[length / 2];
+        });
+    }
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_scale_per_channel);
+    RUN_TEST(test_fade_reaches_black);
+    RUN_TEST(test_trail_keeps_brighter_channel);
+    RUN_TEST(test_decay_moves_towards_frame);
+    RUN_TEST(test_gaussian_blur_spreads_single_pixel);
+    RUN_TEST(test_box_blur_spreads_single_pixel);
+    RUN_TEST(test_blur_keeps_flat_color);
+    RUN_TEST(test_blur_lanes_do_not_bleed);
+
+    RUN_TEST(test_trail_leaves_fading_tail);
+    RUN_TEST(test_static_show_settles);
+    RUN_TEST(test_factory_wraps_post_params);
+
+    RUN_TEST(test_benchmark_kernels);
+
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
@@ -0,0 +1,230 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "show/ColorRun.h"
+#include "show/Fire.h"
+#include "show/Starlight.h"
+#include "support/Random.h"
+
+#include <functional>
+#include <random>
+#include <vector>
+
+using Support::Random;
+
+static constexpr size_t SAMPLES = 1 << 18;
+
+// Pearson's chi-square statistic of bucket counts against a uniform spread
+static double chiSquare(const std::vector<size_t> &counts, size_t total) {
+    double expected = static_cast<double>(total) / counts.size();
+    double sum = 0.0;
+    for (size_t count: counts) {
+        double difference = static_cast<double>(count) - expected;
+        sum += difference * difference / expected;
+    }
+    return sum;
+}
+
+// Compares every pixel of two shows over a number of frames
+static bool renderSame(Show::Show &a, Show::Show &b, Strip::PixelIndex length, Show::Iteration frames) {
+    MockStrip first(length);
+    MockStrip second(length);
+    for (Show::Iteration i = 0; i < frames; i++) {
+        a.execute(first, i);
+        b.execute(second, i);
+        for (Strip::PixelIndex p = 0; p < length; p++) {
+            if (first.getPixelColor(p) != second.getPixelColor(p)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_matches_the_pcg32_reference() {
+    // first outputs of the PCG32 demo program (seed 42, stream 54)
+    Random gen(42, 54);
+    const uint32_t expected[] = {0xa15c02b7, 0x7b47f409, 0xba1d3330, 0x83d2f293, 0xbfa4784b, 0xcbed606e};
+    for (uint32_t value: expected) {
+        TEST_ASSERT_EQUAL_HEX32(value, gen());
+    }
+}
+
+void test_seeds_and_streams() {
+    Random a(7);
+    Random b(7);
+    Random other_seed(8);
+    Random other_stream(7, 1);
+    int same_seed = 0;
+    int same_other_seed = 0;
+    int same_other_stream = 0;
+    for (int i = 0; i < 1000; i++) {
+        uint32_t value = a();
+        same_seed += value == b();
+        same_other_seed += value == other_seed();
+        same_other_stream += value == other_stream();
+    }
+    TEST_ASSERT_EQUAL(1000, same_seed);
+    TEST_ASSERT_LESS_OR_EQUAL(1, same_other_seed);
+    TEST_ASSERT_LESS_OR_EQUAL(1, same_other_stream);
+
+    // seeding again starts over
+    a.seed(7);
+    b.seed(7);
+    uint32_t first = b();
+    TEST_ASSERT_EQUAL_HEX32(first, a());
+}
+
+void test_floats_are_uniform_in_unit_interval() {
+    Random gen(1);
+    std::vector<size_t> buckets(64, 0);
+    double sum = 0.0;
+    for (size_t i = 0; i < SAMPLES; i++) {
+        float value = gen.nextFloat();
+        TEST_ASSERT_TRUE(value >= 0.0f && value < 1.0f);
+        sum += value;
+        buckets[static_cast<size_t>(value * buckets.size())]++;
+    }
+    TEST_ASSERT_DOUBLE_WITHIN(0.005, 0.5, sum / SAMPLES);
+    // 63 degrees of freedom: 103.4 is the 0.1 % critical value
+    TEST_ASSERT_TRUE_MESSAGE(chiSquare(buckets, SAMPLES) < 103.4, "floats are not uniform");
+}
+
+void test_bits_are_balanced() {
+    Random gen(2);
+    size_t ones[32] = {};
+    for (size_t i = 0; i < SAMPLES; i++) {
+        uint32_t value = gen();
+        for (int bit = 0; bit < 32; bit++) {
+            ones[bit] += (value >> bit) & 1;
+        }
+    }
+    for (size_t count: ones) {
+        // five standard deviations of a fair coin
+        TEST_ASSERT_UINT32_WITHIN(5 * 256, SAMPLES / 2, count);
+    }
+}
+
+void test_successive_values_are_uncorrelated() {
+    Random gen(3);
+    double previous = gen.nextFloat() - 0.5;
+    double product = 0.0;
+    double square = 0.0;
+    for (size_t i = 0; i < SAMPLES; i++) {
+        double value = gen.nextFloat() - 0.5;
+        product += previous * value;
+        square += value * value;
+        previous = value;
+    }
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, 0.0, product / square);
+}
+
+void test_below_is_unbiased_and_in_range() {
+    Random gen(4);
+    TEST_ASSERT_EQUAL(0, gen.below(1));
+    for (uint32_t bound: {3u, 7u, 100u}) {
+        std::vector<size_t> counts(bound, 0);
+        for (size_t i = 0; i < SAMPLES; i++) {
+            uint32_t value = gen.below(bound);
+            TEST_ASSERT_LESS_THAN(bound, value);
+            counts[value]++;
+        }
+        // at most 99 degrees of freedom: 148.2 is the 0.1 % critical value
+        TEST_ASSERT_TRUE_MESSAGE(chiSquare(counts, SAMPLES) < 148.2, "below() is biased");
+    }
+}
+
+void test_fill_continues_the_sequence() {
+    Random scalar(5);
+    Random bulk(5);
+    uint32_t words[37];
+    float floats[41];
+    bulk.fill(words, 37);
+    bulk.fill(floats, 41);
+    for (uint32_t word: words) {
+        uint32_t expected = scalar();
+        TEST_ASSERT_EQUAL_HEX32(expected, word);
+    }
+    for (float value: floats) {
+        float expected = scalar.nextFloat();
+        TEST_ASSERT_EQUAL_FLOAT(expected, value);
+    }
+    uint32_t expected = scalar();
+    TEST_ASSERT_EQUAL_HEX32(expected, bulk());
+}
+
+void test_shows_replay_from_a_seed() {
+    Show::Fire fire(0.1f, 10.0f, 0.5f, 0.5f, {1.0f}, 5, 5, Show::Fire::Fuel::WOOD, {0}, 9);
+    Show::Fire same_fire(0.1f, 10.0f, 0.5f, 0.5f, {1.0f}, 5, 5, Show::Fire::Fuel::WOOD, {0}, 9);
+    Show::Fire other_fire(0.1f, 10.0f, 0.5f, 0.5f, {1.0f}, 5, 5, Show::Fire::Fuel::WOOD, {0}, 10);
+    TEST_ASSERT_TRUE(renderSame(fire, same_fire, 60, 200));
+    TEST_ASSERT_FALSE(renderSame(same_fire, other_fire, 60, 200));
+
+    Show::ColorRun run(9);
+    Show::ColorRun same_run(9);
+    TEST_ASSERT_TRUE(renderSame(run, same_run, 60, 500));
+
+    Show::Starlight stars(0.2f, 100, 50, 255, 180, 50, 9);
+    Show::Starlight same_stars(0.2f, 100, 50, 255, 180, 50, 9);
+    TEST_ASSERT_TRUE(renderSame(stars, same_stars, 60, 500));
+}
+
+void test_benchmark_random() {
+    const unsigned count = 310; // a 300 LED fire: 305 spread values plus 5 spark rolls
+    std::vector<float> noise(count);
+
+    // the previous Fire path: a std::function around a distribution over minstd_rand
+    std::minstd_rand engine(1);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::function<float()> randomFloat = [&] { return distribution(engine); };
+    benchmark("std::function + uniform_real_distribution", 2000, count, [&] {
+        for (float &value: noise) {
+            value = randomFloat();
+        }
+        benchmark_sink = static_cast<uint32_t>(noise[0] * 1000.0f);
+    });
+
+    Random gen(1);
+    benchmark("Random::nextFloat", 2000, count, [&] {
+        for (float &value: noise) {
+            value = gen.nextFloat();
+        }
+        benchmark_sink = static_cast<uint32_t>(noise[0] * 1000.0f);
+    });
+    benchmark("Random::fill", 2000, count, [&] {
+        gen.fill(noise.data(), noise.size());
+        benchmark_sink = static_cast<uint32_t>(noise[0] * 1000.0f);
+    });
+
+    Show::Fire fire(0.1f, 10.0f, 0.5f, 0.5f, {1.0f}, 5, 5, Show::Fire::Fuel::WOOD, {0}, 1);
+    MockStrip strip(300);
+    Show::Iteration iteration = 0;
+    benchmark("Fire frame", 2000, 300, [&] {
+        fire.execute(strip, iteration++);
+        benchmark_sink = strip.getPixelColor(0);
+    });
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_matches_the_pcg32_reference);
+    RUN_TEST(test_seeds_and_streams);
+    RUN_TEST(test_floats_are_uniform_in_unit_interval);
+    RUN_TEST(test_bits_are_balanced);
+    RUN_TEST(test_successive_values_are_uncorrelated);
+    RUN_TEST(test_below_is_unbiased_and_in_range);
+    RUN_TEST(test_fill_continues_the_sequence);
+    RUN_TEST(test_shows_replay_from_a_seed);
+    RUN_TEST(test_benchmark_random);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
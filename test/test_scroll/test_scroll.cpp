@@ -0,0 +1,195 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "show/MorseCode.h"
+#include "show/Rainbow.h"
+#include "show/TheaterChase.h"
+#include "strip/Buffer.h"
+#include "support/Blend.h"
+#include "support/Scroll.h"
+
+#include <cmath>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+using Support::Scroll::RingPattern;
+using Support::Scroll::RunPattern;
+using Support::Scroll::Scroller;
+
+void test_ring_pattern_wraps() {
+    RingPattern pattern(3);
+    pattern.set(0, 0x01);
+    pattern.set(1, 0x02);
+    pattern.set(2, 0x03);
+
+    Strip::Color out[8];
+    pattern.render(2, out, 8);
+    const Strip::Color expected[8] = {0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01};
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(expected, out, 8);
+
+    pattern.render(1, out, 1);
+    TEST_ASSERT_EQUAL_HEX32(0x02, out[0]);
+}
+
+void test_run_pattern_merges_and_wraps() {
+    RunPattern pattern;
+    uint8_t red = pattern.addColor(0xFF0000);
+    uint8_t black = pattern.addColor(0x000000);
+    TEST_ASSERT_EQUAL(red, pattern.addColor(0xFF0000));
+
+    pattern.append(red, 2);
+    pattern.append(black, 1);
+    pattern.append(black, 2);
+    pattern.append(red, 1);
+    TEST_ASSERT_EQUAL(3, pattern.runCount());
+    TEST_ASSERT_EQUAL(6, pattern.length());
+
+    Strip::Color out[9];
+    pattern.render(4, out, 9);
+    const Strip::Color expected[9] = {0, 0xFF0000, 0xFF0000, 0xFF0000, 0, 0, 0, 0xFF0000, 0xFF0000};
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(expected, out, 9);
+
+    // going back resets the cached run
+    pattern.render(0, out, 3);
+    const Strip::Color start[3] = {0xFF0000, 0xFF0000, 0};
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(start, out, 3);
+}
+
+void test_scroller_fractional_offset_mixes_neighbours() {
+    RingPattern pattern(4);
+    pattern.set(1, 0xFFFFFF);
+    Scroller scroller;
+    MockStrip strip(4);
+
+    scroller.emit(strip, pattern, 1 * 256);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, strip.getPixelColor(0));
+    TEST_ASSERT_EQUAL_HEX32(0x000000, strip.getPixelColor(1));
+
+    scroller.emit(strip, pattern, 256 + 64);
+    TEST_ASSERT_EQUAL_HEX32(Support::Blend::mix(0xFFFFFF, 0, 64), strip.getPixelColor(0));
+
+    // offsets beyond the pattern wrap, including the last pixel's neighbour
+    scroller.emit(strip, pattern, 5 * 4 * 256 + 3 * 256 + 128);
+    TEST_ASSERT_EQUAL_HEX32(Support::Blend::mix(0, 0, 128), strip.getPixelColor(0));
+    TEST_ASSERT_EQUAL_HEX32(Support::Blend::mix(0, 0xFFFFFF, 128), strip.getPixelColor(1));
+}
+
+void test_rainbow_matches_float_hues() {
+    // for steps in 1/256 the fixed-point hues equal the former float arithmetic
+    for (auto steps: {std::make_pair(1.0f, 1.0f), std::make_pair(0.5f, 2.0f), std::make_pair(3.0f, 0.25f)}) {
+        Show::Rainbow rainbow(steps.first, steps.second);
+        MockStrip strip(120);
+        for (Show::Iteration iteration = 0; iteration < 600; iteration += 37) {
+            rainbow.execute(strip, iteration);
+            for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+                float hue = static_cast<float>(iteration) * steps.first + static_cast<float>(i) * steps.second;
+                TEST_ASSERT_EQUAL_HEX32(wheel(static_cast<uint8_t>(fmodf(hue, 255.0f))), strip.getPixelColor(i));
+            }
+        }
+    }
+}
+
+void test_wheel_table_matches_wheel() {
+    for (unsigned int position = 0; position < 256; position++) {
+        TEST_ASSERT_EQUAL_HEX32(wheel(position), WHEEL_TABLE[position]);
+    }
+}
+
+void test_theater_chase_segments() {
+    Show::TheaterChase chase(21);
+    MockStrip strip(30);
+    for (unsigned int index = 0; index < 30; index++) {
+        chase.execute(strip, index);
+        for (Strip::PixelIndex i = 0; i < strip.length(); i++) {
+            bool dark = (i + index) % 7 < 2;
+            TEST_ASSERT_EQUAL(dark, strip.getPixelColor(i) == 0);
+        }
+    }
+}
+
+void test_morse_code_layout() {
+    // E = ".", T = "-": dot, letter space, dash
+    Show::MorseCode morse("ET", 1.0f, 1, 3, 2, 3, 5);
+    MockStrip strip(9);
+    morse.execute(strip, 0);
+    const bool lit[9] = {true, false, false, false, true, true, true, true, false};
+    for (Strip::PixelIndex i = 0; i < 9; i++) {
+        TEST_ASSERT_EQUAL(lit[i], strip.getPixelColor(i) != 0);
+    }
+
+    // next frame scrolls one LED
+    morse.execute(strip, 1);
+    TEST_ASSERT_EQUAL_HEX32(0, strip.getPixelColor(0));
+    TEST_ASSERT_TRUE(strip.getPixelColor(3) != 0);
+}
+
+void test_morse_code_half_speed_interpolates() {
+    Show::MorseCode morse("E", 0.5f, 1, 3, 2, 3, 5);
+    MockStrip strip(1);
+    morse.execute(strip, 0);
+    Strip::Color full = strip.getPixelColor(0);
+    morse.execute(strip, 1);
+    // a one-LED pattern is the same at every offset
+    TEST_ASSERT_EQUAL_HEX32(full, strip.getPixelColor(0));
+}
+
+void test_benchmark_scrolling_shows() {
+    for (Strip::PixelIndex length: {300, 1000}) {
+        Strip::Buffer strip(length);
+        char label[64];
+        Show::Iteration iteration = 0;
+
+        Show::Rainbow rainbow;
+        snprintf(label, sizeof(label), "Rainbow %d px", length);
+        benchmark(label, 1000, length, [&] {
+            rainbow.execute(strip, iteration++);
+            benchmark_sink = strip.getPixelColor(length / 2);
+        });
+
+        Show::Rainbow slow_rainbow(0.3f, 0.7f);
+        snprintf(label, sizeof(label), "Rainbow 0.3/0.7 %d px", length);
+        benchmark(label, 1000, length, [&] {
+            slow_rainbow.execute(strip, iteration++);
+            benchmark_sink = strip.getPixelColor(length / 2);
+        });
+
+        Show::TheaterChase chase;
+        snprintf(label, sizeof(label), "TheaterChase %d px", length);
+        benchmark(label, 1000, length, [&] {
+            chase.execute(strip, iteration++);
+            benchmark_sink = strip.getPixelColor(length / 2);
+        });
+
+        Show::MorseCode morse("THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG", 0.5f);
+        snprintf(label, sizeof(label), "MorseCode %d px", length);
+        benchmark(label, 1000, length, [&] {
+            morse.execute(strip, iteration++);
+            benchmark_sink = strip.getPixelColor(length / 2);
+        });
+    }
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ring_pattern_wraps);
+    RUN_TEST(test_run_pattern_merges_and_wraps);
+    RUN_TEST(test_scroller_fractional_offset_mixes_neighbours);
+    RUN_TEST(test_rainbow_matches_float_hues);
+    RUN_TEST(test_wheel_table_matches_wheel);
+    RUN_TEST(test_theater_chase_segments);
+    RUN_TEST(test_morse_code_layout);
+    RUN_TEST(test_morse_code_half_speed_interpolates);
+
+    RUN_TEST(test_benchmark_scrolling_shows);
+
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
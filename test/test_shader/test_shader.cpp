@@ -0,0 +1,224 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "color.h"
+#include "strip/Buffer.h"
+#include "support/Shader.h"
+
+#include <cmath>
+
+using Support::Shader::Error;
+using Support::Shader::ONE;
+using Support::Shader::Program;
+using Support::Shader::Variable;
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+static Program compiled(const char *source, const std::vector<Variable> &variables = {}) {
+    Program program;
+    Error error;
+    bool ok = program.compile(source, variables, error);
+    TEST_ASSERT_TRUE_MESSAGE(ok, error.message.c_str());
+    return program;
+}
+
+// Color of one pixel of a 100 pixel strip at a frame
+static Strip::Color colorAt(Program &program, Strip::PixelIndex index, uint32_t frame = 0) {
+    program.beginFrame(frame, 100);
+    return program.pixel(index);
+}
+
+void test_arithmetic_and_gray_output() {
+    Program program = compiled("(1 + 2 * 3 - 6) / 2");
+    TEST_ASSERT_EQUAL_HEX32(0x808080, colorAt(program, 0));
+    TEST_ASSERT_TRUE(program.isUniform());
+    TEST_ASSERT_FALSE(program.isAnimated());
+    // folded away entirely
+    TEST_ASSERT_EQUAL(0, program.frameInstructions() + program.pixelInstructions());
+}
+
+void test_builtins_per_pixel() {
+    Program program = compiled("rgb(x, i / 255, n / 255)");
+    TEST_ASSERT_EQUAL_HEX32(0x000064, colorAt(program, 0));
+    TEST_ASSERT_EQUAL_HEX32(0x803264, colorAt(program, 50));
+}
+
+void test_statements_and_comments() {
+    Program program = compiled(
+        "// red ramp\n"
+        "level = x * 2;\n"
+        "level = min(level, 1);  // saturate\n"
+        "rgb(level, 0, 0);");
+    TEST_ASSERT_EQUAL_HEX32(0x660000, colorAt(program, 20));
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, colorAt(program, 80));
+}
+
+void test_variables_are_folded() {
+    Program program = compiled("rgb(level * 2, 0, 0)", {{"level", 0.25f}});
+    TEST_ASSERT_EQUAL_HEX32(0x800000, colorAt(program, 0));
+    TEST_ASSERT_EQUAL(0, program.frameInstructions() + program.pixelInstructions());
+}
+
+void test_frame_constants_are_hoisted() {
+    // the wheel color only depends on the frame, the select and scale on the pixel
+    Program program = compiled("wheel(t / 10) * (x < 0.5 ? 1 : 0.5)");
+    TEST_ASSERT_TRUE(program.isAnimated());
+    TEST_ASSERT_EQUAL(2, program.frameInstructions());
+    TEST_ASSERT_EQUAL(3, program.pixelInstructions());
+}
+
+void test_comparison_and_select() {
+    Program program = compiled("i % 3 == 0 ? rgb(1, 0, 0) : rgb(0, 0, 1)");
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, colorAt(program, 3));
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, colorAt(program, 4));
+}
+
+void test_division_by_zero_is_zero() {
+    Program program = compiled("rgb(1 / (x - x), 0.5 % 0, 0)");
+    TEST_ASSERT_EQUAL_HEX32(0x000000, colorAt(program, 10));
+}
+
+void test_sin_matches_libm() {
+    Program program = compiled("(sin(x * 6.2831853) + 1) / 2");
+    for (Strip::PixelIndex i = 0; i < 100; i += 7) {
+        double expected = (std::sin(i * 2 * M_PI / 100) + 1) / 2 * 255;
+        TEST_ASSERT_INT_WITHIN(2, static_cast<int>(std::lround(expected)), colorAt(program, i) & 0xFF);
+    }
+}
+
+void test_wheel_hsv_and_palette() {
+    Program wheel_program = compiled("wheel(0.5)");
+    TEST_ASSERT_EQUAL_HEX32(WHEEL_TABLE[127], colorAt(wheel_program, 0));
+
+    Program hsv_program = compiled("hsv(1 / 3, 1, 1)");
+    TEST_ASSERT_EQUAL_HEX32(0x00FF00, colorAt(hsv_program, 0));
+
+    Program palette_program;
+    palette_program.setPalette({0x000000, 0xFF0000});
+    Error error;
+    TEST_ASSERT_TRUE(palette_program.compile("palette(x)", {}, error));
+    TEST_ASSERT_EQUAL_HEX32(0x000000, colorAt(palette_program, 0));
+    TEST_ASSERT_UINT32_WITHIN(0x020000, 0x800000, colorAt(palette_program, 50));
+}
+
+void test_color_operators() {
+    Program program = compiled("rgb(1, 0, 0) * 0.5 + mix(rgb(0, 0, 0), rgb(0, 1, 0), 0.5)");
+    TEST_ASSERT_UINT32_WITHIN(0x010101, 0x808000, colorAt(program, 0));
+}
+
+void test_noise_is_smooth_and_bounded() {
+    // a lattice cell every 25 pixels, smoothstep is at most 1.5 times as steep as linear
+    Program program = compiled("noise(x * 4, t)");
+    int previous = colorAt(program, 0) & 0xFF;
+    for (Strip::PixelIndex i = 1; i < 100; i++) {
+        int level = colorAt(program, i) & 0xFF;
+        TEST_ASSERT_INT_WITHIN(16, previous, level);
+        previous = level;
+    }
+}
+
+void test_compile_errors_report_positions() {
+    struct Case {
+        const char *source;
+        const char *message;
+        size_t position;
+    } cases[] = {
+        {"wheel(x", "Expected )", 7},
+        {"foo + 1", "Unknown name foo", 0},
+        {"bar(1)", "Unknown function bar", 0},
+        {"x = 1; x", "Cannot assign to built-in x", 0},
+        {"rgb(1, 2)", "rgb expects 3 arguments", 0},
+        {"wheel(x) < 1", "Comparison needs numbers", 12},
+        {"level = 1;", "The last statement must be the pixel color", 10},
+        {"1 2", "Expected ; or end of program", 2},
+        {"", "The last statement must be the pixel color", 0},
+    };
+    for (const Case &c: cases) {
+        Program program;
+        Error error;
+        TEST_ASSERT_FALSE_MESSAGE(program.compile(c.source, {}, error), c.source);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(c.message, error.message.c_str(), c.source);
+        TEST_ASSERT_EQUAL_MESSAGE(c.position, error.position, c.source);
+
+        // a failed program renders black
+        MockStrip strip(3);
+        strip.fill(0xFFFFFF);
+        program.render(strip, 0);
+        TEST_ASSERT_EQUAL_HEX32(0x000000, strip.getPixelColor(1));
+    }
+}
+
+void test_reserved_variable_names_are_rejected() {
+    Program program;
+    Error error;
+    TEST_ASSERT_FALSE(program.compile("x", {{"t", 1.0f}}, error));
+    TEST_ASSERT_EQUAL_STRING("Invalid variable t", error.message.c_str());
+}
+
+void test_program_size_is_limited() {
+    std::string source = "x";
+    for (int k = 0; k < 600; k++) {
+        source += " + x";
+    }
+    Program program;
+    Error error;
+    TEST_ASSERT_FALSE(program.compile(source.c_str(), {}, error));
+    TEST_ASSERT_EQUAL_STRING("Program too large: out of registers", error.message.c_str());
+}
+
+void test_nesting_is_limited() {
+    std::string source = std::string(100, '(') + "x" + std::string(100, ')');
+    Program program;
+    Error error;
+    TEST_ASSERT_FALSE(program.compile(source.c_str(), {}, error));
+    TEST_ASSERT_EQUAL_STRING("Program nested too deeply", error.message.c_str());
+}
+
+void test_benchmark_shader() {
+    const char *programs[] = {
+        "wheel(x + t / 10)",
+        "hsv(x + t / 10, 1, wave(x * 4 - t))",
+        "w = wave(x * 3 - t * speed); n1 = noise(x * 8, t); mix(palette(x + t / 20), rgb(1, 1, 1), n1 * n1) * w",
+    };
+    for (const char *source: programs) {
+        Program program = compiled(source, {{"speed", 0.5f}});
+        for (Strip::PixelIndex length: {300, 1000}) {
+            Strip::Buffer strip(length);
+            uint32_t frame = 0;
+            char label[160];
+            snprintf(label, sizeof(label), "%u instr, %d px: %s", static_cast<unsigned>(program.pixelInstructions()),
+                     length, source);
+            benchmark(label, 500, length, [&] { program.render(strip, frame++); });
+        }
+    }
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_arithmetic_and_gray_output);
+    RUN_TEST(test_builtins_per_pixel);
+    RUN_TEST(test_statements_and_comments);
+    RUN_TEST(test_variables_are_folded);
+    RUN_TEST(test_frame_constants_are_hoisted);
+    RUN_TEST(test_comparison_and_select);
+    RUN_TEST(test_division_by_zero_is_zero);
+    RUN_TEST(test_sin_matches_libm);
+    RUN_TEST(test_wheel_hsv_and_palette);
+    RUN_TEST(test_color_operators);
+    RUN_TEST(test_noise_is_smooth_and_bounded);
+    RUN_TEST(test_compile_errors_report_positions);
+    RUN_TEST(test_reserved_variable_names_are_rejected);
+    RUN_TEST(test_program_size_is_limited);
+    RUN_TEST(test_nesting_is_limited);
+
+    RUN_TEST(test_benchmark_shader);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
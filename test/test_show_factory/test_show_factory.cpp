@@ -1,10 +1,17 @@
 #include "unity.h"
+#include "../Benchmark.h"
 #include "ShowFactory.h"
+#include "show/Noise.h"
+#include "support/Gradients.h"
 #include "color.h"
 #include "../MockStrip.h"
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <map>
 #include <memory>
+#include <new>
 #include <string>
 #include <thread>
 #include <vector>
@@ -22,6 +29,21 @@
 // once up front behind a single shared sleep (see renderAll), and the test
 // bodies only assert against the captured pixels.
 
+// Counts heap allocations while armed, to check the registry needs none.
+// The default operator delete releases with free().
+static bool counting = false;
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+    if (counting) {
+        allocations++;
+    }
+    if (void *memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
 static const Strip::PixelIndex PIXELS = 10;
 static const Strip::PixelIndex WIDE_PIXELS = 24;
 
@@ -79,7 +101,7 @@ static void renderAll() {
         auto strip = std::unique_ptr<MockStrip>(new MockStrip(entry.second.pixelCount));
         auto show = entry.second.params.empty()
                         ? factory.createShow("Solid")
-                        : factory.createShow("Solid", entry.second.params);
+                        : factory.createShow("Solid", entry.second.params.c_str());
         if (show == nullptr) {
             continue;  // asserted separately; skip rather than crash here
         }
@@ -158,7 +180,8 @@ void tearDown() {
 void test_all_shows_are_registered() {
     const char *expected[] = {
         "Solid", "Fire", "Starlight", "Stroboscope", "ColorRun", "Jump",
-        "Rainbow", "Wave", "TheaterChase", "MorseCode", "Chaos", "Mandelbrot"
+        "Rainbow", "Wave", "TheaterChase", "MorseCode", "Chaos", "Mandelbrot", "Noise", "Automaton",
+        "Spectrum", "BeatPulse", "Clip", "Shader", "Layers"
     };
     const size_t count = sizeof(expected) / sizeof(expected[0]);
 
@@ -171,7 +194,7 @@ void test_all_shows_are_registered() {
 void test_every_registered_show_constructs_with_empty_params() {
     for (const auto &info: factory->listShows()) {
         auto show = factory->createShow(info.name, "{}");
-        TEST_ASSERT_NOT_NULL_MESSAGE(show.get(), info.name.c_str());
+        TEST_ASSERT_NOT_NULL_MESSAGE(show.get(), info.name);
     }
 }
 
@@ -183,9 +206,89 @@ void test_unknown_show_returns_null() {
 
 void test_show_list_entries_have_descriptions() {
     for (const auto &info: factory->listShows()) {
-        TEST_ASSERT_FALSE(info.name.empty());
-        TEST_ASSERT_FALSE_MESSAGE(info.description.empty(), info.name.c_str());
+        TEST_ASSERT_TRUE(strlen(info.name) > 0);
+        TEST_ASSERT_TRUE_MESSAGE(strlen(info.description) > 0, info.name);
+    }
+}
+
+void test_lookup_finds_every_show_by_name() {
+    for (const auto &info: factory->listShows()) {
+        TEST_ASSERT_EQUAL_PTR(&info, ShowFactory::findShow(info.name));
+    }
+    TEST_ASSERT_NULL(ShowFactory::findShow(""));
+    TEST_ASSERT_NULL(ShowFactory::findShow("solid"));
+    TEST_ASSERT_NULL(ShowFactory::findShow("Solids"));
+    TEST_ASSERT_NULL(ShowFactory::findShow("Zzz"));
+}
+
+void test_registry_needs_no_heap() {
+    allocations = 0;
+    counting = true;
+    ShowFactory registry;
+    for (const auto &info: registry.listShows()) {
+        TEST_ASSERT_TRUE(registry.hasShow(info.name));
     }
+    TEST_ASSERT_FALSE(registry.hasShow("NoSuchShow"));
+    counting = false;
+    TEST_ASSERT_EQUAL(0, allocations);
+}
+
+void test_catalog_json_lists_every_show() {
+    const char *catalog = ShowFactory::catalogJson();
+    TEST_ASSERT_EQUAL(strlen(catalog), ShowFactory::catalogJsonLength());
+
+    JsonDocument doc;
+    TEST_ASSERT_FALSE(deserializeJson(doc, catalog));
+    JsonArrayConst shows = doc["shows"].as<JsonArrayConst>();
+    TEST_ASSERT_EQUAL(factory->listShows().size(), shows.size());
+    size_t i = 0;
+    for (const auto &info: factory->listShows()) {
+        JsonVariantConst show = shows[i++];
+        TEST_ASSERT_EQUAL_STRING(info.name, show["name"].as<const char *>());
+        TEST_ASSERT_EQUAL_STRING(info.description, show["description"].as<const char *>());
+        TEST_ASSERT_TRUE_MESSAGE(show["params"].is<JsonObjectConst>(), info.name);
+    }
+}
+
+void test_listed_parameters_are_the_defaults() {
+    // shows that render the same frames every time they are built
+    for (const char *name: {"Stroboscope", "Rainbow", "Wave", "TheaterChase", "MorseCode", "Mandelbrot"}) {
+        const ShowFactory::ShowInfo *info = ShowFactory::findShow(name);
+        auto defaults = factory->createShow(name, "{}");
+        auto listed = factory->createShow(name, info->parameters);
+        MockStrip expected(PIXELS);
+        MockStrip actual(PIXELS);
+        for (Show::Iteration i = 0; i < 50; i++) {
+            defaults->execute(expected, i);
+            listed->execute(actual, i);
+            for (Strip::PixelIndex pixel = 0; pixel < PIXELS; pixel++) {
+                TEST_ASSERT_EQUAL_HEX32_MESSAGE(expected.getPixelColor(pixel), actual.getPixelColor(pixel), name);
+            }
+        }
+    }
+}
+
+void test_benchmark_lookup() {
+    // the registry as it was: a map of heap strings to std::function
+    std::map<std::string, std::function<std::unique_ptr<Show::Show>(const JsonDocument &)>> map;
+    for (const auto &info: factory->listShows()) {
+        map[info.name] = info.constructor;
+    }
+    std::vector<const char *> names;
+    for (const auto &info: factory->listShows()) {
+        names.push_back(info.name);
+    }
+
+    benchmark("Show lookup, std::map<std::string>", 20000, names.size(), [&] {
+        for (const char *name: names) {
+            benchmark_sink = map.find(name) != map.end();
+        }
+    });
+    benchmark("Show lookup, sorted flash table", 20000, names.size(), [&] {
+        for (const char *name: names) {
+            benchmark_sink = ShowFactory::hasShow(name);
+        }
+    });
 }
 
 // --- malformed input falls back to defaults ---------------------------------
@@ -195,7 +298,7 @@ void test_malformed_json_still_constructs_every_show() {
     // to its default via the | operator rather than the request failing.
     for (const auto &info: factory->listShows()) {
         auto show = factory->createShow(info.name, "{\"colors\":");
-        TEST_ASSERT_NOT_NULL_MESSAGE(show.get(), info.name.c_str());
+        TEST_ASSERT_NOT_NULL_MESSAGE(show.get(), info.name);
     }
 }
 
@@ -284,12 +387,101 @@ void test_gradient_flag_changes_the_result() {
     TEST_ASSERT_TRUE_MESSAGE(differs, "gradient:true produced identical pixels");
 }
 
+// --- Shader parameter parsing -----------------------------------------------
+
+void test_shader_vars_and_palette_reach_the_program() {
+    auto show = factory->createShow("Shader",
+        R"json({"program":"palette(0) + rgb(level, 0, 0)","vars":{"level":0.5},"palette":[[0,0,255],[0,255,0]]})json");
+    MockStrip strip(PIXELS);
+    show->execute(strip, 0);
+    for (Strip::PixelIndex i = 0; i < PIXELS; i++) {
+        TEST_ASSERT_EQUAL_HEX32(0x8000FF, strip.getPixelColor(i));
+    }
+    TEST_ASSERT_TRUE(show->isComplete());
+}
+
+void test_shader_with_a_bad_program_renders_black() {
+    auto show = factory->createShow("Shader", R"json({"program":"wheel(x"})json");
+    TEST_ASSERT_NOT_NULL(show.get());
+    MockStrip strip(PIXELS);
+    strip.fill(0xFFFFFF);
+    show->execute(strip, 0);
+    TEST_ASSERT_EQUAL_HEX32(0x000000, strip.getPixelColor(0));
+}
+
+// --- Noise parameter parsing ------------------------------------------------
+
+void test_noise_palette_accepts_a_color_list() {
+    auto show = factory->createShow("Noise", R"({"palette":[[0,0,255]]})");
+    MockStrip strip(PIXELS);
+    show->execute(strip, 0);
+    for (Strip::PixelIndex i = 0; i < PIXELS; i++) {
+        TEST_ASSERT_EQUAL_HEX32(0x0000FF, strip.getPixelColor(i));
+    }
+}
+
+void test_noise_palette_accepts_a_name() {
+    auto show = factory->createShow("Noise", R"({"palette":"ocean","scale":5})");
+    MockStrip strip(PIXELS);
+    show->execute(strip, 0);
+    auto palette = Support::Gradients::find("ocean");
+    for (Strip::PixelIndex i = 0; i < PIXELS; i++) {
+        // ocean is all blue-green, lava would have red in it
+        TEST_ASSERT_TRUE(red(strip.getPixelColor(i)) <= red(palette.back()));
+    }
+}
+
+// --- palette parameter -------------------------------------------------------
+
+void test_stored_palette_is_selectable_by_name() {
+    TEST_ASSERT_TRUE(Support::Gradients::store("dusk", {0x112233}));
+    for (const char *name: {"Rainbow", "Fire"}) {
+        auto show = factory->createShow(name, R"({"palette":"dusk"})");
+        MockStrip strip(PIXELS);
+        show->execute(strip, 0);
+        // a single color is the whole palette, whatever the hue or heat
+        for (Strip::PixelIndex i = 0; i < PIXELS; i++) {
+            TEST_ASSERT_EQUAL_HEX32_MESSAGE(0x112233, strip.getPixelColor(i), name);
+        }
+    }
+    Support::Gradients::clear();
+}
+
+void test_palette_accepts_a_color_list() {
+    auto show = factory->createShow("Rainbow", R"({"palette":[[0,0,255]]})");
+    MockStrip strip(PIXELS);
+    show->execute(strip, 0);
+    for (Strip::PixelIndex i = 0; i < PIXELS; i++) {
+        TEST_ASSERT_EQUAL_HEX32(0x0000FF, strip.getPixelColor(i));
+    }
+}
+
+void test_unknown_palette_keeps_the_default_colors() {
+    for (const char *name: {"Rainbow", "Wave", "Mandelbrot", "Chaos"}) {
+        auto plain = factory->createShow(name, "{}");
+        auto unknown = factory->createShow(name, R"({"palette":"no-such-palette"})");
+        MockStrip expected(PIXELS);
+        MockStrip actual(PIXELS);
+        for (Show::Iteration iteration = 0; iteration < 5; iteration++) {
+            plain->execute(expected, iteration);
+            unknown->execute(actual, iteration);
+        }
+        for (Strip::PixelIndex i = 0; i < PIXELS; i++) {
+            TEST_ASSERT_EQUAL_HEX32_MESSAGE(expected.getPixelColor(i), actual.getPixelColor(i), name);
+        }
+    }
+}
+
 int runUnityTests() {
     renderAll();
 
     UNITY_BEGIN();
 
     RUN_TEST(test_all_shows_are_registered);
+    RUN_TEST(test_lookup_finds_every_show_by_name);
+    RUN_TEST(test_registry_needs_no_heap);
+    RUN_TEST(test_catalog_json_lists_every_show);
+    RUN_TEST(test_listed_parameters_are_the_defaults);
     RUN_TEST(test_every_registered_show_constructs_with_empty_params);
     RUN_TEST(test_unknown_show_returns_null);
     RUN_TEST(test_show_list_entries_have_descriptions);
@@ -306,6 +498,17 @@ int runUnityTests() {
     RUN_TEST(test_many_colors_are_all_parsed);
     RUN_TEST(test_gradient_flag_changes_the_result);
 
+    RUN_TEST(test_shader_vars_and_palette_reach_the_program);
+    RUN_TEST(test_shader_with_a_bad_program_renders_black);
+
+    RUN_TEST(test_noise_palette_accepts_a_color_list);
+    RUN_TEST(test_noise_palette_accepts_a_name);
+
+    RUN_TEST(test_stored_palette_is_selectable_by_name);
+    RUN_TEST(test_palette_accepts_a_color_list);
+    RUN_TEST(test_unknown_palette_keeps_the_default_colors);
+    RUN_TEST(test_benchmark_lookup);
+
     return UNITY_END();
 }
 
@@ -3,10 +3,17 @@
 #include "show/Fire.h"
 #include "show/Rainbow.h"
 
+#include <algorithm>
+
 Show::FireState *state;
+// noise that spreads (almost) in full and ignites only at ignition 1.0
+uint32_t full[20];
+// fixed-point heat is exact to 1/65536 per step
+constexpr float HEAT_STEP = 1e-4f;
 
 void setUp() {
-    state = new Show::FireState([] { return 1.0f; }, 10);
+    std::fill(full, full + 20, UINT32_MAX);
+    state = new Show::FireState(10);
 }
 
 void tearDown() {
@@ -33,22 +40,22 @@ void test_cooldown() {
 
 void test_spread() {
     state->set_temperature(0, 1.0f);
-    state->spread(1.0, 0.0, 0, 0.5f);
+    state->spread(full, 1.0);
 
     // With double-buffering, heat only spreads one step per frame
     // Heat from index 0 spreads to index 1, not teleporting to index 9
-    TEST_ASSERT_EQUAL_FLOAT(0.75f, state->get_temperature(0));
-    TEST_ASSERT_EQUAL_FLOAT(0.25f, state->get_temperature(1));
+    TEST_ASSERT_FLOAT_WITHIN(HEAT_STEP, 0.75f, state->get_temperature(0));
+    TEST_ASSERT_FLOAT_WITHIN(HEAT_STEP, 0.25f, state->get_temperature(1));
     TEST_ASSERT_EQUAL_FLOAT(0.0f, state->get_temperature(9));
 }
 
 void test_spread_limited() {
     state->set_temperature(0, 0.1f);
-    state->spread(1.0, 0.0, 0, 0.5f);
+    state->spread(full, 1.0);
 
     // With double-buffering, heat spreads to adjacent pixel only
-    TEST_ASSERT_EQUAL_FLOAT(0.0f, state->get_temperature(0));
-    TEST_ASSERT_EQUAL_FLOAT(0.1f, state->get_temperature(1));
+    TEST_ASSERT_FLOAT_WITHIN(HEAT_STEP, 0.0f, state->get_temperature(0));
+    TEST_ASSERT_FLOAT_WITHIN(HEAT_STEP, 0.1f, state->get_temperature(1));
     TEST_ASSERT_EQUAL_FLOAT(0.0f, state->get_temperature(9));
 }
 
@@ -64,7 +71,7 @@ void test_create_fire() {
 
 void test_spread_multiple_weights() {
     delete state;
-    state = new Show::FireState([] { return 1.0f; }, 10);
+    state = new Show::FireState(10, {2.0f, 1.0f});
     state->set_temperature(0, 1.0f);
     state->set_temperature(1, 1.0f);
 
@@ -76,7 +83,7 @@ void test_spread_multiple_weights() {
     // i=3: reads prev_temp[2]=0, prev_temp[1]=1.0, spreads 0.25
     //      temp[2] -= 0.25*2/3, temp[1] -= 0.25*1/3
 
-    state->spread(1.0, 0.0, 0, 0.5f, {2.0f, 1.0f});
+    state->spread(full, 1.0);
 
     // Verify energy conservation
     float total = 0;
@@ -85,15 +92,15 @@ void test_spread_multiple_weights() {
     }
     TEST_ASSERT_EQUAL_FLOAT(2.0f, total);
 
-    TEST_ASSERT_EQUAL_FLOAT(0.6666667f, state->get_temperature(0));
-    TEST_ASSERT_EQUAL_FLOAT(1.0f, state->get_temperature(1));
-    TEST_ASSERT_EQUAL_FLOAT(0.0833333f, state->get_temperature(2));
+    TEST_ASSERT_FLOAT_WITHIN(HEAT_STEP, 0.6666667f, state->get_temperature(0));
+    TEST_ASSERT_FLOAT_WITHIN(HEAT_STEP, 1.0f, state->get_temperature(1));
+    TEST_ASSERT_FLOAT_WITHIN(HEAT_STEP, 0.0833333f, state->get_temperature(2));
 }
 
 void test_spark_amount() {
     state->set_temperature(0, 0.0f);
-    state->spread(0.0, 1.0, 1, 0.7f);
-    TEST_ASSERT_EQUAL_FLOAT(0.7f, state->get_temperature(0));
+    state->ignite(full, 1.0, 1, 0.7f);
+    TEST_ASSERT_FLOAT_WITHIN(HEAT_STEP, 0.7f, state->get_temperature(0));
 }
 
 // Rainbow show tests
@@ -1,9 +1,32 @@
 #include "unity.h"
 #include "../MockStrip.h"
+#include "color.h"
 #include "support/SmoothBlend.h"
 
+using Support::Interpolation::ONE;
+
 MockStrip* mock_strip;
 
+// Counts transmissions, which the blend must leave to the LED task
+class CountingStrip : public MockStrip {
+public:
+    using MockStrip::MockStrip;
+
+    void show() override {
+        shows++;
+    }
+
+    int shows = 0;
+};
+
+// The blend as it was computed before: a float fade per channel, truncated
+static Strip::Color floatBlend(Strip::Color from, Strip::Color to, float fade_progress) {
+    auto channel = [fade_progress](Strip::ColorComponent start, Strip::ColorComponent end) {
+        return static_cast<Strip::ColorComponent>(start * fade_progress + end * (1.0f - fade_progress));
+    };
+    return color(channel(red(from), red(to)), channel(green(from), green(to)), channel(blue(from), blue(to)));
+}
+
 void setUp() {
     mock_strip = new MockStrip(10);
 }
@@ -54,10 +77,65 @@ void test_smooth_blend_multiple_colors() {
     TEST_ASSERT_TRUE(still_running);
 }
 
+void test_smooth_blend_matches_float_blend() {
+    const ::Strip::Color starts[] = {0xFF0000, 0x123456, 0xFFFFFF, 0x000000, 0x80FF01, 0x7F007F, 0x0A0B0C, 0xFEDCBA,
+                                     0x00FF00, 0x333333};
+    std::vector<::Strip::Color> targets = {0x0000FF, 0xFEDCBA, 0x000000, 0xFFFFFF, 0x01FF80, 0x7F7F7F, 0xC0B0A0,
+                                           0x123456, 0xFF00FF, 0x333333};
+    for (int i = 0; i < 10; i++) {
+        mock_strip->setPixelColor(i, starts[i]);
+    }
+    Support::SmoothBlend blend(*mock_strip, targets);
+
+    // quarters are exact in both; in between the Q16 progress may round a channel the other way
+    for (uint32_t progress = 0; progress <= ONE; progress += ONE / 64) {
+        blend.render(progress);
+        float fade = 1.0f - static_cast<float>(progress) / ONE;
+        for (int i = 0; i < 10; i++) {
+            ::Strip::Color expected = floatBlend(starts[i], targets[i], fade);
+            ::Strip::Color actual = mock_strip->getPixelColor(i);
+            if (progress % (ONE / 4) == 0) {
+                TEST_ASSERT_EQUAL_HEX32(expected, actual);
+            } else {
+                TEST_ASSERT_INT_WITHIN(1, red(expected), red(actual));
+                TEST_ASSERT_INT_WITHIN(1, green(expected), green(actual));
+                TEST_ASSERT_INT_WITHIN(1, blue(expected), blue(actual));
+            }
+        }
+    }
+}
+
+void test_smooth_blend_easing() {
+    for (int i = 0; i < 10; i++) {
+        mock_strip->setPixelColor(i, 0x000000);
+    }
+    Support::SmoothBlend blend(*mock_strip, 0xFFFFFF, 2000, Support::Interpolation::Easing::CUBIC);
+    blend.render(0);
+    TEST_ASSERT_EQUAL_HEX32(0x000000, mock_strip->getPixelColor(3));
+    blend.render(ONE / 2);
+    TEST_ASSERT_EQUAL_HEX32(0x7F7F7F, mock_strip->getPixelColor(3));
+    // 4 t^3 at a quarter of the way
+    blend.render(ONE / 4);
+    TEST_ASSERT_EQUAL_HEX32(0x0F0F0F, mock_strip->getPixelColor(3));
+    blend.render(ONE);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, mock_strip->getPixelColor(3));
+}
+
+void test_smooth_blend_leaves_show_to_the_caller() {
+    CountingStrip strip(10);
+    Support::SmoothBlend blend(strip, 0x00FF00, 0);
+    TEST_ASSERT_FALSE(blend.step());
+    TEST_ASSERT_EQUAL(0, strip.shows);
+    TEST_ASSERT_EQUAL_HEX32(0x00FF00, strip.getPixelColor(9));
+}
+
 int runUnityTests() {
     UNITY_BEGIN();
     RUN_TEST(test_smooth_blend_single_color);
     RUN_TEST(test_smooth_blend_multiple_colors);
+    RUN_TEST(test_smooth_blend_matches_float_blend);
+    RUN_TEST(test_smooth_blend_easing);
+    RUN_TEST(test_smooth_blend_leaves_show_to_the_caller);
     return UNITY_END();
 }
 
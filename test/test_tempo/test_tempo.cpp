@@ -0,0 +1,203 @@
+#include "unity.h"
+#include "../MockStrip.h"
+#include "show/Stroboscope.h"
+#include "show/TheaterChase.h"
+#include "support/Tempo.h"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using Support::Tempo::Clock;
+using Support::Tempo::Position;
+
+static constexpr uint64_t SECOND = 1000000;
+static constexpr uint64_t HOUR = 3600 * SECOND;
+
+// Offset of the clock from the exact beat grid, in milliseconds
+static double errorMs(const Position &position, uint64_t elapsed_us, double bpm) {
+    double beat_us = 60e6 / bpm;
+    double expected = static_cast<double>(elapsed_us) / beat_us;
+    // whole beats compared exactly, phases within a beat
+    double whole = std::floor(expected);
+    TEST_ASSERT_EQUAL_UINT64(static_cast<uint64_t>(whole), position.beat);
+    return std::fabs(position.phase - (expected - whole)) * beat_us / 1000.0;
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_default_tempo() {
+    Clock clock(1000);
+    TEST_ASSERT_EQUAL_FLOAT(120.0f, clock.bpm());
+    TEST_ASSERT_EQUAL(4, clock.beatsPerBar());
+
+    Position start = clock.at(1000);
+    TEST_ASSERT_EQUAL_UINT64(0, start.beat);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, start.phase);
+
+    Position position = clock.at(1000 + SECOND + SECOND / 4);
+    TEST_ASSERT_EQUAL_UINT64(2, position.beat);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f, position.phase);
+    TEST_ASSERT_EQUAL_UINT64(0, position.bar);
+    TEST_ASSERT_EQUAL(2, position.beat_in_bar);
+
+    // before the clock started it stands at the start
+    TEST_ASSERT_EQUAL_UINT64(0, clock.at(0).beat);
+}
+
+void test_phase_stays_exact_over_hours() {
+    for (float bpm: {128.0f, 123.456f, 97.5f, 300.0f}) {
+        Clock clock(0);
+        clock.setBpm(bpm, 0);
+        double exact_bpm = std::lround(bpm * 1000.0f) / 1000.0;
+        double worst = 0.0;
+        // frames at an uneven rate over a day
+        for (uint64_t t = 0; t < 24 * HOUR; t += 7 * SECOND + 12345) {
+            worst = std::max(worst, errorMs(clock.at(t), t, exact_bpm));
+        }
+        TEST_ASSERT_TRUE_MESSAGE(worst < 0.001, "phase drifted by a microsecond or more");
+    }
+}
+
+void test_tempo_change_keeps_position() {
+    Clock clock(0);
+    uint64_t change = HOUR + 123457;
+    Position before = clock.at(change);
+    clock.setBpm(90.0f, change);
+    Position after = clock.at(change);
+    TEST_ASSERT_EQUAL_UINT64(before.beat, after.beat);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, before.phase, after.phase);
+
+    // and counts on at the new tempo: one beat is 2/3 s
+    Position later = clock.at(change + 2 * SECOND / 3);
+    TEST_ASSERT_EQUAL_UINT64(before.beat + 1, later.beat);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, before.phase, later.phase);
+}
+
+void test_bpm_is_clamped() {
+    Clock clock(0);
+    clock.setBpm(5.0f, 0);
+    TEST_ASSERT_EQUAL_FLOAT(Support::Tempo::MIN_BPM, clock.bpm());
+    clock.setBpm(1000.0f, 0);
+    TEST_ASSERT_EQUAL_FLOAT(Support::Tempo::MAX_BPM, clock.bpm());
+}
+
+void test_bars() {
+    Clock clock(0);
+    clock.setBeatsPerBar(3, 0);
+    Position position = clock.at(7 * SECOND / 2); // beat 7 at 120 bpm
+    TEST_ASSERT_EQUAL_UINT64(7, position.beat);
+    TEST_ASSERT_EQUAL_UINT64(2, position.bar);
+    TEST_ASSERT_EQUAL(1, position.beat_in_bar);
+
+    clock.setBeatsPerBar(0, 0);
+    TEST_ASSERT_EQUAL(1, clock.beatsPerBar());
+}
+
+void test_tap_tempo() {
+    Clock clock(0);
+    uint64_t start = 10 * SECOND + 100000;
+    TEST_ASSERT_EQUAL(1, clock.tap(start));
+    // a single tap aligns the beat without changing the tempo
+    TEST_ASSERT_EQUAL_FLOAT(120.0f, clock.bpm());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, clock.at(start).phase);
+
+    // 468.75 ms apart is 128 bpm
+    for (uint64_t i = 1; i < 6; i++) {
+        TEST_ASSERT_EQUAL(i + 1, clock.tap(start + i * 468750));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 128.0f, clock.bpm());
+    uint64_t last = start + 5 * 468750;
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, clock.at(last).phase);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.5f, clock.at(last + 234375).phase);
+
+    // only the latest taps count
+    for (uint64_t i = 1; i <= Clock::MAX_TAPS; i++) {
+        TEST_ASSERT_LESS_OR_EQUAL(Clock::MAX_TAPS, clock.tap(last + i * 500000));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 120.0f, clock.bpm());
+
+    // a long pause starts over
+    TEST_ASSERT_EQUAL(1, clock.tap(last + HOUR));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 120.0f, clock.bpm());
+}
+
+void test_taps_keep_counting_beats() {
+    Clock clock(0);
+    Position before = clock.at(10 * SECOND - 100000); // beat 19.8
+    clock.tap(10 * SECOND - 100000);
+    TEST_ASSERT_EQUAL_UINT64(before.beat + 1, clock.at(10 * SECOND - 100000).beat);
+}
+
+void test_beat_timed_shows_are_not_periodic() {
+    TEST_ASSERT_EQUAL(0, Show::Stroboscope(255, 255, 255, 1, 10, 1.0f).period());
+    TEST_ASSERT_EQUAL(0, Show::TheaterChase(21, 2.0f).period());
+    TEST_ASSERT_EQUAL(11, Show::Stroboscope().period());
+}
+
+void test_theater_chase_follows_the_clock() {
+    // 100.5 beats in at 120 bpm, so the chase is at step 100
+    Clock clock(Support::Tempo::now() - 50250000);
+    Show::TheaterChase synced(21, 1.0f, clock);
+    Show::TheaterChase counted(21);
+
+    MockStrip strip(30);
+    MockStrip expected(30);
+    synced.execute(strip, 0);
+    for (Show::Iteration i = 0; i <= 100; i++) {
+        counted.execute(expected, i);
+    }
+    for (Strip::PixelIndex i = 0; i < 30; i++) {
+        TEST_ASSERT_EQUAL_HEX32(expected.getPixelColor(i), strip.getPixelColor(i));
+    }
+}
+
+void test_stroboscope_flashes_on_the_beat() {
+    // 300 bpm at 8 flashes per beat: a flash every 25 ms
+    Clock clock(Support::Tempo::now());
+    clock.setBpm(300.0f);
+    Show::Stroboscope strobe(255, 255, 255, 2, 10, 8.0f, clock);
+    MockStrip strip(4);
+
+    strobe.execute(strip, 0);
+    TEST_ASSERT_EQUAL_HEX32(0, strip.getPixelColor(0)); // waits for the next division
+
+    int flashes = 0;
+    int lit_frames = 0;
+    bool lit = false;
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(120);
+    for (Show::Iteration i = 1; std::chrono::steady_clock::now() < end; i++) {
+        strobe.execute(strip, i);
+        bool on = strip.getPixelColor(0) != 0;
+        flashes += on && !lit;
+        lit_frames += on;
+        lit = on;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL(3, flashes);
+    TEST_ASSERT_LESS_OR_EQUAL(6, flashes);
+    TEST_ASSERT_LESS_OR_EQUAL(2 * flashes, lit_frames);
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_default_tempo);
+    RUN_TEST(test_phase_stays_exact_over_hours);
+    RUN_TEST(test_tempo_change_keeps_position);
+    RUN_TEST(test_bpm_is_clamped);
+    RUN_TEST(test_bars);
+    RUN_TEST(test_tap_tempo);
+    RUN_TEST(test_taps_keep_counting_beats);
+    RUN_TEST(test_beat_timed_shows_are_not_periodic);
+    RUN_TEST(test_theater_chase_follows_the_clock);
+    RUN_TEST(test_stroboscope_flashes_on_the_beat);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
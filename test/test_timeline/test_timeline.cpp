@@ -0,0 +1,318 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "ShowFactory.h"
+#include "show/Baked.h"
+#include "show/Fire.h"
+#include "show/Layers.h"
+#include "show/Noise.h"
+#include "show/Rainbow.h"
+#include "show/Starlight.h"
+#include "support/Timeline.h"
+
+#include <cstdlib>
+#include <new>
+
+using Support::Timeline;
+
+// Counts heap allocations while armed, to check evaluation never allocates.
+// The default operator delete releases with free().
+static bool counting = false;
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+    if (counting) {
+        allocations++;
+    }
+    if (void *memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+static Timeline::Keyframe key(uint32_t time_ms, float value, Timeline::Easing easing = Timeline::Easing::LINEAR) {
+    Timeline::Keyframe keyframe;
+    keyframe.time_ms = time_ms;
+    keyframe.value = value;
+    keyframe.easing = easing;
+    return keyframe;
+}
+
+static bool parse(const char *json, Timeline &timeline, std::string &error) {
+    JsonDocument doc;
+    deserializeJson(doc, json);
+    return ShowFactory::parseTimeline(doc.as<JsonVariantConst>(), timeline, error);
+}
+
+void setUp() {
+    counting = false;
+    allocations = 0;
+}
+
+void tearDown() {
+}
+
+void test_linear_track_interpolates_and_holds() {
+    Timeline timeline;
+    TEST_ASSERT_TRUE(timeline.addTrack("cooling", {key(1000, 0.0f), key(3000, 1.0f)}));
+    TEST_ASSERT_EQUAL(3000, timeline.duration());
+
+    timeline.evaluate(0);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, timeline.value(0));
+    timeline.evaluate(2000);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f, timeline.value(0));
+    timeline.evaluate(2500);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.75f, timeline.value(0));
+    timeline.evaluate(3000);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, timeline.value(0));
+    timeline.evaluate(100000);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, timeline.value(0));
+    TEST_ASSERT_TRUE(timeline.isFinished(3001));
+}
+
+void test_easing_curves() {
+    Timeline timeline;
+    timeline.addTrack("in", {key(0, 0.0f, Timeline::Easing::EASE_IN), key(1000, 1.0f)});
+    timeline.addTrack("out", {key(0, 0.0f, Timeline::Easing::EASE_OUT), key(1000, 1.0f)});
+    timeline.addTrack("in_out", {key(0, 0.0f, Timeline::Easing::SINE), key(1000, 1.0f)});
+    timeline.evaluate(500);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.25f, timeline.value(0));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.75f, timeline.value(1));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.5f, timeline.value(2));
+    timeline.evaluate(1000);
+    for (size_t i = 0; i < timeline.tracks(); i++) {
+        TEST_ASSERT_EQUAL_FLOAT(1.0f, timeline.value(i));
+    }
+
+    timeline = Timeline();
+    timeline.addTrack("speed", {key(0, 2.0f, Timeline::Easing::STEP), key(1000, 4.0f)});
+    timeline.evaluate(999);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, timeline.value(0));
+    timeline.evaluate(1000);
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, timeline.value(0));
+}
+
+void test_easing_names() {
+    Timeline::Easing easing;
+    TEST_ASSERT_TRUE(Support::Interpolation::easingFromName("ease-in-out", easing));
+    TEST_ASSERT_TRUE(Timeline::Easing::SINE == easing);
+    TEST_ASSERT_TRUE(Support::Interpolation::easingFromName("cubic", easing));
+    TEST_ASSERT_TRUE(Timeline::Easing::CUBIC == easing);
+    TEST_ASSERT_FALSE(Support::Interpolation::easingFromName("bounce", easing));
+    TEST_ASSERT_FALSE(Support::Interpolation::easingFromName(nullptr, easing));
+
+    Timeline timeline;
+    std::string error;
+    TEST_ASSERT_FALSE(parse(R"({"tracks":{"cooling":[[0,0.05,"bounce"],[10,0.2]]}})", timeline, error));
+    TEST_ASSERT_EQUAL_STRING("Unknown easing bounce", error.c_str());
+}
+
+void test_loop_starts_over() {
+    Timeline timeline;
+    timeline.setLoop(true);
+    timeline.addTrack("time_step", {key(0, 0.0f), key(1000, 1.0f), key(2000, 0.0f)});
+
+    timeline.evaluate(500);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f, timeline.value(0));
+    timeline.evaluate(1500);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f, timeline.value(0));
+    timeline.evaluate(2250);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.25f, timeline.value(0));
+    timeline.evaluate(3000);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, timeline.value(0));
+    TEST_ASSERT_FALSE(timeline.isFinished(1000000));
+}
+
+void test_tracks_are_independent() {
+    Timeline timeline;
+    timeline.addTrack("a", {key(0, 0.0f), key(1000, 10.0f)});
+    timeline.addTrack("b", {key(500, 5.0f)});
+    TEST_ASSERT_EQUAL(2, timeline.tracks());
+    TEST_ASSERT_EQUAL_STRING("b", timeline.parameter(1));
+
+    timeline.evaluate(100);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 1.0f, timeline.value(0));
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, timeline.value(1));
+
+    // going back in time finds the right segment again
+    timeline.evaluate(900);
+    timeline.evaluate(200);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 2.0f, timeline.value(0));
+}
+
+void test_invalid_tracks_are_rejected() {
+    Timeline timeline;
+    TEST_ASSERT_FALSE(timeline.addTrack("a", {}));
+    TEST_ASSERT_FALSE(timeline.addTrack("", {key(0, 1.0f)}));
+    TEST_ASSERT_FALSE(timeline.addTrack("a", {key(100, 1.0f), key(100, 2.0f)}));
+    TEST_ASSERT_FALSE(timeline.addTrack("a_parameter_name_too_long", {key(0, 1.0f)}));
+    std::vector<Timeline::Keyframe> many;
+    for (uint32_t i = 0; i <= Timeline::MAX_KEYFRAMES; i++) {
+        many.push_back(key(i, 0.0f));
+    }
+    TEST_ASSERT_FALSE(timeline.addTrack("a", many));
+
+    for (size_t i = 0; i < Timeline::MAX_TRACKS; i++) {
+        TEST_ASSERT_TRUE(timeline.addTrack("a", {key(0, 1.0f)}));
+    }
+    TEST_ASSERT_FALSE(timeline.addTrack("a", {key(0, 1.0f)}));
+}
+
+void test_parse_timeline() {
+    Timeline timeline;
+    std::string error;
+    TEST_ASSERT_TRUE(parse(R"({"loop":true,"tracks":{"cooling":[[0,0.05],[3600,0.2,"ease-in-out"]],
+                                                      "spread":[[1.5,8]]}})", timeline, error));
+    TEST_ASSERT_TRUE(timeline.isLooping());
+    TEST_ASSERT_EQUAL(2, timeline.tracks());
+    TEST_ASSERT_EQUAL_STRING("cooling", timeline.parameter(0));
+    TEST_ASSERT_EQUAL(3600000, timeline.keyframes(0)[1].time_ms);
+    TEST_ASSERT_TRUE(Timeline::Easing::LINEAR == timeline.keyframes(0)[0].easing);
+    TEST_ASSERT_TRUE(Timeline::Easing::SINE == timeline.keyframes(0)[1].easing);
+    TEST_ASSERT_EQUAL(1500, timeline.keyframes(1)[0].time_ms);
+    TEST_ASSERT_EQUAL_FLOAT(8.0f, timeline.keyframes(1)[0].value);
+}
+
+void test_parse_timeline_errors() {
+    const char *invalid[] = {
+        R"({})",
+        R"({"tracks":{}})",
+        R"({"tracks":{"cooling":[]}})",
+        R"({"tracks":{"cooling":[[0]]}})",
+        R"({"tracks":{"cooling":[[-1,0.5]]}})",
+        R"({"tracks":{"cooling":[[0,"hot"]]}})",
+        R"({"tracks":{"cooling":[[0,0.1,"bounce"]]}})",
+        R"({"tracks":{"cooling":[[5,0.1],[1,0.2]]}})",
+    };
+    for (const char *json: invalid) {
+        Timeline timeline;
+        std::string error;
+        TEST_ASSERT_FALSE_MESSAGE(parse(json, timeline, error), json);
+        TEST_ASSERT_FALSE(error.empty());
+    }
+}
+
+void test_shows_take_parameters() {
+    Show::Fire fire;
+    TEST_ASSERT_TRUE(fire.setParameter("cooling", 0.3f));
+    TEST_ASSERT_TRUE(fire.setParameter("spark_amount", 0.3f));
+    TEST_ASSERT_FALSE(fire.setParameter("time_step", 1.0f));
+
+    Show::Starlight starlight;
+    TEST_ASSERT_TRUE(starlight.setParameter("probability", 0.5f));
+
+    Show::Noise noise;
+    TEST_ASSERT_TRUE(noise.setParameter("speed", 1.0f));
+    TEST_ASSERT_TRUE(noise.setParameter("scale", 5.0f));
+
+    Show::Rainbow rainbow;
+    TEST_ASSERT_TRUE(rainbow.setParameter("pixel_step", 2.0f));
+    TEST_ASSERT_FALSE(rainbow.setParameter("cooling", 0.1f));
+}
+
+void test_rainbow_speed_change_is_seamless() {
+    MockStrip strip(1);
+    Show::Rainbow rainbow(1.0f, 0.0f);
+    Show::Rainbow reference(1.0f, 0.0f);
+    for (Show::Iteration i = 0; i < 100; i++) {
+        rainbow.execute(strip, i);
+    }
+    MockStrip expected(1);
+    reference.execute(expected, 99);
+    TEST_ASSERT_EQUAL_HEX32(expected.getPixelColor(0), strip.getPixelColor(0));
+
+    // continues from hue 99 at the new speed instead of jumping to 100 * 10
+    rainbow.setParameter("time_step", 10.0f);
+    rainbow.execute(strip, 100);
+    reference.execute(expected, 109);
+    TEST_ASSERT_EQUAL_HEX32(expected.getPixelColor(0), strip.getPixelColor(0));
+}
+
+void test_baked_show_runs_live_after_a_change() {
+    MockStrip strip(10);
+    Show::Baked baked(std::make_unique<Show::Rainbow>(1.0f, 1.0f), 255, 64 * 1024);
+    for (Show::Iteration i = 0; i < 300; i++) {
+        baked.execute(strip, i);
+    }
+    TEST_ASSERT_TRUE(baked.isBaked());
+
+    TEST_ASSERT_TRUE(baked.setParameter("time_step", 2.0f));
+    TEST_ASSERT_FALSE(baked.isBaked());
+    TEST_ASSERT_EQUAL(0, baked.period());
+    baked.execute(strip, 300);
+    TEST_ASSERT_FALSE(baked.setParameter("cooling", 1.0f));
+}
+
+void test_layers_address_parameters() {
+    Show::Layers layers;
+    layers.addLayer(std::make_unique<Show::Fire>(), "base", Support::Blend::Mode::NORMAL, 255);
+    layers.addLayer(std::make_unique<Show::Rainbow>(), "top", Support::Blend::Mode::ADD, 128);
+
+    TEST_ASSERT_TRUE(layers.setParameter("cooling", 0.2f));
+    TEST_ASSERT_TRUE(layers.setParameter("top.time_step", 0.5f));
+    TEST_ASSERT_FALSE(layers.setParameter("base.time_step", 0.5f));
+    TEST_ASSERT_FALSE(layers.setParameter("other.cooling", 0.2f));
+}
+
+void test_evaluation_does_not_allocate() {
+    Timeline timeline;
+    std::string error;
+    TEST_ASSERT_TRUE(parse(R"({"loop":true,"tracks":{
+        "cooling":[[0,0.05],[10,0.2,"ease-in-out"],[20,0.05]],
+        "spread":[[0,5],[5,15,"ease-in"],[20,5]],
+        "spark_amount":[[0,0.2],[20,0.8,"step"]]}})", timeline, error));
+    MockStrip strip(50);
+    Show::Fire fire;
+    fire.execute(strip, 0);
+
+    counting = true;
+    for (uint32_t frame = 0; frame < 5000; frame++) {
+        timeline.evaluate(frame * 10);
+        for (size_t i = 0; i < timeline.tracks(); i++) {
+            TEST_ASSERT_TRUE(fire.setParameter(timeline.parameter(i), timeline.value(i)));
+        }
+    }
+    counting = false;
+    TEST_ASSERT_EQUAL(0, allocations);
+}
+
+void test_benchmark_timeline_evaluation() {
+    Timeline timeline;
+    std::vector<Timeline::Keyframe> keys;
+    for (uint32_t i = 0; i < Timeline::MAX_KEYFRAMES; i++) {
+        keys.push_back(key(i * 1000, static_cast<float>(i % 3), Timeline::Easing::SINE));
+    }
+    for (size_t i = 0; i < Timeline::MAX_TRACKS; i++) {
+        timeline.addTrack("value", keys);
+    }
+    timeline.setLoop(true);
+
+    uint32_t time = 0;
+    benchmark("Timeline 8 tracks x 32 keyframes", 100000, Timeline::MAX_TRACKS, [&] {
+        timeline.evaluate(time += 10);
+        benchmark_sink = static_cast<uint32_t>(timeline.value(0));
+    });
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_linear_track_interpolates_and_holds);
+    RUN_TEST(test_easing_curves);
+    RUN_TEST(test_easing_names);
+    RUN_TEST(test_loop_starts_over);
+    RUN_TEST(test_tracks_are_independent);
+    RUN_TEST(test_invalid_tracks_are_rejected);
+    RUN_TEST(test_parse_timeline);
+    RUN_TEST(test_parse_timeline_errors);
+    RUN_TEST(test_shows_take_parameters);
+    RUN_TEST(test_rainbow_speed_change_is_seamless);
+    RUN_TEST(test_baked_show_runs_live_after_a_change);
+    RUN_TEST(test_layers_address_parameters);
+    RUN_TEST(test_evaluation_does_not_allocate);
+    RUN_TEST(test_benchmark_timeline_evaluation);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
@@ -0,0 +1,249 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "show/Rainbow.h"
+#include "show/Transition.h"
+#include "support/Blend.h"
+
+#include <vector>
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+// Fills the strip with one color and counts its frames
+class SolidShow : public Show::Show {
+public:
+    Strip::Color fill_color;
+    unsigned executions = 0;
+
+    explicit SolidShow(Strip::Color fill_color) : fill_color(fill_color) {
+    }
+
+    void execute(Strip::Strip &strip, ::Show::Iteration iteration) override {
+        strip.fill(fill_color);
+        executions++;
+    }
+};
+
+// Draws once and relies on the strip keeping its frame, like Solid
+class DrawOnceShow : public Show::Show {
+public:
+    Strip::Color fill_color;
+    bool drawn = false;
+
+    explicit DrawOnceShow(Strip::Color fill_color) : fill_color(fill_color) {
+    }
+
+    void execute(Strip::Strip &strip, ::Show::Iteration iteration) override {
+        if (!drawn) {
+            strip.fill(fill_color);
+            drawn = true;
+        }
+    }
+};
+
+static constexpr size_t BUDGET = 8 * 1024;
+
+void test_mix_endpoints() {
+    TEST_ASSERT_EQUAL_HEX32(0x123456, Support::Blend::mix(0x123456, 0xABCDEF, 0));
+    TEST_ASSERT_EQUAL_HEX32(0xABCDEF, Support::Blend::mix(0x123456, 0xABCDEF, 255));
+    TEST_ASSERT_EQUAL_HEX32(0x808080, Support::Blend::mix(0x000000, 0xFFFFFF, 128));
+    // channels must not bleed into each other
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, Support::Blend::mix(0x0000FF, 0x0000FF, 77));
+    TEST_ASSERT_EQUAL_HEX32(0xFF00FF, Support::Blend::mix(0xFF00FF, 0xFF00FF, 200));
+}
+
+void test_type_names_round_trip() {
+    const Show::Transition::Type types[] = {
+        Show::Transition::Type::CUT, Show::Transition::Type::CROSSFADE,
+        Show::Transition::Type::WIPE, Show::Transition::Type::DISSOLVE
+    };
+    for (auto type: types) {
+        TEST_ASSERT_TRUE(type == Show::Transition::typeFromName(Show::Transition::typeName(type)));
+    }
+    TEST_ASSERT_TRUE(Show::Transition::Type::CROSSFADE == Show::Transition::typeFromName("bogus"));
+}
+
+void test_crossfade_reaches_incoming_show() {
+    auto to = std::make_unique<SolidShow>(0x0000FF);
+    SolidShow *incoming = to.get();
+    Show::Transition transition(std::make_unique<SolidShow>(0xFF0000), std::move(to),
+                                Show::Transition::Type::CROSSFADE, 4, BUDGET);
+    MockStrip strip(10);
+
+    transition.execute(strip, 0);
+    TEST_ASSERT_EQUAL_HEX32(Support::Blend::mix(0xFF0000, 0x0000FF, 63), strip.getPixelColor(5));
+    transition.execute(strip, 1);
+    TEST_ASSERT_EQUAL_HEX32(Support::Blend::mix(0xFF0000, 0x0000FF, 127), strip.getPixelColor(5));
+    TEST_ASSERT_FALSE(transition.isFinished());
+
+    transition.execute(strip, 2);
+    transition.execute(strip, 3);
+    TEST_ASSERT_TRUE(transition.isFinished());
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, strip.getPixelColor(0));
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, strip.getPixelColor(9));
+
+    auto released = transition.release();
+    TEST_ASSERT_TRUE(released.get() == incoming);
+    TEST_ASSERT_EQUAL(4, incoming->executions);
+}
+
+void test_wipe_halfway() {
+    Show::Transition transition(std::make_unique<SolidShow>(0xFF0000), std::make_unique<SolidShow>(0x00FF00),
+                                Show::Transition::Type::WIPE, 2, BUDGET);
+    MockStrip strip(10);
+
+    transition.execute(strip, 0);
+    // amount 127 puts the edge just before pixel 5
+    TEST_ASSERT_EQUAL_HEX32(0x00FF00, strip.getPixelColor(0));
+    TEST_ASSERT_EQUAL_HEX32(0x00FF00, strip.getPixelColor(3));
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, strip.getPixelColor(5));
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, strip.getPixelColor(9));
+
+    transition.execute(strip, 1);
+    TEST_ASSERT_EQUAL_HEX32(0x00FF00, strip.getPixelColor(9));
+}
+
+void test_dissolve_switches_pixels_gradually() {
+    Show::Transition transition(std::make_unique<SolidShow>(0xFF0000), std::make_unique<SolidShow>(0x00FF00),
+                                Show::Transition::Type::DISSOLVE, 2, BUDGET);
+    MockStrip strip(200);
+
+    transition.execute(strip, 0);
+    int switched = 0;
+    for (Strip::PixelIndex i = 0; i < 200; i++) {
+        Strip::Color c = strip.getPixelColor(i);
+        TEST_ASSERT_TRUE(c == 0xFF0000 || c == 0x00FF00);
+        switched += c == 0x00FF00;
+    }
+    TEST_ASSERT_INT_WITHIN(40, 100, switched);
+
+    transition.execute(strip, 1);
+    for (Strip::PixelIndex i = 0; i < 200; i++) {
+        TEST_ASSERT_EQUAL_HEX32(0x00FF00, strip.getPixelColor(i));
+    }
+}
+
+void test_blend_leaves_both_frames_untouched() {
+    Show::Transition transition(std::make_unique<DrawOnceShow>(0xFF0000), std::make_unique<DrawOnceShow>(0x0000FF),
+                                Show::Transition::Type::CROSSFADE, 4, BUDGET);
+    MockStrip strip(10);
+
+    transition.execute(strip, 0);
+    transition.execute(strip, 1);
+    TEST_ASSERT_EQUAL_HEX32(Support::Blend::mix(0xFF0000, 0x0000FF, 127), strip.getPixelColor(5));
+    transition.execute(strip, 2);
+    TEST_ASSERT_EQUAL_HEX32(Support::Blend::mix(0xFF0000, 0x0000FF, 191), strip.getPixelColor(5));
+    transition.execute(strip, 3);
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, strip.getPixelColor(5));
+}
+
+void test_snapshot_fallback_when_over_budget() {
+    auto from = std::make_unique<SolidShow>(0xFF0000);
+    SolidShow *outgoing = from.get();
+    MockStrip strip(100);
+    from->execute(strip, 0); // last frame before the switch
+    outgoing->executions = 0;
+
+    // room for one buffer only
+    Show::Transition transition(std::move(from), std::make_unique<SolidShow>(0x0000FF),
+                                Show::Transition::Type::CROSSFADE, 2, 100 * sizeof(Strip::Color));
+
+    transition.execute(strip, 1);
+    TEST_ASSERT_EQUAL_HEX32(Support::Blend::mix(0xFF0000, 0x0000FF, 127), strip.getPixelColor(50));
+    transition.execute(strip, 2);
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, strip.getPixelColor(50));
+    TEST_ASSERT_TRUE(transition.isFinished());
+}
+
+void test_snapshot_without_outgoing_show() {
+    MockStrip strip(10);
+    strip.fill(0xFFFFFF);
+
+    Show::Transition transition(nullptr, std::make_unique<SolidShow>(0x000000),
+                                Show::Transition::Type::CROSSFADE, 2, BUDGET);
+    transition.execute(strip, 0);
+    TEST_ASSERT_EQUAL_HEX32(0x808080, strip.getPixelColor(0));
+}
+
+void test_cut_without_memory() {
+    MockStrip strip(100);
+    Show::Transition transition(std::make_unique<SolidShow>(0xFF0000), std::make_unique<SolidShow>(0x0000FF),
+                                Show::Transition::Type::CROSSFADE, 10, 16);
+
+    transition.execute(strip, 0);
+    TEST_ASSERT_TRUE(transition.isFinished());
+    TEST_ASSERT_EQUAL_HEX32(0x0000FF, strip.getPixelColor(0));
+}
+
+void test_cut_type_finishes_immediately() {
+    Show::Transition transition(std::make_unique<SolidShow>(0xFF0000), std::make_unique<SolidShow>(0x0000FF),
+                                Show::Transition::Type::CUT, 10, BUDGET);
+    TEST_ASSERT_TRUE(transition.isFinished());
+}
+
+void test_benchmark_blend_kernels() {
+    for (size_t length: {300, 1000}) {
+        std::vector<Strip::Color> from(length), to(length), out(length);
+        for (size_t i = 0; i < length; i++) {
+            from[i] = wheel(i % 255);
+            to[i] = wheel((i * 7) % 255);
+        }
+        char label[48];
+        uint8_t amount = 0;
+
+        snprintf(label, sizeof(label), "crossfade %zu px", length);
+        benchmark(label, 2000, length, [&] {
+            Support::Blend::crossfade(from.data(), to.data(), out.data(), length, amount++);
+            benchmark_sink = out[length / 2];
+        });
+        snprintf(label, sizeof(label), "wipe %zu px", length);
+        benchmark(label, 2000, length, [&] {
+            Support::Blend::wipe(from.data(), to.data(), out.data(), length, amount++);
+            benchmark_sink = out[length / 2];
+        });
+        snprintf(label, sizeof(label), "dissolve %zu px", length);
+        benchmark(label, 2000, length, [&] {
+            Support::Blend::dissolve(from.data(), to.data(), out.data(), length, amount++);
+            benchmark_sink = out[length / 2];
+        });
+    }
+}
+
+void test_benchmark_transition_frame() {
+    MockStrip strip(300);
+    Show::Transition transition(std::make_unique<Show::Rainbow>(), std::make_unique<Show::Rainbow>(3.0f, 2.0f),
+                                Show::Transition::Type::CROSSFADE, 1000000, BUDGET);
+    Show::Iteration iteration = 0;
+    benchmark("crossfade Rainbow -> Rainbow 300 px (render + blend)", 500, 300, [&] {
+        transition.execute(strip, iteration++);
+    });
+    TEST_PASS();
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_mix_endpoints);
+    RUN_TEST(test_type_names_round_trip);
+    RUN_TEST(test_crossfade_reaches_incoming_show);
+    RUN_TEST(test_wipe_halfway);
+    RUN_TEST(test_dissolve_switches_pixels_gradually);
+    RUN_TEST(test_blend_leaves_both_frames_untouched);
+    RUN_TEST(test_snapshot_fallback_when_over_budget);
+    RUN_TEST(test_snapshot_without_outgoing_show);
+    RUN_TEST(test_cut_without_memory);
+    RUN_TEST(test_cut_type_finishes_immediately);
+
+    RUN_TEST(test_benchmark_blend_kernels);
+    RUN_TEST(test_benchmark_transition_frame);
+
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}
@@ -0,0 +1,199 @@
+#include "unity.h"
+#include "../Benchmark.h"
+#include "../MockStrip.h"
+#include "color.h"
+#include "show/Wave.h"
+
+#include <cmath>
+#include <cstdlib>
+
+using Show::Wave;
+
+// The engine Wave had before: sinf and expf for every pixel and frame, a
+// single source at pixel 0. Kept to compare against.
+class ReferenceWave {
+public:
+    ReferenceWave(float wave_speed, float decay_rate, float brightness_frequency, float wavelength)
+        : wave_speed(wave_speed), decay_rate(decay_rate), brightness_frequency(brightness_frequency),
+          wavelength(wavelength) {
+    }
+
+    void execute(Strip::Strip &strip) {
+        time += 0.05f;
+        color_time += 0.05f;
+        uint16_t num_leds = strip.length();
+        float source_brightness = 0.65f + 0.35f * sinf(time * brightness_frequency * 2.0f * M_PI);
+        for (uint16_t i = 0; i < num_leds; i++) {
+            float wave_position = (float) (i - (time * wave_speed * 10.0f)) / wavelength;
+            float wave_brightness = (sinf(wave_position) + 1.0f) / 2.0f;
+            float emission_time = color_time - ((float) i / (wave_speed * 10.0f));
+            uint8_t color_index = (uint8_t) ((int) (emission_time * 20.0f) % 255);
+            Strip::Color pixel_color = wheel(color_index);
+            float distance_factor = expf(-decay_rate * (float) i / (float) num_leds);
+            float final_brightness = source_brightness * wave_brightness * distance_factor;
+            uint8_t r = (uint8_t) (red(pixel_color) * final_brightness);
+            uint8_t g = (uint8_t) (green(pixel_color) * final_brightness);
+            uint8_t b = (uint8_t) (blue(pixel_color) * final_brightness);
+            strip.setPixelColor(i, color(r, g, b));
+        }
+    }
+
+private:
+    float wave_speed, decay_rate, brightness_frequency, wavelength;
+    float time = 0.0f;
+    float color_time = 0.0f;
+};
+
+// Largest difference of any color component between two pixels
+static int difference(Strip::Color a, Strip::Color b) {
+    return std::max(std::abs(red(a) - red(b)), std::max(std::abs(green(a) - green(b)), std::abs(blue(a) - blue(b))));
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_single_source_looks_like_the_old_engine() {
+    const float settings[][4] = {{1.0f, 2.0f, 0.1f, 6.0f}, {0.3f, 4.0f, 0.5f, 15.0f}, {2.5f, 0.5f, 0.05f, 2.0f}};
+    for (const auto &setting: settings) {
+        Wave wave(setting[0], setting[1], setting[2], setting[3]);
+        ReferenceWave reference(setting[0], setting[1], setting[2], setting[3]);
+        MockStrip strip(60);
+        MockStrip expected(60);
+        int worst = 0;
+        // frames early on, while the old engine's color index is still
+        // negative at the far end, wrap differently: compare later frames
+        for (int frame = 0; frame < 600; frame++) {
+            wave.execute(strip, frame);
+            reference.execute(expected);
+            if (frame < 300) {
+                continue;
+            }
+            for (Strip::PixelIndex i = 0; i < 60; i++) {
+                worst = std::max(worst, difference(expected.getPixelColor(i), strip.getPixelColor(i)));
+            }
+        }
+        // phase and hue are accumulated differently: off by a level or two at most
+        TEST_ASSERT_LESS_OR_EQUAL(3, worst);
+    }
+}
+
+void test_decay_follows_the_strip_length() {
+    Wave wave;
+    ReferenceWave reference(1.0f, 2.0f, 0.1f, 6.0f);
+    MockStrip short_strip(30);
+    MockStrip long_strip(90);
+    MockStrip expected(90);
+    for (int frame = 0; frame < 400; frame++) {
+        bool long_frames = frame >= 350;
+        MockStrip &strip = long_frames ? long_strip : short_strip;
+        wave.execute(strip, frame);
+        MockStrip reference_strip(strip.length());
+        reference.execute(long_frames ? expected : reference_strip);
+        if (long_frames) {
+            for (Strip::PixelIndex i = 0; i < 90; i++) {
+                TEST_ASSERT_LESS_OR_EQUAL(3, difference(expected.getPixelColor(i), long_strip.getPixelColor(i)));
+            }
+        }
+    }
+}
+
+void test_waves_run_both_ways_from_a_source() {
+    Wave wave(1.0f, 2.0f, 0.1f, 6.0f, {{20, 6.0f, 1.0f}});
+    MockStrip strip(41);
+    for (int frame = 0; frame < 50; frame++) {
+        wave.execute(strip, frame);
+        for (Strip::PixelIndex d = 1; d <= 20; d++) {
+            TEST_ASSERT_LESS_OR_EQUAL(1, difference(strip.getPixelColor(20 - d), strip.getPixelColor(20 + d)));
+        }
+    }
+
+    // a source past the end is at the last pixel
+    Wave clamped(1.0f, 2.0f, 0.1f, 6.0f, {{1000, 6.0f, 1.0f}});
+    Wave at_end(1.0f, 2.0f, 0.1f, 6.0f, {{40, 6.0f, 1.0f}});
+    MockStrip other(41);
+    clamped.execute(strip, 0);
+    at_end.execute(other, 0);
+    for (Strip::PixelIndex i = 0; i < 41; i++) {
+        TEST_ASSERT_EQUAL_HEX32(other.getPixelColor(i), strip.getPixelColor(i));
+    }
+}
+
+void test_sources_interfere() {
+    // two sources in the same place add up, clipped to full brightness
+    Wave one(1.0f, 2.0f, 0.1f, 6.0f);
+    Wave two(1.0f, 2.0f, 0.1f, 6.0f, {{0, 6.0f, 1.0f}, {0, 6.0f, 1.0f}});
+    MockStrip single(60);
+    MockStrip doubled(60);
+    for (int frame = 0; frame < 20; frame++) {
+        one.execute(single, frame);
+        two.execute(doubled, frame);
+    }
+    for (Strip::PixelIndex i = 0; i < 60; i++) {
+        Strip::Color a = single.getPixelColor(i);
+        Strip::Color b = doubled.getPixelColor(i);
+        TEST_ASSERT_INT_WITHIN(2, std::min(255, 2 * red(a)), red(b));
+        TEST_ASSERT_INT_WITHIN(2, std::min(255, 2 * green(a)), green(b));
+        TEST_ASSERT_INT_WITHIN(2, std::min(255, 2 * blue(a)), blue(b));
+    }
+
+    // from both ends of the strip the ripples meet in the middle: the
+    // brightness there is not the same as from either source alone
+    Wave left(1.0f, 0.0f, 0.0f, 6.0f, {{0, 6.0f, 1.0f}});
+    Wave both(1.0f, 0.0f, 0.0f, 6.0f, {{0, 6.0f, 1.0f}, {59, 6.0f, 1.0f}});
+    left.execute(single, 0);
+    both.execute(doubled, 0);
+    int changed = 0;
+    for (Strip::PixelIndex i = 0; i < 60; i++) {
+        changed += single.getPixelColor(i) != doubled.getPixelColor(i);
+    }
+    TEST_ASSERT_GREATER_THAN(30, changed);
+}
+
+static void benchmarkFrames(Strip::PixelIndex length) {
+    char label[64];
+    MockStrip strip(length);
+
+    ReferenceWave reference(1.0f, 2.0f, 0.1f, 6.0f);
+    snprintf(label, sizeof(label), "sinf/expf Wave, %d LEDs", length);
+    benchmark(label, 500, length, [&] {
+        reference.execute(strip);
+        benchmark_sink = strip.getPixelColor(0);
+    });
+
+    Wave wave;
+    snprintf(label, sizeof(label), "table Wave, %d LEDs", length);
+    benchmark(label, 500, length, [&] {
+        wave.execute(strip, 0);
+        benchmark_sink = strip.getPixelColor(0);
+    });
+
+    auto middle = static_cast<Strip::PixelIndex>(length / 2);
+    Wave three(1.0f, 2.0f, 0.1f, 6.0f, {{0, 6.0f, 1.0f}, {middle, 3.0f, 2.0f}, {length, 9.0f, 0.5f}});
+    snprintf(label, sizeof(label), "table Wave, 3 sources, %d LEDs", length);
+    benchmark(label, 500, length, [&] {
+        three.execute(strip, 0);
+        benchmark_sink = strip.getPixelColor(0);
+    });
+}
+
+void test_benchmark_wave() {
+    benchmarkFrames(300);
+    benchmarkFrames(1000);
+}
+
+int runUnityTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_single_source_looks_like_the_old_engine);
+    RUN_TEST(test_decay_follows_the_strip_length);
+    RUN_TEST(test_waves_run_both_ways_from_a_source);
+    RUN_TEST(test_sources_interfere);
+    RUN_TEST(test_benchmark_wave);
+    return UNITY_END();
+}
+
+int main() {
+    return runUnityTests();
+}